@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include "base/CCScheduler.h"
 #include "base/ccMacros.h"
 #include "base/ccCArray.h"
+#include "base/CCFrameProfiler.h"
 #include "uthash/uthash.h"
 
 NS_CC_BEGIN
@@ -428,6 +429,8 @@ ssize_t ActionManager::getNumberOfRunningActions() const
 // main loop
 void ActionManager::update(float dt)
 {
+    CC_PROFILE_ZONE("ActionManager::update");
+
     for (tHashElement* elt = _targets; elt != nullptr;)
     {
         _currentTarget         = elt;
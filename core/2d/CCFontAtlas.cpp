@@ -37,6 +37,7 @@
 #include "base/CCEventListenerCustom.h"
 #include "base/CCEventDispatcher.h"
 #include "base/CCEventType.h"
+#include "base/CCJobSystem.h"
 
 NS_CC_BEGIN
 
@@ -44,6 +45,8 @@ const int FontAtlas::CacheTextureWidth     = 512;
 const int FontAtlas::CacheTextureHeight    = 512;
 const char* FontAtlas::CMD_PURGE_FONTATLAS = "__cc_PURGE_FONTATLAS";
 const char* FontAtlas::CMD_RESET_FONTATLAS = "__cc_RESET_FONTATLAS";
+const char* FontAtlas::CMD_UPDATE_FONTATLAS = "__cc_UPDATE_FONTATLAS";
+bool FontAtlas::_asyncGlyphRenderingEnabled = false;
 
 FontAtlas::FontAtlas(Font* theFont) : _font(theFont)
 {
@@ -121,6 +124,15 @@ FontAtlas::~FontAtlas()
     }
 #endif
 
+    if (_beforeDrawListener)
+    {
+        Director::getInstance()->getEventDispatcher()->removeEventListener(_beforeDrawListener);
+        _beforeDrawListener = nullptr;
+    }
+
+    for (auto& glyph : _renderedGlyphs)
+        delete[] glyph.bitmap;
+
     _font->release();
     releaseTextures();
 
@@ -162,12 +174,19 @@ void FontAtlas::reset()
 {
     releaseTextures();
 
-    _currLineHeight   = 0;
-    _currentPage      = 0;
-    _currentPageOrigX = 0;
-    _currentPageOrigY = 0;
+    _currentPage   = 0;
+    _shelvesBottom = 0;
+    _dirtyTop      = CacheTextureHeight;
+    _dirtyBottom   = 0;
+    _shelves.clear();
     _letterDefinitions.clear();
 
+    // the glyphs being rendered belong to the definitions cleared above
+    ++_generation;
+    for (auto& glyph : _renderedGlyphs)
+        delete[] glyph.bitmap;
+    _renderedGlyphs.clear();
+
     reinit();
 }
 
@@ -377,130 +396,276 @@ bool FontAtlas::prepareLetterDefinitions(const std::u32string& utf32Text)
         return false;
     }
 
-    int adjustForDistanceMap = _letterPadding / 2;
-    int adjustForExtend      = _letterEdgeExtend / 2;
-    int32_t bitmapWidth;
-    int32_t bitmapHeight;
-    int glyphHeight;
+    if (_asyncGlyphRenderingEnabled)
+    {
+        renderGlyphsAsync(codeMapOfNewChar);
+        return true;
+    }
+
+    int32_t bitmapWidth  = 0;
+    int32_t bitmapHeight = 0;
+    int xAdvance         = 0;
     Rect tempRect;
-    FontLetterDefinition tempDef;
 
-    auto scaleFactor = CC_CONTENT_SCALE_FACTOR();
-    auto pixelFormat = _fontFreeType->getOutlineSize() > 0 ? backend::PixelFormat::LA8 : backend::PixelFormat::A8;
+    for (auto&& it : codeMapOfNewChar)
+    {
+        auto bitmap = _fontFreeType->getGlyphBitmap(it.second, bitmapWidth, bitmapHeight, tempRect, xAdvance);
+        addGlyph(it.first, bitmap, bitmapWidth, bitmapHeight, tempRect, xAdvance);
+    }
 
-    int startY = (int)_currentPageOrigY;
+    updateTextureContent();
+    return true;
+}
 
-    for (auto&& it : codeMapOfNewChar)
+void FontAtlas::addGlyph(char32_t utf32Char,
+                         unsigned char* bitmap,
+                         int32_t bitmapWidth,
+                         int32_t bitmapHeight,
+                         const Rect& rect,
+                         int xAdvance)
+{
+    FontLetterDefinition tempDef;
+    tempDef.xAdvance = xAdvance;
+    tempDef.rotated  = false;
+
+    int originX = 0;
+    int originY = 0;
+    bool placed = false;
+    if (bitmap && bitmapWidth > 0 && bitmapHeight > 0)
     {
-        auto bitmap = _fontFreeType->getGlyphBitmap(it.second, bitmapWidth, bitmapHeight, tempRect, tempDef.xAdvance);
-        if (bitmap && bitmapWidth > 0 && bitmapHeight > 0)
+        tempDef.width  = rect.size.width + _letterPadding + _letterEdgeExtend;
+        tempDef.height = rect.size.height + _letterPadding + _letterEdgeExtend;
+
+        // the bitmap and the metrics may differ by a pixel, reserve room for both
+        int glyphWidth  = std::max(static_cast<int>(tempDef.width), bitmapWidth + _letterPadding + _letterEdgeExtend);
+        int glyphHeight = std::max(static_cast<int>(tempDef.height), bitmapHeight + _letterPadding + _letterEdgeExtend);
+
+        placed = allocateGlyphRect(glyphWidth, glyphHeight, originX, originY);
+        if (!placed)
         {
-            tempDef.validDefinition = true;
-            tempDef.width           = tempRect.size.width + _letterPadding + _letterEdgeExtend;
-            tempDef.height          = tempRect.size.height + _letterPadding + _letterEdgeExtend;
-            tempDef.offsetX         = tempRect.origin.x - adjustForDistanceMap - adjustForExtend;
-            tempDef.offsetY         = _fontAscender + tempRect.origin.y - adjustForDistanceMap - adjustForExtend;
+            addNewPage();
+            placed = allocateGlyphRect(glyphWidth, glyphHeight, originX, originY);
+        }
 
-            if (_currentPageOrigX + tempDef.width > CacheTextureWidth)
-            {
-                _currentPageOrigY += _currLineHeight;
-                _currLineHeight   = 0;
-                _currentPageOrigX = 0;
-                if (_currentPageOrigY + _lineHeight + _letterPadding + _letterEdgeExtend >= CacheTextureHeight)
-                {
-                    updateTextureContent(pixelFormat, startY);
-
-                    startY = 0;
-
-                    _currentPageOrigY = 0;
-                    memset(_currentPageData, 0, _currentPageDataSize);
-                    _currentPage++;
-                    auto tex = new Texture2D;
-
-                    initTextureWithZeros(tex);
-
-                    if (_antialiasEnabled)
-                    {
-                        tex->setAntiAliasTexParameters();
-                    }
-                    else
-                    {
-                        tex->setAliasTexParameters();
-                    }
-                    addTexture(tex, _currentPage);
-
-                    tex->release();
-                }
-            }
-            glyphHeight = static_cast<int>(bitmapHeight) + _letterPadding + _letterEdgeExtend;
-            if (glyphHeight > _currLineHeight)
-            {
-                _currLineHeight = glyphHeight;
-            }
-            _fontFreeType->renderCharAt(_currentPageData, (int)_currentPageOrigX + adjustForExtend,
-                                        (int)_currentPageOrigY + adjustForExtend, bitmap, bitmapWidth, bitmapHeight);
-
-            tempDef.U         = _currentPageOrigX;
-            tempDef.V         = _currentPageOrigY;
-            tempDef.textureID = _currentPage;
-            _currentPageOrigX += tempDef.width + 1;
-            // take from pixels to points
-            tempDef.width   = tempDef.width / scaleFactor;
-            tempDef.height  = tempDef.height / scaleFactor;
-            tempDef.U       = tempDef.U / scaleFactor;
-            tempDef.V       = tempDef.V / scaleFactor;
-            tempDef.rotated = false;
+        if (placed)
+        {
+            _dirtyTop    = std::min(_dirtyTop, originY);
+            _dirtyBottom = std::max(_dirtyBottom, originY + glyphHeight);
         }
         else
         {
-            if (bitmap)
-                delete[] bitmap;
-            if (tempDef.xAdvance)
-                tempDef.validDefinition = true;
-            else
-                tempDef.validDefinition = false;
-
-            tempDef.width     = 0;
-            tempDef.height    = 0;
-            tempDef.U         = 0;
-            tempDef.V         = 0;
-            tempDef.offsetX   = 0;
-            tempDef.offsetY   = 0;
-            tempDef.textureID = 0;
-            tempDef.rotated   = false;
-            _currentPageOrigX += 1;
+            CCLOG("FontAtlas: the glyph of %u doesn't fit in a page", static_cast<unsigned int>(utf32Char));
         }
+    }
 
-        _letterDefinitions[it.first] = tempDef;
+    if (placed)
+    {
+        int adjustForDistanceMap = _letterPadding / 2;
+        int adjustForExtend      = _letterEdgeExtend / 2;
+        auto scaleFactor         = CC_CONTENT_SCALE_FACTOR();
+
+        tempDef.validDefinition = true;
+        tempDef.offsetX         = rect.origin.x - adjustForDistanceMap - adjustForExtend;
+        tempDef.offsetY         = _fontAscender + rect.origin.y - adjustForDistanceMap - adjustForExtend;
+
+        _fontFreeType->renderCharAt(_currentPageData, originX + adjustForExtend, originY + adjustForExtend, bitmap,
+                                    bitmapWidth, bitmapHeight);
+
+        tempDef.textureID = _currentPage;
+        // take from pixels to points
+        tempDef.width  = tempDef.width / scaleFactor;
+        tempDef.height = tempDef.height / scaleFactor;
+        tempDef.U      = originX / scaleFactor;
+        tempDef.V      = originY / scaleFactor;
+    }
+    else
+    {
+        // like renderCharAt, only the bitmaps of the outlined glyphs are owned here
+        if (bitmap && _fontFreeType->getOutlineSize() > 0)
+            delete[] bitmap;
+
+        tempDef.validDefinition = tempDef.xAdvance != 0;
+        tempDef.width           = 0;
+        tempDef.height          = 0;
+        tempDef.U               = 0;
+        tempDef.V               = 0;
+        tempDef.offsetX         = 0;
+        tempDef.offsetY         = 0;
+        tempDef.textureID       = 0;
     }
 
-    updateTextureContent(pixelFormat, startY);
+    _letterDefinitions[utf32Char] = tempDef;
+}
+
+bool FontAtlas::allocateGlyphRect(int width, int height, int& x, int& y)
+{
+    // the lowest shelf the glyph fits in
+    GlyphShelf* best = nullptr;
+    for (auto& shelf : _shelves)
+    {
+        if (shelf.height >= height && shelf.x + width <= CacheTextureWidth && (!best || shelf.height < best->height))
+            best = &shelf;
+    }
+
+    // a shelf much higher than the glyph wastes space, open a new one while the page has room
+    if (!best || best->height > height + height / 2)
+    {
+        // round up, so glyphs of close heights share shelves
+        int shelfHeight = (height + 3) & ~3;
+        if (_shelvesBottom + shelfHeight <= CacheTextureHeight && width <= CacheTextureWidth)
+        {
+            _shelves.push_back({_shelvesBottom, shelfHeight, 0});
+            _shelvesBottom += shelfHeight + 1;
+            best = &_shelves.back();
+        }
+    }
+
+    if (!best)
+        return false;
+
+    x = best->x;
+    y = best->y;
+    best->x += width + 1;
     return true;
 }
 
-void FontAtlas::updateTextureContent(backend::PixelFormat format, int startY)
+void FontAtlas::addNewPage()
 {
-    unsigned char* data = nullptr;
-    auto outlineSize    = _fontFreeType->getOutlineSize();
-    if (outlineSize > 0 && format == backend::PixelFormat::LA8)
+    updateTextureContent();
+
+    memset(_currentPageData, 0, _currentPageDataSize);
+    _shelves.clear();
+    _shelvesBottom = 0;
+    _currentPage++;
+
+    auto tex = new Texture2D;
+
+    initTextureWithZeros(tex);
+
+    if (_antialiasEnabled)
+    {
+        tex->setAntiAliasTexParameters();
+    }
+    else
     {
-        int nLen = CacheTextureWidth * ((int)_currentPageOrigY - startY + _currLineHeight);
-        data     = _currentPageData + CacheTextureWidth * (int)startY * 2;
+        tex->setAliasTexParameters();
+    }
+    addTexture(tex, _currentPage);
+
+    tex->release();
+}
+
+void FontAtlas::updateTextureContent()
+{
+    if (_dirtyTop >= _dirtyBottom)
+        return;
+
+    int rows = std::min(_dirtyBottom, CacheTextureHeight) - _dirtyTop;
+    if (_fontFreeType->getOutlineSize() > 0)
+    {
+        int nLen  = CacheTextureWidth * rows;
+        auto data = _currentPageData + CacheTextureWidth * _dirtyTop * 2;
         memset(_currentPageDataRGBA, 0, 4 * nLen);
         for (auto i = 0; i < nLen; i++)
         {
             _currentPageDataRGBA[i * 4]     = data[i * 2];
             _currentPageDataRGBA[i * 4 + 3] = data[i * 2 + 1];
         }
-        _atlasTextures[_currentPage]->updateWithSubData(_currentPageDataRGBA, 0, startY, CacheTextureWidth,
-                                                        (int)_currentPageOrigY - startY + _currLineHeight);
+        _atlasTextures[_currentPage]->updateWithSubData(_currentPageDataRGBA, 0, _dirtyTop, CacheTextureWidth, rows);
     }
     else
     {
-        data = _currentPageData + CacheTextureWidth * (int)startY;
-        _atlasTextures[_currentPage]->updateWithSubData(data, 0, startY, CacheTextureWidth,
-                                                        (int)_currentPageOrigY - startY + _currLineHeight);
+        auto data = _currentPageData + CacheTextureWidth * _dirtyTop;
+        _atlasTextures[_currentPage]->updateWithSubData(data, 0, _dirtyTop, CacheTextureWidth, rows);
     }
+
+    _dirtyTop    = CacheTextureHeight;
+    _dirtyBottom = 0;
+}
+
+void FontAtlas::renderGlyphsAsync(const std::unordered_map<unsigned int, unsigned int>& charCodeMap)
+{
+    auto glyphs = std::make_shared<std::vector<GlyphBitmap>>();
+    glyphs->reserve(charCodeMap.size());
+    for (auto&& it : charCodeMap)
+    {
+        // the placeholder also keeps findNewCharacters from requesting the glyph again
+        auto& letterDefinition           = _letterDefinitions[it.first];
+        letterDefinition                 = FontLetterDefinition{};
+        letterDefinition.validDefinition = true;
+        letterDefinition.xAdvance        = getPlaceholderAdvance(it.first);
+
+        GlyphBitmap glyph;
+        glyph.utf32Char = it.first;
+        glyph.charCode  = it.second;
+        glyphs->push_back(glyph);
+    }
+
+    if (!_beforeDrawListener)
+    {
+        _beforeDrawListener = Director::getInstance()->getEventDispatcher()->addCustomEventListener(
+            Director::EVENT_BEFORE_DRAW, [this](EventCustom* /*event*/) { addRenderedGlyphs(); });
+    }
+
+    // the atlas, and its font, are kept alive until the glyphs are back on the cocos thread
+    retain();
+    auto fontFreeType = _fontFreeType;
+    auto generation   = _generation;
+    JobSystem::getInstance()->submit(
+        [glyphs, fontFreeType]() {
+            JobSystem::getInstance()->parallelFor(glyphs->size(), [&glyphs, fontFreeType](size_t index) {
+                auto& glyph  = (*glyphs)[index];
+                glyph.bitmap = fontFreeType->renderGlyphBitmap(glyph.charCode, glyph.width, glyph.height, glyph.rect,
+                                                               glyph.xAdvance);
+            });
+        },
+        [this, glyphs, generation]() {
+            if (generation == _generation)
+            {
+                _renderedGlyphs.insert(_renderedGlyphs.end(), glyphs->begin(), glyphs->end());
+            }
+            else
+            {
+                for (auto& glyph : *glyphs)
+                    delete[] glyph.bitmap;
+            }
+            release();
+        },
+        JobSystem::Priority::HIGH);
+}
+
+void FontAtlas::addRenderedGlyphs()
+{
+    if (_renderedGlyphs.empty())
+        return;
+
+    if (!_currentPageData)
+        reinit();
+
+    bool outlined = _fontFreeType->getOutlineSize() > 0;
+    for (auto& glyph : _renderedGlyphs)
+    {
+        addGlyph(glyph.utf32Char, glyph.bitmap, glyph.width, glyph.height, glyph.rect, glyph.xAdvance);
+        // addGlyph releases the outlined bitmaps only, renderGlyphBitmap gave us the others too
+        if (!outlined)
+            delete[] glyph.bitmap;
+    }
+    _renderedGlyphs.clear();
+
+    // one upload for all the glyphs of the frame
+    updateTextureContent();
+
+    Director::getInstance()->getEventDispatcher()->dispatchCustomEvent(CMD_UPDATE_FONTATLAS, this);
+}
+
+int FontAtlas::getPlaceholderAdvance(char32_t utf32Char) const
+{
+    if (utf32Char < 0x20)
+        return 0;
+
+    // about an em for the east asian scripts, half of it for the others
+    auto fontHeight = _fontFreeType->getFontMaxHeight();
+    return utf32Char >= 0x2E80 ? fontHeight : fontHeight / 2;
 }
 
 void FontAtlas::addTexture(Texture2D* texture, int slot)
@@ -32,6 +32,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "platform/CCPlatformMacros.h"
 #include "base/CCRef.h"
@@ -66,6 +67,7 @@ public:
     static const int CacheTextureHeight;
     static const char* CMD_PURGE_FONTATLAS;
     static const char* CMD_RESET_FONTATLAS;
+    static const char* CMD_UPDATE_FONTATLAS;
     /**
      * @js ctor
      */
@@ -113,7 +115,35 @@ public:
     */
     void setAliasTexParameters();
 
+    /** Enables rendering the new glyphs of prepareLetterDefinitions on the JobSystem workers, disabled by default.
+     Until they are added to the atlas the new letters have placeholder definitions, with an estimated advance and
+     nothing to draw. The rendered glyphs are added once per frame, before drawing, and CMD_UPDATE_FONTATLAS is
+     dispatched then.
+     */
+    static void setAsyncGlyphRenderingEnabled(bool enabled) { _asyncGlyphRenderingEnabled = enabled; }
+    static bool isAsyncGlyphRenderingEnabled() { return _asyncGlyphRenderingEnabled; }
+
 protected:
+    // a glyph rendered on a worker thread, waiting to be added to the atlas
+    struct GlyphBitmap
+    {
+        char32_t utf32Char    = 0;
+        unsigned int charCode = 0;
+        unsigned char* bitmap = nullptr;
+        int32_t width         = 0;
+        int32_t height        = 0;
+        Rect rect;
+        int xAdvance = 0;
+    };
+
+    // a row of the current page, holding glyphs up to its height side by side
+    struct GlyphShelf
+    {
+        int y;
+        int height;
+        int x;
+    };
+
     void reset();
 
     void reinit();
@@ -134,7 +164,25 @@ protected:
      */
     void scaleFontLetterDefinition(float scaleFactor);
 
-    void updateTextureContent(backend::PixelFormat format, int startY);
+    void addGlyph(char32_t utf32Char,
+                  unsigned char* bitmap,
+                  int32_t bitmapWidth,
+                  int32_t bitmapHeight,
+                  const Rect& rect,
+                  int xAdvance);
+
+    bool allocateGlyphRect(int width, int height, int& x, int& y);
+
+    void addNewPage();
+
+    /** Uploads the rows of the current page changed since the last upload. */
+    void updateTextureContent();
+
+    void renderGlyphsAsync(const std::unordered_map<unsigned int, unsigned int>& charCodeMap);
+
+    void addRenderedGlyphs();
+
+    int getPlaceholderAdvance(char32_t utf32Char) const;
 
     std::unordered_map<ssize_t, Texture2D*> _atlasTextures;
     std::unordered_map<char32_t, FontLetterDefinition> _letterDefinitions;
@@ -149,15 +197,25 @@ protected:
     unsigned char* _currentPageDataRGBA = nullptr;
     int _currentPageDataSize            = 0;
     int _currentPageDataSizeRGBA        = 0;
-    float _currentPageOrigX             = 0;
-    float _currentPageOrigY             = 0;
     int _letterPadding                  = 0;
     int _letterEdgeExtend               = 0;
 
+    // shelf packing of the current page
+    std::vector<GlyphShelf> _shelves;
+    int _shelvesBottom = 0;
+    // the rows of the current page to upload
+    int _dirtyTop    = CacheTextureHeight;
+    int _dirtyBottom = 0;
+
+    // async glyph rendering, jobs started before a reset are dropped by comparing the generation
+    std::vector<GlyphBitmap> _renderedGlyphs;
+    unsigned int _generation                 = 0;
+    EventListenerCustom* _beforeDrawListener = nullptr;
+    static bool _asyncGlyphRenderingEnabled;
+
     int _fontAscender                               = 0;
     EventListenerCustom* _rendererRecreatedListener = nullptr;
     bool _antialiasEnabled                          = true;
-    int _currLineHeight                             = 0;
 
     friend class Label;
 };
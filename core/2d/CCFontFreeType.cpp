@@ -61,6 +61,9 @@ typedef struct _DataRef
 
 static std::unordered_map<std::string, DataRef> s_cacheFontData;
 
+// FT_Open_Face and FT_Done_Face change the library, they can't run concurrently, see renderGlyphBitmap
+static std::mutex s_faceMutex;
+
 // ------ freetype2 stream parsing support ---
 static unsigned long ft_stream_read_callback(FT_Stream stream,
                                              unsigned long offset,
@@ -149,6 +152,7 @@ FT_Library FontFreeType::getFTLibrary()
 FontFreeType::FontFreeType(bool distanceFieldEnabled /* = false */, float outline /* = 0 */)
 : _fontFace(nullptr)
 , _stroker(nullptr)
+, _charSize(0)
 , _encoding(FT_ENCODING_UNICODE)
 , _distanceFieldEnabled(distanceFieldEnabled)
 , _outlineSize(0.0f)
@@ -199,6 +203,7 @@ bool FontFreeType::loadFontFace(std::string_view fontName, float fontSize)
         args.flags        = FT_OPEN_STREAM;
         args.stream       = fts.get();
 
+        std::lock_guard<std::mutex> lock(s_faceMutex);
         if (FT_Open_Face(getFTLibrary(), &args, 0, &face))
             return false;
 
@@ -220,6 +225,7 @@ bool FontFreeType::loadFontFace(std::string_view fontName, float fontSize)
 
         ++sharableData->referenceCount;
         auto& data = sharableData->data;
+        std::lock_guard<std::mutex> lock(s_faceMutex);
         if (data.isNull() ||
             FT_New_Memory_Face(getFTLibrary(), data.getBytes(), static_cast<FT_Long>(data.getSize()), 0, &face))
             return false;
@@ -254,6 +260,7 @@ bool FontFreeType::loadFontFace(std::string_view fontName, float fontSize)
     int fontSizePoints = (int)(64.f * fontSize * CC_CONTENT_SCALE_FACTOR());
     if (FT_Set_Char_Size(face, fontSizePoints, fontSizePoints, dpi, dpi))
         return false;
+    _charSize = fontSizePoints;
 
     // store the face globally
     _fontFace = face;
@@ -285,6 +292,7 @@ FontFreeType::~FontFreeType()
 {
     if (_FTInitialized)
     {
+        std::lock_guard<std::mutex> lock(s_faceMutex);
         if (_stroker)
         {
             FT_Stroker_Done(_stroker);
@@ -293,6 +301,12 @@ FontFreeType::~FontFreeType()
         {
             FT_Done_Face(_fontFace);
         }
+        for (auto& workerFace : _idleWorkerFaces)
+        {
+            if (workerFace.stroker)
+                FT_Stroker_Done(workerFace.stroker);
+            FT_Done_Face(workerFace.face);
+        }
     }
 
     auto iter = s_cacheFontData.find(_fontName);
@@ -385,16 +399,109 @@ unsigned char* FontFreeType::getGlyphBitmap(uint32_t theChar,
                                             int32_t& outHeight,
                                             Rect& outRect,
                                             int& xAdvance)
+{
+    return getGlyphBitmap(_fontFace, _stroker, theChar, outWidth, outHeight, outRect, xAdvance);
+}
+
+unsigned char* FontFreeType::renderGlyphBitmap(uint32_t theChar,
+                                               int32_t& outWidth,
+                                               int32_t& outHeight,
+                                               Rect& outRect,
+                                               int& xAdvance)
+{
+    WorkerFace workerFace;
+    if (!acquireWorkerFace(workerFace))
+    {
+        outRect.size.width  = 0;
+        outRect.size.height = 0;
+        xAdvance            = 0;
+        return nullptr;
+    }
+
+    auto ret = getGlyphBitmap(workerFace.face, workerFace.stroker, theChar, outWidth, outHeight, outRect, xAdvance);
+    if (ret && (outWidth <= 0 || outHeight <= 0))
+    {
+        // nothing to draw, and the buffer of an empty glyph belongs to the face
+        ret = nullptr;
+    }
+    else if (ret && _outlineSize <= 0)
+    {
+        // the bitmap belongs to the face glyph slot, copy it before another thread uses the face
+        auto copyBitmap = new unsigned char[outWidth * outHeight];
+        memcpy(copyBitmap, ret, outWidth * outHeight * sizeof(unsigned char));
+        ret = copyBitmap;
+    }
+
+    releaseWorkerFace(workerFace);
+    return ret;
+}
+
+bool FontFreeType::acquireWorkerFace(WorkerFace& workerFace)
+{
+    {
+        std::lock_guard<std::mutex> lock(_workerFacesMutex);
+        if (!_idleWorkerFaces.empty())
+        {
+            workerFace = _idleWorkerFaces.back();
+            _idleWorkerFaces.pop_back();
+            return true;
+        }
+
+        if (_workerFontData.isNull())
+            _workerFontData = FileUtils::getInstance()->getMappedDataFromFile(_fontName);
+        if (_workerFontData.isNull())
+            return false;
+    }
+
+    // _workerFontData isn't changed anymore once it's set, faces can be created without holding _workerFacesMutex
+    FT_Face face;
+    {
+        std::lock_guard<std::mutex> lock(s_faceMutex);
+        if (FT_New_Memory_Face(getFTLibrary(), _workerFontData.getBytes(),
+                               static_cast<FT_Long>(_workerFontData.getSize()), 0, &face))
+            return false;
+    }
+
+    if (FT_Select_Charmap(face, _encoding) || FT_Set_Char_Size(face, _charSize, _charSize, 72, 72))
+    {
+        std::lock_guard<std::mutex> lock(s_faceMutex);
+        FT_Done_Face(face);
+        return false;
+    }
+
+    workerFace.face = face;
+    if (_outlineSize > 0)
+    {
+        FT_Stroker_New(getFTLibrary(), &workerFace.stroker);
+        FT_Stroker_Set(workerFace.stroker, (int)(_outlineSize * 64), FT_STROKER_LINECAP_ROUND,
+                       FT_STROKER_LINEJOIN_ROUND, 0);
+    }
+    return true;
+}
+
+void FontFreeType::releaseWorkerFace(const WorkerFace& workerFace)
+{
+    std::lock_guard<std::mutex> lock(_workerFacesMutex);
+    _idleWorkerFaces.push_back(workerFace);
+}
+
+unsigned char* FontFreeType::getGlyphBitmap(FT_Face face,
+                                            FT_Stroker stroker,
+                                            uint32_t theChar,
+                                            int32_t& outWidth,
+                                            int32_t& outHeight,
+                                            Rect& outRect,
+                                            int& xAdvance)
 {
     unsigned char* ret = nullptr;
 
     do
     {
-        if (_fontFace == nullptr)
+        if (face == nullptr)
             break;
 
         // @remark: glyphIndex=0 means charactor is mssing on current font face
-        auto glyphIndex = FT_Get_Char_Index(_fontFace, static_cast<FT_ULong>(theChar));
+        auto glyphIndex = FT_Get_Char_Index(face, static_cast<FT_ULong>(theChar));
 #if defined(COCOS2D_DEBUG) && COCOS2D_DEBUG > 0
         if (glyphIndex == 0)
         {
@@ -405,31 +512,31 @@ unsigned char* FontFreeType::getGlyphBitmap(uint32_t theChar,
 
             if (charUTF8 == "\n")
                 charUTF8 = "\\n";
-            cocos2d::log("The font face: %s doesn't contains char: <%s>", _fontFace->charmap->face->family_name,
+            cocos2d::log("The font face: %s doesn't contains char: <%s>", face->charmap->face->family_name,
                          charUTF8.c_str());
             return nullptr;
         }
 #endif
-        if (FT_Load_Glyph(_fontFace, glyphIndex, FT_LOAD_RENDER | FT_LOAD_NO_AUTOHINT))
+        if (FT_Load_Glyph(face, glyphIndex, FT_LOAD_RENDER | FT_LOAD_NO_AUTOHINT))
             break;
-        if (_distanceFieldEnabled && _fontFace->glyph->bitmap.buffer)
+        if (_distanceFieldEnabled && face->glyph->bitmap.buffer)
         {
             // Require freetype version > 2.11.0, because freetype 2.11.0 sdf has memory access bug, see:
             // https://gitlab.freedesktop.org/freetype/freetype/-/issues/1077
-            FT_Render_Glyph(_fontFace->glyph, FT_Render_Mode::FT_RENDER_MODE_SDF);
+            FT_Render_Glyph(face->glyph, FT_Render_Mode::FT_RENDER_MODE_SDF);
         }
 
-        auto& metrics       = _fontFace->glyph->metrics;
+        auto& metrics       = face->glyph->metrics;
         outRect.origin.x    = static_cast<float>(metrics.horiBearingX >> 6);
         outRect.origin.y    = static_cast<float>(-(metrics.horiBearingY >> 6));
         outRect.size.width  = static_cast<float>((metrics.width >> 6));
         outRect.size.height = static_cast<float>((metrics.height >> 6));
 
-        xAdvance = (static_cast<int>(_fontFace->glyph->metrics.horiAdvance >> 6));
+        xAdvance = (static_cast<int>(face->glyph->metrics.horiAdvance >> 6));
 
-        outWidth  = _fontFace->glyph->bitmap.width;
-        outHeight = _fontFace->glyph->bitmap.rows;
-        ret       = _fontFace->glyph->bitmap.buffer;
+        outWidth  = face->glyph->bitmap.width;
+        outHeight = face->glyph->bitmap.rows;
+        ret       = face->glyph->bitmap.buffer;
 
         if (_outlineSize > 0 && outWidth > 0 && outHeight > 0)
         {
@@ -437,7 +544,7 @@ unsigned char* FontFreeType::getGlyphBitmap(uint32_t theChar,
             memcpy(copyBitmap, ret, outWidth * outHeight * sizeof(unsigned char));
 
             FT_BBox bbox;
-            auto outlineBitmap = getGlyphBitmapWithOutline(glyphIndex, bbox);
+            auto outlineBitmap = getGlyphBitmapWithOutline(face, stroker, glyphIndex, bbox);
             if (outlineBitmap == nullptr)
             {
                 ret = nullptr;
@@ -518,17 +625,20 @@ unsigned char* FontFreeType::getGlyphBitmap(uint32_t theChar,
     return nullptr;
 }
 
-unsigned char* FontFreeType::getGlyphBitmapWithOutline(unsigned int glyphIndex, FT_BBox& bbox)
+unsigned char* FontFreeType::getGlyphBitmapWithOutline(FT_Face face,
+                                                       FT_Stroker stroker,
+                                                       unsigned int glyphIndex,
+                                                       FT_BBox& bbox)
 {
     unsigned char* ret = nullptr;
-    if (FT_Load_Glyph(_fontFace, glyphIndex, FT_LOAD_NO_BITMAP) == 0)
+    if (FT_Load_Glyph(face, glyphIndex, FT_LOAD_NO_BITMAP) == 0)
     {
-        if (_fontFace->glyph->format == FT_GLYPH_FORMAT_OUTLINE)
+        if (face->glyph->format == FT_GLYPH_FORMAT_OUTLINE)
         {
             FT_Glyph glyph;
-            if (FT_Get_Glyph(_fontFace->glyph, &glyph) == 0)
+            if (FT_Get_Glyph(face->glyph, &glyph) == 0)
             {
-                FT_Glyph_StrokeBorder(&glyph, _stroker, 0, 1);
+                FT_Glyph_StrokeBorder(&glyph, stroker, 0, 1);
                 if (glyph->format == FT_GLYPH_FORMAT_OUTLINE)
                 {
                     FT_Outline* outline = &reinterpret_cast<FT_OutlineGlyph>(glyph)->outline;
@@ -31,9 +31,12 @@
 /// @cond DO_NOT_SHOW
 
 #include "2d/CCFont.h"
+#include "base/CCData.h"
 
 #include "ft2build.h"
 #include <string>
+#include <vector>
+#include <mutex>
 
 #include FT_FREETYPE_H
 #include FT_STROKER_H
@@ -99,6 +102,16 @@ public:
                                   Rect& outRect,
                                   int& xAdvance);
 
+    /**
+     * Renders a glyph like getGlyphBitmap, with a face used by one thread at a time, so it can be called from
+     * several worker threads at once. The returned bitmap is always owned by the caller, delete[] it.
+     */
+    unsigned char* renderGlyphBitmap(uint32_t theChar,
+                                     int32_t& outWidth,
+                                     int32_t& outHeight,
+                                     Rect& outRect,
+                                     int& xAdvance);
+
     int getFontAscender() const;
     const char* getFontFamily() const;
     std::string_view getFontName() const { return _fontName; }
@@ -124,7 +137,26 @@ private:
     static bool initFreeType();
 
     int getHorizontalKerningForChars(uint64_t firstChar, uint64_t secondChar) const;
-    unsigned char* getGlyphBitmapWithOutline(unsigned int glyphIndex, FT_BBox& bbox);
+    unsigned char* getGlyphBitmap(FT_Face face,
+                                  FT_Stroker stroker,
+                                  uint32_t theChar,
+                                  int32_t& outWidth,
+                                  int32_t& outHeight,
+                                  Rect& outRect,
+                                  int& xAdvance);
+    unsigned char* getGlyphBitmapWithOutline(FT_Face face,
+                                             FT_Stroker stroker,
+                                             unsigned int glyphIndex,
+                                             FT_BBox& bbox);
+
+    // a face of renderGlyphBitmap, used by one thread at a time
+    struct WorkerFace
+    {
+        FT_Face face       = nullptr;
+        FT_Stroker stroker = nullptr;
+    };
+    bool acquireWorkerFace(WorkerFace& workerFace);
+    void releaseWorkerFace(const WorkerFace& workerFace);
 
     void setGlyphCollection(GlyphCollection glyphs, std::string_view customGlyphs);
     std::string_view getGlyphCollection() const;
@@ -132,6 +164,12 @@ private:
     FT_Face _fontFace;
     std::unique_ptr<FT_StreamRec> _fontStream;
     FT_Stroker _stroker;
+    int _charSize;
+
+    // the faces of renderGlyphBitmap are created from a mapping of the font file
+    MappedData _workerFontData;
+    std::vector<WorkerFace> _idleWorkerFaces;
+    std::mutex _workerFacesMutex;
     FT_Encoding _encoding;
 
     std::string _fontName;
@@ -72,6 +72,20 @@ void updateBlend(backend::BlendDescriptor& blendDescriptor, BlendFunc blendFunc)
         blendDescriptor.destinationAlphaBlendFactor = backend::BlendFactor::ONE_MINUS_SRC_ALPHA;
     }
 }
+
+// returns the byte offset of the letter `letters` letters after the byte offset `from`
+size_t advanceUTF8(std::string_view utf8, size_t from, int letters)
+{
+    auto size = utf8.size();
+    while (letters > 0 && from < size)
+    {
+        ++from;
+        while (from < size && (static_cast<unsigned char>(utf8[from]) & 0xC0) == 0x80)
+            ++from;
+        --letters;
+    }
+    return from;
+}
 }  // namespace
 
 /**
@@ -548,6 +562,15 @@ Label::Label(TextHAlignment hAlignment /* = TextHAlignment::LEFT */,
         }
     });
     _eventDispatcher->addEventListenerWithFixedPriority(_resetTextureListener, 2);
+
+    // the glyphs rendered asynchronously replace the placeholders, see FontAtlas::setAsyncGlyphRenderingEnabled
+    _updateTextureListener = EventListenerCustom::create(FontAtlas::CMD_UPDATE_FONTATLAS, [this](EventCustom* event) {
+        if (_fontAtlas && _currentLabelType == LabelType::TTF && event->getUserData() == _fontAtlas)
+        {
+            _contentDirty = true;
+        }
+    });
+    _eventDispatcher->addEventListenerWithFixedPriority(_updateTextureListener, 3);
 }
 
 Label::~Label()
@@ -564,6 +587,7 @@ Label::~Label()
     _batchCommands.clear();
     _eventDispatcher->removeEventListener(_purgeTextureListener);
     _eventDispatcher->removeEventListener(_resetTextureListener);
+    _eventDispatcher->removeEventListener(_updateTextureListener);
 
     CC_SAFE_RELEASE_NULL(_textSprite);
     CC_SAFE_RELEASE_NULL(_shadowNode);
@@ -590,6 +614,9 @@ void Label::reset()
     _contentDirty     = false;
     _numberOfLines    = 0;
     _lengthOfString   = 0;
+    _lineLayouts.clear();
+    _layoutLength = 0;
+    _editIndex    = -1;
     _utf32Text.clear();
     _utf8Text.clear();
 
@@ -955,6 +982,14 @@ void Label::setString(std::string_view text)
 {
     if (text.compare(_utf8Text))
     {
+        // a string growing at its end only needs the new tail laid out
+        if (!_utf8Text.empty() && text.size() > _utf8Text.size() &&
+            text.compare(0, _utf8Text.size(), _utf8Text) == 0)
+        {
+            appendString(text.substr(_utf8Text.size()));
+            return;
+        }
+
         _utf8Text     = text;
         _contentDirty = true;
 
@@ -966,6 +1001,51 @@ void Label::setString(std::string_view text)
     }
 }
 
+void Label::appendString(std::string_view text)
+{
+    replaceString(static_cast<int>(_utf32Text.length()), 0, text);
+}
+
+void Label::replaceString(int startIndex, int length, std::string_view text)
+{
+    int textLength = static_cast<int>(_utf32Text.length());
+    if (startIndex < 0 || startIndex > textLength || length < 0)
+    {
+        CCLOG("Label::replaceString: invalid range (%d, %d) for a string of %d letters", startIndex, length,
+              textLength);
+        return;
+    }
+
+    length = std::min(length, textLength - startIndex);
+    if (length == 0 && text.empty())
+    {
+        return;
+    }
+
+    std::u32string utf32String;
+    if (!StringUtils::UTF8ToUTF32(text, utf32String))
+    {
+        CCLOG("Label::replaceString: the text isn't valid UTF-8");
+        return;
+    }
+
+    size_t first = _utf8Text.size();
+    size_t last  = first;
+    if (startIndex < textLength)
+    {
+        first = advanceUTF8(_utf8Text, 0, startIndex);
+        last  = advanceUTF8(_utf8Text, first, length);
+    }
+    _utf8Text.replace(first, last - first, text);
+    _utf32Text.replace(startIndex, length, utf32String);
+
+    // when a full layout is already pending there is nothing to gain from tracking the edit
+    if (!_contentDirty)
+    {
+        _editIndex = _editIndex < 0 ? startIndex : std::min(_editIndex, startIndex);
+    }
+}
+
 void Label::setAlignment(TextHAlignment hAlignment, TextVAlignment vAlignment)
 {
     if (hAlignment != _hAlignment || vAlignment != _vAlignment)
@@ -1109,23 +1189,7 @@ bool Label::alignText()
     do
     {
         _fontAtlas->prepareLetterDefinitions(_utf32Text);
-        auto& textures = _fontAtlas->getTextures();
-        auto size      = textures.size();
-        if (size > static_cast<size_t>(_batchNodes.size()))
-        {
-            for (auto index = static_cast<size_t>(_batchNodes.size()); index < size; ++index)
-            {
-                auto batchNode = SpriteBatchNode::createWithTexture(textures.at(index));
-                if (batchNode)
-                {
-                    _isOpacityModifyRGB = batchNode->getTexture()->hasPremultipliedAlpha();
-                    _blendFunc          = batchNode->getBlendFunc();
-                    batchNode->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
-                    batchNode->setPosition(Vec2::ZERO);
-                    _batchNodes.pushBack(batchNode);
-                }
-            }
-        }
+        updateBatchNodes();
         if (_batchNodes.empty())
         {
             return true;
@@ -1179,6 +1243,164 @@ bool Label::alignText()
     return ret;
 }
 
+void Label::updateBatchNodes()
+{
+    auto& textures = _fontAtlas->getTextures();
+    auto size      = textures.size();
+    if (size > static_cast<size_t>(_batchNodes.size()))
+    {
+        for (auto index = static_cast<size_t>(_batchNodes.size()); index < size; ++index)
+        {
+            auto batchNode = SpriteBatchNode::createWithTexture(textures.at(index));
+            if (batchNode)
+            {
+                _isOpacityModifyRGB = batchNode->getTexture()->hasPremultipliedAlpha();
+                _blendFunc          = batchNode->getBlendFunc();
+                batchNode->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+                batchNode->setPosition(Vec2::ZERO);
+                _batchNodes.pushBack(batchNode);
+            }
+        }
+    }
+}
+
+bool Label::alignTextIncrementally()
+{
+    // clipping, shrinking and centered lines of a growing width depend on the whole text
+    if (_fontAtlas == nullptr || _batchNodes.empty() || _lineLayouts.empty() || !_letters.empty() ||
+        _underlineNode || _labelHeight > 0.f || (_overflow != Overflow::NONE && _overflow != Overflow::RESIZE_HEIGHT) ||
+        (_hAlignment != TextHAlignment::LEFT && _labelWidth <= 0.f) || _editIndex > _layoutLength ||
+        _utf32Text.empty())
+    {
+        return false;
+    }
+
+    int textLength = static_cast<int>(_utf32Text.length());
+
+    // a letter's advance depends on the kerning with its neighbours and the decision to wrap a line on the
+    // first token of the next line, so resume from the line before the one holding the letter ahead of the edit.
+    int anchorIndex = std::max(0, _editIndex - 2);
+    auto it         = std::upper_bound(_lineLayouts.begin(), _lineLayouts.end(), anchorIndex,
+                                       [](int index, const LineLayout& line) { return index < line.startIndex; });
+    int startLine   = std::max(0, static_cast<int>(it - _lineLayouts.begin()) - 2);
+    int startIndex  = _lineLayouts[startLine].startIndex;
+
+    // the quads of every texture are laid out in letter order, drop the ones from startIndex on
+    std::vector<int> firstQuadIndices(_batchNodes.size(), -1);
+    for (int index = startIndex; index < _layoutLength; ++index)
+    {
+        auto& letterInfo = _lettersInfo[index];
+        if (letterInfo.valid && letterInfo.atlasIndex >= 0)
+        {
+            auto textureID = _fontAtlas->_letterDefinitions[letterInfo.utf32Char].textureID;
+            if (textureID < static_cast<int>(firstQuadIndices.size()) &&
+                (firstQuadIndices[textureID] < 0 || letterInfo.atlasIndex < firstQuadIndices[textureID]))
+            {
+                firstQuadIndices[textureID] = letterInfo.atlasIndex;
+            }
+        }
+    }
+    for (size_t i = 0; i < firstQuadIndices.size(); ++i)
+    {
+        auto textureAtlas = _batchNodes.at(i)->getTextureAtlas();
+        auto totalQuads   = static_cast<int>(textureAtlas->getTotalQuads());
+        if (firstQuadIndices[i] < 0)
+        {
+            firstQuadIndices[i] = totalQuads;
+        }
+        else
+        {
+            textureAtlas->removeQuadsAtIndex(firstQuadIndices[i], totalQuads - firstQuadIndices[i]);
+        }
+    }
+
+    if (!updateHorizontalKernings(anchorIndex))
+    {
+        return false;
+    }
+
+    _fontAtlas->prepareLetterDefinitions(_utf32Text.substr(startIndex));
+    updateBatchNodes();
+    firstQuadIndices.resize(_batchNodes.size(), 0);
+
+    auto letterOffsetY = _letterOffsetY;
+    if (_maxLineWidth > 0.f && !_lineBreakWithoutSpaces)
+    {
+        multilineTextWrapByWord(startLine);
+    }
+    else
+    {
+        multilineTextWrapByChar(startLine);
+    }
+    computeAlignmentOffset();
+
+    // new lines move the top of the text, the letters kept only need to be translated
+    auto offsetY = _letterOffsetY - letterOffsetY;
+    if (offsetY != 0.f)
+    {
+        for (size_t i = 0; i < firstQuadIndices.size(); ++i)
+        {
+            auto textureAtlas = _batchNodes.at(i)->getTextureAtlas();
+            auto quads        = textureAtlas->getQuads();
+            for (int index = 0; index < firstQuadIndices[i]; ++index)
+            {
+                quads[index].bl.vertices.y += offsetY;
+                quads[index].br.vertices.y += offsetY;
+                quads[index].tl.vertices.y += offsetY;
+                quads[index].tr.vertices.y += offsetY;
+            }
+            textureAtlas->setDirty(true);
+        }
+    }
+
+    updateQuads(startIndex);
+    updateQuadsColor(firstQuadIndices);
+    _layoutLength = textLength;
+
+    return true;
+}
+
+bool Label::updateHorizontalKernings(int startIndex)
+{
+    // kernings are computed per pair of letters, only the ones from the pair (startIndex, startIndex + 1) on
+    // may have changed; depending on the font the value is stored at the first or the second letter of the pair.
+    int letterCount = 0;
+    auto kernings =
+        _fontAtlas->getFont()->getHorizontalKerningForTextUTF32(_utf32Text.substr(startIndex), letterCount);
+    if (!kernings)
+    {
+        if (startIndex == 0)
+        {
+            delete[] _horizontalKernings;
+            _horizontalKernings = nullptr;
+        }
+        return !_horizontalKernings;
+    }
+
+    auto textLength = _utf32Text.length();
+    auto merged     = new int[textLength];
+    if (startIndex > 0)
+    {
+        if (!_horizontalKernings)
+        {
+            delete[] kernings;
+            delete[] merged;
+            return false;
+        }
+        std::copy(_horizontalKernings, _horizontalKernings + startIndex + 1, merged);
+        std::copy(kernings + 1, kernings + letterCount, merged + startIndex + 1);
+    }
+    else
+    {
+        std::copy(kernings, kernings + letterCount, merged);
+    }
+    delete[] kernings;
+    delete[] _horizontalKernings;
+    _horizontalKernings = merged;
+
+    return true;
+}
+
 bool Label::computeHorizontalKernings(const std::u32string& stringToRender)
 {
     if (_horizontalKernings)
@@ -1210,15 +1432,18 @@ bool Label::isHorizontalClamped(float letterPositionX, int lineIndex)
     }
 }
 
-bool Label::updateQuads()
+bool Label::updateQuads(int startIndex)
 {
     bool ret = true;
-    for (auto&& batchNode : _batchNodes)
+    if (startIndex == 0)
     {
-        batchNode->getTextureAtlas()->removeAllQuads();
+        for (auto&& batchNode : _batchNodes)
+        {
+            batchNode->getTextureAtlas()->removeAllQuads();
+        }
     }
 
-    for (int ctr = 0; ctr < _lengthOfString; ++ctr)
+    for (int ctr = startIndex; ctr < _lengthOfString; ++ctr)
     {
         if (_lettersInfo[ctr].valid)
         {
@@ -1445,7 +1670,7 @@ void Label::enableShadow(const Color4B& shadowColor /* = Color4B::BLACK */,
     _shadowColor3B.b = shadowColor.b;
     _shadowOpacity   = shadowColor.a;
 
-    if (!_systemFontDirty && !_contentDirty && _textSprite)
+    if (!_systemFontDirty && !_contentDirty && _editIndex < 0 && _textSprite)
     {
         auto fontDef = _getFontDefinition();
         if (_shadowNode)
@@ -1692,8 +1917,12 @@ void Label::updateContent()
     CC_SAFE_RELEASE_NULL(_shadowNode);
     bool updateFinished = true;
 
-    if (_fontAtlas)
+    // appendString and replaceString only lay out the lines they touched when nothing else changed
+    if (_fontAtlas && (_editIndex < 0 || _contentDirty || !alignTextIncrementally()))
     {
+        _lineLayouts.clear();
+        _layoutLength = 0;
+
         std::u32string utf32String;
         if (StringUtils::UTF8ToUTF32(_utf8Text, utf32String))
         {
@@ -1702,8 +1931,12 @@ void Label::updateContent()
 
         computeHorizontalKernings(_utf32Text);
         updateFinished = alignText();
+        if (!_lineLayouts.empty())
+        {
+            _layoutLength = _lengthOfString;
+        }
     }
-    else
+    else if (!_fontAtlas)
     {
         auto fontDef = _getFontDefinition();
         createSpriteForSystemFont(fontDef);
@@ -1759,6 +1992,7 @@ void Label::updateContent()
     {
         _contentDirty = false;
     }
+    _editIndex = -1;
 
 #if CC_LABEL_DEBUG_DRAW
     _debugDrawNode->clear();
@@ -2021,7 +2255,7 @@ void Label::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t pare
         return;
     }
 
-    if (_systemFontDirty || _contentDirty)
+    if (_systemFontDirty || _contentDirty || _editIndex >= 0)
     {
         // Label overflow shrink fix #566
         if (_overflow == Overflow::SHRINK && this->getRenderingFontSize() < _originalFontSize)
@@ -2138,7 +2372,7 @@ Sprite* Label::getLetter(int letterIndex)
             break;
         }
 
-        auto contentDirty = _contentDirty;
+        auto contentDirty = _contentDirty || _editIndex >= 0;
         if (contentDirty)
         {
             updateContent();
@@ -2273,7 +2507,7 @@ void Label::computeStringNumLines()
 
 int Label::getStringNumLines()
 {
-    if (_contentDirty)
+    if (_contentDirty || _editIndex >= 0)
     {
         updateContent();
     }
@@ -2371,13 +2605,8 @@ void Label::setTextColor(const Color4B& color)
     _textColorF.a = _textColor.a / 255.0f;
 }
 
-void Label::updateColor()
+Color4B Label::getQuadsColor() const
 {
-    if (_batchNodes.empty())
-    {
-        return;
-    }
-
     Color4B color4(_displayedColor.r, _displayedColor.g, _displayedColor.b, _displayedOpacity);
 
     // special opacity for premultiplied textures
@@ -2388,6 +2617,38 @@ void Label::updateColor()
         color4.b *= _displayedOpacity / 255.0f;
     }
 
+    return color4;
+}
+
+void Label::updateQuadsColor(const std::vector<int>& firstQuadIndices)
+{
+    auto color4 = getQuadsColor();
+    for (size_t i = 0; i < firstQuadIndices.size() && i < static_cast<size_t>(_batchNodes.size()); ++i)
+    {
+        auto textureAtlas = _batchNodes.at(i)->getTextureAtlas();
+        auto quads        = textureAtlas->getQuads();
+        auto count        = static_cast<int>(textureAtlas->getTotalQuads());
+
+        for (int index = firstQuadIndices[i]; index < count; ++index)
+        {
+            quads[index].bl.colors = color4;
+            quads[index].br.colors = color4;
+            quads[index].tl.colors = color4;
+            quads[index].tr.colors = color4;
+            textureAtlas->updateQuad(&quads[index], index);
+        }
+    }
+}
+
+void Label::updateColor()
+{
+    if (_batchNodes.empty())
+    {
+        return;
+    }
+
+    auto color4 = getQuadsColor();
+
     cocos2d::TextureAtlas* textureAtlas;
     V3F_C4B_T2F_Quad* quads;
     for (auto&& batchNode : _batchNodes)
@@ -2419,7 +2680,7 @@ std::string Label::getDescription() const
 
 const Vec2& Label::getContentSize() const
 {
-    if (_systemFontDirty || _contentDirty)
+    if (_systemFontDirty || _contentDirty || _editIndex >= 0)
     {
         const_cast<Label*>(this)->updateContent();
     }
@@ -403,6 +403,23 @@ public:
     /** Return the text the Label is currently displaying.*/
     virtual std::string_view getString() const override { return _utf8Text; }
 
+    /**
+     * Appends text to the end of the Label.
+     *
+     * Unlike setString, only the lines touched by the appended text are laid out again when the Label
+     * uses a font atlas, isn't clamped or shrunk and has no underline. This keeps long, growing labels
+     * such as chat or log panels cheap to update.
+     */
+    void appendString(std::string_view text);
+
+    /**
+     * Replaces `length` letters starting at the letter `startIndex` with text.
+     *
+     * Indices count letters (UTF-32 characters), not bytes. The layout is updated incrementally from the
+     * line before the one containing `startIndex`, under the same conditions as appendString.
+     */
+    void replaceString(int startIndex, int length, std::string_view text);
+
     /**
      * Return the number of lines of text.
      */
@@ -737,6 +754,17 @@ protected:
         int lineIndex;
     };
 
+    /** The wrapping state at the first letter of a line, multilineTextWrap can resume from it. */
+    struct LineLayout
+    {
+        int startIndex;
+        float nextTokenY;
+        float highestY;
+        float lowestY;
+        float nextWhitespaceWidth;
+        bool nextChangeSize;
+    };
+
     struct BatchCommand
     {
         BatchCommand();
@@ -763,9 +791,9 @@ protected:
 
     void drawSelf(bool visibleByCamera, Renderer* renderer, uint32_t flags);
 
-    bool multilineTextWrapByChar();
-    bool multilineTextWrapByWord();
-    bool multilineTextWrap(const std::function<int(const std::u32string&, int, int)>& lambda);
+    bool multilineTextWrapByChar(int startLine = 0);
+    bool multilineTextWrapByWord(int startLine = 0);
+    bool multilineTextWrap(const std::function<int(const std::u32string&, int, int)>& lambda, int startLine = 0);
     void shrinkLabelToContentSize(const std::function<bool(void)>& lambda);
     bool isHorizontalClamp();
     bool isVerticalClamp();
@@ -773,13 +801,16 @@ protected:
 
     void updateLabelLetters();
     virtual bool alignText();
+    bool alignTextIncrementally();
+    void updateBatchNodes();
     void computeAlignmentOffset();
     bool computeHorizontalKernings(const std::u32string& stringToRender);
+    bool updateHorizontalKernings(int startIndex);
 
     void recordLetterInfo(const cocos2d::Vec2& point, char32_t utf32Char, int letterIndex, int lineIndex);
     void recordPlaceholderInfo(int letterIndex, char32_t utf16Char);
 
-    bool updateQuads();
+    bool updateQuads(int startIndex = 0);
 
     void createSpriteForSystemFont(const FontDefinition& fontDef);
     void createShadowSpriteForSystemFont(const FontDefinition& fontDef);
@@ -800,6 +831,8 @@ protected:
     FontDefinition _getFontDefinition() const;
 
     virtual void updateColor() override;
+    void updateQuadsColor(const std::vector<int>& firstQuadIndices);
+    Color4B getQuadsColor() const;
 
     void updateUniformLocations();
     void setVertexLayout();
@@ -861,6 +894,11 @@ protected:
     float _tailoredTopY;
     float _tailoredBottomY;
 
+    // incremental layout, see appendString and replaceString.
+    std::vector<LineLayout> _lineLayouts;
+    int _layoutLength;
+    int _editIndex;
+
     LabelEffect _currLabelEffect;
     Color4F _effectColorF;
     Color4B _textColor;
@@ -899,6 +937,7 @@ protected:
 
     EventListenerCustom* _purgeTextureListener;
     EventListenerCustom* _resetTextureListener;
+    EventListenerCustom* _updateTextureListener;
 
 #if CC_LABEL_DEBUG_DRAW
     DrawNode* _debugDrawNode;
@@ -149,9 +149,10 @@ void Label::updateBMFontScale()
     }
 }
 
-bool Label::multilineTextWrap(const std::function<int(const std::u32string&, int, int)>& nextTokenLen)
+bool Label::multilineTextWrap(const std::function<int(const std::u32string&, int, int)>& nextTokenLen, int startLine)
 {
     int textLen               = getStringLength();
+    int index                 = 0;
     int lineIndex             = 0;
     float nextTokenX          = 0.f;
     float nextTokenY          = 0.f;
@@ -169,7 +170,23 @@ bool Label::multilineTextWrap(const std::function<int(const std::u32string&, int
 
     this->updateBMFontScale();
 
-    for (int index = 0; index < textLen;)
+    // resume from the cached state of startLine, the lines above it are kept as they are
+    if (startLine > 0 && startLine < static_cast<int>(_lineLayouts.size()))
+    {
+        auto& line          = _lineLayouts[startLine];
+        index               = line.startIndex;
+        lineIndex           = startLine;
+        nextTokenY          = line.nextTokenY;
+        highestY            = line.highestY;
+        lowestY             = line.lowestY;
+        nextWhitespaceWidth = line.nextWhitespaceWidth;
+        nextChangeSize      = line.nextChangeSize;
+        _linesWidth.resize(startLine);
+    }
+    _lineLayouts.resize(lineIndex);
+    _lineLayouts.push_back({index, nextTokenY, highestY, lowestY, nextWhitespaceWidth, nextChangeSize});
+
+    while (index < textLen)
     {
         char32_t character = _utf32Text[index];
         if (character == StringUtils::UnicodeCharacters::NewLine)
@@ -181,6 +198,7 @@ bool Label::multilineTextWrap(const std::function<int(const std::u32string&, int
             nextTokenY -= _lineHeight * _bmfontScale + lineSpacing;
             recordPlaceholderInfo(index, character);
             index++;
+            _lineLayouts.push_back({index, nextTokenY, highestY, lowestY, nextWhitespaceWidth, nextChangeSize});
             continue;
         }
 
@@ -229,6 +247,7 @@ bool Label::multilineTextWrap(const std::function<int(const std::u32string&, int
                 nextTokenX = 0.f;
                 nextTokenY -= (_lineHeight * _bmfontScale + lineSpacing);
                 newLine = true;
+                _lineLayouts.push_back({index, nextTokenY, highestY, lowestY, nextWhitespaceWidth, nextChangeSize});
                 break;
             }
             else
@@ -316,14 +335,14 @@ bool Label::multilineTextWrap(const std::function<int(const std::u32string&, int
     return true;
 }
 
-bool Label::multilineTextWrapByWord()
+bool Label::multilineTextWrapByWord(int startLine)
 {
-    return multilineTextWrap(CC_CALLBACK_3(Label::getFirstWordLen, this));
+    return multilineTextWrap(CC_CALLBACK_3(Label::getFirstWordLen, this), startLine);
 }
 
-bool Label::multilineTextWrapByChar()
+bool Label::multilineTextWrapByChar(int startLine)
 {
-    return multilineTextWrap(CC_CALLBACK_3(Label::getFirstCharLen, this));
+    return multilineTextWrap(CC_CALLBACK_3(Label::getFirstCharLen, this), startLine);
 }
 
 bool Label::isVerticalClamp()
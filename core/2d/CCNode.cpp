@@ -44,6 +44,7 @@ THE SOFTWARE.
 #include "2d/CCScene.h"
 #include "2d/CCComponent.h"
 #include "renderer/CCMaterial.h"
+#include "renderer/CCRenderer.h"
 #include "math/TransformUtils.h"
 #include "renderer/backend/ProgramStateRegistry.h"
 
@@ -78,6 +79,7 @@ Node::Node()
     , _positionZ(0.0f)
     , _usingNormalizedPosition(false)
     , _normalizedPositionDirty(false)
+    , _parallelRoot(false)
     , _skewX(0.0f)
     , _skewY(0.0f)
     , _anchorPoint(0, 0)
@@ -1191,7 +1193,10 @@ void Node::sortAllChildren()
     {
         sortNodes(_children);
         _reorderChildDirty = false;
-        _eventDispatcher->setDirtyForNode(this);
+        if (Renderer::isRecordingThread())
+            _director->getRenderer()->runAfterRecording([this]() { _eventDispatcher->setDirtyForNode(this); });
+        else
+            _eventDispatcher->setDirtyForNode(this);
     }
 }
 
@@ -1272,7 +1277,13 @@ void Node::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t paren
 
     int i = 0;
 
-    if (!_children.empty())
+    if (!_children.empty() && _parallelRoot && renderer->isParallelRecordingEnabled() &&
+        !Renderer::isRecordingThread())
+    {
+        sortAllChildren();
+        visitChildrenInParallel(renderer, flags, visibleByCamera);
+    }
+    else if (!_children.empty())
     {
         sortAllChildren();
         // draw children zOrder < 0
@@ -1305,6 +1316,24 @@ void Node::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t paren
     // _orderOfArrival = 0;
 }
 
+void Node::visitChildrenInParallel(Renderer* renderer, uint32_t flags, bool visibleByCamera)
+{
+    renderer->recordParallel(_children.size(), [this, renderer, flags](size_t index) {
+        _children.at(index)->visit(renderer, _modelViewTransform, flags);
+    });
+
+    // merge in the same order as the serial visit: children zOrder < 0, self draw, other children
+    ssize_t i = 0, size = _children.size();
+    for (; i < size && _children.at(i)->_localZOrder < 0; ++i)
+        renderer->mergeRecordedCommands(i);
+
+    if (visibleByCamera)
+        this->draw(renderer, _modelViewTransform, flags);
+
+    for (; i < size; ++i)
+        renderer->mergeRecordedCommands(i);
+}
+
 Mat4 Node::transform(const Mat4& parentTransform)
 {
     return parentTransform * this->getNodeToParentTransform();
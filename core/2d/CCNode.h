@@ -1141,6 +1141,24 @@ public:
     virtual void visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags);
     virtual void visit() final;
 
+    /**
+     * Sets whether the children of this node are visited on the renderer's recording threads.
+     * Each child subtree records its commands into its own queue, they are merged in children order,
+     * so the result is the same as a serial visit.
+     * Only takes effect when Renderer::isParallelRecordingEnabled() is true, and the subtrees must not
+     * push render groups (e.g. ClippingNode, RenderTexture) or touch shared objects while drawing.
+     *
+     * @param parallelRoot true to visit the children in parallel.
+     */
+    void setParallelRoot(bool parallelRoot) { _parallelRoot = parallelRoot; }
+
+    /**
+     * Whether the children of this node are visited in parallel.
+     *
+     * @return true if this node is a parallel root.
+     */
+    bool isParallelRoot() const { return _parallelRoot; }
+
     /** Returns the Scene that contains the Node.
      It returns `nullptr` if the node doesn't belong to any Scene.
      This function recursively calls parent->getScene() until parent is a Scene object. The results are not cached. It
@@ -1859,6 +1877,9 @@ protected:
     // check whether this camera mask is visible by the current visiting camera
     bool isVisitableByVisitingCamera() const;
 
+    // visit children on the renderer's recording threads, see setParallelRoot
+    void visitChildrenInParallel(Renderer* renderer, uint32_t flags, bool visibleByCamera);
+
     // update quaternion from Rotation3D
     void updateRotationQuat();
     // update Rotation3D from quaternion
@@ -1967,6 +1988,7 @@ protected:
 
     bool _usingNormalizedPosition;
     bool _normalizedPositionDirty;
+    bool _parallelRoot;  ///< whether children are visited in parallel
     // camera mask, it is visible only when _cameraMask & current camera' camera flag is true
     unsigned short _cameraMask;
 
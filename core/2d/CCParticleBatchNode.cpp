@@ -39,7 +39,7 @@
 #include "renderer/CCQuadCommand.h"
 #include "renderer/CCRenderer.h"
 #include "renderer/CCTextureAtlas.h"
-#include "base/CCProfiling.h"
+#include "base/CCFrameProfiler.h"
 #include "base/ccUTF8.h"
 #include "base/ccUtils.h"
 #include "renderer/ccShaders.h"
@@ -447,7 +447,7 @@ void ParticleBatchNode::removeAllChildrenWithCleanup(bool doCleanup)
 
 void ParticleBatchNode::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
-    CC_PROFILER_START("CCParticleBatchNode - draw");
+    CC_PROFILE_ZONE("ParticleBatchNode::draw");
 
     if (_textureAtlas->getTotalQuads() == 0)
         return;
@@ -475,8 +475,6 @@ void ParticleBatchNode::draw(Renderer* renderer, const Mat4& transform, uint32_t
     }
 
     renderer->addCommand(&_customCommand);
-
-    CC_PROFILER_STOP("CCParticleBatchNode - draw");
 }
 
 void ParticleBatchNode::increaseAtlasCapacityTo(ssize_t quantity)
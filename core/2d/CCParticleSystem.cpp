@@ -49,11 +49,12 @@ THE SOFTWARE.
 #include <string>
 
 #include "2d/CCParticleBatchNode.h"
+#include "math/MathUtil.h"
 #include "renderer/CCTextureAtlas.h"
 #include "base/base64.h"
 #include "base/ZipUtils.h"
 #include "base/CCDirector.h"
-#include "base/CCProfiling.h"
+#include "base/CCFrameProfiler.h"
 #include "base/ccUTF8.h"
 #include "base/ccUtils.h"
 #include "renderer/CCTextureCache.h"
@@ -85,7 +86,11 @@ inline void normalize_point(float x, float y, particle_point* out)
     float n = x * x + y * y;
     // Already normalized.
     if (n == 1.0f)
+    {
+        out->x = x;
+        out->y = y;
         return;
+    }
 
     n = sqrt(n);
     // Too close to zero.
@@ -190,6 +195,7 @@ void ParticleData::release()
 
 Vector<ParticleSystem*> ParticleSystem::__allInstances;
 float ParticleSystem::__totalParticleCountFactor = 1.0f;
+bool ParticleSystem::__simdEnabled              = true;
 
 ParticleSystem::ParticleSystem()
     : _isBlendAdditive(false)
@@ -280,6 +286,26 @@ void ParticleSystem::setTotalParticleCountFactor(float factor)
     __totalParticleCountFactor = factor;
 }
 
+void ParticleSystem::setSIMDEnabled(bool enabled)
+{
+    __simdEnabled = enabled;
+}
+
+bool ParticleSystem::isSIMDEnabled()
+{
+    return __simdEnabled;
+}
+
+int ParticleSystem::nextDeadParticle(int start) const
+{
+    if (__simdEnabled)
+        return MathUtil::findLessEqual(_particleData.timeToLive, 0.0f, start, _particleCount);
+
+    while (start < _particleCount && _particleData.timeToLive[start] > 0.0f)
+        ++start;
+    return start;
+}
+
 bool ParticleSystem::init()
 {
     return initWithTotalParticles(150);
@@ -848,7 +874,7 @@ bool ParticleSystem::isFull()
 // ParticleSystem - MainLoop
 void ParticleSystem::update(float dt)
 {
-    CC_PROFILER_START_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
+    CC_PROFILE_ZONE("ParticleSystem::update");
 
     if (_isActive && _emissionRate)
     {
@@ -877,138 +903,161 @@ void ParticleSystem::update(float dt)
     }
 
     {
-        for (int i = 0; i < _particleCount; ++i)
+        if (__simdEnabled)
         {
-            _particleData.timeToLive[i] -= dt;
+            MathUtil::addScalarArray(_particleData.timeToLive, -dt, _particleCount);
+        }
+        else
+        {
+            for (int i = 0; i < _particleCount; ++i)
+            {
+                _particleData.timeToLive[i] -= dt;
+            }
         }
 
-        for (int i = 0; i < _particleCount; ++i)
+        // move the last alive particle into each dead slot
+        for (int i = nextDeadParticle(0); i < _particleCount; i = nextDeadParticle(i + 1))
         {
-            if (_particleData.timeToLive[i] <= 0.0f)
+            int last = _particleCount - 1;
+            while (last > i && _particleData.timeToLive[last] <= 0.0f)
             {
-                int j = _particleCount - 1;
-                while (j > 0 && _particleData.timeToLive[j] <= 0)
-                {
-                    _particleCount--;
-                    j--;
-                }
-                _particleData.copyParticle(i, _particleCount - 1);
+                // the dead particles at the end are dropped as they are
+                if (_batchNode)
+                    _batchNode->disableParticle(_atlasIndex + _particleData.atlasIndex[last]);
+                --last;
+            }
+
+            int currentIndex = _particleData.atlasIndex[i];
+            if (_batchNode)
+            {
+                // disable the dead particle, whether or not it gets switched
+                _batchNode->disableParticle(_atlasIndex + currentIndex);
+            }
+
+            if (last > i)
+            {
+                _particleData.copyParticle(i, last);
                 if (_batchNode)
                 {
-                    // disable the switched particle
-                    int currentIndex = _particleData.atlasIndex[i];
-                    _batchNode->disableParticle(_atlasIndex + currentIndex);
                     // switch indexes
-                    _particleData.atlasIndex[_particleCount - 1] = currentIndex;
-                }
-                --_particleCount;
-                if (_particleCount == 0 && _isAutoRemoveOnFinish)
-                {
-                    this->unscheduleUpdate();
-                    _parent->removeChild(this, true);
-                    return;
+                    _particleData.atlasIndex[last] = currentIndex;
                 }
             }
+            _particleCount = last;
+            if (_particleCount == 0 && _isAutoRemoveOnFinish)
+            {
+                this->unscheduleUpdate();
+                _parent->removeChild(this, true);
+                return;
+            }
         }
 
-        if (_emitterMode == Mode::GRAVITY)
+        if (__simdEnabled)
         {
-            for (int i = 0; i < _particleCount; ++i)
+            updateParticlesSIMD(dt);
+        }
+        else
+        {
+            if (_emitterMode == Mode::GRAVITY)
             {
-                particle_point tmp, radial = {0.0f, 0.0f}, tangential;
+                for (int i = 0; i < _particleCount; ++i)
+                {
+                    particle_point tmp, radial = {0.0f, 0.0f}, tangential;
 
-                // radial acceleration
-                if (_particleData.posx[i] || _particleData.posy[i])
+                    // radial acceleration
+                    if (_particleData.posx[i] || _particleData.posy[i])
+                    {
+                        normalize_point(_particleData.posx[i], _particleData.posy[i], &radial);
+                    }
+                    tangential = radial;
+                    radial.x *= _particleData.modeA.radialAccel[i];
+                    radial.y *= _particleData.modeA.radialAccel[i];
+
+                    // tangential acceleration
+                    std::swap(tangential.x, tangential.y);
+                    tangential.x *= -_particleData.modeA.tangentialAccel[i];
+                    tangential.y *= _particleData.modeA.tangentialAccel[i];
+
+                    // (gravity + radial + tangential) * dt
+                    tmp.x = radial.x + tangential.x + modeA.gravity.x;
+                    tmp.y = radial.y + tangential.y + modeA.gravity.y;
+                    tmp.x *= dt;
+                    tmp.y *= dt;
+
+                    _particleData.modeA.dirX[i] += tmp.x;
+                    _particleData.modeA.dirY[i] += tmp.y;
+
+                    // this is cocos2d-x v3.0
+                    // if (_configName.length()>0 && _yCoordFlipped != -1)
+
+                    // this is cocos2d-x v3.0
+                    tmp.x = _particleData.modeA.dirX[i] * dt * _yCoordFlipped;
+                    tmp.y = _particleData.modeA.dirY[i] * dt * _yCoordFlipped;
+                    _particleData.posx[i] += tmp.x;
+                    _particleData.posy[i] += tmp.y;
+                }
+            }
+            else
+            {
+                // Why use so many for-loop separately instead of putting them together?
+                // When the processor needs to read from or write to a location in memory,
+                // it first checks whether a copy of that data is in the cache.
+                // And every property's memory of the particle system is continuous,
+                // for the purpose of improving cache hit rate, we should process only one property in one for-loop
+                // AFAP.
+                // It was proved to be effective especially for low-end machine.
+                for (int i = 0; i < _particleCount; ++i)
                 {
-                    normalize_point(_particleData.posx[i], _particleData.posy[i], &radial);
+                    _particleData.modeB.angle[i] += _particleData.modeB.degreesPerSecond[i] * dt;
                 }
-                tangential = radial;
-                radial.x *= _particleData.modeA.radialAccel[i];
-                radial.y *= _particleData.modeA.radialAccel[i];
 
-                // tangential acceleration
-                std::swap(tangential.x, tangential.y);
-                tangential.x *= -_particleData.modeA.tangentialAccel[i];
-                tangential.y *= _particleData.modeA.tangentialAccel[i];
-
-                // (gravity + radial + tangential) * dt
-                tmp.x = radial.x + tangential.x + modeA.gravity.x;
-                tmp.y = radial.y + tangential.y + modeA.gravity.y;
-                tmp.x *= dt;
-                tmp.y *= dt;
-
-                _particleData.modeA.dirX[i] += tmp.x;
-                _particleData.modeA.dirY[i] += tmp.y;
-
-                // this is cocos2d-x v3.0
-                // if (_configName.length()>0 && _yCoordFlipped != -1)
-
-                // this is cocos2d-x v3.0
-                tmp.x = _particleData.modeA.dirX[i] * dt * _yCoordFlipped;
-                tmp.y = _particleData.modeA.dirY[i] * dt * _yCoordFlipped;
-                _particleData.posx[i] += tmp.x;
-                _particleData.posy[i] += tmp.y;
+                for (int i = 0; i < _particleCount; ++i)
+                {
+                    _particleData.modeB.radius[i] += _particleData.modeB.deltaRadius[i] * dt;
+                }
+
+                for (int i = 0; i < _particleCount; ++i)
+                {
+                    _particleData.posx[i] = -cosf(_particleData.modeB.angle[i]) * _particleData.modeB.radius[i];
+                }
+                for (int i = 0; i < _particleCount; ++i)
+                {
+                    _particleData.posy[i] =
+                        -sinf(_particleData.modeB.angle[i]) * _particleData.modeB.radius[i] * _yCoordFlipped;
+                }
             }
-        }
-        else
-        {
-            // Why use so many for-loop separately instead of putting them together?
-            // When the processor needs to read from or write to a location in memory,
-            // it first checks whether a copy of that data is in the cache.
-            // And every property's memory of the particle system is continuous,
-            // for the purpose of improving cache hit rate, we should process only one property in one for-loop AFAP.
-            // It was proved to be effective especially for low-end machine.
+
+            // color r,g,b,a
             for (int i = 0; i < _particleCount; ++i)
             {
-                _particleData.modeB.angle[i] += _particleData.modeB.degreesPerSecond[i] * dt;
+                _particleData.colorR[i] += _particleData.deltaColorR[i] * dt;
             }
 
             for (int i = 0; i < _particleCount; ++i)
             {
-                _particleData.modeB.radius[i] += _particleData.modeB.deltaRadius[i] * dt;
+                _particleData.colorG[i] += _particleData.deltaColorG[i] * dt;
             }
 
             for (int i = 0; i < _particleCount; ++i)
             {
-                _particleData.posx[i] = -cosf(_particleData.modeB.angle[i]) * _particleData.modeB.radius[i];
+                _particleData.colorB[i] += _particleData.deltaColorB[i] * dt;
             }
+
             for (int i = 0; i < _particleCount; ++i)
             {
-                _particleData.posy[i] =
-                    -sinf(_particleData.modeB.angle[i]) * _particleData.modeB.radius[i] * _yCoordFlipped;
+                _particleData.colorA[i] += _particleData.deltaColorA[i] * dt;
+            }
+            // size
+            for (int i = 0; i < _particleCount; ++i)
+            {
+                _particleData.size[i] += (_particleData.deltaSize[i] * dt);
+                _particleData.size[i] = MAX(0, _particleData.size[i]);
+            }
+            // angle
+            for (int i = 0; i < _particleCount; ++i)
+            {
+                _particleData.rotation[i] += _particleData.deltaRotation[i] * dt;
             }
-        }
-
-        // color r,g,b,a
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.colorR[i] += _particleData.deltaColorR[i] * dt;
-        }
-
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.colorG[i] += _particleData.deltaColorG[i] * dt;
-        }
-
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.colorB[i] += _particleData.deltaColorB[i] * dt;
-        }
-
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.colorA[i] += _particleData.deltaColorA[i] * dt;
-        }
-        // size
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.size[i] += (_particleData.deltaSize[i] * dt);
-            _particleData.size[i] = MAX(0, _particleData.size[i]);
-        }
-        // angle
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.rotation[i] += _particleData.deltaRotation[i] * dt;
         }
 
         updateParticleQuads();
@@ -1020,8 +1069,38 @@ void ParticleSystem::update(float dt)
     {
         postStep();
     }
+}
+
+void ParticleSystem::updateParticlesSIMD(float dt)
+{
+    int count = _particleCount;
+    if (_emitterMode == Mode::GRAVITY)
+    {
+        MathUtil::accelerateRadialTangential(_particleData.posx, _particleData.posy, _particleData.modeA.dirX,
+                                             _particleData.modeA.dirY, _particleData.modeA.radialAccel,
+                                             _particleData.modeA.tangentialAccel, modeA.gravity.x, modeA.gravity.y, dt,
+                                             _yCoordFlipped, count);
+    }
+    else
+    {
+        MathUtil::addScaledArray(_particleData.modeB.angle, _particleData.modeB.degreesPerSecond, dt, count);
+        MathUtil::addScaledArray(_particleData.modeB.radius, _particleData.modeB.deltaRadius, dt, count);
+
+        // posx = -cos(angle) * radius, posy = -sin(angle) * radius * _yCoordFlipped
+        MathUtil::sinCosArray(_particleData.modeB.angle, 1.0f, _particleData.posy, _particleData.posx, count);
+        MathUtil::multiplyScaledArray(_particleData.posx, _particleData.modeB.radius, -1.0f, count);
+        MathUtil::multiplyScaledArray(_particleData.posy, _particleData.modeB.radius, -_yCoordFlipped, count);
+    }
+
+    MathUtil::addScaledArray(_particleData.colorR, _particleData.deltaColorR, dt, count);
+    MathUtil::addScaledArray(_particleData.colorG, _particleData.deltaColorG, dt, count);
+    MathUtil::addScaledArray(_particleData.colorB, _particleData.deltaColorB, dt, count);
+    MathUtil::addScaledArray(_particleData.colorA, _particleData.deltaColorA, dt, count);
+
+    MathUtil::addScaledArray(_particleData.size, _particleData.deltaSize, dt, count);
+    MathUtil::clampMinArray(_particleData.size, 0.0f, count);
 
-    CC_PROFILER_STOP_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
+    MathUtil::addScaledArray(_particleData.rotation, _particleData.deltaRotation, dt, count);
 }
 
 void ParticleSystem::updateWithNoTime()
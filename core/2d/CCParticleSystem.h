@@ -251,6 +251,14 @@ public:
      */
     static Vector<ParticleSystem*>& getAllParticleSystems();
 
+    /** Sets whether particles are updated with the SIMD (SSE/NEON) array functions of MathUtil, default true.
+     * The scalar path is kept for comparison, the SIMD path uses an approximated sin/cos in radius mode.
+     */
+    static void setSIMDEnabled(bool enabled);
+
+    /** Whether particles are updated with the SIMD array functions of MathUtil. */
+    static bool isSIMDEnabled();
+
 public:
     void addParticles(int count);
 
@@ -827,6 +835,12 @@ private:
     /** Internal use only, it's used by EngineDataManager class for Android platform */
     static void setTotalParticleCountFactor(float factor);
 
+    /** Index of the first dead particle at or after start, or _particleCount if there is none. */
+    int nextDeadParticle(int start) const;
+
+    /** Integrates the alive particles with the SIMD array functions of MathUtil. */
+    void updateParticlesSIMD(float dt);
+
 protected:
     /** whether or not the particles are using blend additive.
      If enabled, the following blending function will be used.
@@ -920,6 +934,8 @@ protected:
     int _particleCount;
     /** The factor affects the total particle count, its value should be 0.0f ~ 1.0f, default 1.0f*/
     static float __totalParticleCountFactor;
+    /** Whether the SIMD update path is used, default true */
+    static bool __simdEnabled;
 
     /** How many seconds the emitter will run. -1 means 'forever' */
     float _duration;
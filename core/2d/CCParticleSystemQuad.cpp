@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include "2d/CCSpriteFrame.h"
 #include "2d/CCParticleBatchNode.h"
 #include "renderer/CCTextureAtlas.h"
+#include "math/MathUtil.h"
 #include "renderer/CCRenderer.h"
 #include "base/CCDirector.h"
 #include "base/CCEventType.h"
@@ -344,6 +345,12 @@ void ParticleSystemQuad::updateParticleQuads()
         startQuad = &(_quads[0]);
     }
 
+    if (isSIMDEnabled())
+    {
+        updateParticleQuadsSIMD(startQuad, currentPosition, pos);
+        return;
+    }
+
     if (_positionType == PositionType::FREE)
     {
         Vec3 p1(currentPosition.x, currentPosition.y, 0);
@@ -448,6 +455,93 @@ void ParticleSystemQuad::updateParticleQuads()
     }
 }
 
+void ParticleSystemQuad::updateParticleQuadsSIMD(V3F_C4B_T2F_Quad* startQuad,
+                                                 const Vec2& currentPosition,
+                                                 const Vec2& pos)
+{
+    // small enough to stay in the stack and in the L1 cache
+    static const int CHUNK_SIZE = 256;
+    float posX[CHUNK_SIZE];
+    float posY[CHUNK_SIZE];
+    float sinR[CHUNK_SIZE];
+    float cosR[CHUNK_SIZE];
+    uint8_t colors[CHUNK_SIZE * 4];
+
+    // particle offset relative to the emitter, the same for all the particles of a chunk
+    Vec3 p1(currentPosition.x, currentPosition.y, 0);
+    Mat4 worldToNodeTM;
+    if (_positionType == PositionType::FREE)
+    {
+        worldToNodeTM = getWorldToNodeTransform();
+        worldToNodeTM.transformPoint(&p1);
+    }
+    const float* m = worldToNodeTM.m;
+
+    for (int start = 0; start < _particleCount; start += CHUNK_SIZE)
+    {
+        const int count     = std::min(CHUNK_SIZE, _particleCount - start);
+        const float* x      = _particleData.posx + start;
+        const float* y      = _particleData.posy + start;
+        const float* startX = _particleData.startPosX + start;
+        const float* startY = _particleData.startPosY + start;
+        const float* size   = _particleData.size + start;
+
+        if (_positionType == PositionType::FREE)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                float sx = m[0] * startX[i] + m[4] * startY[i] + m[12];
+                float sy = m[1] * startX[i] + m[5] * startY[i] + m[13];
+                posX[i]  = x[i] - (p1.x - sx - pos.x);
+                posY[i]  = y[i] - (p1.y - sy - pos.y);
+            }
+        }
+        else if (_positionType == PositionType::RELATIVE)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                posX[i] = x[i] - (currentPosition.x - startX[i]) + pos.x;
+                posY[i] = y[i] - (currentPosition.y - startY[i]) + pos.y;
+            }
+        }
+        else
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                posX[i] = x[i] + pos.x;
+                posY[i] = y[i] + pos.y;
+            }
+        }
+
+        MathUtil::sinCosArray(_particleData.rotation + start, (float)-CC_DEGREES_TO_RADIANS(1), sinR, cosR, count);
+        MathUtil::packColorsRGBA8(_particleData.colorR + start, _particleData.colorG + start,
+                                  _particleData.colorB + start, _particleData.colorA + start, _opacityModifyRGB,
+                                  colors, count);
+
+        V3F_C4B_T2F_Quad* quad = startQuad + start;
+        for (int i = 0; i < count; ++i, ++quad)
+        {
+            float halfSize = size[i] / 2;
+            float hc       = halfSize * cosR[i];
+            float hs       = halfSize * sinR[i];
+
+            quad->bl.vertices.x = -hc + hs + posX[i];
+            quad->bl.vertices.y = -hs - hc + posY[i];
+            quad->br.vertices.x = hc + hs + posX[i];
+            quad->br.vertices.y = hs - hc + posY[i];
+            quad->tl.vertices.x = -hc - hs + posX[i];
+            quad->tl.vertices.y = -hs + hc + posY[i];
+            quad->tr.vertices.x = hc - hs + posX[i];
+            quad->tr.vertices.y = hs + hc + posY[i];
+
+            memcpy(&quad->bl.colors, colors + i * 4, 4);
+            memcpy(&quad->br.colors, colors + i * 4, 4);
+            memcpy(&quad->tl.colors, colors + i * 4, 4);
+            memcpy(&quad->tr.colors, colors + i * 4, 4);
+        }
+    }
+}
+
 // overriding draw method
 void ParticleSystemQuad::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
@@ -168,6 +168,9 @@ protected:
 
     bool allocMemory();
 
+    /** Generates the quads of the alive particles in chunks, with the SIMD array functions of MathUtil. */
+    void updateParticleQuadsSIMD(V3F_C4B_T2F_Quad* startQuad, const Vec2& currentPosition, const Vec2& pos);
+
     V3F_C4B_T2F_Quad* _quads = nullptr;  // quads to be rendered
     unsigned short* _indices = nullptr;  // indices
 
@@ -33,6 +33,8 @@ THE SOFTWARE.
 #include "base/CCEventListenerCustom.h"
 #include "base/ccUTF8.h"
 #include "renderer/CCRenderer.h"
+#include "renderer/backend/ProgramState.h"
+#include "2d/CCLight.h"
 
 #if CC_USE_PHYSICS
 #    include "physics/CCPhysicsWorld.h"
@@ -49,6 +51,138 @@ THE SOFTWARE.
 
 NS_CC_BEGIN
 
+namespace
+{
+const int MAX_BLOCK_LIGHTS = 4;
+
+/*
+ * The shared uniform blocks set by Scene::render(), declared in GLSL as
+ *
+ *   layout(std140) uniform CameraBlock
+ *   {
+ *       mat4 u_viewProjection;
+ *       mat4 u_view;
+ *       mat4 u_projection;
+ *       vec4 u_eyePosition;
+ *   };
+ *
+ *   layout(std140) uniform LightBlock
+ *   {
+ *       vec4 u_ambientColor;
+ *       ivec4 u_lightCounts;           // directional, point, spot
+ *       vec4 u_dirLightColor[4];       // w: LightFlag
+ *       vec4 u_dirLightDir[4];
+ *       vec4 u_pointLightColor[4];     // w: LightFlag
+ *       vec4 u_pointLightPosition[4];  // w: inverse of the range
+ *       vec4 u_spotLightColor[4];      // w: LightFlag
+ *       vec4 u_spotLightPosition[4];   // w: inverse of the range
+ *       vec4 u_spotLightDir[4];        // w: cosine of the inner angle
+ *       vec4 u_spotLightOuterCos[4];   // x: cosine of the outer angle
+ *   };
+ *
+ * The light flags let a shader skip the lights excluded by the light mask of its mesh.
+ */
+struct CameraBlock
+{
+    Mat4 viewProjection;
+    Mat4 view;
+    Mat4 projection;
+    Vec4 eyePosition;
+};
+
+struct LightBlock
+{
+    Vec4 ambientColor;
+    int32_t counts[4];
+    Vec4 dirLightColor[MAX_BLOCK_LIGHTS];
+    Vec4 dirLightDir[MAX_BLOCK_LIGHTS];
+    Vec4 pointLightColor[MAX_BLOCK_LIGHTS];
+    Vec4 pointLightPosition[MAX_BLOCK_LIGHTS];
+    Vec4 spotLightColor[MAX_BLOCK_LIGHTS];
+    Vec4 spotLightPosition[MAX_BLOCK_LIGHTS];
+    Vec4 spotLightDir[MAX_BLOCK_LIGHTS];
+    Vec4 spotLightOuterCos[MAX_BLOCK_LIGHTS];
+};
+
+void setCameraUniformBlock(Camera* camera)
+{
+    CameraBlock block;
+    block.viewProjection = camera->getViewProjectionMatrix();
+    block.view           = camera->getViewMatrix();
+    block.projection     = camera->getProjectionMatrix();
+    const auto& world    = camera->getNodeToWorldTransform();
+    block.eyePosition.set(world.m[12], world.m[13], world.m[14], 1.0f);
+    backend::ProgramState::setSharedUniformBlock("CameraBlock", &block, sizeof(block));
+}
+
+void setLightUniformBlock(const std::vector<BaseLight*>& lights)
+{
+    LightBlock block = {};
+    for (const auto& light : lights)
+    {
+        if (!light->isEnabled())
+            continue;
+
+        const float intensity = light->getIntensity() / 255.0f;
+        const auto& col       = light->getDisplayedColor();
+        const Vec4 color(col.r * intensity, col.g * intensity, col.b * intensity,
+                         static_cast<float>(light->getLightFlag()));
+        switch (light->getLightType())
+        {
+        case LightType::DIRECTIONAL:
+        {
+            auto& count = block.counts[0];
+            if (count < MAX_BLOCK_LIGHTS)
+            {
+                auto dir = static_cast<DirectionLight*>(light)->getDirectionInWorld();
+                dir.normalize();
+                block.dirLightColor[count] = color;
+                block.dirLightDir[count].set(dir.x, dir.y, dir.z, 0.0f);
+                ++count;
+            }
+        }
+        break;
+        case LightType::POINT:
+        {
+            auto& count = block.counts[1];
+            if (count < MAX_BLOCK_LIGHTS)
+            {
+                auto pointLight              = static_cast<PointLight*>(light);
+                const auto& mat              = pointLight->getNodeToWorldTransform();
+                block.pointLightColor[count] = color;
+                block.pointLightPosition[count].set(mat.m[12], mat.m[13], mat.m[14], 1.0f / pointLight->getRange());
+                ++count;
+            }
+        }
+        break;
+        case LightType::SPOT:
+        {
+            auto& count = block.counts[2];
+            if (count < MAX_BLOCK_LIGHTS)
+            {
+                auto spotLight  = static_cast<SpotLight*>(light);
+                const auto& mat = spotLight->getNodeToWorldTransform();
+                auto dir        = spotLight->getDirectionInWorld();
+                dir.normalize();
+                block.spotLightColor[count] = color;
+                block.spotLightPosition[count].set(mat.m[12], mat.m[13], mat.m[14], 1.0f / spotLight->getRange());
+                block.spotLightDir[count].set(dir.x, dir.y, dir.z, spotLight->getCosInnerAngle());
+                block.spotLightOuterCos[count].x = spotLight->getCosOuterAngle();
+                ++count;
+            }
+        }
+        break;
+        case LightType::AMBIENT:
+            block.ambientColor.add(Vec4(color.x, color.y, color.z, 0.0f));
+            break;
+        default:
+            break;
+        }
+    }
+    backend::ProgramState::setSharedUniformBlock("LightBlock", &block, sizeof(block));
+}
+}  // namespace
+
 Scene::Scene()
     : _event(_director->getEventDispatcher()->addCustomEventListener(
           Director::EVENT_PROJECTION_CHANGED,
@@ -184,6 +318,8 @@ void Scene::render(Renderer* renderer, const Mat4& eyeTransform, const Mat4* eye
     Camera* defaultCamera = nullptr;
     const auto& transform = getNodeToParentTransform();
 
+    setLightUniformBlock(_lights);
+
     for (const auto& camera : getCameras())
     {
         if (!camera->isVisible())
@@ -211,6 +347,7 @@ void Scene::render(Renderer* renderer, const Mat4& eyeTransform, const Mat4* eye
                               Camera::_visitingCamera->getViewProjectionMatrix());
 
         camera->apply();
+        setCameraUniformBlock(camera);
         // clear background with max depth
         camera->clearBackground();
         // visit the scene
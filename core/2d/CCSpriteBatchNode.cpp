@@ -32,7 +32,7 @@ THE SOFTWARE.
 #include "base/ccTypes.h"
 #include "2d/CCSprite.h"
 #include "base/CCDirector.h"
-#include "base/CCProfiling.h"
+#include "base/CCFrameProfiler.h"
 #include "base/ccUTF8.h"
 #include "renderer/CCTextureCache.h"
 #include "renderer/CCRenderer.h"
@@ -185,7 +185,7 @@ SpriteBatchNode::~SpriteBatchNode()
 // don't call visit on it's children
 void SpriteBatchNode::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags)
 {
-    CC_PROFILER_START_CATEGORY(kProfilerCategoryBatchSprite, "CCSpriteBatchNode - visit");
+    CC_PROFILE_ZONE("SpriteBatchNode::visit");
 
     // CAREFUL:
     // This visit is almost identical to CocosNode#visit
@@ -217,8 +217,6 @@ void SpriteBatchNode::visit(Renderer* renderer, const Mat4& parentTransform, uin
         // FIX ME: Why need to set _orderOfArrival to 0??
         // Please refer to https://github.com/cocos2d/cocos2d-x/pull/6920
         //    setOrderOfArrival(0);
-
-        CC_PROFILER_STOP_CATEGORY(kProfilerCategoryBatchSprite, "CCSpriteBatchNode - visit");
     }
 }
 
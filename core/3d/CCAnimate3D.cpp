@@ -26,6 +26,7 @@
 #include "3d/CCAnimate3D.h"
 #include "3d/CCSprite3D.h"
 #include "3d/CCSkeleton3D.h"
+#include "3d/CCMeshSkin.h"
 #include "platform/CCFileUtils.h"
 #include "base/CCConfiguration.h"
 #include "base/CCEventCustom.h"
@@ -157,6 +158,7 @@ void Animate3D::startWithTarget(Node* target)
 
         bool hasCurve    = false;
         Sprite3D* sprite = dynamic_cast<Sprite3D*>(target);
+        _skeleton        = sprite ? sprite->getSkeleton() : nullptr;
 
         if (sprite)
         {
@@ -344,6 +346,20 @@ void Animate3D::update(float t)
                 t        = _start + t * _last;
                 lastTime = _start + lastTime * _last;
 
+                // with a palette cache, sample the clip on the cache grid so instances in step share palettes,
+                // only a pose of this animation alone can be shared
+                const Animation3D* poseAnimation = nullptr;
+                int64_t poseTimeIndex            = 0;
+                auto quantum                     = MeshSkin::getPaletteCacheQuantum();
+                if (quantum > 0 && _skeleton && _state == Animate3D::Animate3DState::Running && _weight >= 1.0f)
+                {
+                    auto duration = _animation->getDuration();
+                    poseTimeIndex = static_cast<int64_t>(std::lround(t * duration / quantum));
+                    poseAnimation = _animation;
+                    if (duration > 0)
+                        t = std::min(poseTimeIndex * quantum / duration, 1.0f);
+                }
+
                 for (const auto& it : _boneCurves)
                 {
                     auto bone  = it.first;
@@ -365,6 +381,8 @@ void Animate3D::update(float t)
                     }
                     bone->setAnimationValue(trans, rot, scale, this, _weight);
                 }
+                if (_skeleton && !_boneCurves.empty())
+                    _skeleton->setAnimatedPose(poseAnimation, poseTimeIndex);
 
                 for (const auto& it : _nodeCurves)
                 {
@@ -37,6 +37,7 @@
 NS_CC_BEGIN
 
 class Bone3D;
+class Skeleton3D;
 class Sprite3D;
 class EventCustom;
 
@@ -170,6 +171,7 @@ protected:
     Animate3DQuality _quality;
 
     std::unordered_map<Bone3D*, Animation3D::Curve*> _boneCurves;  // weak ref
+    Skeleton3D* _skeleton = nullptr;                                 // weak ref, skeleton of the target Sprite3D
     std::unordered_map<Node*, Animation3D::Curve*> _nodeCurves;
 
     std::unordered_map<int, ValueMap> _keyFrameUserInfos;
@@ -1090,7 +1090,7 @@ bool Bundle3D::loadBinary(std::string_view path)
 
     // get file data
     _binaryBuffer.clear();
-    _binaryBuffer = FileUtils::getInstance()->getDataFromFile(path);
+    _binaryBuffer = FileUtils::getInstance()->getMappedDataFromFile(path);
     if (_binaryBuffer.isNull())
     {
         clear();
@@ -1099,6 +1099,7 @@ bool Bundle3D::loadBinary(std::string_view path)
     }
 
     // Initialise bundle reader
+    // the reader only copies from the buffer, it's never written
     _binaryReader.init((char*)_binaryBuffer.getBytes(), _binaryBuffer.getSize());
 
     // Read identifier info
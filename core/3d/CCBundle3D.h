@@ -189,8 +189,8 @@ protected:
     std::string _jsonBuffer;
     rapidjson::Document _jsonReader;
 
-    // for binary reading
-    Data _binaryBuffer;
+    // for binary reading, mapped from the file when it's large enough
+    MappedData _binaryBuffer;
     BundleReader _binaryReader;
     unsigned int _referenceCount;
     Reference* _references;
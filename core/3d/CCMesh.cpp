@@ -113,6 +113,7 @@ Mesh::Mesh()
     , _visible(true)
     , _isTransparent(false)
     , _force2DQueue(false)
+    , _instancing(false)
     , _meshIndexData(nullptr)
     , _blend(BlendFunc::ALPHA_NON_PREMULTIPLIED)
     , _blendDirty(true)
@@ -436,6 +437,8 @@ void Mesh::draw(Renderer* renderer,
         command.setSkipBatching(isTransparent);
         command.setTransparent(isTransparent);
         command.set3D(!_force2DQueue);
+        command.setInstanced(_instancing);
+        command.setInstanceColor(color);
     }
 
     _material->draw(commands.data(), globalZ, getVertexBuffer(), getIndexBuffer(), getPrimitiveType(), getIndexFormat(),
@@ -238,6 +238,13 @@ public:
      */
     void setForce2DQueue(bool force2D) { _force2DQueue = force2D; }
 
+    /**
+     * draw the mesh with hardware instancing, the material must use an instancing program
+     * @see Sprite3D::setInstancing
+     */
+    void setInstancing(bool instancing) { _instancing = instancing; }
+    bool isInstancing() const { return _instancing; }
+
     std::string getTextureFileName() { return _texFile; }
 
     CC_CONSTRUCTOR_ACCESS :
@@ -255,6 +262,7 @@ protected:
     bool _visible;                                        // is the submesh visible
     bool _isTransparent;  // is this mesh transparent, it is a property of material in fact
     bool _force2DQueue;   // add this mesh to 2D render queue
+    bool _instancing;     // draw this mesh with an instancing program
 
     std::string _name;
     MeshIndexData* _meshIndexData;
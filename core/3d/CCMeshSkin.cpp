@@ -26,15 +26,66 @@
 #include "3d/CCMeshSkin.h"
 #include "3d/CCBundle3D.h"
 #include "3d/CCSkeleton3D.h"
+#include "base/CCJobSystem.h"
+#include "xxhash.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 NS_CC_BEGIN
 
-static int PALETTE_ROWS = 3;
+static int PALETTE_ROWS                 = 3;
+static int DUAL_QUATERNION_PALETTE_ROWS = 2;
+
+#define PALETTE_CACHE_MAX_ENTRIES 4096  // the whole cache is dropped once it grows past this
+
+struct PaletteCacheKey
+{
+    uint64_t skin;
+    const void* animation;
+    int64_t timeIndex;
+
+    bool operator==(const PaletteCacheKey& other) const
+    {
+        return skin == other.skin && animation == other.animation && timeIndex == other.timeIndex;
+    }
+};
+
+struct PaletteCacheKeyHash
+{
+    size_t operator()(const PaletteCacheKey& key) const
+    {
+        return static_cast<size_t>(key.skin ^ (reinterpret_cast<uintptr_t>(key.animation) * 0x9E3779B97F4A7C15ull) ^
+                                   (static_cast<uint64_t>(key.timeIndex) * 0xC2B2AE3D27D4EB4Full));
+    }
+};
+
+// palettes may be computed on JobSystem workers, the cache is shared by all of them
+static std::unordered_map<PaletteCacheKey, std::vector<Vec4>, PaletteCacheKeyHash> s_paletteCache;
+static std::mutex s_paletteCacheMutex;
+static uint64_t s_paletteCacheHits   = 0;
+static uint64_t s_paletteCacheMisses = 0;
+
+// live skins, walked by updateAnimatedPalettes, skins may be created and released by loader threads
+static std::unordered_set<MeshSkin*> s_skins;
+static std::mutex s_skinsMutex;
 
-MeshSkin::MeshSkin() : _rootBone(nullptr), _skeleton(nullptr) {}
+float MeshSkin::s_paletteCacheQuantum  = 0.0f;
+bool MeshSkin::s_parallelPaletteUpdate = false;
+
+MeshSkin::MeshSkin() : _rootBone(nullptr), _skeleton(nullptr)
+{
+    std::lock_guard<std::mutex> lock(s_skinsMutex);
+    s_skins.insert(this);
+}
 
 MeshSkin::~MeshSkin()
 {
+    {
+        std::lock_guard<std::mutex> lock(s_skinsMutex);
+        s_skins.erase(this);
+    }
     removeAllBones();
     CC_SAFE_RELEASE(_skeleton);
 }
@@ -57,6 +108,7 @@ MeshSkin* MeshSkin::create(Skeleton3D* skeleton,
         }
     }
     skin->_invBindPoses = invBindPose;
+    skin->updatePaletteHash();
     skin->autorelease();
 
     return skin;
@@ -100,28 +152,182 @@ int MeshSkin::getBoneIndex(Bone3D* bone) const
 // compute matrix palette used by gpu skin
 Vec4* MeshSkin::getMatrixPalette()
 {
-    _matrixPalette.resize(_skinBones.size() * PALETTE_ROWS);
-    int i = 0, paletteIndex = 0;
-    static Mat4 t;
-    for (auto it : _skinBones)
+    // every pass of every mesh using the skin asks for the palette, the bones only move in updateBoneMatrix
+    auto version = _skeleton ? _skeleton->getBoneMatrixVersion() : 0;
+    if (_paletteValid && _paletteVersion == version && _skeleton)
+        return _matrixPalette.data();
+
+    _matrixPalette.resize(getMatrixPaletteSize());
+
+    const void* animation = nullptr;
+    int64_t timeIndex     = 0;
+    if (s_paletteCacheQuantum > 0 && _skeleton && _skeleton->getAnimatedPose(animation, timeIndex) && animation)
     {
-        Mat4::multiply(it->getWorldMat(), _invBindPoses[i++], &t);
-        _matrixPalette[paletteIndex++].set(t.m[0], t.m[4], t.m[8], t.m[12]);
-        _matrixPalette[paletteIndex++].set(t.m[1], t.m[5], t.m[9], t.m[13]);
-        _matrixPalette[paletteIndex++].set(t.m[2], t.m[6], t.m[10], t.m[14]);
+        PaletteCacheKey key{_paletteHash, animation, timeIndex};
+        bool hit = false;
+        {
+            std::lock_guard<std::mutex> lock(s_paletteCacheMutex);
+            auto it = s_paletteCache.find(key);
+            if (it != s_paletteCache.end() && it->second.size() == _matrixPalette.size())
+            {
+                std::copy(it->second.begin(), it->second.end(), _matrixPalette.begin());
+                ++s_paletteCacheHits;
+                hit = true;
+            }
+        }
+
+        if (!hit)
+        {
+            computePalette(_matrixPalette.data());
+
+            std::lock_guard<std::mutex> lock(s_paletteCacheMutex);
+            ++s_paletteCacheMisses;
+            if (s_paletteCache.size() >= PALETTE_CACHE_MAX_ENTRIES)
+                s_paletteCache.clear();
+            s_paletteCache[key] = _matrixPalette;
+        }
+    }
+    else
+    {
+        computePalette(_matrixPalette.data());
     }
 
+    _paletteVersion = version;
+    _paletteValid   = true;
+
     return _matrixPalette.data();
 }
 
+void MeshSkin::computePalette(Vec4* palette) const
+{
+    int i = 0;
+    Mat4 t;
+    if (_paletteFormat == PaletteFormat::DUAL_QUATERNION)
+    {
+        Quaternion real;
+        Vec3 translation;
+        for (auto it : _skinBones)
+        {
+            Mat4::multiply(it->getWorldMat(), _invBindPoses[i++], &t);
+            t.decompose(nullptr, &real, &translation);
+            // dual part is half the translation quaternion times the rotation
+            Quaternion dual = Quaternion(translation.x, translation.y, translation.z, 0.0f) * real;
+            (palette++)->set(real.x, real.y, real.z, real.w);
+            (palette++)->set(dual.x * 0.5f, dual.y * 0.5f, dual.z * 0.5f, dual.w * 0.5f);
+        }
+        return;
+    }
+
+    for (auto it : _skinBones)
+    {
+        Mat4::multiply(it->getWorldMat(), _invBindPoses[i++], &t);
+        (palette++)->set(t.m[0], t.m[4], t.m[8], t.m[12]);
+        (palette++)->set(t.m[1], t.m[5], t.m[9], t.m[13]);
+        (palette++)->set(t.m[2], t.m[6], t.m[10], t.m[14]);
+    }
+}
+
 ssize_t MeshSkin::getMatrixPaletteSize() const
 {
-    return _skinBones.size() * PALETTE_ROWS;
+    return _skinBones.size() *
+           (_paletteFormat == PaletteFormat::DUAL_QUATERNION ? DUAL_QUATERNION_PALETTE_ROWS : PALETTE_ROWS);
 }
 
 ssize_t MeshSkin::getMatrixPaletteSizeInBytes() const
 {
-    return _skinBones.size() * PALETTE_ROWS * sizeof(_matrixPalette[0]);
+    return getMatrixPaletteSize() * sizeof(Vec4);
+}
+
+void MeshSkin::setPaletteFormat(PaletteFormat format)
+{
+    if (_paletteFormat != format)
+    {
+        _paletteFormat = format;
+        _paletteValid  = false;
+        updatePaletteHash();
+    }
+}
+
+void MeshSkin::updatePaletteHash()
+{
+    // instances of one model have equal bone names and bind poses, so they share cached palettes
+    XXH64_state_t* state = XXH64_createState();
+    XXH64_reset(state, static_cast<unsigned long long>(_paletteFormat));
+    for (auto bone : _skinBones)
+    {
+        auto name = bone->getName();
+        XXH64_update(state, name.data(), name.length());
+    }
+    if (!_invBindPoses.empty())
+        XXH64_update(state, _invBindPoses.data(), _invBindPoses.size() * sizeof(Mat4));
+    _paletteHash = XXH64_digest(state);
+    XXH64_freeState(state);
+}
+
+void MeshSkin::setPaletteCacheQuantum(float quantum)
+{
+    s_paletteCacheQuantum = quantum > 0 ? quantum : 0.0f;
+    clearPaletteCache();
+}
+
+void MeshSkin::clearPaletteCache()
+{
+    std::lock_guard<std::mutex> lock(s_paletteCacheMutex);
+    s_paletteCache.clear();
+}
+
+MeshSkin::PaletteCacheStats MeshSkin::getPaletteCacheStats()
+{
+    std::lock_guard<std::mutex> lock(s_paletteCacheMutex);
+    PaletteCacheStats stats;
+    stats.hits    = s_paletteCacheHits;
+    stats.misses  = s_paletteCacheMisses;
+    stats.entries = s_paletteCache.size();
+    return stats;
+}
+
+void MeshSkin::resetPaletteCacheStats()
+{
+    std::lock_guard<std::mutex> lock(s_paletteCacheMutex);
+    s_paletteCacheHits   = 0;
+    s_paletteCacheMisses = 0;
+}
+
+void MeshSkin::setParallelPaletteUpdate(bool enabled)
+{
+    s_parallelPaletteUpdate = enabled;
+}
+
+void MeshSkin::updateAnimatedPalettes()
+{
+    static std::vector<Skeleton3D*> skeletons;
+    static std::vector<MeshSkin*> skins;
+
+    const void* animation = nullptr;
+    int64_t timeIndex     = 0;
+    // held until the palettes are done, so no skin goes away under the workers
+    std::lock_guard<std::mutex> lock(s_skinsMutex);
+    for (auto skin : s_skins)
+    {
+        auto skeleton = skin->_skeleton;
+        if (!skeleton || !skeleton->getAnimatedPose(animation, timeIndex))
+            continue;
+
+        // several skins share the skeleton of one Sprite3D, its bones are refreshed once
+        if (!skeleton->isBoneMatrixPrepared())
+        {
+            skeleton->setBoneMatrixPrepared();
+            skeletons.push_back(skeleton);
+        }
+        skins.push_back(skin);
+    }
+
+    auto jobSystem = JobSystem::getInstance();
+    jobSystem->parallelFor(skeletons.size(), [](size_t index) { skeletons[index]->updateBoneMatrix(); });
+    jobSystem->parallelFor(skins.size(), [](size_t index) { skins[index]->getMatrixPalette(); });
+
+    skeletons.clear();
+    skins.clear();
 }
 
 void MeshSkin::removeAllBones()
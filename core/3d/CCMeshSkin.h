@@ -53,6 +53,20 @@ class CC_DLL MeshSkin : public Ref
     friend class Mesh;
 
 public:
+    /**layout of the palette passed to u_matrixPalette*/
+    enum class PaletteFormat
+    {
+        MATRIX_4X3,       // 3 Vec4 rows of the 4x3 bone matrix per bone
+        DUAL_QUATERNION,  // real and dual quaternion per bone, for rigid bones and a dual quaternion skinning shader
+    };
+
+    struct PaletteCacheStats
+    {
+        uint64_t hits   = 0;
+        uint64_t misses = 0;
+        size_t entries  = 0;
+    };
+
     /**create a new meshskin if do not want to share meshskin*/
     static MeshSkin* create(Skeleton3D* skeleton, std::string_view filename, std::string_view name);
 
@@ -70,15 +84,41 @@ public:
     /**get bone index*/
     int getBoneIndex(Bone3D* bone) const;
 
-    /**compute matrix palette used by gpu skin*/
+    /**compute matrix palette used by gpu skin, it is only recomputed after the skeleton refreshed its bones*/
     Vec4* getMatrixPalette();
 
-    /**getSkinBoneCount() * 3*/
+    /**getSkinBoneCount() * 3, or * 2 for PaletteFormat::DUAL_QUATERNION*/
     ssize_t getMatrixPaletteSize() const;
 
-    /**getSkinBoneCount() * 3 * sizeof(Vec4) */
+    /**getMatrixPaletteSize() * sizeof(Vec4) */
     ssize_t getMatrixPaletteSizeInBytes() const;
 
+    /**set the palette format, the mesh material must use the matching skinning shader*/
+    void setPaletteFormat(PaletteFormat format);
+    PaletteFormat getPaletteFormat() const { return _paletteFormat; }
+
+    /**
+     * Share palettes between instances of the same model which play the same clip in step.
+     * Animate3D samples clips at multiples of quantum seconds, and the palette of each (model, clip, sample) is
+     * computed once and reused by every instance reaching that sample. Bones not driven by the clip must keep the
+     * same pose on all instances. 0 disables the cache, which is the default.
+     */
+    static void setPaletteCacheQuantum(float quantum);
+    static float getPaletteCacheQuantum() { return s_paletteCacheQuantum; }
+    static void clearPaletteCache();
+    static PaletteCacheStats getPaletteCacheStats();
+    static void resetPaletteCacheStats();
+
+    /**
+     * Refresh the bones and palettes of all skins animated in the current frame on the JobSystem workers once the
+     * scheduler update is done, instead of one by one while drawing.
+     */
+    static void setParallelPaletteUpdate(bool enabled);
+    static bool isParallelPaletteUpdate() { return s_parallelPaletteUpdate; }
+
+    /**refresh the bones and palettes of the skins animated in the current frame in parallel*/
+    static void updateAnimatedPalettes();
+
     /**get root bone of the skin*/
     Bone3D* getRootBone() const;
 
@@ -98,6 +138,9 @@ public:
     const Mat4& getInvBindPose(const Bone3D* bone);
 
 protected:
+    void computePalette(Vec4* palette) const;
+    void updatePaletteHash();
+
     Vector<Bone3D*> _skinBones;       // bones with skin
     std::vector<Mat4> _invBindPoses;  // inverse bind pose of bone
 
@@ -109,6 +152,14 @@ protected:
     // Each 4x3 row-wise matrix is represented as 3 Vec4's.
     // The number of Vec4's is (_skinBones.size() * 3).
     std::vector<Vec4> _matrixPalette;
+
+    PaletteFormat _paletteFormat = PaletteFormat::MATRIX_4X3;
+    uint32_t _paletteVersion     = 0;  // skeleton bone matrix version the palette was computed from
+    bool _paletteValid           = false;
+    uint64_t _paletteHash        = 0;  // identifies bones, bind poses and format in the palette cache
+
+    static float s_paletteCacheQuantum;
+    static bool s_parallelPaletteUpdate;
 };
 
 // end of 3d group
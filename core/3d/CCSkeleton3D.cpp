@@ -24,6 +24,7 @@
  ****************************************************************************/
 
 #include "3d/CCSkeleton3D.h"
+#include "base/CCDirector.h"
 
 NS_CC_BEGIN
 
@@ -146,7 +147,7 @@ Bone3D* Bone3D::create(std::string_view id)
 void Bone3D::updateJointMatrix(Vec4* matrixPalette)
 {
     {
-        static Mat4 t;
+        Mat4 t;
         Mat4::multiply(_world, getInverseBindPose(), &t);
 
         matrixPalette[0].set(t.m[0], t.m[4], t.m[8], t.m[12]);
@@ -320,6 +321,39 @@ void Skeleton3D::updateBoneMatrix()
         it->setWorldMatDirty(true);
         it->updateWorldMat();
     }
+    ++_boneMatrixVersion;
+}
+
+void Skeleton3D::setAnimatedPose(const void* animation, int64_t timeIndex)
+{
+    auto frame = Director::getInstance()->getTotalFrames();
+    // several animations blend into this frame's pose
+    if (_poseFrame == frame && (_poseAnimation != animation || _poseTimeIndex != timeIndex))
+        animation = nullptr;
+
+    _poseFrame     = frame;
+    _poseAnimation = animation;
+    _poseTimeIndex = timeIndex;
+}
+
+bool Skeleton3D::getAnimatedPose(const void*& animation, int64_t& timeIndex) const
+{
+    if (_poseFrame != Director::getInstance()->getTotalFrames())
+        return false;
+
+    animation = _poseAnimation;
+    timeIndex = _poseTimeIndex;
+    return true;
+}
+
+void Skeleton3D::setBoneMatrixPrepared()
+{
+    _preparedFrame = Director::getInstance()->getTotalFrames();
+}
+
+bool Skeleton3D::isBoneMatrixPrepared() const
+{
+    return _preparedFrame == Director::getInstance()->getTotalFrames();
 }
 
 void Skeleton3D::removeAllBones()
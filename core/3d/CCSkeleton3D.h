@@ -202,6 +202,24 @@ public:
     /**refresh bone world matrix*/
     void updateBoneMatrix();
 
+    /**number of updateBoneMatrix calls, a skin recomputes its palette only when it changes*/
+    uint32_t getBoneMatrixVersion() const { return _boneMatrixVersion; }
+
+    /**
+     * Records the animation which posed the skeleton in the current frame.
+     * @param animation the clip if the pose only depends on (animation, timeIndex), nullptr if the pose can't be
+     * shared with other instances (blending, fading)
+     * @param timeIndex sample time of the clip in MeshSkin::getPaletteCacheQuantum() steps
+     */
+    void setAnimatedPose(const void* animation, int64_t timeIndex);
+
+    /**returns true if an animation posed the skeleton in the current frame, see setAnimatedPose*/
+    bool getAnimatedPose(const void*& animation, int64_t& timeIndex) const;
+
+    /**mark the bone world matrices as refreshed for the current frame by MeshSkin::updateAnimatedPalettes*/
+    void setBoneMatrixPrepared();
+    bool isBoneMatrixPrepared() const;
+
     CC_CONSTRUCTOR_ACCESS :
 
         Skeleton3D();
@@ -221,6 +239,15 @@ protected:
     Vector<Bone3D*> _bones;  // bones
 
     Vector<Bone3D*> _rootBones;
+
+    uint32_t _boneMatrixVersion = 0;
+
+    // pose of the current frame, used as palette cache key
+    unsigned int _poseFrame    = 0;
+    const void* _poseAnimation = nullptr;
+    int64_t _poseTimeIndex     = 0;
+
+    unsigned int _preparedFrame = 0;  // frame MeshSkin::updateAnimatedPalettes refreshed the bones
 };
 
 // end of 3d group
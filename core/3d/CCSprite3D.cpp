@@ -48,7 +48,10 @@
 
 NS_CC_BEGIN
 
-static Sprite3DMaterial* getSprite3DMaterialForAttribs(MeshVertexData* meshVertexData, bool usesLight);
+static Sprite3DMaterial* getSprite3DMaterialForAttribs(MeshVertexData* meshVertexData,
+                                                       bool usesLight,
+                                                       bool dualQuaternion,
+                                                       bool instanced);
 
 Sprite3D* Sprite3D::create()
 {
@@ -480,12 +483,14 @@ void Sprite3D::setMaterial(Material* material, int meshIndex)
         for (ssize_t i = 0, size = _meshes.size(); i < size; ++i)
         {
             _meshes.at(i)->setMaterial(i == 0 ? material : material->clone());
+            _meshes.at(i)->setInstancing(false);
         }
     }
     else
     {
         auto mesh = _meshes.at(meshIndex);
         mesh->setMaterial(material);
+        mesh->setInstancing(false);
     }
 
     _usingAutogeneratedGLProgram = false;
@@ -497,6 +502,39 @@ Material* Sprite3D::getMaterial(int meshIndex) const
     return _meshes.at(meshIndex)->getMaterial();
 }
 
+void Sprite3D::setDualQuaternionSkinning(bool enabled)
+{
+    if (_dualQuaternionSkinning == enabled)
+        return;
+
+    _dualQuaternionSkinning = enabled;
+    auto format = enabled ? MeshSkin::PaletteFormat::DUAL_QUATERNION : MeshSkin::PaletteFormat::MATRIX_4X3;
+    for (auto mesh : _meshes)
+    {
+        if (mesh->getSkin())
+            mesh->getSkin()->setPaletteFormat(format);
+    }
+
+    if (_usingAutogeneratedGLProgram)
+        genMaterial(_shaderUsingLight);
+}
+
+void Sprite3D::setInstancing(bool enabled)
+{
+    if (enabled && !_director->getRenderer()->isInstancingSupported())
+    {
+        CCLOG("Sprite3D: instancing is not supported by the renderer");
+        enabled = false;
+    }
+
+    if (_instancing == enabled)
+        return;
+
+    _instancing = enabled;
+    if (_usingAutogeneratedGLProgram)
+        genMaterial(_shaderUsingLight);
+}
+
 void Sprite3D::genMaterial(bool useLight)
 {
     _shaderUsingLight = useLight;
@@ -504,7 +542,7 @@ void Sprite3D::genMaterial(bool useLight)
     std::unordered_map<const MeshVertexData*, Sprite3DMaterial*> materials;
     for (auto meshVertexData : _meshVertexDatas)
     {
-        auto material = getSprite3DMaterialForAttribs(meshVertexData, useLight);
+        auto material = getSprite3DMaterialForAttribs(meshVertexData, useLight, _dualQuaternionSkinning, _instancing);
         CCASSERT(material, "material should not be null");
         materials[meshVertexData] = material;
     }
@@ -523,6 +561,7 @@ void Sprite3D::genMaterial(bool useLight)
             mesh->setMaterial(material);
         else
             mesh->setMaterial(material->clone());
+        mesh->setInstancing(material->isInstanced());
     }
 }
 
@@ -782,7 +821,8 @@ void Sprite3D::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 //        return;
 #endif
 
-    if (_skeleton)
+    // MeshSkin::updateAnimatedPalettes may have refreshed the bones on the job threads already
+    if (_skeleton && !_skeleton->isBoneMatrixPrepared())
         _skeleton->updateBoneMatrix();
 
     Color4F color(getDisplayedColor());
@@ -1020,7 +1060,10 @@ Sprite3DCache::~Sprite3DCache()
 //
 // MARK: Helpers
 //
-static Sprite3DMaterial* getSprite3DMaterialForAttribs(MeshVertexData* meshVertexData, bool usesLight)
+static Sprite3DMaterial* getSprite3DMaterialForAttribs(MeshVertexData* meshVertexData,
+                                                       bool usesLight,
+                                                       bool dualQuaternion,
+                                                       bool instanced)
 {
     bool textured = meshVertexData->hasVertexAttrib(shaderinfos::VertexKey::VERTEX_ATTRIB_TEX_COORD);
     bool hasSkin  = meshVertexData->hasVertexAttrib(shaderinfos::VertexKey::VERTEX_ATTRIB_BLEND_INDEX) &&
@@ -1048,7 +1091,7 @@ static Sprite3DMaterial* getSprite3DMaterialForAttribs(MeshVertexData* meshVerte
                                       : Sprite3DMaterial::MaterialType::UNLIT_NOTEX;
     }
 
-    return Sprite3DMaterial::createBuiltInMaterial(type, hasSkin);
+    return Sprite3DMaterial::createBuiltInMaterial(type, hasSkin, dualQuaternion, instanced);
 }
 
 NS_CC_END
@@ -154,6 +154,24 @@ public:
      */
     virtual Action* runAction(Action* action) override;
 
+    /**
+     * Skin with dual quaternions instead of 4x3 matrices. It halves the bone palette upload and avoids the
+     * candy-wrapper collapse of twisted joints, but bones must be rigid (no scale). Only the built-in materials
+     * have a dual quaternion shader, custom materials must handle PaletteFormat::DUAL_QUATERNION themselves.
+     */
+    void setDualQuaternionSkinning(bool enabled);
+    bool isDualQuaternionSkinning() const { return _dualQuaternionSkinning; }
+
+    /**
+     * Draw the meshes with hardware instancing. The renderer draws the opaque meshes sharing the same buffers,
+     * program and textures with a single draw call, taking the model view matrix and the color of each one from a
+     * per instance vertex stream. Only the built-in materials of meshes without skin have an instancing shader, and
+     * the other uniforms and render states are those of the first instance drawn. Ignored if the renderer doesn't
+     * support instancing.
+     */
+    void setInstancing(bool enabled);
+    bool isInstancing() const { return _instancing; }
+
     /**
      * Force to write to depth buffer, this is useful if you want to achieve effects like fading.
      */
@@ -267,6 +285,8 @@ protected:
     bool _shaderUsingLight;  // is current shader using light ?
     bool _forceDepthWrite;   // Always write to depth buffer
     bool _usingAutogeneratedGLProgram;
+    bool _dualQuaternionSkinning = false;
+    bool _instancing             = false;
 
     struct AsyncLoadParam
     {
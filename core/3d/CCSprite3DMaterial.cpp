@@ -51,6 +51,10 @@ Sprite3DMaterial* Sprite3DMaterial::_vertexLitMaterialSkin     = nullptr;
 Sprite3DMaterial* Sprite3DMaterial::_diffuseMaterialSkin       = nullptr;
 Sprite3DMaterial* Sprite3DMaterial::_bumpedDiffuseMaterialSkin = nullptr;
 
+Sprite3DMaterial* Sprite3DMaterial::_unLitMaterialSkinDQ         = nullptr;
+Sprite3DMaterial* Sprite3DMaterial::_diffuseMaterialSkinDQ       = nullptr;
+Sprite3DMaterial* Sprite3DMaterial::_bumpedDiffuseMaterialSkinDQ = nullptr;
+
 backend::ProgramState* Sprite3DMaterial::_unLitMaterialProgState         = nullptr;
 backend::ProgramState* Sprite3DMaterial::_unLitNoTexMaterialProgState    = nullptr;
 backend::ProgramState* Sprite3DMaterial::_vertexLitMaterialProgState     = nullptr;
@@ -145,6 +149,10 @@ void Sprite3DMaterial::releaseBuiltInMaterial()
     CC_SAFE_RELEASE_NULL(_vertexLitMaterialSkin);
     CC_SAFE_RELEASE_NULL(_diffuseMaterialSkin);
     CC_SAFE_RELEASE_NULL(_bumpedDiffuseMaterialSkin);
+
+    CC_SAFE_RELEASE_NULL(_unLitMaterialSkinDQ);
+    CC_SAFE_RELEASE_NULL(_diffuseMaterialSkinDQ);
+    CC_SAFE_RELEASE_NULL(_bumpedDiffuseMaterialSkinDQ);
     // release program states
     CC_SAFE_RELEASE_NULL(_unLitMaterialProgState);
     CC_SAFE_RELEASE_NULL(_unLitNoTexMaterialProgState);
@@ -191,17 +199,92 @@ Material* Sprite3DMaterial::clone() const
     auto name                   = _currentTechnique->getName();
     material->_currentTechnique = material->getTechniqueByName(name);
     material->_type             = _type;
+    material->_instanced        = _instanced;
     material->autorelease();
 
     return material;
 }
 
-Sprite3DMaterial* Sprite3DMaterial::createBuiltInMaterial(MaterialType type, bool skinned)
+Sprite3DMaterial* Sprite3DMaterial::createBuiltInMaterial(MaterialType type,
+                                                          bool skinned,
+                                                          bool dualQuaternion,
+                                                          bool instanced)
 {
     /////
     if (_diffuseMaterial == nullptr)
         createBuiltInMaterial();
 
+    if (skinned && dualQuaternion)
+    {
+        // kept around like the linear blend skinning materials, but only built once a sprite asks for them
+        Sprite3DMaterial** cached = nullptr;
+        uint32_t programType;
+        switch (type)
+        {
+        case Sprite3DMaterial::MaterialType::UNLIT:
+            cached      = &_unLitMaterialSkinDQ;
+            programType = backend::ProgramType::SKINPOSITION_DQ_TEXTURE_3D;
+            break;
+        case Sprite3DMaterial::MaterialType::DIFFUSE:
+            cached      = &_diffuseMaterialSkinDQ;
+            programType = backend::ProgramType::SKINPOSITION_DQ_NORMAL_TEXTURE_3D;
+            break;
+        case Sprite3DMaterial::MaterialType::BUMPED_DIFFUSE:
+            cached      = &_bumpedDiffuseMaterialSkinDQ;
+            programType = backend::ProgramType::SKINPOSITION_DQ_BUMPEDNORMAL_TEXTURE_3D;
+            break;
+        default:
+            return createBuiltInMaterial(type, skinned);
+        }
+
+        if (*cached == nullptr)
+        {
+            auto programState = new backend::ProgramState(backend::Program::getBuiltinProgram(programType));
+            auto material     = new Sprite3DMaterial();
+            if (material->initWithProgramState(programState))
+            {
+                material->_type = type;
+                *cached         = material;
+            }
+            else
+            {
+                CC_SAFE_DELETE(material);
+            }
+            CC_SAFE_RELEASE(programState);
+        }
+        return *cached ? (Sprite3DMaterial*)(*cached)->clone() : nullptr;
+    }
+
+    if (!skinned && instanced)
+    {
+        // instancing is rarely used, its materials aren't kept around
+        uint32_t programType;
+        switch (type)
+        {
+        case Sprite3DMaterial::MaterialType::UNLIT:
+            programType = backend::ProgramType::POSITION_TEXTURE_3D_INSTANCED;
+            break;
+        case Sprite3DMaterial::MaterialType::DIFFUSE:
+            programType = backend::ProgramType::POSITION_NORMAL_TEXTURE_3D_INSTANCED;
+            break;
+        case Sprite3DMaterial::MaterialType::BUMPED_DIFFUSE:
+            programType = backend::ProgramType::POSITION_BUMPEDNORMAL_TEXTURE_3D_INSTANCED;
+            break;
+        default:
+            return createBuiltInMaterial(type, skinned);
+        }
+
+        auto programState = new backend::ProgramState(backend::Program::getBuiltinProgram(programType));
+        auto material     = createWithProgramState(programState);
+        CC_SAFE_RELEASE(programState);
+        if (material)
+        {
+            material->_type      = type;
+            material->_instanced = true;
+        }
+        return material;
+    }
+
     Sprite3DMaterial* material = nullptr;
     switch (type)
     {
@@ -74,13 +74,24 @@ public:
      */
     MaterialType getMaterialType() const { return _type; }
 
+    /**
+     * Whether the material uses an instancing program, the meshes using it must be drawn instanced
+     * @see Mesh::setInstancing
+     */
+    bool isInstanced() const { return _instanced; }
+
     /**
      * Create built in material from material type
      * @param type Material type
      * @param skinned Has skin?
+     * @param dualQuaternion Skin with MeshSkin::PaletteFormat::DUAL_QUATERNION palettes, only used if skinned
+     * @param instanced Draw with hardware instancing, only used if not skinned
      * @return Created material
      */
-    static Sprite3DMaterial* createBuiltInMaterial(MaterialType type, bool skinned);
+    static Sprite3DMaterial* createBuiltInMaterial(MaterialType type,
+                                                   bool skinned,
+                                                   bool dualQuaternion = false,
+                                                   bool instanced      = false);
 
     /**
      * Create material with file name, it creates material from cache if it is previously loaded
@@ -121,6 +132,7 @@ public:
 
 protected:
     MaterialType _type;
+    bool _instanced = false;
     static std::unordered_map<std::string, Sprite3DMaterial*> _materials;  // cached material
     static Sprite3DMaterial* _unLitMaterial;
     static Sprite3DMaterial* _unLitNoTexMaterial;
@@ -134,6 +146,11 @@ protected:
     static Sprite3DMaterial* _diffuseMaterialSkin;
     static Sprite3DMaterial* _bumpedDiffuseMaterialSkin;
 
+    // dual quaternion skinning variants, created on first use
+    static Sprite3DMaterial* _unLitMaterialSkinDQ;
+    static Sprite3DMaterial* _diffuseMaterialSkinDQ;
+    static Sprite3DMaterial* _bumpedDiffuseMaterialSkinDQ;
+
     static backend::ProgramState* _unLitMaterialProgState;
     static backend::ProgramState* _unLitNoTexMaterialProgState;
     static backend::ProgramState* _vertexLitMaterialProgState;
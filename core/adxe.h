@@ -49,9 +49,12 @@ THE SOFTWARE.
 #include "base/CCDirector.h"
 #include "base/CCIMEDelegate.h"
 #include "base/CCIMEDispatcher.h"
+#include "base/CCJobSystem.h"
 #include "base/CCMap.h"
 #include "base/CCNS.h"
 #include "base/CCProfiling.h"
+#include "base/CCFrameProfiler.h"
+#include "base/CCFramePacer.h"
 #include "base/CCProperties.h"
 #include "base/CCRef.h"
 #include "base/CCRefPtr.h"
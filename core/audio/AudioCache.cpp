@@ -34,6 +34,7 @@
 #include <thread>
 #include "base/CCDirector.h"
 #include "base/CCScheduler.h"
+#include "platform/CCFileUtils.h"
 
 #include "audio/AudioDecoderManager.h"
 #include "audio/AudioDecoder.h"
@@ -54,7 +55,6 @@ unsigned int __idIndex = 0;
 }
 
 #define INVALID_AL_BUFFER_ID 0xFFFFFFFF
-#define PCMDATA_CACHEMAXSIZE 1048576
 
 using namespace cocos2d;
 
@@ -65,6 +65,11 @@ AudioCache::AudioCache()
     , _duration(0.0f)
     , _alBufferId(INVALID_AL_BUFFER_ID)
     , _queBufferFrames(0)
+    , _pcmCacheMaxSize(PCMDATA_CACHEMAXSIZE)
+    , _compressedCacheMaxSize(0)
+    , _memorySize(0)
+    , _lastUsed(0)
+    , _evictable(false)
     , _state(State::INITIAL)
     , _isDestroyed(std::make_shared<bool>(false))
     , _id(++__idIndex)
@@ -180,7 +185,7 @@ void AudioCache::readDataTask(unsigned int selfId)
         _duration    = 1.0f * totalFrames / sampleRate;
         _totalFrames = totalFrames;
 
-        if (dataSize <= PCMDATA_CACHEMAXSIZE)
+        if (dataSize <= _pcmCacheMaxSize)
         {
             uint32_t framesRead = 0;
             const uint32_t framesToReadOnce =
@@ -296,7 +301,8 @@ void AudioCache::readDataTask(unsigned int selfId)
                 break;
             }
 
-            _state = State::READY;
+            _memorySize = dataSize;
+            _state      = State::READY;
         }
         else
         {
@@ -312,6 +318,23 @@ void AudioCache::readDataTask(unsigned int selfId)
 
                 decoder->readFixedFrames(_queBufferFrames, _queBuffers[index]);
             }
+            _memorySize = queBufferBytes * QUEUEBUFFER_NUM;
+
+            // Keep the encoded file in memory, the players then decode it on demand instead of reading the file
+            if (_compressedCacheMaxSize > 0 && decoder->supportsSourceData())
+            {
+                auto fileUtils = FileUtils::getInstance();
+                auto fileSize  = fileUtils->getFileSize(_fileFullPath);
+                if (fileSize > 0 && fileSize <= static_cast<int64_t>(_compressedCacheMaxSize))
+                {
+                    auto compressedData = std::make_shared<std::vector<char>>();
+                    if (fileUtils->getContents(_fileFullPath, compressedData.get()) == FileUtils::Status::OK)
+                    {
+                        _memorySize += compressedData->size();
+                        _compressedData = std::move(compressedData);
+                    }
+                }
+            }
 
             _state = State::READY;
         }
@@ -77,17 +77,34 @@ protected:
     uint32_t _framesRead;
 
     /*Cache related stuff;
-     * Cache pcm data when sizeInBytes less than PCMDATA_CACHEMAXSIZE
+     * Cache pcm data when sizeInBytes less than _pcmCacheMaxSize
      */
     ALuint _alBufferId;
 
     /*Queue buffer related stuff
-     *  Streaming in OpenAL when sizeInBytes greater then PCMDATA_CACHEMAXSIZE
+     *  Streaming in OpenAL when sizeInBytes greater then _pcmCacheMaxSize
      */
     char* _queBuffers[QUEUEBUFFER_NUM];
     ALsizei _queBufferSize[QUEUEBUFFER_NUM];
     uint32_t _queBufferFrames;
 
+    /* Streamed audio whose file isn't bigger than _compressedCacheMaxSize keeps the encoded file here,
+     * the players decode it on demand instead of reading the file again.
+     */
+    std::shared_ptr<const std::vector<char>> _compressedData;
+
+    // limits taken from AudioEngine when the cache is created
+    uint32_t _pcmCacheMaxSize;
+    uint32_t _compressedCacheMaxSize;
+
+    // bytes of audio data held by the cache, valid once _isLoadingFinished is set
+    size_t _memorySize;
+    // value of the AudioEngineImpl use counter when the cache was last preloaded or played, for the LRU eviction
+    uint64_t _lastUsed;
+    // set by the first eviction pass which found the cache loaded with its preload callbacks dispatched, the caches
+    // which just finished loading aren't evicted before that
+    bool _evictable;
+
     std::mutex _playCallbackMutex;
     std::vector<std::function<void()>> _playCallbacks;
 
@@ -33,6 +33,77 @@
 namespace cocos2d
 {
 
+namespace
+{
+// read only stream over the encoded bytes kept by an AudioCache
+class SourceDataStream : public FileStream
+{
+public:
+    explicit SourceDataStream(std::shared_ptr<const std::vector<char>> data) : _data(std::move(data)), _offset(0) {}
+
+    bool open(std::string_view /*path*/, FileStream::Mode mode) override { return mode == FileStream::Mode::READ; }
+
+    int close() override
+    {
+        _data.reset();
+        return 0;
+    }
+
+    int seek(int64_t offset, int origin) override
+    {
+        if (!_data)
+            return -1;
+
+        int64_t base = 0;
+        switch (origin)
+        {
+        case SEEK_SET:
+            break;
+        case SEEK_CUR:
+            base = _offset;
+            break;
+        case SEEK_END:
+            base = static_cast<int64_t>(_data->size());
+            break;
+        default:
+            return -1;
+        }
+
+        if (base + offset < 0)
+            return -1;
+        _offset = (std::min)(base + offset, static_cast<int64_t>(_data->size()));
+        return 0;
+    }
+
+    int read(void* buf, unsigned int size) override
+    {
+        if (!_data)
+            return -1;
+
+        auto available = static_cast<int64_t>(_data->size()) - _offset;
+        auto bytesRead = static_cast<int>((std::min)(static_cast<int64_t>(size), available));
+        if (bytesRead > 0)
+        {
+            memcpy(buf, _data->data() + _offset, bytesRead);
+            _offset += bytesRead;
+        }
+        return bytesRead;
+    }
+
+    int write(const void* /*buf*/, unsigned int /*size*/) override { return -1; }
+
+    int64_t tell() override { return _data ? _offset : -1; }
+
+    int64_t size() override { return _data ? static_cast<int64_t>(_data->size()) : -1; }
+
+    bool isOpen() const override { return _data != nullptr; }
+
+private:
+    std::shared_ptr<const std::vector<char>> _data;
+    int64_t _offset;
+};
+}  // namespace
+
 AudioDecoder::AudioDecoder()
     : _isOpened(false)
     , _totalFrames(0)
@@ -45,6 +116,14 @@ AudioDecoder::AudioDecoder()
 
 AudioDecoder::~AudioDecoder() {}
 
+std::unique_ptr<FileStream> AudioDecoder::openStream(std::string_view path) const
+{
+    if (_sourceData)
+        return std::make_unique<SourceDataStream>(_sourceData);
+
+    return FileUtils::getInstance()->openFileStream(path, FileStream::Mode::READ);
+}
+
 bool AudioDecoder::isOpened() const
 {
     return _isOpened;
@@ -28,6 +28,8 @@
 
 #include <stdint.h>
 #include <string>
+#include <memory>
+#include <vector>
 #include "platform/CCFileStream.h"
 
 namespace cocos2d
@@ -133,10 +135,23 @@ public:
 
     virtual AUDIO_SOURCE_FORMAT getSourceFormat() const;
 
+    /**
+     * @brief Makes |open| decode the given encoded bytes instead of reading the file, the path is then only used
+     * for logging.
+     * @param data The whole content of the audio file, shared with the AudioCache keeping it.
+     */
+    void setSourceData(std::shared_ptr<const std::vector<char>> data) { _sourceData = std::move(data); }
+
+    /** Whether the decoder can decode the bytes given to |setSourceData|. */
+    virtual bool supportsSourceData() const { return true; }
+
 protected:
     AudioDecoder();
     virtual ~AudioDecoder();
 
+    /** Opens the encoded bytes, from the source data if any, from the file otherwise. */
+    std::unique_ptr<FileStream> openStream(std::string_view path) const;
+
     bool _isOpened;
     uint32_t _totalFrames;
     uint32_t _bytesPerBlock;  // Same as bytesPerFrame when _samplesPerBlock is 1
@@ -144,6 +159,7 @@ protected:
     uint32_t _sampleRate;
     uint32_t _channelCount;
     AUDIO_SOURCE_FORMAT _sourceFormat;
+    std::shared_ptr<const std::vector<char>> _sourceData;
 
     friend class AudioDecoderManager;
 };
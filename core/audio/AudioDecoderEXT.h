@@ -51,6 +51,9 @@ public:
      */
     bool open(std::string_view path) override;
 
+    /** ExtAudioFile reads the file by itself, the audio is always decoded from the file. */
+    bool supportsSourceData() const override { return false; }
+
     /**
      * @brief Closes opened audio file.
      * @note The method will also be automatically invoked in the destructor.
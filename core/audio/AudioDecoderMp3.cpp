@@ -131,7 +131,7 @@ bool AudioDecoderMp3::open(std::string_view fullPath)
 #if !CC_USE_MPG123
     do
     {
-        _fileStream = FileUtils::getInstance()->openFileStream(fullPath, FileStream::Mode::READ);
+        _fileStream = openStream(fullPath);
         if (!_fileStream)
         {
             ALOGE("Trouble with minimp3(1): %s\n", strerror(errno));
@@ -185,7 +185,8 @@ bool AudioDecoderMp3::open(std::string_view fullPath)
             break;
         }
 
-        if (!_fileStream.open(fullPath))
+        _fileStream = openStream(fullPath);
+        if (!_fileStream)
         {
             ALOGE("Trouble with mpg123(1): %s\n", strerror(errno));
             break;
@@ -193,7 +194,7 @@ bool AudioDecoderMp3::open(std::string_view fullPath)
 
         mpg123_replace_reader_handle(_handle, mpg123_read_r, mpg123_lseek_r, mpg123_close_r);
 
-        if (mpg123_open_handle(_handle, _fileStream) != MPG123_OK ||
+        if (mpg123_open_handle(_handle, _fileStream.get()) != MPG123_OK ||
             mpg123_getformat(_handle, &rate, &channel, &mp3Encoding) != MPG123_OK)
         {
             ALOGE("Trouble with mpg123(2): %s\n", mpg123_strerror(_handle));
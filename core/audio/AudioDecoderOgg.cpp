@@ -72,7 +72,7 @@ AudioDecoderOgg::~AudioDecoderOgg()
 
 bool AudioDecoderOgg::open(std::string_view fullPath)
 {
-    auto fs = FileUtils::getInstance()->openFileStream(fullPath, FileStream::Mode::READ).release();
+    auto fs = openStream(fullPath).release();
     if (!fs)
     {
         ALOGE("Trouble with ogg(1): %s\n", strerror(errno));
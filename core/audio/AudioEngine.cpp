@@ -51,6 +51,9 @@ hlookup::string_map<std::list<AUDIO_ID>> AudioEngine::_audioPathIDMap;
 // profileName,ProfileHelper
 hlookup::string_map<AudioEngine::ProfileHelper> AudioEngine::_audioPathProfileHelperMap;
 unsigned int AudioEngine::_maxInstances                        = MAX_AUDIOINSTANCES;
+size_t AudioEngine::_cacheBudget                               = 0;
+unsigned int AudioEngine::_pcmCacheMaxSize                     = PCMDATA_CACHEMAXSIZE;
+unsigned int AudioEngine::_compressedCacheMaxSize              = 0;
 AudioEngine::ProfileHelper* AudioEngine::_defaultProfileHelper = nullptr;
 std::unordered_map<AUDIO_ID, AudioEngine::AudioInfo> AudioEngine::_audioIDInfoMap;
 AudioEngineImpl* AudioEngine::_audioEngineImpl = nullptr;
@@ -427,6 +430,32 @@ void AudioEngine::uncacheAll()
     _audioEngineImpl->uncacheAll();
 }
 
+void AudioEngine::setCacheBudget(size_t bytes)
+{
+    _cacheBudget = bytes;
+    if (_audioEngineImpl)
+    {
+        _audioEngineImpl->evictCaches();
+    }
+}
+
+AudioCacheStats AudioEngine::getCacheStats()
+{
+    if (_audioEngineImpl)
+    {
+        return _audioEngineImpl->getCacheStats();
+    }
+    return AudioCacheStats();
+}
+
+void AudioEngine::resetCacheStats()
+{
+    if (_audioEngineImpl)
+    {
+        _audioEngineImpl->resetCacheStats();
+    }
+}
+
 float AudioEngine::getDuration(AUDIO_ID audioID)
 {
     auto it = _audioIDInfoMap.find(audioID);
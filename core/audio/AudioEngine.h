@@ -71,6 +71,28 @@ public:
     AudioProfile() : maxInstances(0), minDelay(0.0) {}
 };
 
+/**
+ * @class AudioCacheStats
+ *
+ * @brief Memory use and hit rate of the audio data cached by AudioEngine.
+ * @js NA
+ */
+struct CC_DLL AudioCacheStats
+{
+    // Number of audio files cached.
+    unsigned int cacheCount = 0;
+    // Cached files kept as encoded bytes and decoded on demand.
+    unsigned int compressedCount = 0;
+    // Bytes of audio data held by the caches.
+    size_t memoryUsed = 0;
+    // Preloads and plays that found their file cached already.
+    uint64_t hits = 0;
+    // Preloads and plays that had to load their file.
+    uint64_t misses = 0;
+    // Caches released to stay within the budget.
+    uint64_t evictions = 0;
+};
+
 class AudioEngineImpl;
 
 /**
@@ -262,6 +284,42 @@ public:
      */
     static void uncacheAll();
 
+    /**
+     * Sets how many bytes of audio data the caches may hold, 0 means no limit which is the default.
+     * When the budget is exceeded, the least recently used caches which aren't playing are uncached.
+     *
+     * @param bytes The budget in bytes.
+     */
+    static void setCacheBudget(size_t bytes);
+
+    /** Gets how many bytes of audio data the caches may hold. */
+    static size_t getCacheBudget() { return _cacheBudget; }
+
+    /**
+     * Sets the decoded size up to which an audio is cached as PCM, longer audio is streamed. 1MB by default.
+     * Only affects the audio loaded afterwards.
+     */
+    static void setPcmCacheMaxSize(unsigned int bytes) { _pcmCacheMaxSize = bytes; }
+
+    /** Gets the decoded size up to which an audio is cached as PCM. */
+    static unsigned int getPcmCacheMaxSize() { return _pcmCacheMaxSize; }
+
+    /**
+     * Sets the file size up to which a streamed audio keeps its encoded bytes in memory and is decoded from them on
+     * demand instead of being read from the file again, 0 disables it which is the default.
+     * Only affects the audio loaded afterwards, and isn't supported for the formats decoded by the system on Apple.
+     */
+    static void setCompressedCacheMaxSize(unsigned int bytes) { _compressedCacheMaxSize = bytes; }
+
+    /** Gets the file size up to which a streamed audio keeps its encoded bytes in memory. */
+    static unsigned int getCompressedCacheMaxSize() { return _compressedCacheMaxSize; }
+
+    /** Gets the memory use, hits and misses of the audio caches. */
+    static AudioCacheStats getCacheStats();
+
+    /** Resets the hit, miss and eviction counters of the audio caches. */
+    static void resetCacheStats();
+
     /**
      * Gets the audio profile by id of audio instance.
      *
@@ -353,6 +411,10 @@ protected:
 
     static unsigned int _maxInstances;
 
+    static size_t _cacheBudget;
+    static unsigned int _pcmCacheMaxSize;
+    static unsigned int _compressedCacheMaxSize;
+
     static ProfileHelper* _defaultProfileHelper;
 
     static AudioEngineImpl* _audioEngineImpl;
@@ -34,6 +34,7 @@
 #    include <queue>
 
 #    include "base/CCRef.h"
+#    include "audio/AudioEngine.h"
 #    include "audio/AudioMacros.h"
 #    include "audio/AudioCache.h"
 #    include "audio/AudioPlayer.h"
@@ -66,11 +67,17 @@ public:
     AudioCache* preload(std::string_view filePath, std::function<void(bool)> callback);
     void update(float dt);
 
+    // uncaches the least recently used caches nobody plays until they fit in AudioEngine's cache budget
+    void evictCaches();
+    AudioCacheStats getCacheStats() const;
+    void resetCacheStats();
+
 private:
     // query players state per frame and dispatch finish callback if possible
     void _updatePlayers(bool forStop);
     void _play2d(AudioCache* cache, AUDIO_ID audioID);
     void _unscheduleUpdate();
+    bool _isCacheInUse(AudioCache* cache);
     ALuint findValidSource();
 #    if defined(__APPLE__)
     static ALvoid myAlSourceNotificationCallback(ALuint sid, ALuint notificationID, ALvoid* userData);
@@ -83,6 +90,12 @@ private:
     // filePath,bufferInfo
     hlookup::string_map<std::unique_ptr<AudioCache>> _audioCaches;
 
+    // incremented by each preload, stamps AudioCache::_lastUsed
+    uint64_t _cacheUseCounter;
+    uint64_t _cacheHits;
+    uint64_t _cacheMisses;
+    uint64_t _cacheEvictions;
+
     // audioID,AudioInfo
     std::unordered_map<AUDIO_ID, AudioPlayer*> _audioPlayers;
     std::recursive_mutex _threadMutex;
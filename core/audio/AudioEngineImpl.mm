@@ -30,6 +30,7 @@
 
 #include "audio/AudioEngineImpl.h"
 #include "audio/AudioDecoderManager.h"
+#include "audio/AudioStreamService.h"
 
 #if CC_TARGET_PLATFORM == CC_PLATFORM_IOS || CC_TARGET_PLATFORM == CC_PLATFORM_MAC
 #    import <AVFoundation/AVFoundation.h>
@@ -245,22 +246,22 @@ ALvoid AudioEngineImpl::myAlSourceNotificationCallback(ALuint sid, ALuint notifi
     if (notificationID != AL_BUFFERS_PROCESSED)
         return;
 
-    AudioPlayer* player = nullptr;
-    s_instance->_threadMutex.lock();
-    for (const auto& e : s_instance->_audioPlayers)
-    {
-        player = e.second;
-        if (player->_alSource == sid && player->_streamingSource)
-        {
-            player->wakeupRotateThread();
-        }
-    }
-    s_instance->_threadMutex.unlock();
+    // All the streams are refilled by the same thread, don't take its locks here since OpenAL may call us while
+    // the streaming thread is inside an al call. The engine may be shutting the service down meanwhile, so don't
+    // create or use it past destroyInstance either
+    AudioStreamService::wakeupInstance();
 }
 
 #endif
 
-AudioEngineImpl::AudioEngineImpl() : _scheduled(false), _currentAudioID(0), _scheduler(nullptr)
+AudioEngineImpl::AudioEngineImpl()
+    : _cacheUseCounter(0)
+    , _cacheHits(0)
+    , _cacheMisses(0)
+    , _cacheEvictions(0)
+    , _scheduled(false)
+    , _currentAudioID(0)
+    , _scheduler(nullptr)
 {
     s_instance = this;
 }
@@ -272,6 +273,9 @@ AudioEngineImpl::~AudioEngineImpl()
         _scheduler->unschedule(CC_SCHEDULE_SELECTOR(AudioEngineImpl::update), this);
     }
 
+    // stop refilling the streams before their sources go away
+    AudioStreamService::destroyInstance();
+
     if (s_ALContext)
     {
         alDeleteSources(MAX_AUDIOINSTANCES, _alSources);
@@ -410,9 +414,15 @@ AudioCache* AudioEngineImpl::preload(std::string_view filePath, std::function<vo
     auto it = _audioCaches.find(filePath);
     if (it == _audioCaches.end())
     {
+        ++_cacheMisses;
+        // make room for the new audio before loading it
+        evictCaches();
+
         audioCache = new AudioCache();  // hlookup_second(it);
         _audioCaches.emplace(filePath, std::unique_ptr<AudioCache>(audioCache));
-        audioCache->_fileFullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
+        audioCache->_fileFullPath           = FileUtils::getInstance()->fullPathForFilename(filePath);
+        audioCache->_pcmCacheMaxSize        = AudioEngine::_pcmCacheMaxSize;
+        audioCache->_compressedCacheMaxSize = AudioEngine::_compressedCacheMaxSize;
         unsigned int cacheId      = audioCache->_id;
         auto isCacheDestroyed     = audioCache->_isDestroyed;
         AudioEngine::addTask([audioCache, cacheId, isCacheDestroyed]() {
@@ -427,8 +437,10 @@ AudioCache* AudioEngineImpl::preload(std::string_view filePath, std::function<vo
     }
     else
     {
+        ++_cacheHits;
         audioCache = it->second.get();
     }
+    audioCache->_lastUsed = ++_cacheUseCounter;
 
     if (audioCache && callback)
     {
@@ -776,6 +788,9 @@ void AudioEngineImpl::update(float /*dt*/)
 {
     std::unique_lock<std::recursive_mutex> lck(_threadMutex);
     _updatePlayers(false);
+
+    // the caches loaded since the last preload are accounted for once they finished loading
+    evictCaches();
 }
 
 void AudioEngineImpl::_updatePlayers(bool forStop)
@@ -862,6 +877,92 @@ void AudioEngineImpl::uncache(std::string_view filePath)
     _audioCaches.erase(filePath);
 }
 
+bool AudioEngineImpl::_isCacheInUse(AudioCache* cache)
+{
+    std::unique_lock<std::recursive_mutex> lck(_threadMutex);
+    for (auto& player : _audioPlayers)
+    {
+        if (player.second->_audioCache == cache)
+            return true;
+    }
+    return false;
+}
+
+void AudioEngineImpl::evictCaches()
+{
+    const size_t budget = AudioEngine::_cacheBudget;
+    if (budget == 0)
+        return;
+
+    size_t memoryUsed = 0;
+    // the most recently used cache is never evicted, a fresh preload larger than the budget would evict itself
+    AudioCache* newest = nullptr;
+    for (auto& e : _audioCaches)
+    {
+        auto cache = e.second.get();
+        if (!cache->_isLoadingFinished)
+            continue;
+        memoryUsed += cache->_memorySize;
+        if (!newest || cache->_lastUsed > newest->_lastUsed)
+            newest = cache;
+    }
+
+    while (memoryUsed > budget)
+    {
+        auto victim = _audioCaches.end();
+        for (auto it = _audioCaches.begin(); it != _audioCaches.end(); ++it)
+        {
+            auto cache = it->second.get();
+            if (!cache->_evictable || cache == newest || _isCacheInUse(cache))
+                continue;
+            if (victim == _audioCaches.end() || cache->_lastUsed < victim->second->_lastUsed)
+                victim = it;
+        }
+
+        // everything left is playing or loading
+        if (victim == _audioCaches.end())
+            break;
+
+        ALOGV("Evict audio cache %s, %u bytes", victim->first.c_str(), (unsigned int)victim->second->_memorySize);
+        memoryUsed -= victim->second->_memorySize;
+        _audioCaches.erase(victim);
+        ++_cacheEvictions;
+    }
+
+    // the load callbacks are dispatched on the cocos thread after loading finished, keep the caches until they ran
+    for (auto& e : _audioCaches)
+    {
+        auto cache = e.second.get();
+        if (cache->_isLoadingFinished && cache->_loadCallbacks.empty())
+            cache->_evictable = true;
+    }
+}
+
+AudioCacheStats AudioEngineImpl::getCacheStats() const
+{
+    AudioCacheStats stats;
+    for (auto& e : _audioCaches)
+    {
+        auto cache = e.second.get();
+        ++stats.cacheCount;
+        if (cache->_compressedData)
+            ++stats.compressedCount;
+        if (cache->_isLoadingFinished)
+            stats.memoryUsed += cache->_memorySize;
+    }
+    stats.hits      = _cacheHits;
+    stats.misses    = _cacheMisses;
+    stats.evictions = _cacheEvictions;
+    return stats;
+}
+
+void AudioEngineImpl::resetCacheStats()
+{
+    _cacheHits      = 0;
+    _cacheMisses    = 0;
+    _cacheEvictions = 0;
+}
+
 void AudioEngineImpl::uncacheAll()
 {
     // prevent player hold invalid AudioCache* pointer, since all audio caches purged
@@ -34,6 +34,9 @@
 #define QUEUEBUFFER_NUM (3)
 #define QUEUEBUFFER_TIME_STEP (0.05f)
 
+// default decoded size up to which an audio is kept in a single OpenAL buffer instead of being streamed
+#define PCMDATA_CACHEMAXSIZE 1048576
+
 #define QUOTEME_(x) #x
 #define QUOTEME(x) QUOTEME_(x)
 
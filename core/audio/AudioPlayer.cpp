@@ -33,6 +33,10 @@
 #include "platform/CCFileUtils.h"
 #include "audio/AudioDecoder.h"
 #include "audio/AudioDecoderManager.h"
+#include "audio/AudioStreamService.h"
+
+#include <chrono>
+#include <thread>
 
 #ifdef VERY_VERY_VERBOSE_LOGGING
 #    define ALOGVV ALOGV
@@ -58,12 +62,11 @@ AudioPlayer::AudioPlayer()
     , _ready(false)
     , _currTime(0.0f)
     , _streamingSource(false)
-    , _rotateBufferThread(nullptr)
     , _timeDirty(false)
-    , _isRotateThreadExited(false)
-#if defined(__APPLE__)
-    , _needWakeupRotateThread(false)
-#endif
+    , _streamDecoder(nullptr)
+    , _streamOffsetFrame(0)
+    , _streamServiced(false)
+    , _streamFinished(false)
     , _id(++__idIndex)
 {
     memset(_bufferIds, 0, sizeof(_bufferIds));
@@ -73,6 +76,7 @@ AudioPlayer::~AudioPlayer()
 {
     ALOGVV("~AudioPlayer() (%p), id=%u", this, _id);
     destroy();
+    closeStream();
 
     if (_streamingSource)
     {
@@ -108,22 +112,11 @@ void AudioPlayer::destroy()
 
         if (_streamingSource)
         {
-            if (_rotateBufferThread != nullptr)
+            if (_streamServiced)
             {
-                while (!_isRotateThreadExited)
-                {
-                    _sleepCondition.notify_one();
-                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
-                }
-
-                if (_rotateBufferThread->joinable())
-                {
-                    _rotateBufferThread->join();
-                }
-
-                delete _rotateBufferThread;
-                _rotateBufferThread = nullptr;
-                ALOGVV("rotateBufferThread exited!");
+                AudioStreamService::getInstance()->removePlayer(this);
+                _streamServiced = false;
+                ALOGVV("stream removed from AudioStreamService!");
 
 #if CC_TARGET_PLATFORM == CC_PLATFORM_IOS
                 // some specific OpenAL implement defects existed on iOS platform
@@ -225,28 +218,20 @@ bool AudioPlayer::play2d()
             _streamingSource = true;
         }
 
+        if (_streamingSource)
         {
-            std::unique_lock<std::mutex> lk(_sleepMutex);
-            if (_isDestroyed)
-                break;
-
-            if (_streamingSource)
-            {
-                // To continuously stream audio from a source without interruption, buffer queuing is required.
-                alSourceQueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
-                CHECK_AL_ERROR_DEBUG();
-                _rotateBufferThread = new std::thread(&AudioPlayer::rotateBufferThread, this,
-                                                      _audioCache->_queBufferFrames * QUEUEBUFFER_NUM + 1);
-            }
-            else
-            {
-                alSourcei(_alSource, AL_BUFFER, _audioCache->_alBufferId);
-                CHECK_AL_ERROR_DEBUG();
-            }
-
-            alSourcePlay(_alSource);
+            // To continuously stream audio from a source without interruption, buffer queuing is required.
+            alSourceQueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
+            CHECK_AL_ERROR_DEBUG();
+        }
+        else
+        {
+            alSourcei(_alSource, AL_BUFFER, _audioCache->_alBufferId);
+            CHECK_AL_ERROR_DEBUG();
         }
 
+        alSourcePlay(_alSource);
+
         auto alError = alGetError();
         if (alError != AL_NO_ERROR)
         {
@@ -254,6 +239,14 @@ bool AudioPlayer::play2d()
             break;
         }
 
+        if (_streamingSource)
+        {
+            // the remaining frames are decoded by the shared streaming thread
+            _streamOffsetFrame = _audioCache->_queBufferFrames * QUEUEBUFFER_NUM + 1;
+            _streamServiced    = true;
+            AudioStreamService::getInstance()->addPlayer(this);
+        }
+
         ALint state;
         alGetSourcei(_alSource, AL_SOURCE_STATE, &state);
         if (state != AL_PLAYING)
@@ -275,163 +268,149 @@ bool AudioPlayer::play2d()
     return ret;
 }
 
-// rotateBufferThread is used to rotate alBufferData for _alSource when playing big audio file
-void AudioPlayer::rotateBufferThread(int offsetFrame)
+// updateStream rotates alBufferData for _alSource when playing big audio file, it's called by the AudioStreamService
+// thread every time it wakes up
+bool AudioPlayer::updateStream(std::vector<char>& decodeBuffer, AudioStreamService* service)
 {
-#if defined(__APPLE__)
-    pthread_setname_np("ALStreaming");
-#endif
+    if (_isDestroyed)
+        return false;
 
-    char* tmpBuffer           = nullptr;
-    auto& fullPath            = _audioCache->_fileFullPath;
-    AudioDecoder* decoder     = AudioDecoderManager::createDecoder(fullPath);
-    long long rotateSleepTime = static_cast<long long>(QUEUEBUFFER_TIME_STEP * 1000) / 2;
-    do
+    auto& fullPath = _audioCache->_fileFullPath;
+    if (_streamDecoder == nullptr)
     {
-        BREAK_IF(decoder == nullptr || !decoder->open(fullPath));
-
-        uint32_t framesRead         = 0;
-        const uint32_t framesToRead = _audioCache->_queBufferFrames;
-        const uint32_t bufferSize   = decoder->framesToBytes(framesToRead);
-#if CC_USE_ALSOFT
-        const auto sourceFormat = decoder->getSourceFormat();
-#endif
-        tmpBuffer = (char*)malloc(bufferSize);
-        memset(tmpBuffer, 0, bufferSize);
+        _streamDecoder = AudioDecoderManager::createDecoder(fullPath);
+        if (_streamDecoder && _audioCache->_compressedData)
+            _streamDecoder->setSourceData(_audioCache->_compressedData);
+        if (_streamDecoder == nullptr || !_streamDecoder->open(fullPath))
+            return false;
 
-        if (offsetFrame != 0)
+        if (_streamOffsetFrame != 0)
         {
-            decoder->seek(offsetFrame);
+            _streamDecoder->seek(_streamOffsetFrame);
         }
+    }
 
-        ALint sourceState;
-        ALint bufferProcessed = 0;
-        bool needToExitThread = false;
+    AudioDecoder* decoder       = _streamDecoder;
+    uint32_t framesRead         = 0;
+    const uint32_t framesToRead = _audioCache->_queBufferFrames;
+    const uint32_t bufferSize   = decoder->framesToBytes(framesToRead);
+#if CC_USE_ALSOFT
+    const auto sourceFormat = decoder->getSourceFormat();
+#endif
+    if (decodeBuffer.size() < bufferSize)
+        decodeBuffer.resize(bufferSize);
+    char* tmpBuffer = decodeBuffer.data();
+
+    ALint sourceState;
+    ALint bufferProcessed = 0;
+    bool needToExitStream = false;
 
-        while (!_isDestroyed)
+    alGetSourcei(_alSource, AL_SOURCE_STATE, &sourceState);
+    if (sourceState == AL_PLAYING)
+    {
+        alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
+        while (bufferProcessed > 0)
         {
-            alGetSourcei(_alSource, AL_SOURCE_STATE, &sourceState);
-            if (sourceState == AL_PLAYING)
+            bufferProcessed--;
+            if (_timeDirty)
             {
-                alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
-                while (bufferProcessed > 0)
+                _timeDirty         = false;
+                _streamOffsetFrame = _currTime * decoder->getSampleRate();
+                decoder->seek(_streamOffsetFrame);
+            }
+            else
+            {
+                _currTime += QUEUEBUFFER_TIME_STEP;
+                if (_currTime > _audioCache->_duration)
                 {
-                    bufferProcessed--;
-                    if (_timeDirty)
+                    if (_loop)
                     {
-                        _timeDirty  = false;
-                        offsetFrame = _currTime * decoder->getSampleRate();
-                        decoder->seek(offsetFrame);
+                        _currTime = 0.0f;
                     }
                     else
                     {
-                        _currTime += QUEUEBUFFER_TIME_STEP;
-                        if (_currTime > _audioCache->_duration)
-                        {
-                            if (_loop)
-                            {
-                                _currTime = 0.0f;
-                            }
-                            else
-                            {
-                                _currTime = _audioCache->_duration;
-                            }
-                        }
-                    }
-
-                    framesRead = decoder->readFixedFrames(framesToRead, tmpBuffer);
-
-                    if (framesRead == 0)
-                    {
-                        if (_loop)
-                        {
-                            decoder->seek(0);
-                            framesRead = decoder->readFixedFrames(framesToRead, tmpBuffer);
-                        }
-                        else
-                        {
-                            needToExitThread = true;
-                            break;
-                        }
+                        _currTime = _audioCache->_duration;
                     }
-                    /*
-                     While the source is playing, alSourceUnqueueBuffers can be called to remove buffers which have
-                     already played. Those buffers can then be filled with new data or discarded. New or refilled
-                     buffers can then be attached to the playing source using alSourceQueueBuffers. As long as there is
-                     always a new buffer to play in the queue, the source will continue to play.
-                     */
-                    ALuint bid;
-                    alSourceUnqueueBuffers(_alSource, 1, &bid);
-#if CC_USE_ALSOFT
-                    if (sourceFormat == AUDIO_SOURCE_FORMAT::ADPCM || sourceFormat == AUDIO_SOURCE_FORMAT::IMA_ADPCM)
-                        alBufferi(bid, AL_UNPACK_BLOCK_ALIGNMENT_SOFT, decoder->getSamplesPerBlock());
-#endif
-                    alBufferData(bid, _audioCache->_format, tmpBuffer, decoder->framesToBytes(framesRead),
-                                 decoder->getSampleRate());
-                    alSourceQueueBuffers(_alSource, 1, &bid);
                 }
             }
-            /* Make sure the source hasn't underrun */
-            else if (sourceState != AL_PAUSED)
-            {
-                ALint queued;
 
-                /* If no buffers are queued, playback is finished */
-                alGetSourcei(_alSource, AL_BUFFERS_QUEUED, &queued);
-                if (queued == 0)
+            auto decodeStart = std::chrono::steady_clock::now();
+            framesRead       = decoder->readFixedFrames(framesToRead, tmpBuffer);
+
+            if (framesRead == 0)
+            {
+                if (_loop)
                 {
-                    needToExitThread = true;
+                    decoder->seek(0);
+                    framesRead = decoder->readFixedFrames(framesToRead, tmpBuffer);
                 }
                 else
                 {
-                    alSourcePlay(_alSource);
-                    if (alGetError() != AL_NO_ERROR)
-                    {
-                        ALOGE("Error restarting playback!");
-                        needToExitThread = true;
-                    }
+                    needToExitStream = true;
+                    break;
                 }
             }
+            service->recordDecode(std::chrono::duration_cast<std::chrono::microseconds>(
+                                      std::chrono::steady_clock::now() - decodeStart)
+                                      .count());
+            /*
+             While the source is playing, alSourceUnqueueBuffers can be called to remove buffers which have
+             already played. Those buffers can then be filled with new data or discarded. New or refilled
+             buffers can then be attached to the playing source using alSourceQueueBuffers. As long as there is
+             always a new buffer to play in the queue, the source will continue to play.
+             */
+            ALuint bid;
+            alSourceUnqueueBuffers(_alSource, 1, &bid);
+#if CC_USE_ALSOFT
+            if (sourceFormat == AUDIO_SOURCE_FORMAT::ADPCM || sourceFormat == AUDIO_SOURCE_FORMAT::IMA_ADPCM)
+                alBufferi(bid, AL_UNPACK_BLOCK_ALIGNMENT_SOFT, decoder->getSamplesPerBlock());
+#endif
+            alBufferData(bid, _audioCache->_format, tmpBuffer, decoder->framesToBytes(framesRead),
+                         decoder->getSampleRate());
+            alSourceQueueBuffers(_alSource, 1, &bid);
+        }
+    }
+    /* Make sure the source hasn't underrun */
+    else if (sourceState != AL_PAUSED)
+    {
+        ALint queued;
 
-            std::unique_lock<std::mutex> lk(_sleepMutex);
-            if (_isDestroyed || needToExitThread)
-            {
-                break;
-            }
-#if defined(__APPLE__)
-            if (!_needWakeupRotateThread)
+        /* If no buffers are queued, playback is finished */
+        alGetSourcei(_alSource, AL_BUFFERS_QUEUED, &queued);
+        if (queued == 0)
+        {
+            needToExitStream = true;
+        }
+        else
+        {
+            service->recordUnderrun();
+            alSourcePlay(_alSource);
+            if (alGetError() != AL_NO_ERROR)
             {
-                _sleepCondition.wait_for(lk, std::chrono::milliseconds(rotateSleepTime));
+                ALOGE("Error restarting playback!");
+                needToExitStream = true;
             }
-
-            _needWakeupRotateThread = false;
-#else
-            _sleepCondition.wait_for(lk, std::chrono::milliseconds(rotateSleepTime));
-#endif
         }
+    }
 
-    } while (false);
-
-    ALOGVV("Exit rotate buffer thread ...");
-    if (decoder)
-        decoder->close();
-    AudioDecoderManager::destroyDecoder(decoder);
-    free(tmpBuffer);
-    _isRotateThreadExited = true;
+    return !needToExitStream;
 }
 
-#if defined(__APPLE__)
-void AudioPlayer::wakeupRotateThread()
+void AudioPlayer::closeStream()
 {
-    _needWakeupRotateThread = true;
-    _sleepCondition.notify_all();
+    if (_streamDecoder)
+    {
+        ALOGVV("Close stream decoder, id=%u", _id);
+        _streamDecoder->close();
+        AudioDecoderManager::destroyDecoder(_streamDecoder);
+        _streamDecoder = nullptr;
+    }
 }
-#endif
 
 bool AudioPlayer::isFinished() const
 {
     if (_streamingSource)
-        return _isRotateThreadExited;
+        return _streamFinished;
     else
     {
         ALint sourceState;
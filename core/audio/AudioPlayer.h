@@ -29,10 +29,10 @@
 
 #include "platform/CCPlatformConfig.h"
 
+#include <atomic>
 #include <string>
-#include <condition_variable>
 #include <mutex>
-#include <thread>
+#include <vector>
 
 #include "audio/AudioMacros.h"
 #include "platform/CCPlatformMacros.h"
@@ -41,7 +41,9 @@
 NS_CC_BEGIN
 
 class AudioCache;
+class AudioDecoder;
 class AudioEngineImpl;
+class AudioStreamService;
 
 class CC_DLL AudioPlayer
 {
@@ -62,11 +64,11 @@ public:
 
 protected:
     void setCache(AudioCache* cache);
-    void rotateBufferThread(int offsetFrame);
     bool play2d();
-#if defined(__APPLE__)
-    void wakeupRotateThread();
-#endif
+
+    // called by the AudioStreamService thread, returns false once the stream is over
+    bool updateStream(std::vector<char>& decodeBuffer, AudioStreamService* service);
+    void closeStream();
 
     AudioCache* _audioCache;
 
@@ -83,19 +85,19 @@ protected:
     float _currTime;
     bool _streamingSource;
     ALuint _bufferIds[QUEUEBUFFER_NUM];
-    std::thread* _rotateBufferThread;
-    std::condition_variable _sleepCondition;
-    std::mutex _sleepMutex;
     bool _timeDirty;
-    bool _isRotateThreadExited;
-#if defined(__APPLE__)
-    std::atomic_bool _needWakeupRotateThread;
-#endif
+
+    // streaming state, owned by the AudioStreamService thread while the player is serviced
+    AudioDecoder* _streamDecoder;
+    int _streamOffsetFrame;
+    bool _streamServiced;
+    std::atomic_bool _streamFinished;
 
     std::mutex _play2dMutex;
 
     unsigned int _id;
     friend class AudioEngineImpl;
+    friend class AudioStreamService;
 };
 
 NS_CC_END
@@ -0,0 +1,237 @@
+/****************************************************************************
+ Copyright (c) 2021 Bytedance Inc.
+
+ https://adxeproject.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#define LOG_TAG "AudioStreamService"
+
+#include "audio/AudioStreamService.h"
+#include "audio/AudioPlayer.h"
+#include "audio/AudioMacros.h"
+
+#include <algorithm>
+#include <chrono>
+
+NS_CC_BEGIN
+
+namespace
+{
+// enough for QUEUEBUFFER_TIME_STEP of 48kHz stereo float samples, grown on demand by the streams
+const size_t DECODE_BUFFER_RESERVE = 64 * 1024;
+}  // namespace
+
+AudioStreamService* AudioStreamService::s_instance = nullptr;
+std::mutex AudioStreamService::s_instanceMutex;
+
+AudioStreamService* AudioStreamService::getInstance()
+{
+    std::lock_guard<std::mutex> lock(s_instanceMutex);
+    if (s_instance == nullptr)
+    {
+        s_instance = new AudioStreamService();
+    }
+    return s_instance;
+}
+
+void AudioStreamService::destroyInstance()
+{
+    AudioStreamService* instance = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(s_instanceMutex);
+        std::swap(instance, s_instance);
+    }
+    // joining the thread may wait for an OpenAL callback, so the mutex must not be held meanwhile
+    delete instance;
+}
+
+void AudioStreamService::wakeupInstance()
+{
+    // the service thread never takes s_instanceMutex, so an OpenAL callback can't deadlock on it
+    std::lock_guard<std::mutex> lock(s_instanceMutex);
+    if (s_instance)
+    {
+        s_instance->wakeup();
+    }
+}
+
+AudioStreamService::AudioStreamService()
+    : _stop(false)
+    , _wakeupRequested(false)
+    , _decodeBuffer(DECODE_BUFFER_RESERVE)
+    , _wakeups(0)
+    , _buffersQueued(0)
+    , _underruns(0)
+    , _decodeTimeTotal(0)
+    , _decodeTimeMax(0)
+{
+    _thread = std::thread(&AudioStreamService::run, this);
+}
+
+AudioStreamService::~AudioStreamService()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _condition.notify_one();
+
+    if (_thread.joinable())
+    {
+        _thread.join();
+    }
+}
+
+void AudioStreamService::addPlayer(AudioPlayer* player)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _players.push_back(player);
+    }
+    _condition.notify_one();
+}
+
+void AudioStreamService::removePlayer(AudioPlayer* player)
+{
+    // wait for the current refill to finish so the player isn't used after this returns
+    std::lock_guard<std::mutex> serviceLock(_serviceMutex);
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto iter = std::find(_players.begin(), _players.end(), player);
+        if (iter != _players.end())
+        {
+            _players.erase(iter);
+            found = true;
+        }
+    }
+
+    if (found)
+    {
+        player->closeStream();
+        player->_streamFinished = true;
+    }
+}
+
+void AudioStreamService::wakeup()
+{
+    // may be called from an OpenAL callback, so don't take any lock of the instance
+    _wakeupRequested = true;
+    _condition.notify_one();
+}
+
+AudioStreamService::Stats AudioStreamService::getStats() const
+{
+    Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        stats.streams = static_cast<unsigned int>(_players.size());
+    }
+    stats.wakeups         = _wakeups;
+    stats.buffersQueued   = _buffersQueued;
+    stats.underruns       = _underruns;
+    stats.decodeTimeTotal = _decodeTimeTotal;
+    stats.decodeTimeMax   = _decodeTimeMax;
+    return stats;
+}
+
+void AudioStreamService::resetStats()
+{
+    _wakeups         = 0;
+    _buffersQueued   = 0;
+    _underruns       = 0;
+    _decodeTimeTotal = 0;
+    _decodeTimeMax   = 0;
+}
+
+void AudioStreamService::recordDecode(uint64_t microseconds)
+{
+    ++_buffersQueued;
+    _decodeTimeTotal += microseconds;
+
+    uint64_t currentMax = _decodeTimeMax;
+    while (microseconds > currentMax && !_decodeTimeMax.compare_exchange_weak(currentMax, microseconds))
+    {
+    }
+}
+
+void AudioStreamService::run()
+{
+#if defined(__APPLE__)
+    pthread_setname_np("ALStreaming");
+#endif
+
+    const auto interval = std::chrono::milliseconds(static_cast<long long>(QUEUEBUFFER_TIME_STEP * 1000) / 2);
+    std::vector<AudioPlayer*> players;
+    std::vector<AudioPlayer*> finished;
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_stop)
+    {
+        if (_players.empty())
+        {
+            _condition.wait(lock, [this] { return _stop || !_players.empty(); });
+            continue;
+        }
+        lock.unlock();
+
+        {
+            std::lock_guard<std::mutex> serviceLock(_serviceMutex);
+            {
+                // players removed while we waited for _serviceMutex are gone from the list already
+                std::lock_guard<std::mutex> listLock(_mutex);
+                players = _players;
+            }
+
+            ++_wakeups;
+            for (auto player : players)
+            {
+                if (!player->updateStream(_decodeBuffer, this))
+                    finished.push_back(player);
+            }
+
+            if (!finished.empty())
+            {
+                {
+                    std::lock_guard<std::mutex> listLock(_mutex);
+                    for (auto player : finished)
+                        _players.erase(std::find(_players.begin(), _players.end(), player));
+                }
+
+                for (auto player : finished)
+                {
+                    player->closeStream();
+                    player->_streamFinished = true;
+                }
+                finished.clear();
+            }
+        }
+
+        lock.lock();
+        if (!_stop && !_wakeupRequested)
+        {
+            _condition.wait_for(lock, interval, [this] { return _stop || _wakeupRequested.load(); });
+        }
+        _wakeupRequested = false;
+    }
+}
+
+NS_CC_END
@@ -0,0 +1,121 @@
+/****************************************************************************
+ Copyright (c) 2021 Bytedance Inc.
+
+ https://adxeproject.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "platform/CCPlatformConfig.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "platform/CCPlatformMacros.h"
+
+NS_CC_BEGIN
+
+class AudioPlayer;
+
+/**
+ * Refills the OpenAL buffer queues of every streamed AudioPlayer from one thread.
+ *
+ * The thread wakes up every QUEUEBUFFER_TIME_STEP / 2 seconds, or earlier when OpenAL reports processed buffers, and
+ * decodes the next chunk of each stream into a scratch buffer shared by all of them.
+ */
+class CC_DLL AudioStreamService
+{
+public:
+    struct Stats
+    {
+        /** Streams currently serviced. */
+        unsigned int streams = 0;
+        /** Times the service thread woke up to refill the queues. */
+        uint64_t wakeups = 0;
+        /** Buffers decoded and queued. */
+        uint64_t buffersQueued = 0;
+        /** Times a stream ran out of queued buffers and had to be restarted. */
+        uint64_t underruns = 0;
+        /** Time spent decoding, in microseconds. */
+        uint64_t decodeTimeTotal = 0;
+        uint64_t decodeTimeMax = 0;
+    };
+
+    static AudioStreamService* getInstance();
+    static void destroyInstance();
+
+    /**
+     * Wakes the service thread of the current instance up, does nothing when there is no instance.
+     * Unlike getInstance()->wakeup(), it's safe to call from any thread, even while the instance is destroyed.
+     */
+    static void wakeupInstance();
+
+    /** Starts refilling the buffers queued on the player's source, the stream is opened on the service thread. */
+    void addPlayer(AudioPlayer* player);
+
+    /** Stops servicing the player, returns once the service thread doesn't touch it anymore. */
+    void removePlayer(AudioPlayer* player);
+
+    /** Wakes the service thread up before its next scheduled refill. */
+    void wakeup();
+
+    Stats getStats() const;
+    void resetStats();
+
+    /** Counts a buffer decoded and queued by a player, with the time its decoding took. */
+    void recordDecode(uint64_t microseconds);
+    /** Counts a player found stopped with buffers still queued. */
+    void recordUnderrun() { ++_underruns; }
+
+protected:
+    AudioStreamService();
+    ~AudioStreamService();
+
+    void run();
+
+    std::thread _thread;
+    // guards _players and _stop
+    mutable std::mutex _mutex;
+    // held while the players are serviced
+    std::mutex _serviceMutex;
+    std::condition_variable _condition;
+    std::vector<AudioPlayer*> _players;
+    bool _stop;
+    std::atomic_bool _wakeupRequested;
+
+    // decode buffer shared by all the streams, only used by the service thread
+    std::vector<char> _decodeBuffer;
+
+    std::atomic<uint64_t> _wakeups;
+    std::atomic<uint64_t> _buffersQueued;
+    std::atomic<uint64_t> _underruns;
+    std::atomic<uint64_t> _decodeTimeTotal;
+    std::atomic<uint64_t> _decodeTimeMax;
+
+    static AudioStreamService* s_instance;
+    // guards s_instance, only held to create, clear or wake up the instance
+    static std::mutex s_instanceMutex;
+};
+
+NS_CC_END
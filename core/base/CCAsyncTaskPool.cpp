@@ -45,8 +45,48 @@ void AsyncTaskPool::destroyInstance()
     s_asyncTaskPool = nullptr;
 }
 
-AsyncTaskPool::AsyncTaskPool() {}
+AsyncTaskPool::AsyncTaskPool() : _ioQueue(std::make_shared<SerialQueue>())
+{
+    for (auto& generation : _generations)
+        generation = std::make_shared<Generation>(0);
+}
+
+AsyncTaskPool::~AsyncTaskPool()
+{
+    for (auto& generation : _generations)
+        ++*generation;
+}
 
-AsyncTaskPool::~AsyncTaskPool() {}
+void AsyncTaskPool::enqueueSerial(std::function<void()> task)
+{
+    auto queue = _ioQueue;
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->tasks.push_back(std::move(task));
+        if (queue->draining)
+            return;
+        queue->draining = true;
+    }
+
+    JobSystem::getInstance()->submit(
+        [queue] {
+            for (;;)
+            {
+                std::function<void()> next;
+                {
+                    std::lock_guard<std::mutex> lock(queue->mutex);
+                    if (queue->tasks.empty())
+                    {
+                        queue->draining = false;
+                        return;
+                    }
+                    next = std::move(queue->tasks.front());
+                    queue->tasks.pop_front();
+                }
+                next();
+            }
+        },
+        JobSystem::Priority::LOW);
+}
 
 NS_CC_END
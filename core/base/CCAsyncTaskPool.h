@@ -29,8 +29,11 @@ THE SOFTWARE.
 #include "platform/CCPlatformMacros.h"
 #include "base/CCDirector.h"
 #include "base/CCScheduler.h"
+#include "base/CCJobSystem.h"
+#include <atomic>
 #include <vector>
 #include <queue>
+#include <deque>
 #include <memory>
 #include <thread>
 #include <mutex>
@@ -48,6 +51,8 @@ NS_CC_BEGIN
 /**
  * @class AsyncTaskPool
  * @brief This class allows to perform background operations without having to manipulate threads.
+ * Tasks run on the shared JobSystem: io and network tasks at low priority, other tasks at normal priority. Io tasks
+ * still run one at a time in the order they were enqueued, network and other tasks may run concurrently.
  * @js NA
  */
 class CC_DLL AsyncTaskPool
@@ -69,12 +74,12 @@ public:
     static AsyncTaskPool* getInstance();
 
     /**
-     * Destroys the async task pool.
+     * Destroys the async task pool, tasks not started yet are dropped.
      */
     static void destroyInstance();
 
     /**
-     * Stop tasks.
+     * Stop tasks. Tasks of this type that haven't started yet are dropped along with their callbacks.
      *
      * @param type Task type you want to stop.
      */
@@ -83,7 +88,7 @@ public:
     /**
      * Enqueue a asynchronous task.
      *
-     * @param type task type is io task, network task or others, each type of task has a thread to deal with it.
+     * @param type task type is io task, network task or others, it selects the job priority.
      * @param callback callback when the task is finished. The callback is called in the main thread instead of task
      * thread.
      * @param callbackParam parameter used by the callback.
@@ -95,7 +100,7 @@ public:
     /**
      * Enqueue a asynchronous task.
      *
-     * @param type task type is io task, network task or others, each type of task has a thread to deal with it.
+     * @param type task type is io task, network task or others, it selects the job priority.
      * @param task: task can be lambda function to be performed off thread.
      * @lua NA
      */
@@ -105,108 +110,29 @@ public:
     ~AsyncTaskPool();
 
 protected:
-    // thread tasks internally used
-    class ThreadTasks
+    // bumped by stopTasks(), queued tasks of an older generation are skipped. Shared with the queued jobs since
+    // they may outlive the pool.
+    typedef std::atomic<unsigned int> Generation;
+    std::shared_ptr<Generation> _generations[int(TaskType::TASK_MAX_TYPE)];
+
+    // io tasks wait here and a single job drains them in order, io callers rely on the serial execution of the
+    // former io thread. Shared with the draining job since it may outlive the pool.
+    struct SerialQueue
     {
-        struct AsyncTaskCallBack
-        {
-            TaskCallBack callback;
-            void* callbackParam;
-        };
-
-    public:
-        ThreadTasks() : _stop(false)
-        {
-            _thread = std::thread([this] {
-                for (;;)
-                {
-                    std::function<void()> task;
-                    AsyncTaskCallBack callback;
-                    {
-                        std::unique_lock<std::mutex> lock(this->_queueMutex);
-                        this->_condition.wait(lock, [this] { return this->_stop || !this->_tasks.empty(); });
-                        if (this->_stop && this->_tasks.empty())
-                            return;
-                        task     = std::move(this->_tasks.front());
-                        callback = std::move(this->_taskCallBacks.front());
-                        this->_tasks.pop();
-                        this->_taskCallBacks.pop();
-                    }
-
-                    task();
-                    Director::getInstance()->getScheduler()->performFunctionInCocosThread(
-                        std::bind(callback.callback, callback.callbackParam));
-                }
-            });
-        }
-        ~ThreadTasks()
-        {
-            {
-                std::unique_lock<std::mutex> lock(_queueMutex);
-                _stop = true;
-
-                while (_tasks.size())
-                    _tasks.pop();
-                while (_taskCallBacks.size())
-                    _taskCallBacks.pop();
-            }
-            _condition.notify_all();
-            _thread.join();
-        }
-        void clear()
-        {
-            std::unique_lock<std::mutex> lock(_queueMutex);
-            while (_tasks.size())
-                _tasks.pop();
-            while (_taskCallBacks.size())
-                _taskCallBacks.pop();
-        }
-
-        void enqueue(TaskCallBack callback, void* callbackParam, std::function<void()> task)
-        {
-            AsyncTaskCallBack taskCallBack;
-            taskCallBack.callback      = std::move(callback);
-            taskCallBack.callbackParam = callbackParam;
-
-            {
-                std::unique_lock<std::mutex> lock(_queueMutex);
-
-                // don't allow enqueueing after stopping the pool
-                if (_stop)
-                {
-                    CC_ASSERT(0 && "already stop");
-                    return;
-                }
-
-                _tasks.push(std::move(task));
-                _taskCallBacks.push(std::move(taskCallBack));
-            }
-            _condition.notify_one();
-        }
-
-    private:
-        // need to keep track of thread so we can join them
-        std::thread _thread;
-        // the task queue
-        std::queue<std::function<void()>> _tasks;
-        std::queue<AsyncTaskCallBack> _taskCallBacks;
-
-        // synchronization
-        std::mutex _queueMutex;
-        std::condition_variable _condition;
-        bool _stop;
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+        bool draining = false;
     };
+    std::shared_ptr<SerialQueue> _ioQueue;
 
-    // tasks
-    ThreadTasks _threadTasks[int(TaskType::TASK_MAX_TYPE)];
+    void enqueueSerial(std::function<void()> task);
 
     static AsyncTaskPool* s_asyncTaskPool;
 };
 
 inline void AsyncTaskPool::stopTasks(TaskType type)
 {
-    auto& threadTask = _threadTasks[(int)type];
-    threadTask.clear();
+    ++*_generations[(int)type];
 }
 
 inline void AsyncTaskPool::enqueue(AsyncTaskPool::TaskType type,
@@ -214,9 +140,23 @@ inline void AsyncTaskPool::enqueue(AsyncTaskPool::TaskType type,
                                    void* callbackParam,
                                    std::function<void()> task)
 {
-    auto& threadTask = _threadTasks[(int)type];
+    auto generation             = _generations[(int)type];
+    unsigned int taskGeneration = generation->load();
 
-    threadTask.enqueue(std::move(callback), callbackParam, std::move(task));
+    auto job = [generation, taskGeneration, callback = std::move(callback), callbackParam, task = std::move(task)] {
+        if (generation->load() != taskGeneration)
+            return;
+
+        task();
+        Director::getInstance()->getScheduler()->performFunctionInCocosThread(std::bind(callback, callbackParam));
+    };
+
+    if (type == TaskType::TASK_IO)
+        enqueueSerial(std::move(job));
+    else if (type == TaskType::TASK_NETWORK)
+        JobSystem::getInstance()->submit(std::move(job), JobSystem::Priority::LOW);
+    else
+        JobSystem::getInstance()->submit(std::move(job), JobSystem::Priority::NORMAL);
 }
 
 inline void AsyncTaskPool::enqueue(AsyncTaskPool::TaskType type, std::function<void()> task)
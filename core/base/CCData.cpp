@@ -161,4 +161,53 @@ uint8_t* Data::takeBuffer(ssize_t* size)
     return buffer;
 }
 
+const MappedData MappedData::Null;
+
+MappedData::MappedData() : _bytes(nullptr), _size(0), _mapped(false) {}
+
+MappedData::MappedData(std::shared_ptr<const void> mapping, const uint8_t* bytes, ssize_t size)
+    : _owner(std::move(mapping)), _bytes(bytes), _size(size), _mapped(true)
+{}
+
+MappedData::MappedData(Data&& data) : _bytes(nullptr), _size(0), _mapped(false)
+{
+    if (!data.isNull())
+    {
+        auto buffer = std::make_shared<Data>(std::move(data));
+        _bytes      = buffer->getBytes();
+        _size       = buffer->getSize();
+        _owner      = std::move(buffer);
+    }
+}
+
+void MappedData::clear()
+{
+    _owner.reset();
+    _bytes  = nullptr;
+    _size   = 0;
+    _mapped = false;
+}
+
+uint8_t* MappedData::takeBuffer(ssize_t* size)
+{
+    uint8_t* buffer = nullptr;
+    if (!isNull())
+    {
+        if (!_mapped && _owner.use_count() == 1)
+        {
+            // the only owner of the read buffer, hand it over instead of copying
+            buffer = std::const_pointer_cast<Data>(std::static_pointer_cast<const Data>(_owner))->takeBuffer(nullptr);
+        }
+        else
+        {
+            buffer = static_cast<uint8_t*>(malloc(_size));
+            memcpy(buffer, _bytes, _size);
+        }
+    }
+    if (size)
+        *size = buffer ? _size : 0;
+    clear();
+    return buffer;
+}
+
 NS_CC_END
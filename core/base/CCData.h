@@ -30,6 +30,7 @@
 #include "platform/CCPlatformMacros.h"
 #include <stdint.h>           // for ssize_t on android
 #include <string>             // for ssize_t on linux
+#include <memory>
 #include "platform/CCStdC.h"  // for ssize_t on window
 
 /**
@@ -154,6 +155,77 @@ private:
     ssize_t _size;
 };
 
+/**
+ * Read only view of file contents, see FileUtils::getMappedDataFromFile.
+ *
+ * The bytes are either a memory mapping of the file or a buffer the file was read into. Copies of a MappedData
+ * share them, they are released with the last copy.
+ */
+class CC_DLL MappedData
+{
+public:
+    /**
+     * This parameter is defined for convenient reference if a null MappedData object is needed.
+     */
+    static const MappedData Null;
+
+    MappedData();
+
+    /**
+     * Constructor of MappedData, views bytes of a memory mapping.
+     *
+     * @param mapping The memory mapping the bytes point into, it's kept alive by the view.
+     */
+    MappedData(std::shared_ptr<const void> mapping, const uint8_t* bytes, ssize_t size);
+
+    /**
+     * Constructor of MappedData, takes the buffer of data.
+     */
+    explicit MappedData(Data&& data);
+
+    /**
+     * Gets the bytes, they are read only.
+     */
+    const uint8_t* getBytes() const { return _bytes; }
+
+    /**
+     * Gets the size of the bytes.
+     */
+    ssize_t getSize() const { return _size; }
+
+    /**
+     * Check whether the data is null.
+     */
+    bool isNull() const { return _bytes == nullptr || _size == 0; }
+
+    /**
+     * Check whether the bytes are a memory mapping of the file, or a buffer the file was read into.
+     */
+    bool isMapped() const { return _mapped; }
+
+    /**
+     * Releases the bytes held by this view.
+     */
+    void clear();
+
+    /**
+     * Gets the bytes in a buffer owned by the caller and set the view to empty state.
+     *
+     * The read buffer is handed over when no other copy shares it, otherwise (and always for a mapping) a copy
+     * is made.
+     *
+     * @param size Will fill with the buffer size in bytes, if you do not care buffer size, pass nullptr.
+     * @return the buffer allocated with malloc, free it after use.
+     */
+    uint8_t* takeBuffer(ssize_t* size);
+
+private:
+    std::shared_ptr<const void> _owner;
+    const uint8_t* _bytes;
+    ssize_t _size;
+    bool _mapped;
+};
+
 NS_CC_END
 
 /** @} */
@@ -58,10 +58,13 @@ THE SOFTWARE.
 #include "base/CCAutoreleasePool.h"
 #include "base/CCConfiguration.h"
 #include "base/CCAsyncTaskPool.h"
+#include "base/CCFrameProfiler.h"
+#include "base/CCFramePacer.h"
 #include "base/ObjectFactory.h"
 #include "platform/CCApplication.h"
 #include "renderer/backend/ProgramCache.h"
 #include "audio/AudioEngine.h"
+#include "3d/CCMeshSkin.h"
 
 #if CC_ENABLE_SCRIPT_BINDING
 #    include "base/CCScriptSupport.h"
@@ -75,6 +78,11 @@ NS_CC_BEGIN
 // singleton stuff
 static Director* s_SharedDirector = nullptr;
 
+static float elapsedMilliseconds(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to)
+{
+    return std::chrono::duration<float, std::milli>(to - from).count();
+}
+
 #define kDefaultFPS 60  // 60 frames per second
 
 const char* Director::EVENT_BEFORE_SET_NEXT_SCENE = "director_before_set_next_scene";
@@ -237,6 +245,16 @@ void Director::setGLDefaultValues()
 // Draw the Scene
 void Director::drawScene()
 {
+    CC_PROFILE_ZONE("Director::drawScene");
+
+    using Clock = std::chrono::steady_clock;
+
+    FramePacer::FrameTimings timings;
+    auto frameStart = Clock::now();
+    if (_lastFrameStart != Clock::time_point())
+        timings.frame = elapsedMilliseconds(_lastFrameStart, frameStart);
+    _lastFrameStart = frameStart;
+
     _renderer->beginFrame();
 
     // calculate "global" dt
@@ -247,14 +265,45 @@ void Director::drawScene()
         _openGLView->pollEvents();
     }
 
+    // the time the scene was simulated for this frame
+    float simulatedTime = _deltaTime;
+
     // tick before glClear: issue #533
     if (!_paused)
     {
-        _eventDispatcher->dispatchEvent(_eventBeforeUpdate);
-        _scheduler->update(_deltaTime);
-        _eventDispatcher->dispatchEvent(_eventAfterUpdate);
+        if (_fixedTimeStep > 0)
+        {
+            // drop what the step limit can't catch up with
+            _fixedTimeAccumulator =
+                std::min(_fixedTimeAccumulator + _deltaTime, _fixedTimeStep * _maxFixedStepsPerFrame);
+            simulatedTime = 0;
+            while (_fixedTimeAccumulator >= _fixedTimeStep)
+            {
+                _eventDispatcher->dispatchEvent(_eventBeforeUpdate);
+                _scheduler->update(_fixedTimeStep);
+                _eventDispatcher->dispatchEvent(_eventAfterUpdate);
+
+                _fixedTimeAccumulator -= _fixedTimeStep;
+                simulatedTime += _fixedTimeStep;
+                ++timings.updateSteps;
+            }
+            _frameInterpolation = _fixedTimeAccumulator / _fixedTimeStep;
+        }
+        else
+        {
+            _eventDispatcher->dispatchEvent(_eventBeforeUpdate);
+            _scheduler->update(_deltaTime);
+            _eventDispatcher->dispatchEvent(_eventAfterUpdate);
+            timings.updateSteps = 1;
+        }
+
+        if (MeshSkin::isParallelPaletteUpdate())
+            MeshSkin::updateAnimatedPalettes();
     }
 
+    auto updateEnd = Clock::now();
+    timings.update = elapsedMilliseconds(frameStart, updateEnd);
+
     _renderer->clear(ClearFlag::ALL, _clearColor, 1, 0, -10000.0);
 
     _eventDispatcher->dispatchEvent(_eventBeforeDraw);
@@ -272,7 +321,7 @@ void Director::drawScene()
     if (_runningScene)
     {
 #if (CC_USE_PHYSICS || (CC_USE_3D_PHYSICS && CC_ENABLE_BULLET_INTEGRATION) || CC_USE_NAVMESH)
-        _runningScene->stepPhysicsAndNavigation(_deltaTime);
+        _runningScene->stepPhysicsAndNavigation(simulatedTime);
 #endif
         // clear draw stats
         _renderer->clearDrawStats();
@@ -299,6 +348,9 @@ void Director::drawScene()
 #endif
     }
 
+    auto visitEnd = Clock::now();
+    timings.visit = elapsedMilliseconds(updateEnd, visitEnd);
+
     _renderer->render();
 
     _eventDispatcher->dispatchEvent(_eventAfterDraw);
@@ -307,6 +359,9 @@ void Director::drawScene()
 
     _totalFrames++;
 
+    auto renderEnd = Clock::now();
+    timings.render = elapsedMilliseconds(visitEnd, renderEnd);
+
     // swap buffers
     if (_openGLView)
     {
@@ -315,6 +370,9 @@ void Director::drawScene()
 
     _renderer->endFrame();
 
+    timings.swap = elapsedMilliseconds(renderEnd, Clock::now());
+    FramePacer::getInstance()->recordFrame(timings);
+
     if (_displayStats)
     {
 #if !CC_STRIP_FPS
@@ -323,6 +381,13 @@ void Director::drawScene()
     }
 }
 
+void Director::setFixedTimeStep(float step)
+{
+    _fixedTimeStep        = std::max(step, 0.0f);
+    _fixedTimeAccumulator = 0.0f;
+    _frameInterpolation   = 0.0f;
+}
+
 void Director::calculateDeltaTime()
 {
     // new delta time. Re-fixed issue #1277
@@ -457,11 +522,29 @@ void Director::resetMatrixStack()
     initMatrixStack();
 }
 
+// the model view matrix stack bound to a recording thread, see Renderer::recordParallel
+static thread_local std::stack<Mat4>* s_threadModelViewMatrixStack = nullptr;
+
+static inline std::stack<Mat4>& modelViewStackOf(std::stack<Mat4>& shared)
+{
+    return s_threadModelViewMatrixStack ? *s_threadModelViewMatrixStack : shared;
+}
+
+static inline const std::stack<Mat4>& modelViewStackOf(const std::stack<Mat4>& shared)
+{
+    return s_threadModelViewMatrixStack ? *s_threadModelViewMatrixStack : shared;
+}
+
+void Director::setThreadModelViewMatrixStack(std::stack<Mat4>* stack)
+{
+    s_threadModelViewMatrixStack = stack;
+}
+
 void Director::popMatrix(MATRIX_STACK_TYPE type)
 {
     if (MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
     {
-        _modelViewMatrixStack.pop();
+        modelViewStackOf(_modelViewMatrixStack).pop();
     }
     else if (MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION == type)
     {
@@ -481,7 +564,7 @@ void Director::loadIdentityMatrix(MATRIX_STACK_TYPE type)
 {
     if (MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
     {
-        _modelViewMatrixStack.top() = Mat4::IDENTITY;
+        modelViewStackOf(_modelViewMatrixStack).top() = Mat4::IDENTITY;
     }
     else if (MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION == type)
     {
@@ -501,7 +584,7 @@ void Director::loadMatrix(MATRIX_STACK_TYPE type, const Mat4& mat)
 {
     if (MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
     {
-        _modelViewMatrixStack.top() = mat;
+        modelViewStackOf(_modelViewMatrixStack).top() = mat;
     }
     else if (MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION == type)
     {
@@ -521,7 +604,7 @@ void Director::multiplyMatrix(MATRIX_STACK_TYPE type, const Mat4& mat)
 {
     if (MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
     {
-        _modelViewMatrixStack.top() *= mat;
+        modelViewStackOf(_modelViewMatrixStack).top() *= mat;
     }
     else if (MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION == type)
     {
@@ -541,7 +624,8 @@ void Director::pushMatrix(MATRIX_STACK_TYPE type)
 {
     if (type == MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW)
     {
-        _modelViewMatrixStack.push(_modelViewMatrixStack.top());
+        auto& modelViewStack = modelViewStackOf(_modelViewMatrixStack);
+        modelViewStack.push(modelViewStack.top());
     }
     else if (type == MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION)
     {
@@ -561,7 +645,7 @@ const Mat4& Director::getMatrix(MATRIX_STACK_TYPE type) const
 {
     if (type == MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW)
     {
-        return _modelViewMatrixStack.top();
+        return modelViewStackOf(_modelViewMatrixStack).top();
     }
     else if (type == MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION)
     {
@@ -573,7 +657,7 @@ const Mat4& Director::getMatrix(MATRIX_STACK_TYPE type) const
     }
 
     CCASSERT(false, "unknown matrix stack type, will return modelview matrix instead");
-    return _modelViewMatrixStack.top();
+    return modelViewStackOf(_modelViewMatrixStack).top();
 }
 
 void Director::setProjection(Projection projection)
@@ -1017,6 +1101,7 @@ void Director::reset()
     SpriteFrameCache::destroyInstance();
     FileUtils::destroyInstance();
     AsyncTaskPool::destroyInstance();
+    JobSystem::destroyInstance();
     backend::ProgramCache::destroyInstance();
 
     // cocos2d-x specific data structures
@@ -1039,6 +1124,9 @@ void Director::purgeDirector()
         _openGLView = nullptr;
     }
 
+    // not in reset(), the run loops keep using the pacer across restartDirector()
+    FramePacer::destroyInstance();
+
     // delete Director
     release();
 }
@@ -1396,6 +1484,8 @@ void Director::mainLoop()
 
         // release the objects
         PoolManager::getInstance()->getCurrentPool()->clear();
+
+        CC_PROFILE_FRAME_MARK();
     }
 }
 
@@ -451,6 +451,31 @@ public:
      */
     float getFrameRate() const { return _frameRate; }
 
+    /**
+     * Runs the scheduler with a fixed time step instead of once per frame, which decouples the update rate from the
+     * frame rate set with setAnimationInterval(). Every frame runs as many steps as the elapsed time covers and the
+     * remainder carries over to the next frame, getFrameInterpolation() tells how far into the next step it reached.
+     * getDeltaTime() still returns the time since the last frame.
+     *
+     * @param step The time of one update in seconds, 0 updates once per frame with the frame's delta time. 0 by
+     * default.
+     */
+    void setFixedTimeStep(float step);
+    float getFixedTimeStep() const { return _fixedTimeStep; }
+
+    /**
+     * Sets the maximum number of fixed steps in one frame, 5 by default. Time beyond them is dropped, so a slow frame
+     * doesn't make the next ones slower.
+     */
+    void setMaxFixedStepsPerFrame(unsigned int steps) { _maxFixedStepsPerFrame = steps > 0 ? steps : 1; }
+    unsigned int getMaxFixedStepsPerFrame() const { return _maxFixedStepsPerFrame; }
+
+    /**
+     * Returns the fraction of a fixed step elapsed since the last one, in [0, 1). Nodes may blend their last two
+     * simulated states by it when drawn. Always 0 without a fixed time step.
+     */
+    float getFrameInterpolation() const { return _frameInterpolation; }
+
     /**
      * Clones a specified type matrix and put it to the top of specified type of matrix stack.
      * @js NA
@@ -497,6 +522,13 @@ public:
      */
     void resetMatrixStack();
 
+    /**
+     * Binds a model view matrix stack to the calling thread, nullptr restores the shared one.
+     * Used by Renderer::recordParallel, so that nodes visited on worker threads don't share the stack.
+     * @js NA
+     */
+    void setThreadModelViewMatrixStack(std::stack<Mat4>* stack);
+
     /**
      * returns the cocos2d thread id.
      Useful to know if certain code is already running on the cocos2d thread
@@ -624,6 +656,15 @@ protected:
     /* last time the main loop was updated */
     std::chrono::steady_clock::time_point _lastUpdate;
 
+    /* fixed time step, see setFixedTimeStep */
+    float _fixedTimeStep                = 0.0f;
+    float _fixedTimeAccumulator         = 0.0f;
+    float _frameInterpolation           = 0.0f;
+    unsigned int _maxFixedStepsPerFrame = 5;
+
+    /* start of the last frame, for the FramePacer timings */
+    std::chrono::steady_clock::time_point _lastFrameStart;
+
     /* whether or not the next delta time will be zero */
     bool _nextDeltaTimeZero = false;
 
@@ -40,6 +40,7 @@
 #include "2d/CCScene.h"
 #include "base/CCDirector.h"
 #include "base/CCEventType.h"
+#include "base/CCFrameProfiler.h"
 #include "2d/CCCamera.h"
 
 #define DUMP_LISTENER_ITEM_PRIORITY_INFO 0
@@ -895,6 +896,8 @@ void EventDispatcher::dispatchEvent(Event* event)
     if (!_isEnabled)
         return;
 
+    CC_PROFILE_ZONE("EventDispatcher::dispatchEvent");
+
     updateDirtyFlagForSceneGraph();
 
     DispatchGuard guard(_inDispatch);
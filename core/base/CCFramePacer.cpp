@@ -0,0 +1,183 @@
+/****************************************************************************
+ Copyright (c) 2021 Bytedance Inc.
+
+ https://adxeproject.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/CCFramePacer.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+NS_CC_BEGIN
+
+namespace
+{
+const size_t DEFAULT_HISTORY_SIZE = 240;
+
+float toMilliseconds(FramePacer::Clock::duration duration)
+{
+    return std::chrono::duration<float, std::milli>(duration).count();
+}
+}  // namespace
+
+FramePacer* FramePacer::s_sharedFramePacer = nullptr;
+
+FramePacer* FramePacer::getInstance()
+{
+    if (s_sharedFramePacer == nullptr)
+    {
+        s_sharedFramePacer = new FramePacer();
+    }
+    return s_sharedFramePacer;
+}
+
+void FramePacer::destroyInstance()
+{
+    delete s_sharedFramePacer;
+    s_sharedFramePacer = nullptr;
+}
+
+FramePacer::FramePacer()
+    : _interval(Clock::duration::zero())
+    , _spinThreshold(std::chrono::milliseconds(2))
+    , _history(DEFAULT_HISTORY_SIZE)
+{}
+
+void FramePacer::setFrameInterval(double interval)
+{
+    _interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(std::max(interval, 0.0)));
+    // restart the schedule with the next wait
+    _nextFrame = Clock::time_point();
+}
+
+double FramePacer::getFrameInterval() const
+{
+    return std::chrono::duration<double>(_interval).count();
+}
+
+FramePacer::Clock::duration FramePacer::waitForNextFrame()
+{
+    auto start = Clock::now();
+    if (_interval <= Clock::duration::zero())
+        return Clock::duration::zero();
+
+    _nextFrame += _interval;
+    if (start - _nextFrame > _interval)
+    {
+        _nextFrame = start;
+        return Clock::duration::zero();
+    }
+
+    sleepUntil(_nextFrame, _spinThreshold);
+
+    auto waited = Clock::now() - start;
+    if (_historyCount > 0)
+    {
+        auto last = (_historyHead + _history.size() - 1) % _history.size();
+        _history[last].idle += toMilliseconds(waited);
+    }
+    return waited;
+}
+
+void FramePacer::sleepUntil(Clock::time_point deadline, Clock::duration spinThreshold)
+{
+    for (auto now = Clock::now(); now < deadline; now = Clock::now())
+    {
+        auto remaining = deadline - now;
+        if (remaining > spinThreshold)
+            std::this_thread::sleep_for(remaining - spinThreshold);
+        else
+            std::this_thread::yield();
+    }
+}
+
+void FramePacer::recordFrame(const FrameTimings& timings)
+{
+    _history[_historyHead] = timings;
+    _historyHead           = (_historyHead + 1) % _history.size();
+    _historyCount          = std::min(_historyCount + 1, _history.size());
+}
+
+const FramePacer::FrameTimings& FramePacer::getLastFrameTimings() const
+{
+    static const FrameTimings empty;
+    if (_historyCount == 0)
+        return empty;
+    return _history[(_historyHead + _history.size() - 1) % _history.size()];
+}
+
+std::vector<FramePacer::FrameTimings> FramePacer::getFrameTimingsHistory() const
+{
+    std::vector<FrameTimings> frames;
+    frames.reserve(_historyCount);
+    auto first = (_historyHead + _history.size() - _historyCount) % _history.size();
+    for (size_t i = 0; i < _historyCount; ++i)
+        frames.push_back(_history[(first + i) % _history.size()]);
+    return frames;
+}
+
+FramePacer::FrameTimeStats FramePacer::getFrameTimeStats() const
+{
+    FrameTimeStats stats;
+    if (_historyCount == 0)
+        return stats;
+
+    auto first = (_historyHead + _history.size() - _historyCount) % _history.size();
+    double sum = 0.0;
+    stats.min  = _history[first].frame;
+    stats.max  = _history[first].frame;
+    for (size_t i = 0; i < _historyCount; ++i)
+    {
+        float frame = _history[(first + i) % _history.size()].frame;
+        sum += frame;
+        stats.min = std::min(stats.min, frame);
+        stats.max = std::max(stats.max, frame);
+    }
+    double mean = sum / _historyCount;
+
+    double squares = 0.0;
+    for (size_t i = 0; i < _historyCount; ++i)
+    {
+        double difference = _history[(first + i) % _history.size()].frame - mean;
+        squares += difference * difference;
+    }
+
+    stats.frames    = _historyCount;
+    stats.mean      = static_cast<float>(mean);
+    stats.variance  = static_cast<float>(squares / _historyCount);
+    stats.deviation = std::sqrt(stats.variance);
+    return stats;
+}
+
+void FramePacer::setHistorySize(size_t size)
+{
+    _history.assign(std::max(size, size_t(1)), FrameTimings());
+    clearHistory();
+}
+
+void FramePacer::clearHistory()
+{
+    _historyHead  = 0;
+    _historyCount = 0;
+}
+
+NS_CC_END
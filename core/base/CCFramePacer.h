@@ -0,0 +1,144 @@
+/****************************************************************************
+ Copyright (c) 2021 Bytedance Inc.
+
+ https://adxeproject.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "platform/CCPlatformMacros.h"
+#include <chrono>
+#include <vector>
+
+/**
+ * @addtogroup base
+ * @{
+ */
+NS_CC_BEGIN
+
+/**
+ * @class FramePacer
+ * @brief Waits for the next frame of the desktop main loops and keeps the timings of the last frames.
+ *
+ * Frames are due on a fixed schedule of the animation interval, so the error of one wait doesn't delay the following
+ * frames. A wait sleeps until shortly before the deadline and yields the rest, which keeps the jitter of coarse OS
+ * sleeps out of the frame times.
+ *
+ * The Director records the time each frame spends in every phase, the timings of the last frames are kept to graph the
+ * frame time variance. All functions must be called from the cocos thread.
+ * @js NA
+ */
+class CC_DLL FramePacer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /** Time spent in the phases of a frame, in milliseconds. */
+    struct FrameTimings
+    {
+        /** Scheduler updates, including every fixed step. */
+        float update = 0.0f;
+        /** Physics, scene visit and the commands queued by it. */
+        float visit = 0.0f;
+        /** Renderer::render(). */
+        float render = 0.0f;
+        /** Buffer swap and Renderer::endFrame(), includes waiting for vsync. */
+        float swap = 0.0f;
+        /** Time the main loop waited for the next frame after this one. */
+        float idle = 0.0f;
+        /** Time since the previous frame started. */
+        float frame = 0.0f;
+        /** Number of scheduler updates of the frame. */
+        unsigned int updateSteps = 0;
+    };
+
+    /** Distribution of FrameTimings::frame over the recorded frames, in milliseconds. */
+    struct FrameTimeStats
+    {
+        size_t frames   = 0;
+        float mean      = 0.0f;
+        float variance  = 0.0f;
+        float deviation = 0.0f;
+        float min       = 0.0f;
+        float max       = 0.0f;
+    };
+
+    static FramePacer* getInstance();
+    static void destroyInstance();
+
+    /** Sets the time between two frames in seconds, 0 runs the frames back to back. */
+    void setFrameInterval(double interval);
+    double getFrameInterval() const;
+
+    /**
+     * Sets how long before a deadline the wait stops sleeping and yields instead, 2 ms by default. It should exceed
+     * the time slice the OS may oversleep by.
+     */
+    void setSpinThreshold(Clock::duration threshold) { _spinThreshold = threshold; }
+    Clock::duration getSpinThreshold() const { return _spinThreshold; }
+
+    /**
+     * Blocks until the next frame is due. Falling behind by more than a frame restarts the schedule instead of running
+     * the missed frames back to back.
+     * @return The time waited, it is also added to the idle time of the last recorded frame.
+     */
+    Clock::duration waitForNextFrame();
+
+    /** Sleeps until shortly before deadline and yields the thread for the last spinThreshold of the wait. */
+    static void sleepUntil(Clock::time_point deadline, Clock::duration spinThreshold);
+
+    /** Called by the Director once per frame. */
+    void recordFrame(const FrameTimings& timings);
+
+    /** Returns the timings of the last recorded frame. */
+    const FrameTimings& getLastFrameTimings() const;
+
+    /** Returns the timings of the recorded frames, from the oldest to the newest. */
+    std::vector<FrameTimings> getFrameTimingsHistory() const;
+
+    /** Returns the distribution of the frame times of the recorded frames. */
+    FrameTimeStats getFrameTimeStats() const;
+
+    /** Sets the number of frames whose timings are kept, 240 by default. The recorded frames are discarded. */
+    void setHistorySize(size_t size);
+    size_t getHistorySize() const { return _history.size(); }
+
+    /** Discards the recorded frames. */
+    void clearHistory();
+
+protected:
+    FramePacer();
+
+    Clock::duration _interval;
+    Clock::duration _spinThreshold;
+    Clock::time_point _nextFrame;
+
+    std::vector<FrameTimings> _history;
+    // index of the next frame to record and number of frames recorded
+    size_t _historyHead  = 0;
+    size_t _historyCount = 0;
+
+    static FramePacer* s_sharedFramePacer;
+};
+
+NS_CC_END
+// end group
+/// @}
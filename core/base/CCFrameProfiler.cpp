@@ -0,0 +1,258 @@
+/****************************************************************************
+ Copyright (c) 2021 Bytedance Inc.
+
+ https://adxeproject.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/CCFrameProfiler.h"
+#include "platform/CCFileUtils.h"
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+NS_CC_BEGIN
+
+namespace
+{
+// the ring buffer of the current thread and the id of the profiler it was registered with
+thread_local std::shared_ptr<void> t_buffer;
+thread_local uint64_t t_bufferOwner = 0;
+// set by setThreadName() before the thread records its first zone
+thread_local std::string t_threadName;
+
+std::atomic<uint64_t> s_nextProfilerId{1};
+// number of recordZone() calls using the shared profiler, destroyInstance() waits for them
+std::atomic<int> s_activeRecorders{0};
+
+void appendJsonString(std::string& out, std::string_view text)
+{
+    out += '"';
+    for (auto c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out += '\\';
+            out += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            out += ' ';
+        }
+        else
+        {
+            out += c;
+        }
+    }
+    out += '"';
+}
+}  // namespace
+
+std::atomic<bool> FrameProfiler::s_capturing{false};
+std::atomic<FrameProfiler*> FrameProfiler::s_sharedFrameProfiler{nullptr};
+
+FrameProfiler::FrameProfiler() : _id(s_nextProfilerId.fetch_add(1)) {}
+
+FrameProfiler::ThreadBuffer::ThreadBuffer(size_t capacity_, unsigned int threadId_)
+    : zones(new Zone[capacity_]), capacity(capacity_), threadId(threadId_)
+{}
+
+static std::mutex s_instanceMutex;
+
+FrameProfiler* FrameProfiler::getInstance()
+{
+    // the JobSystem workers name their threads through it as they start, concurrently with the cocos thread
+    auto profiler = s_sharedFrameProfiler.load(std::memory_order_acquire);
+    if (profiler == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(s_instanceMutex);
+        profiler = s_sharedFrameProfiler.load(std::memory_order_relaxed);
+        if (profiler == nullptr)
+        {
+            profiler = new FrameProfiler();
+            s_sharedFrameProfiler.store(profiler, std::memory_order_release);
+        }
+    }
+    return profiler;
+}
+
+void FrameProfiler::destroyInstance()
+{
+    s_capturing = false;
+    std::lock_guard<std::mutex> lock(s_instanceMutex);
+    auto profiler = s_sharedFrameProfiler.exchange(nullptr);
+    if (profiler == nullptr)
+    {
+        return;
+    }
+
+    // recordZone() calls started from now see no profiler, wait for the ones which may still write to it
+    while (s_activeRecorders.load() > 0)
+    {
+        std::this_thread::yield();
+    }
+    delete profiler;
+}
+
+FrameProfiler::ThreadBuffer* FrameProfiler::getThreadBuffer()
+{
+    if (t_bufferOwner != _id)
+    {
+        std::lock_guard<std::mutex> lock(_buffersMutex);
+        auto buffer  = std::make_shared<ThreadBuffer>(_bufferCapacity, static_cast<unsigned int>(_buffers.size() + 1));
+        buffer->name = t_threadName;
+        _buffers.push_back(buffer);
+        t_buffer      = buffer;
+        t_bufferOwner = _id;
+    }
+    return static_cast<ThreadBuffer*>(t_buffer.get());
+}
+
+void FrameProfiler::recordZone(const char* name, int64_t start, int64_t end)
+{
+    // counted before loading the profiler, so destroyInstance() either waits for this call or it sees nullptr
+    s_activeRecorders.fetch_add(1);
+    auto profiler = s_sharedFrameProfiler.load();
+    if (profiler != nullptr)
+    {
+        auto buffer   = profiler->getThreadBuffer();
+        auto head     = buffer->head.load(std::memory_order_relaxed);
+        auto& zone    = buffer->zones[head % buffer->capacity];
+        zone.name     = name;
+        zone.start    = start;
+        zone.duration = end - start;
+        buffer->head.store(head + 1, std::memory_order_release);
+    }
+    s_activeRecorders.fetch_sub(1, std::memory_order_release);
+}
+
+void FrameProfiler::startCapture(unsigned int frameCount)
+{
+    _frameCount     = frameCount;
+    _capturedFrames = 0;
+    _captureEnd     = std::numeric_limits<int64_t>::max();
+    _captureStart   = now();
+    s_capturing     = true;
+}
+
+void FrameProfiler::stopCapture()
+{
+    if (s_capturing)
+    {
+        s_capturing = false;
+        _captureEnd = now();
+    }
+}
+
+void FrameProfiler::markFrame()
+{
+    ++_capturedFrames;
+    if (_frameCount > 0 && _capturedFrames >= _frameCount)
+    {
+        stopCapture();
+    }
+}
+
+void FrameProfiler::setThreadName(std::string_view name)
+{
+    // the ring buffer is only allocated when the thread records its first zone
+    t_threadName = name;
+    if (t_bufferOwner == _id)
+    {
+        std::lock_guard<std::mutex> lock(_buffersMutex);
+        static_cast<ThreadBuffer*>(t_buffer.get())->name = t_threadName;
+    }
+}
+
+std::string FrameProfiler::toChromeTrace() const
+{
+    int64_t captureStart = _captureStart;
+    int64_t captureEnd   = _captureEnd;
+
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(_buffersMutex);
+        buffers = _buffers;
+    }
+
+    std::string json = "{\"traceEvents\":[";
+    bool first       = true;
+    char event[128];
+    std::vector<Zone> zones;
+    for (auto&& buffer : buffers)
+    {
+        // copy the zones still in the ring, then drop the ones the writer may have overwritten meanwhile
+        auto head  = buffer->head.load(std::memory_order_acquire);
+        auto begin = head > buffer->capacity ? head - buffer->capacity : 0;
+        zones.clear();
+        for (auto index = begin; index < head; ++index)
+        {
+            zones.push_back(buffer->zones[index % buffer->capacity]);
+        }
+        auto newHead = buffer->head.load(std::memory_order_acquire);
+        // a writer at newHead may be filling the slot of index newHead - capacity already
+        if (newHead >= begin + buffer->capacity)
+        {
+            auto overwritten = std::min<uint64_t>(newHead - buffer->capacity - begin + 1, zones.size());
+            zones.erase(zones.begin(), zones.begin() + static_cast<ptrdiff_t>(overwritten));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_buffersMutex);
+            if (!buffer->name.empty())
+            {
+                json += first ? "\n" : ",\n";
+                first = false;
+                snprintf(event, sizeof(event),
+                         "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                         buffer->threadId);
+                json += event;
+                appendJsonString(json, buffer->name);
+                json += "}}";
+            }
+        }
+
+        for (auto&& zone : zones)
+        {
+            if (zone.start < captureStart || zone.start + zone.duration > captureEnd)
+            {
+                continue;
+            }
+
+            json += first ? "\n" : ",\n";
+            first = false;
+            json += "{\"name\":";
+            appendJsonString(json, zone.name);
+            snprintf(event, sizeof(event), ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                     buffer->threadId, (zone.start - captureStart) / 1000.0, zone.duration / 1000.0);
+            json += event;
+        }
+    }
+    json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    return json;
+}
+
+bool FrameProfiler::writeChromeTrace(std::string_view fullPath) const
+{
+    return FileUtils::getInstance()->writeStringToFile(toChromeTrace(), fullPath);
+}
+
+NS_CC_END
@@ -0,0 +1,192 @@
+/****************************************************************************
+ Copyright (c) 2021 Bytedance Inc.
+
+ https://adxeproject.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "platform/CCPlatformMacros.h"
+#include "base/ccConfig.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @addtogroup base
+ * @{
+ */
+NS_CC_BEGIN
+
+/**
+ * @class FrameProfiler
+ * @brief Records nested, timed zones of every thread and exports captured frames as Chrome trace events.
+ *
+ * Zones are opened with CC_PROFILE_ZONE and closed at the end of the enclosing scope. Each thread writes its zones to
+ * its own ring buffer without taking a lock, the oldest zones are overwritten once a buffer is full. When no capture is
+ * running a zone costs one relaxed atomic load, and the macros compile to nothing when CC_ENABLE_FRAME_PROFILER is 0.
+ *
+ * The resulting JSON loads in chrome://tracing or https://ui.perfetto.dev, zones of a thread nest by their times.
+ * @js NA
+ */
+class CC_DLL FrameProfiler
+{
+public:
+    /** A closed zone, times are in nanoseconds of the steady clock. */
+    struct Zone
+    {
+        const char* name;
+        int64_t start;
+        int64_t duration;
+    };
+
+    static FrameProfiler* getInstance();
+    /** Stops the capture and waits for the zones being recorded by other threads before freeing the profiler. */
+    static void destroyInstance();
+
+    /** Returns true while a capture is running, zones opened otherwise aren't recorded. */
+    static bool isCapturing() { return s_capturing.load(std::memory_order_relaxed); }
+
+    /** Returns the current time of the clock zones are measured with, in nanoseconds. */
+    static int64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    /**
+     * Appends a zone to the ring buffer of the calling thread.
+     * @param name must outlive the profiler, string literals are expected.
+     */
+    static void recordZone(const char* name, int64_t start, int64_t end);
+
+    /**
+     * Starts recording zones. The ring buffers aren't cleared, the trace leaves out every zone which started before
+     * this call or ended after the capture stopped.
+     * @param frameCount stops the capture after that many frames, 0 records until stopCapture is called.
+     */
+    void startCapture(unsigned int frameCount = 0);
+    void stopCapture();
+
+    /** Called by the Director once per frame, counts the captured frames. */
+    void markFrame();
+
+    unsigned int getCapturedFrames() const { return _capturedFrames; }
+
+    /** Names the calling thread in the exported trace, the name is kept until the thread records its first zone. */
+    void setThreadName(std::string_view name);
+
+    /**
+     * Sets the number of zones kept per thread, 65536 by default. Only threads recording their first zone afterwards
+     * are affected.
+     */
+    void setBufferCapacity(size_t capacity) { _bufferCapacity = capacity > 0 ? capacity : 1; }
+    size_t getBufferCapacity() const { return _bufferCapacity; }
+
+    /** Returns the zones of the last capture in the Chrome trace event format. */
+    std::string toChromeTrace() const;
+
+    /** Writes toChromeTrace() to a file, returns false if it can't be written. */
+    bool writeChromeTrace(std::string_view fullPath) const;
+
+protected:
+    struct ThreadBuffer
+    {
+        ThreadBuffer(size_t capacity, unsigned int threadId);
+
+        std::unique_ptr<Zone[]> zones;
+        size_t capacity;
+        // number of zones ever written, only the writing thread stores it
+        std::atomic<uint64_t> head{0};
+        unsigned int threadId;
+        std::string name;
+    };
+
+    FrameProfiler();
+
+    ThreadBuffer* getThreadBuffer();
+
+    mutable std::mutex _buffersMutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> _buffers;
+    size_t _bufferCapacity = 65536;
+
+    std::atomic<int64_t> _captureStart{0};
+    std::atomic<int64_t> _captureEnd{0};
+    unsigned int _frameCount     = 0;
+    unsigned int _capturedFrames = 0;
+
+    // tells the ring buffers of this instance from the ones of a destroyed instance at the same address
+    const uint64_t _id;
+
+    static std::atomic<bool> s_capturing;
+    static std::atomic<FrameProfiler*> s_sharedFrameProfiler;
+};
+
+/** Records the lifetime of a scope as a zone of the FrameProfiler, see CC_PROFILE_ZONE. */
+class ProfileZone
+{
+public:
+    explicit ProfileZone(const char* name)
+        : _name(FrameProfiler::isCapturing() ? name : nullptr), _start(_name ? FrameProfiler::now() : 0)
+    {}
+    ~ProfileZone()
+    {
+        if (_name)
+            FrameProfiler::recordZone(_name, _start, FrameProfiler::now());
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* _name;
+    int64_t _start;
+};
+
+NS_CC_END
+// end group
+/// @}
+
+#define CC_PROFILE_CONCAT_IMPL(a, b) a##b
+#define CC_PROFILE_CONCAT(a, b) CC_PROFILE_CONCAT_IMPL(a, b)
+
+#if CC_ENABLE_FRAME_PROFILER
+/** Records the rest of the enclosing scope as a zone named by the string literal __name__. */
+#    define CC_PROFILE_ZONE(__name__) NS_CC::ProfileZone CC_PROFILE_CONCAT(__ccProfileZone, __LINE__)(__name__)
+/** Names the calling thread in the exported trace. */
+#    define CC_PROFILE_THREAD_NAME(__name__) NS_CC::FrameProfiler::getInstance()->setThreadName(__name__)
+/** Marks the end of a frame, called by the Director. */
+#    define CC_PROFILE_FRAME_MARK()                               \
+        do                                                        \
+        {                                                         \
+            if (NS_CC::FrameProfiler::isCapturing())              \
+                NS_CC::FrameProfiler::getInstance()->markFrame(); \
+        } while (0)
+#else
+#    define CC_PROFILE_ZONE(__name__)
+#    define CC_PROFILE_THREAD_NAME(__name__)
+#    define CC_PROFILE_FRAME_MARK()
+#endif
@@ -0,0 +1,287 @@
+/****************************************************************************
+ Copyright (c) 2021 Bytedance Inc.
+
+ https://adxeproject.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/CCJobSystem.h"
+#include "base/CCDirector.h"
+#include "base/CCScheduler.h"
+#include "base/CCFrameProfiler.h"
+#include <algorithm>
+
+NS_CC_BEGIN
+
+namespace
+{
+// the job system and worker index of the current thread, null/0 outside the workers
+thread_local JobSystem* t_jobSystem = nullptr;
+thread_local unsigned int t_workerIndex = 0;
+}  // namespace
+
+std::atomic<JobSystem*> JobSystem::s_sharedJobSystem{nullptr};
+
+static std::mutex s_instanceMutex;
+
+JobSystem* JobSystem::getInstance()
+{
+    // jobs may be submitted from any thread, the first calls can race
+    auto jobSystem = s_sharedJobSystem.load(std::memory_order_acquire);
+    if (jobSystem == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(s_instanceMutex);
+        jobSystem = s_sharedJobSystem.load(std::memory_order_relaxed);
+        if (jobSystem == nullptr)
+        {
+            jobSystem = new JobSystem();
+            s_sharedJobSystem.store(jobSystem, std::memory_order_release);
+        }
+    }
+    return jobSystem;
+}
+
+void JobSystem::destroyInstance()
+{
+    std::lock_guard<std::mutex> lock(s_instanceMutex);
+    delete s_sharedJobSystem.exchange(nullptr);
+}
+
+bool JobSystem::isWorkerThread()
+{
+    return t_jobSystem != nullptr;
+}
+
+JobSystem::JobSystem(unsigned int workerCount)
+{
+    if (workerCount == 0)
+    {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        workerCount                  = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    _workers.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; ++i)
+        _workers.emplace_back(new Worker());
+
+    for (unsigned int i = 0; i < workerCount; ++i)
+        _workers[i]->thread = std::thread(&JobSystem::workerLoop, this, i);
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stop = true;
+    }
+    _sleepCondition.notify_all();
+
+    for (auto& worker : _workers)
+        worker->thread.join();
+}
+
+void JobSystem::submit(std::function<void()> job, Priority priority)
+{
+    unsigned int index;
+    if (t_jobSystem == this)
+        index = t_workerIndex;
+    else
+        index = _nextWorker.fetch_add(1, std::memory_order_relaxed) % _workers.size();
+
+    auto& worker = *_workers[index];
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.jobs[(int)priority].push_back(std::move(job));
+    }
+
+    // the job must be visible in its deque before the pending count lets a worker look for it
+    ++_pendingJobs;
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+    }
+    _sleepCondition.notify_one();
+}
+
+void JobSystem::submit(std::function<void()> job, std::function<void()> continuation, Priority priority)
+{
+    submit(
+        [job = std::move(job), continuation = std::move(continuation)]() mutable {
+            job();
+            Director::getInstance()->getScheduler()->performFunctionInCocosThread(std::move(continuation));
+        },
+        priority);
+}
+
+void JobSystem::parallelFor(size_t count, const std::function<void(size_t)>& body, unsigned int maxWorkers)
+{
+    if (count == 0)
+        return;
+
+    size_t helperCount = _workers.size();
+    if (maxWorkers > 0)
+        helperCount = std::min<size_t>(helperCount, maxWorkers);
+    helperCount = std::min(helperCount, count - 1);
+
+    if (helperCount == 0)
+    {
+        for (size_t i = 0; i < count; ++i)
+            body(i);
+        return;
+    }
+
+    // shared by the caller and the helper jobs, a helper may start after the loop is over so it owns a reference
+    struct LoopState
+    {
+        const std::function<void(size_t)>* body = nullptr;
+        size_t count                            = 0;
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+    auto state   = std::make_shared<LoopState>();
+    state->body  = &body;
+    state->count = count;
+
+    auto drain = [](LoopState& loop) {
+        size_t finished = 0;
+        for (size_t i = loop.next++; i < loop.count; i = loop.next++)
+        {
+            (*loop.body)(i);
+            ++finished;
+        }
+        if (finished > 0 && loop.done.fetch_add(finished) + finished == loop.count)
+        {
+            std::lock_guard<std::mutex> lock(loop.mutex);
+            loop.condition.notify_all();
+        }
+    };
+
+    for (size_t i = 0; i < helperCount; ++i)
+        submit([state, drain] { drain(*state); }, Priority::HIGH);
+
+    drain(*state);
+
+    // the caller doesn't run unrelated jobs while waiting, it could pick a long io job and stall the loop
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->condition.wait(lock, [&state] { return state->done.load() == state->count; });
+}
+
+void JobSystem::parallelForRange(size_t begin,
+                                 size_t end,
+                                 size_t grainSize,
+                                 const std::function<void(size_t, size_t)>& body,
+                                 unsigned int maxWorkers)
+{
+    if (end <= begin)
+        return;
+
+    grainSize         = std::max<size_t>(grainSize, 1);
+    size_t chunkCount = (end - begin + grainSize - 1) / grainSize;
+    parallelFor(
+        chunkCount,
+        [&](size_t chunk) {
+            size_t chunkBegin = begin + chunk * grainSize;
+            body(chunkBegin, std::min(chunkBegin + grainSize, end));
+        },
+        maxWorkers);
+}
+
+JobSystem::Stats JobSystem::getStats() const
+{
+    Stats stats;
+    stats.queueDepth   = _pendingJobs.load();
+    stats.executedJobs = _executedJobs.load();
+    stats.stolenJobs   = _stolenJobs.load();
+
+    stats.workerQueueDepths.reserve(_workers.size());
+    for (auto& worker : _workers)
+    {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        size_t depth = 0;
+        for (auto& jobs : worker->jobs)
+            depth += jobs.size();
+        stats.workerQueueDepths.push_back(depth);
+    }
+    return stats;
+}
+
+void JobSystem::resetStats()
+{
+    _executedJobs = 0;
+    _stolenJobs   = 0;
+}
+
+bool JobSystem::popJob(unsigned int index, std::function<void()>& job)
+{
+    const size_t workerCount = _workers.size();
+
+    // higher priorities first; for each one try the own deque (newest job) before stealing (oldest job)
+    for (int priority = 0; priority < (int)Priority::COUNT; ++priority)
+    {
+        for (size_t i = 0; i < workerCount; ++i)
+        {
+            auto& worker = *_workers[(index + i) % workerCount];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            auto& jobs = worker.jobs[priority];
+            if (jobs.empty())
+                continue;
+
+            if (i == 0)
+            {
+                job = std::move(jobs.back());
+                jobs.pop_back();
+            }
+            else
+            {
+                job = std::move(jobs.front());
+                jobs.pop_front();
+                ++_stolenJobs;
+            }
+            --_pendingJobs;
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::workerLoop(unsigned int index)
+{
+    t_jobSystem   = this;
+    t_workerIndex = index;
+    CC_PROFILE_THREAD_NAME("JobSystem worker " + std::to_string(index));
+
+    std::function<void()> job;
+    while (!_stop)
+    {
+        if (popJob(index, job))
+        {
+            job();
+            job = nullptr;
+            ++_executedJobs;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _sleepCondition.wait(lock, [this] { return _stop || _pendingJobs.load() > 0; });
+    }
+}
+
+NS_CC_END
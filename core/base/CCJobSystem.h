@@ -0,0 +1,158 @@
+/****************************************************************************
+ Copyright (c) 2021 Bytedance Inc.
+
+ https://adxeproject.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "platform/CCPlatformMacros.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @addtogroup base
+ * @{
+ */
+NS_CC_BEGIN
+
+/**
+ * @class JobSystem
+ * @brief A work-stealing thread pool shared by the engine for background and data-parallel work.
+ *
+ * Every worker owns one deque per priority. A worker pops its own jobs from the back, so the most recently pushed
+ * (and still cache-hot) job runs first, and steals the oldest job from the front of another worker's deque once its
+ * own are empty. Jobs submitted from a worker thread go to that worker's deques, other jobs are spread round-robin.
+ * @js NA
+ */
+class CC_DLL JobSystem
+{
+public:
+    enum class Priority
+    {
+        HIGH,
+        NORMAL,
+        LOW,
+        COUNT,
+    };
+
+    struct Stats
+    {
+        /** Jobs submitted but not started yet. */
+        size_t queueDepth = 0;
+        /** Jobs waiting in each worker's deques. */
+        std::vector<size_t> workerQueueDepths;
+        /** Jobs run since the last resetStats(). */
+        uint64_t executedJobs = 0;
+        /** Jobs run by another worker than the one owning the deque they were pushed to. */
+        uint64_t stolenJobs = 0;
+    };
+
+    /**
+     * Returns the shared job system, its worker count is the number of hardware threads minus one (at least one).
+     * Safe to call from any thread.
+     */
+    static JobSystem* getInstance();
+
+    /**
+     * Destroys the shared job system. Jobs not started yet are dropped, running jobs are waited for.
+     */
+    static void destroyInstance();
+
+    /** Returns true if the calling thread is one of the workers of any job system. */
+    static bool isWorkerThread();
+
+    /**
+     * @param workerCount number of worker threads, 0 means the number of hardware threads minus one.
+     */
+    explicit JobSystem(unsigned int workerCount = 0);
+    ~JobSystem();
+
+    unsigned int getWorkerCount() const { return static_cast<unsigned int>(_workers.size()); }
+
+    /**
+     * Runs job on a worker thread.
+     */
+    void submit(std::function<void()> job, Priority priority = Priority::NORMAL);
+
+    /**
+     * Runs job on a worker thread, then continuation on the cocos thread through
+     * Scheduler::performFunctionInCocosThread.
+     */
+    void submit(std::function<void()> job, std::function<void()> continuation, Priority priority = Priority::NORMAL);
+
+    /**
+     * Calls body(i) for every i in [0, count) and returns once all calls are done. The calling thread takes part in
+     * the loop and indices are claimed one at a time, so uneven iterations balance out across the workers. Safe to
+     * call from inside a job.
+     *
+     * @param maxWorkers caps the number of workers helping the caller, 0 means all of them.
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& body, unsigned int maxWorkers = 0);
+
+    /**
+     * Splits [begin, end) into chunks of grainSize elements and calls body(chunkBegin, chunkEnd) for each one in
+     * parallel, see parallelFor.
+     */
+    void parallelForRange(size_t begin,
+                          size_t end,
+                          size_t grainSize,
+                          const std::function<void(size_t, size_t)>& body,
+                          unsigned int maxWorkers = 0);
+
+    Stats getStats() const;
+    void resetStats();
+
+protected:
+    struct Worker
+    {
+        std::deque<std::function<void()>> jobs[(int)Priority::COUNT];
+        mutable std::mutex mutex;
+        std::thread thread;
+    };
+
+    void workerLoop(unsigned int index);
+    bool popJob(unsigned int index, std::function<void()>& job);
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+
+    // idle workers sleep until _pendingJobs becomes positive
+    std::mutex _sleepMutex;
+    std::condition_variable _sleepCondition;
+    std::atomic<size_t> _pendingJobs{0};
+    std::atomic<unsigned int> _nextWorker{0};
+    std::atomic<bool> _stop{false};
+
+    std::atomic<uint64_t> _executedJobs{0};
+    std::atomic<uint64_t> _stolenJobs{0};
+
+    static std::atomic<JobSystem*> s_sharedJobSystem;
+};
+
+NS_CC_END
+// end group
+/// @}
@@ -48,6 +48,9 @@ class ProfilingTimer;
  cocos2d builtin profiler.
 
  To use it, enable set the CC_ENABLE_PROFILERS=1 in the ccConfig.h file
+
+ @deprecated The engine no longer times itself with it, use FrameProfiler and CC_PROFILE_ZONE from
+ base/CCFrameProfiler.h instead.
  */
 
 class CC_DLL Profiler : public Ref
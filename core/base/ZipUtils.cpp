@@ -41,10 +41,13 @@
 #include <assert.h>
 #include <stdlib.h>
 #include <set>
+#include <limits>
 
 #include "base/CCData.h"
 #include "base/ccMacros.h"
 #include "platform/CCFileUtils.h"
+#include "platform/CCPosixFileStream.h"
+#include "mio/mio.hpp"
 #include <map>
 #include <mutex>
 
@@ -1048,4 +1051,348 @@ unsigned char* ZipFile::getFileDataFromZip(std::string_view zipFilePath, std::st
     return buffer;
 }
 
+// --------------------- MappedZipFile ---------------------
+namespace
+{
+enum : uint32_t
+{
+    ZIP_LOCAL_HEADER_SIG      = 0x04034b50,
+    ZIP_CENTRAL_HEADER_SIG    = 0x02014b50,
+    ZIP_END_OF_CENTRAL_SIG    = 0x06054b50,
+    ZIP64_END_OF_CENTRAL_SIG  = 0x06064b50,
+    ZIP64_END_LOCATOR_SIG     = 0x07064b50,
+    ZIP_LOCAL_HEADER_SIZE     = 30,
+    ZIP_CENTRAL_HEADER_SIZE   = 46,
+    ZIP_END_OF_CENTRAL_SIZE   = 22,
+    ZIP64_END_OF_CENTRAL_SIZE = 56,
+    ZIP64_END_LOCATOR_SIZE    = 20,
+    ZIP64_EXTRA_FIELD_ID      = 0x0001,
+};
+
+enum : uint16_t
+{
+    ZIP_METHOD_STORED  = 0,
+    ZIP_METHOD_DEFLATE = 8,
+};
+
+inline uint16_t readLE16(const unsigned char* p)
+{
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t readLE32(const unsigned char* p)
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[3]) << 24);
+}
+
+inline uint64_t readLE64(const unsigned char* p)
+{
+    return static_cast<uint64_t>(readLE32(p)) | (static_cast<uint64_t>(readLE32(p + 4)) << 32);
+}
+}  // namespace
+
+struct MappedZipEntryInfo
+{
+    uint64_t localHeaderOffset;
+    uint64_t compressedSize;
+    uint64_t uncompressedSize;
+    uint16_t method;
+};
+
+struct MappedZipFilePrivate
+{
+    // shared with the MappedData views of the stored entries, which may outlive the archive
+    std::shared_ptr<mio::ummap_source> mapping = std::make_shared<mio::ummap_source>();
+    hlookup::string_map<MappedZipEntryInfo> fileList;
+
+    bool indexCentralDirectory(std::string_view filter);
+
+    // returns the entry data inside the mapping, nullptr if it's out of the mapping or can't be held in memory
+    const unsigned char* getEntryData(const MappedZipEntryInfo& entry) const
+    {
+        const uint64_t size = mapping->size();
+        if (entry.localHeaderOffset > size || ZIP_LOCAL_HEADER_SIZE > size - entry.localHeaderOffset)
+            return nullptr;
+
+        // a stored entry is read as is, its sizes must agree or the reads would run past the data
+        if (entry.method == ZIP_METHOD_STORED && entry.compressedSize != entry.uncompressedSize)
+            return nullptr;
+        if (entry.uncompressedSize > std::numeric_limits<size_t>::max())
+            return nullptr;
+
+        const unsigned char* header = mapping->data() + entry.localHeaderOffset;
+        if (readLE32(header) != ZIP_LOCAL_HEADER_SIG)
+            return nullptr;
+
+        // the local name and extra field lengths may differ from the central directory ones
+        uint64_t dataOffset =
+            entry.localHeaderOffset + ZIP_LOCAL_HEADER_SIZE + readLE16(header + 26) + readLE16(header + 28);
+        if (dataOffset > size || entry.compressedSize > size - dataOffset)
+            return nullptr;
+        return mapping->data() + dataOffset;
+    }
+};
+
+bool MappedZipFilePrivate::indexCentralDirectory(std::string_view filter)
+{
+    const unsigned char* base = mapping->data();
+    const uint64_t size       = mapping->size();
+    if (size < ZIP_END_OF_CENTRAL_SIZE)
+        return false;
+
+    // the end of central directory record is followed by a comment of 64KB at most
+    const unsigned char* eocd = nullptr;
+    const uint64_t scanEnd    = size > ZIP_END_OF_CENTRAL_SIZE + 0xffff ? size - ZIP_END_OF_CENTRAL_SIZE - 0xffff : 0;
+    for (uint64_t pos = size - ZIP_END_OF_CENTRAL_SIZE + 1; pos-- > scanEnd;)
+    {
+        if (readLE32(base + pos) == ZIP_END_OF_CENTRAL_SIG)
+        {
+            eocd = base + pos;
+            break;
+        }
+    }
+    if (!eocd)
+        return false;
+
+    uint64_t entryCount = readLE16(eocd + 10);
+    uint64_t cdSize     = readLE32(eocd + 12);
+    uint64_t cdOffset   = readLE32(eocd + 16);
+
+    // zip64: the real values are in the zip64 end of central directory record
+    if ((entryCount == 0xffff || cdSize == 0xffffffff || cdOffset == 0xffffffff) &&
+        static_cast<uint64_t>(eocd - base) >= ZIP64_END_LOCATOR_SIZE)
+    {
+        const unsigned char* locator = eocd - ZIP64_END_LOCATOR_SIZE;
+        if (readLE32(locator) == ZIP64_END_LOCATOR_SIG)
+        {
+            uint64_t zip64Pos = readLE64(locator + 8);
+            // the values come from the archive, compare without adding them so a bogus one can't wrap around
+            if (size >= ZIP64_END_OF_CENTRAL_SIZE && zip64Pos <= size - ZIP64_END_OF_CENTRAL_SIZE &&
+                readLE32(base + zip64Pos) == ZIP64_END_OF_CENTRAL_SIG)
+            {
+                entryCount = readLE64(base + zip64Pos + 32);
+                cdSize     = readLE64(base + zip64Pos + 40);
+                cdOffset   = readLE64(base + zip64Pos + 48);
+            }
+        }
+    }
+    if (cdOffset > size || cdSize > size - cdOffset)
+        return false;
+    // every entry takes a header at least, a bogus count mustn't make the reserve below blow up
+    if (entryCount > cdSize / ZIP_CENTRAL_HEADER_SIZE)
+        return false;
+
+    fileList.clear();
+    fileList.reserve(static_cast<size_t>(entryCount));
+
+    const unsigned char* p   = base + cdOffset;
+    const unsigned char* end = p + cdSize;
+    for (uint64_t i = 0; i < entryCount; ++i)
+    {
+        if (static_cast<size_t>(end - p) < ZIP_CENTRAL_HEADER_SIZE || readLE32(p) != ZIP_CENTRAL_HEADER_SIG)
+            return false;
+
+        const uint16_t flags         = readLE16(p + 8);
+        const uint16_t nameLength    = readLE16(p + 28);
+        const uint16_t extraLength   = readLE16(p + 30);
+        const uint16_t commentLength = readLE16(p + 32);
+        const unsigned char* name    = p + ZIP_CENTRAL_HEADER_SIZE;
+        if (static_cast<size_t>(end - name) < static_cast<size_t>(nameLength) + extraLength + commentLength)
+            return false;
+        const unsigned char* extra    = name + nameLength;
+        const unsigned char* extraEnd = extra + extraLength;
+
+        MappedZipEntryInfo entry;
+        entry.method            = readLE16(p + 10);
+        entry.compressedSize    = readLE32(p + 20);
+        entry.uncompressedSize  = readLE32(p + 24);
+        entry.localHeaderOffset = readLE32(p + 42);
+
+        // zip64 extended information, only the fields saturated in the header are present, in this order
+        for (const unsigned char* field = extra; extraEnd - field >= 4;)
+        {
+            const uint16_t fieldId     = readLE16(field);
+            const uint16_t fieldLength = readLE16(field + 2);
+            const unsigned char* value = field + 4;
+            // a field running past the extra data is malformed, and so is everything after it
+            if (extraEnd - value < fieldLength)
+                break;
+            const unsigned char* valueEnd = value + fieldLength;
+            if (fieldId == ZIP64_EXTRA_FIELD_ID)
+            {
+                if (entry.uncompressedSize == 0xffffffff && value + 8 <= valueEnd)
+                {
+                    entry.uncompressedSize = readLE64(value);
+                    value += 8;
+                }
+                if (entry.compressedSize == 0xffffffff && value + 8 <= valueEnd)
+                {
+                    entry.compressedSize = readLE64(value);
+                    value += 8;
+                }
+                if (entry.localHeaderOffset == 0xffffffff && value + 8 <= valueEnd)
+                    entry.localHeaderOffset = readLE64(value);
+                break;
+            }
+            field = valueEnd;
+        }
+
+        std::string_view fileName{reinterpret_cast<const char*>(name), nameLength};
+        p = extraEnd + commentLength;
+
+        // skip folders, encrypted files and compression methods zlib can't handle
+        if (fileName.empty() || fileName.back() == '/')
+            continue;
+        if ((flags & 0x1) || (entry.method != ZIP_METHOD_STORED && entry.method != ZIP_METHOD_DEFLATE))
+        {
+            CCLOG("MappedZipFile: unsupported entry %.*s", static_cast<int>(fileName.size()), fileName.data());
+            continue;
+        }
+        // cache info about filtered files only (like 'assets/')
+        if (!filter.empty() && !cxx20::starts_with(fileName, filter))
+            continue;
+
+        fileList.emplace(fileName, entry);
+    }
+    return true;
+}
+
+MappedZipFile::MappedZipFile(std::string_view zipFile, std::string_view filter) : _data(new MappedZipFilePrivate())
+{
+    int fd = posix_open_cxx(zipFile, O_READ_FLAGS);
+    if (fd == -1)
+        return;
+
+    // the mapping keeps the file alive, the descriptor isn't needed anymore
+    std::error_code error;
+    _data->mapping->map(posix_fd2fh(fd), 0, mio::map_entire_file, error);
+    posix_close(fd);
+
+    if (error || !_data->mapping->is_mapped() || !_data->indexCentralDirectory(filter))
+    {
+        CCLOG("MappedZipFile: can't open %.*s", static_cast<int>(zipFile.size()), zipFile.data());
+        _data->fileList.clear();
+        _data->mapping->unmap();
+    }
+}
+
+MappedZipFile::~MappedZipFile()
+{
+    CC_SAFE_DELETE(_data);
+}
+
+bool MappedZipFile::isOpen() const
+{
+    return _data->mapping->is_mapped();
+}
+
+bool MappedZipFile::fileExists(std::string_view fileName) const
+{
+    return _data->fileList.find(fileName) != _data->fileList.end();
+}
+
+std::vector<std::string> MappedZipFile::listFiles(std::string_view pathname) const
+{
+    std::set<std::string> fileSet;
+    // ensure pathname ends with `/` as a directory
+    std::string ensureDir;
+    std::string_view dirname = pathname[pathname.length() - 1] == '/' ? pathname : (ensureDir.append(pathname) += '/');
+    for (auto& item : _data->fileList)
+    {
+        std::string_view filename = item.first;
+        if (cxx20::starts_with(filename, cxx17::string_view{dirname}))
+        {
+            std::string_view suffix{filename.substr(dirname.length())};
+            auto pos = suffix.find('/');
+            if (pos == std::string::npos)
+                fileSet.insert(std::string{suffix});
+            else
+                fileSet.insert(std::string{suffix.substr(0, pos + 1)});
+        }
+    }
+
+    return std::vector<std::string>{fileSet.begin(), fileSet.end()};
+}
+
+int64_t MappedZipFile::getFileSize(std::string_view fileName) const
+{
+    auto it = _data->fileList.find(fileName);
+    if (it == _data->fileList.end())
+        return -1;
+    return static_cast<int64_t>(it->second.uncompressedSize);
+}
+
+MappedData MappedZipFile::getStoredFileData(std::string_view fileName) const
+{
+    auto it = _data->fileList.find(fileName);
+    if (it == _data->fileList.end() || it->second.method != ZIP_METHOD_STORED)
+        return MappedData::Null;
+
+    auto bytes = _data->getEntryData(it->second);
+    if (!bytes)
+        return MappedData::Null;
+    return MappedData(_data->mapping, bytes, static_cast<ssize_t>(it->second.uncompressedSize));
+}
+
+bool MappedZipFile::getFileData(std::string_view fileName, ResizableBuffer* buffer) const
+{
+    auto it = _data->fileList.find(fileName);
+    if (it == _data->fileList.end())
+        return false;
+
+    const MappedZipEntryInfo& fileInfo = it->second;
+    const unsigned char* data          = _data->getEntryData(fileInfo);
+    if (!data)
+        return false;
+
+    buffer->resize(static_cast<size_t>(fileInfo.uncompressedSize));
+    if (fileInfo.uncompressedSize == 0)
+        return true;
+
+    if (fileInfo.method == ZIP_METHOD_STORED)
+    {
+        memcpy(buffer->buffer(), data, static_cast<size_t>(fileInfo.uncompressedSize));
+        return true;
+    }
+
+    // raw deflate stream, every call has its own z_stream so reads can run concurrently
+    z_stream stream{};
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+        return false;
+
+    // zlib counts in uInt, entries of 4GB and more are fed in chunks
+    const uint64_t chunkLimit = std::numeric_limits<uInt>::max();
+    uint64_t inputLeft        = fileInfo.compressedSize;
+    uint64_t outputLeft       = fileInfo.uncompressedSize;
+    stream.next_in            = const_cast<Bytef*>(data);
+    stream.next_out           = static_cast<Bytef*>(buffer->buffer());
+
+    int err = Z_OK;
+    while (err == Z_OK)
+    {
+        if (stream.avail_in == 0 && inputLeft > 0)
+        {
+            stream.avail_in = static_cast<uInt>(std::min(inputLeft, chunkLimit));
+            inputLeft -= stream.avail_in;
+        }
+        if (stream.avail_out == 0 && outputLeft > 0)
+        {
+            stream.avail_out = static_cast<uInt>(std::min(outputLeft, chunkLimit));
+            outputLeft -= stream.avail_out;
+        }
+        err = inflate(&stream, Z_NO_FLUSH);
+    }
+    inflateEnd(&stream);
+
+    // total_out is only 32 bits wide on some platforms, count what's left of the buffer instead
+    if (err != Z_STREAM_END || outputLeft + stream.avail_out != 0)
+    {
+        CCLOG("MappedZipFile: inflating %.*s failed: %d", static_cast<int>(fileName.size()), fileName.data(), err);
+        buffer->resize(0);
+        return false;
+    }
+    return true;
+}
+
 NS_CC_END
@@ -224,6 +224,7 @@ private:
 // forward declaration
 struct ZipEntryInfo;
 struct ZipFilePrivate;
+struct MappedZipFilePrivate;
 
 struct ZipFileStream
 {
@@ -337,6 +338,66 @@ private:
     /** Internal data like zip file pointer / file list array and so on */
     ZipFilePrivate* _data;
 };
+
+/**
+ * Memory mapped zip file - reader helper class.
+ *
+ * The archive is mapped once and the central directory is indexed by file name when it's opened. Reads don't go
+ * through a shared minizip handle: stored entries are read straight from the mapping, deflated entries are inflated
+ * by the calling thread, so several threads can read from the same archive at once.
+ */
+class CC_DLL MappedZipFile
+{
+public:
+    /**
+     * Constructor, map zip file and index its central directory.
+     *
+     * @param zipFile Zip file name, must be a file on disk (not an asset inside the apk).
+     * @param filter The first part of file names, which should be accessible.
+     *               For example, "assets/". Other files will be missed.
+     */
+    MappedZipFile(std::string_view zipFile, std::string_view filter = std::string());
+    ~MappedZipFile();
+
+    /** Returns true if the archive is mapped and its central directory was read. */
+    bool isOpen() const;
+
+    /**
+     * Check does a file exists or not in zip file
+     *
+     * @param fileName File to be checked on existence
+     * @return true whenever file exists, false otherwise
+     */
+    bool fileExists(std::string_view fileName) const;
+
+    /**
+     * Get files and folders in pathname
+     */
+    std::vector<std::string> listFiles(std::string_view pathname) const;
+
+    /** Returns the uncompressed size of a file, or -1 if it doesn't exist. */
+    int64_t getFileSize(std::string_view fileName) const;
+
+    /**
+     * Returns a view of a stored (not compressed) file inside the mapping, no copy is made. The view keeps the
+     * mapping alive, so it stays valid after the MappedZipFile is destroyed.
+     * @param fileName File name
+     * @return MappedData::Null if the file doesn't exist, is compressed or empty.
+     */
+    MappedData getStoredFileData(std::string_view fileName) const;
+
+    /**
+     * Get resource file data from a zip file, thread safe.
+     * @param fileName File name
+     * @param[out] buffer If the file read operation succeeds, if will contain the file data.
+     * @return True if successful.
+     */
+    bool getFileData(std::string_view fileName, ResizableBuffer* buffer) const;
+
+private:
+    /** Internal data like the mapping and the file index */
+    MappedZipFilePrivate* _data;
+};
 }  // end of namespace cocos2d
 
 // end group
@@ -246,6 +246,20 @@ THE SOFTWARE.
 #    define CC_ENABLE_PROFILERS 0
 #endif
 
+/** @def CC_ENABLE_FRAME_PROFILER
+ * If enabled, the engine records timed zones around its main frame stages (scene drawing, scheduler, actions,
+ * event dispatching, rendering and texture uploads) while a FrameProfiler capture runs, see base/CCFrameProfiler.h.
+ * A zone costs one atomic load when no capture is running.
+ * Enabled in debug builds by default.
+ */
+#ifndef CC_ENABLE_FRAME_PROFILER
+#    if defined(COCOS2D_DEBUG) && COCOS2D_DEBUG > 0
+#        define CC_ENABLE_FRAME_PROFILER 1
+#    else
+#        define CC_ENABLE_FRAME_PROFILER 0
+#    endif
+#endif
+
 /** Enable Lua engine debug log. */
 #ifndef CC_LUA_ENGINE_DEBUG
 #    define CC_LUA_ENGINE_DEBUG 0
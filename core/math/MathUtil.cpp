@@ -32,6 +32,7 @@ This file was modified to fit the cocos2d-x project
 //#define INCLUDE_NEON64    : neon 64 code included
 //#define USE_SSE           : SSE code used
 //#define INCLUDE_SSE       : SSE code included
+//#define USE_SSE2          : SSE2 code used by the array functions
 
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_IOS)
 #    if defined(__arm64__)
@@ -59,6 +60,14 @@ This file was modified to fit the cocos2d-x project
 #    define INCLUDE_SSE
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define USE_SSE2
+#    define INCLUDE_SSE
+#endif
+
+// the SIMD versions fall back to MathUtilC for the elements which don't fill a vector
+#include "math/MathUtil.inl"
+
 #ifdef INCLUDE_NEON32
 #    include "math/MathUtilNeon.inl"
 #endif
@@ -71,8 +80,6 @@ This file was modified to fit the cocos2d-x project
 #    include "math/MathUtilSSE.inl"
 #endif
 
-#include "math/MathUtil.inl"
-
 NS_CC_MATH_BEGIN
 
 void MathUtil::smooth(float* x, float target, float elapsedTime, float responseTime)
@@ -298,4 +305,111 @@ void MathUtil::crossVec3(const float* v1, const float* v2, float* dst)
 #endif
 }
 
+void MathUtil::addScaledArray(float* dst, const float* src, float scalar, int count)
+{
+#if defined(USE_NEON64)
+    MathUtilNeon64::addScaledArray(dst, src, scalar, count);
+#elif defined(USE_SSE2)
+    MathUtilSSE::addScaledArray(dst, src, scalar, count);
+#else
+    MathUtilC::addScaledArray(dst, src, scalar, count);
+#endif
+}
+
+void MathUtil::addScalarArray(float* dst, float scalar, int count)
+{
+#if defined(USE_NEON64)
+    MathUtilNeon64::addScalarArray(dst, scalar, count);
+#elif defined(USE_SSE2)
+    MathUtilSSE::addScalarArray(dst, scalar, count);
+#else
+    MathUtilC::addScalarArray(dst, scalar, count);
+#endif
+}
+
+void MathUtil::multiplyScaledArray(float* dst, const float* src, float scalar, int count)
+{
+#if defined(USE_NEON64)
+    MathUtilNeon64::multiplyScaledArray(dst, src, scalar, count);
+#elif defined(USE_SSE2)
+    MathUtilSSE::multiplyScaledArray(dst, src, scalar, count);
+#else
+    MathUtilC::multiplyScaledArray(dst, src, scalar, count);
+#endif
+}
+
+void MathUtil::clampMinArray(float* dst, float minValue, int count)
+{
+#if defined(USE_NEON64)
+    MathUtilNeon64::clampMinArray(dst, minValue, count);
+#elif defined(USE_SSE2)
+    MathUtilSSE::clampMinArray(dst, minValue, count);
+#else
+    MathUtilC::clampMinArray(dst, minValue, count);
+#endif
+}
+
+int MathUtil::findLessEqual(const float* src, float value, int start, int count)
+{
+#if defined(USE_NEON64)
+    return MathUtilNeon64::findLessEqual(src, value, start, count);
+#elif defined(USE_SSE2)
+    return MathUtilSSE::findLessEqual(src, value, start, count);
+#else
+    return MathUtilC::findLessEqual(src, value, start, count);
+#endif
+}
+
+void MathUtil::sinCosArray(const float* angles, float scale, float* sinDst, float* cosDst, int count)
+{
+#if defined(USE_NEON64)
+    MathUtilNeon64::sinCosArray(angles, scale, sinDst, cosDst, count);
+#elif defined(USE_SSE2)
+    MathUtilSSE::sinCosArray(angles, scale, sinDst, cosDst, count);
+#else
+    MathUtilC::sinCosArray(angles, scale, sinDst, cosDst, count);
+#endif
+}
+
+void MathUtil::accelerateRadialTangential(float* posX,
+                                          float* posY,
+                                          float* dirX,
+                                          float* dirY,
+                                          const float* radialAccel,
+                                          const float* tangentialAccel,
+                                          float gravityX,
+                                          float gravityY,
+                                          float dt,
+                                          float posScale,
+                                          int count)
+{
+#if defined(USE_NEON64)
+    MathUtilNeon64::accelerateRadialTangential(posX, posY, dirX, dirY, radialAccel, tangentialAccel, gravityX, gravityY,
+                                               dt, posScale, count);
+#elif defined(USE_SSE2)
+    MathUtilSSE::accelerateRadialTangential(posX, posY, dirX, dirY, radialAccel, tangentialAccel, gravityX, gravityY,
+                                            dt, posScale, count);
+#else
+    MathUtilC::accelerateRadialTangential(posX, posY, dirX, dirY, radialAccel, tangentialAccel, gravityX, gravityY, dt,
+                                          posScale, count);
+#endif
+}
+
+void MathUtil::packColorsRGBA8(const float* r,
+                               const float* g,
+                               const float* b,
+                               const float* a,
+                               bool premultiplyAlpha,
+                               unsigned char* dst,
+                               int count)
+{
+#if defined(USE_NEON64)
+    MathUtilNeon64::packColorsRGBA8(r, g, b, a, premultiplyAlpha, dst, count);
+#elif defined(USE_SSE2)
+    MathUtilSSE::packColorsRGBA8(r, g, b, a, premultiplyAlpha, dst, count);
+#else
+    MathUtilC::packColorsRGBA8(r, g, b, a, premultiplyAlpha, dst, count);
+#endif
+}
+
 NS_CC_MATH_END
@@ -88,6 +88,78 @@ public:
      */
     static float lerp(float from, float to, float alpha);
 
+    /**
+     * Adds the scaled source array to the destination array, dst[i] += src[i] * scalar.
+     * Like the other array functions, it uses SSE or NEON when available.
+     *
+     * @param dst The destination array.
+     * @param src The source array.
+     * @param scalar The scale applied to the source elements.
+     * @param count The number of elements.
+     */
+    static void addScaledArray(float* dst, const float* src, float scalar, int count);
+
+    /**
+     * Adds a scalar to each element of the array, dst[i] += scalar.
+     */
+    static void addScalarArray(float* dst, float scalar, int count);
+
+    /**
+     * Multiplies the destination array by the scaled source array, dst[i] = dst[i] * src[i] * scalar.
+     */
+    static void multiplyScaledArray(float* dst, const float* src, float scalar, int count);
+
+    /**
+     * Clamps each element of the array to a minimum value, dst[i] = max(dst[i], minValue).
+     */
+    static void clampMinArray(float* dst, float minValue, int count);
+
+    /**
+     * Finds the first element which is less than or equal to the value.
+     *
+     * @return The index in [start, count) of the element, or count if there is no such element.
+     */
+    static int findLessEqual(const float* src, float value, int start, int count);
+
+    /**
+     * Computes the sine and cosine of the scaled angles,
+     * sinDst[i] = sin(angles[i] * scale), cosDst[i] = cos(angles[i] * scale).
+     * The SSE and NEON versions use a polynomial approximation, which is accurate to about 1e-6 for angles within a few
+     * thousand radians.
+     */
+    static void sinCosArray(const float* angles, float scale, float* sinDst, float* cosDst, int count);
+
+    /**
+     * Accelerates points along their normalized position (radial) and its perpendicular (tangential) direction plus a
+     * constant gravity, then moves them along their direction:
+     * dir += (normalize(pos) * radialAccel + perpendicular(normalize(pos)) * tangentialAccel + gravity) * dt
+     * pos += dir * dt * posScale
+     */
+    static void accelerateRadialTangential(float* posX,
+                                           float* posY,
+                                           float* dirX,
+                                           float* dirY,
+                                           const float* radialAccel,
+                                           const float* tangentialAccel,
+                                           float gravityX,
+                                           float gravityY,
+                                           float dt,
+                                           float posScale,
+                                           int count);
+
+    /**
+     * Converts normalized color channels to RGBA8 colors, 4 bytes per element in dst.
+     *
+     * @param premultiplyAlpha Whether r, g and b are multiplied by a.
+     */
+    static void packColorsRGBA8(const float* r,
+                                const float* g,
+                                const float* b,
+                                const float* a,
+                                bool premultiplyAlpha,
+                                unsigned char* dst,
+                                int count);
+
 private:
     // Indicates that if neon is enabled
     static bool isNeon32Enabled();
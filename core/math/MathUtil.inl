@@ -42,6 +42,25 @@ public:
     inline static void transformVec4(const float* m, const float* v, float* dst);
     
     inline static void crossVec3(const float* v1, const float* v2, float* dst);
+
+    inline static void addScaledArray(float* dst, const float* src, float scalar, int count);
+
+    inline static void addScalarArray(float* dst, float scalar, int count);
+
+    inline static void multiplyScaledArray(float* dst, const float* src, float scalar, int count);
+
+    inline static void clampMinArray(float* dst, float minValue, int count);
+
+    inline static int findLessEqual(const float* src, float value, int start, int count);
+
+    inline static void sinCosArray(const float* angles, float scale, float* sinDst, float* cosDst, int count);
+
+    inline static void accelerateRadialTangential(float* posX, float* posY, float* dirX, float* dirY,
+                                                  const float* radialAccel, const float* tangentialAccel,
+                                                  float gravityX, float gravityY, float dt, float posScale, int count);
+
+    inline static void packColorsRGBA8(const float* r, const float* g, const float* b, const float* a,
+                                       bool premultiplyAlpha, unsigned char* dst, int count);
 };
 
 inline void MathUtilC::addMatrix(const float* m, float scalar, float* dst)
@@ -215,4 +234,90 @@ inline void MathUtilC::crossVec3(const float* v1, const float* v2, float* dst)
     dst[2] = z;
 }
 
+inline void MathUtilC::addScaledArray(float* dst, const float* src, float scalar, int count)
+{
+    for (int i = 0; i < count; ++i)
+        dst[i] += src[i] * scalar;
+}
+
+inline void MathUtilC::addScalarArray(float* dst, float scalar, int count)
+{
+    for (int i = 0; i < count; ++i)
+        dst[i] += scalar;
+}
+
+inline void MathUtilC::multiplyScaledArray(float* dst, const float* src, float scalar, int count)
+{
+    for (int i = 0; i < count; ++i)
+        dst[i] = dst[i] * src[i] * scalar;
+}
+
+inline void MathUtilC::clampMinArray(float* dst, float minValue, int count)
+{
+    for (int i = 0; i < count; ++i)
+        dst[i] = dst[i] < minValue ? minValue : dst[i];
+}
+
+inline int MathUtilC::findLessEqual(const float* src, float value, int start, int count)
+{
+    while (start < count && src[start] > value)
+        ++start;
+    return start;
+}
+
+inline void MathUtilC::sinCosArray(const float* angles, float scale, float* sinDst, float* cosDst, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        float angle = angles[i] * scale;
+        sinDst[i]   = sinf(angle);
+        cosDst[i]   = cosf(angle);
+    }
+}
+
+inline void MathUtilC::accelerateRadialTangential(float* posX, float* posY, float* dirX, float* dirY,
+                                                  const float* radialAccel, const float* tangentialAccel,
+                                                  float gravityX, float gravityY, float dt, float posScale, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        // normalized position, zero if too close to the origin
+        float x = 0.0f, y = 0.0f;
+        float n = sqrtf(posX[i] * posX[i] + posY[i] * posY[i]);
+        if (n >= MATH_TOLERANCE)
+        {
+            n = 1.0f / n;
+            x = posX[i] * n;
+            y = posY[i] * n;
+        }
+
+        // (gravity + radial + tangential) * dt
+        float ax = x * radialAccel[i] + y * -tangentialAccel[i] + gravityX;
+        float ay = y * radialAccel[i] + x * tangentialAccel[i] + gravityY;
+        dirX[i] += ax * dt;
+        dirY[i] += ay * dt;
+
+        posX[i] += dirX[i] * dt * posScale;
+        posY[i] += dirY[i] * dt * posScale;
+    }
+}
+
+inline void MathUtilC::packColorsRGBA8(const float* r, const float* g, const float* b, const float* a,
+                                       bool premultiplyAlpha, unsigned char* dst, int count)
+{
+    // clamp to [0, 255] before truncating, the same as the SIMD versions
+    auto toByte = [](float value) {
+        value *= 255;
+        return static_cast<unsigned char>(value < 0 ? 0 : (value > 255 ? 255 : value));
+    };
+    for (int i = 0; i < count; ++i, dst += 4)
+    {
+        float alpha = premultiplyAlpha ? a[i] : 1.0f;
+        dst[0]      = toByte(r[i] * alpha);
+        dst[1]      = toByte(g[i] * alpha);
+        dst[2]      = toByte(b[i] * alpha);
+        dst[3]      = toByte(a[i]);
+    }
+}
+
 NS_CC_MATH_END
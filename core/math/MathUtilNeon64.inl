@@ -18,6 +18,8 @@
  This file was modified to fit the cocos2d-x project
  */
 
+#include <arm_neon.h>
+
 NS_CC_MATH_BEGIN
 
 class MathUtilNeon64
@@ -42,6 +44,29 @@ public:
     inline static void transformVec4(const float* m, const float* v, float* dst);
     
     inline static void crossVec3(const float* v1, const float* v2, float* dst);
+
+    // The array functions process 4 elements at a time, the remaining ones are done by MathUtilC.
+    inline static void addScaledArray(float* dst, const float* src, float scalar, int count);
+
+    inline static void addScalarArray(float* dst, float scalar, int count);
+
+    inline static void multiplyScaledArray(float* dst, const float* src, float scalar, int count);
+
+    inline static void clampMinArray(float* dst, float minValue, int count);
+
+    inline static int findLessEqual(const float* src, float value, int start, int count);
+
+    inline static void sinCosArray(const float* angles, float scale, float* sinDst, float* cosDst, int count);
+
+    inline static void accelerateRadialTangential(float* posX, float* posY, float* dirX, float* dirY,
+                                                  const float* radialAccel, const float* tangentialAccel,
+                                                  float gravityX, float gravityY, float dt, float posScale, int count);
+
+    inline static void packColorsRGBA8(const float* r, const float* g, const float* b, const float* a,
+                                       bool premultiplyAlpha, unsigned char* dst, int count);
+
+private:
+    inline static void sinCos(float32x4_t x, float32x4_t* s, float32x4_t* c);
 };
 
 inline void MathUtilNeon64::addMatrix(const float* m, float scalar, float* dst)
@@ -262,4 +287,176 @@ inline void MathUtilNeon64::crossVec3(const float* v1, const float* v2, float* d
     );
 }
 
+inline void MathUtilNeon64::addScaledArray(float* dst, const float* src, float scalar, int count)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+        vst1q_f32(dst + i, vmlaq_n_f32(vld1q_f32(dst + i), vld1q_f32(src + i), scalar));
+    MathUtilC::addScaledArray(dst + i, src + i, scalar, count - i);
+}
+
+inline void MathUtilNeon64::addScalarArray(float* dst, float scalar, int count)
+{
+    float32x4_t s = vdupq_n_f32(scalar);
+    int i         = 0;
+    for (; i + 4 <= count; i += 4)
+        vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), s));
+    MathUtilC::addScalarArray(dst + i, scalar, count - i);
+}
+
+inline void MathUtilNeon64::multiplyScaledArray(float* dst, const float* src, float scalar, int count)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+        vst1q_f32(dst + i, vmulq_n_f32(vmulq_f32(vld1q_f32(dst + i), vld1q_f32(src + i)), scalar));
+    MathUtilC::multiplyScaledArray(dst + i, src + i, scalar, count - i);
+}
+
+inline void MathUtilNeon64::clampMinArray(float* dst, float minValue, int count)
+{
+    float32x4_t m = vdupq_n_f32(minValue);
+    int i         = 0;
+    for (; i + 4 <= count; i += 4)
+        vst1q_f32(dst + i, vmaxq_f32(vld1q_f32(dst + i), m));
+    MathUtilC::clampMinArray(dst + i, minValue, count - i);
+}
+
+inline int MathUtilNeon64::findLessEqual(const float* src, float value, int start, int count)
+{
+    float32x4_t v = vdupq_n_f32(value);
+    for (; start + 4 <= count; start += 4)
+    {
+        if (vmaxvq_u32(vcleq_f32(vld1q_f32(src + start), v)))
+            break;
+    }
+    return MathUtilC::findLessEqual(src, value, start, count);
+}
+
+// the single precision sin/cos of cephes, range reduced to [-PI/4, PI/4]
+inline void MathUtilNeon64::sinCos(float32x4_t x, float32x4_t* s, float32x4_t* c)
+{
+    uint32x4_t signSin = vandq_u32(vreinterpretq_u32_f32(x), vdupq_n_u32(0x80000000));
+    x                  = vabsq_f32(x);
+
+    // j = (int)(x * 4 / PI) rounded up to even, the octant of x
+    uint32x4_t j  = vcvtq_u32_f32(vmulq_n_f32(x, 1.27323954473516f));
+    j             = vandq_u32(vaddq_u32(j, vdupq_n_u32(1)), vdupq_n_u32(~1u));
+    float32x4_t y = vcvtq_f32_u32(j);
+
+    uint32x4_t swapSignSin = vshlq_n_u32(vandq_u32(j, vdupq_n_u32(4)), 29);
+    uint32x4_t signCos     = vshlq_n_u32(vbicq_u32(vdupq_n_u32(4), vsubq_u32(j, vdupq_n_u32(2))), 29);
+    uint32x4_t polyMask    = vceqq_u32(vandq_u32(j, vdupq_n_u32(2)), vdupq_n_u32(0));
+    signSin                = veorq_u32(signSin, swapSignSin);
+
+    // x = x - y * PI / 4, in extended precision
+    x = vmlsq_n_f32(x, y, 0.78515625f);
+    x = vmlsq_n_f32(x, y, 2.4187564849853515625e-4f);
+    x = vmlsq_n_f32(x, y, 3.77489497744594108e-8f);
+
+    float32x4_t z = vmulq_f32(x, x);
+
+    // cos polynomial
+    float32x4_t pc = vdupq_n_f32(2.443315711809948e-5f);
+    pc             = vmlaq_f32(vdupq_n_f32(-1.388731625493765e-3f), pc, z);
+    pc             = vmlaq_f32(vdupq_n_f32(4.166664568298827e-2f), pc, z);
+    pc             = vmulq_f32(vmulq_f32(pc, z), z);
+    pc             = vmlsq_n_f32(pc, z, 0.5f);
+    pc             = vaddq_f32(pc, vdupq_n_f32(1.0f));
+
+    // sin polynomial
+    float32x4_t ps = vdupq_n_f32(-1.9515295891e-4f);
+    ps             = vmlaq_f32(vdupq_n_f32(8.3321608736e-3f), ps, z);
+    ps             = vmlaq_f32(vdupq_n_f32(-1.6666654611e-1f), ps, z);
+    ps             = vmlaq_f32(x, vmulq_f32(ps, z), x);
+
+    // select the polynomials by octant
+    float32x4_t sinValue = vbslq_f32(polyMask, ps, pc);
+    float32x4_t cosValue = vbslq_f32(polyMask, pc, ps);
+
+    *s = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(sinValue), signSin));
+    *c = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(cosValue), signCos));
+}
+
+inline void MathUtilNeon64::sinCosArray(const float* angles, float scale, float* sinDst, float* cosDst, int count)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t s, c;
+        sinCos(vmulq_n_f32(vld1q_f32(angles + i), scale), &s, &c);
+        vst1q_f32(sinDst + i, s);
+        vst1q_f32(cosDst + i, c);
+    }
+    MathUtilC::sinCosArray(angles + i, scale, sinDst + i, cosDst + i, count - i);
+}
+
+inline void MathUtilNeon64::accelerateRadialTangential(float* posX, float* posY, float* dirX, float* dirY,
+                                                       const float* radialAccel, const float* tangentialAccel,
+                                                       float gravityX, float gravityY, float dt, float posScale,
+                                                       int count)
+{
+    const float32x4_t one       = vdupq_n_f32(1.0f);
+    const float32x4_t tolerance = vdupq_n_f32(MATH_TOLERANCE);
+    const float32x4_t gx        = vdupq_n_f32(gravityX);
+    const float32x4_t gy        = vdupq_n_f32(gravityY);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t px = vld1q_f32(posX + i);
+        float32x4_t py = vld1q_f32(posY + i);
+
+        // normalized position, zero if too close to the origin
+        float32x4_t n   = vsqrtq_f32(vaddq_f32(vmulq_f32(px, px), vmulq_f32(py, py)));
+        uint32x4_t mask = vcgeq_f32(n, tolerance);
+        n               = vdivq_f32(one, n);
+        float32x4_t x   = vreinterpretq_f32_u32(vandq_u32(mask, vreinterpretq_u32_f32(vmulq_f32(px, n))));
+        float32x4_t y   = vreinterpretq_f32_u32(vandq_u32(mask, vreinterpretq_u32_f32(vmulq_f32(py, n))));
+
+        float32x4_t ra = vld1q_f32(radialAccel + i);
+        float32x4_t ta = vld1q_f32(tangentialAccel + i);
+        float32x4_t ax = vaddq_f32(vaddq_f32(vmulq_f32(x, ra), vmulq_f32(y, vnegq_f32(ta))), gx);
+        float32x4_t ay = vaddq_f32(vaddq_f32(vmulq_f32(y, ra), vmulq_f32(x, ta)), gy);
+
+        float32x4_t dx = vaddq_f32(vld1q_f32(dirX + i), vmulq_n_f32(ax, dt));
+        float32x4_t dy = vaddq_f32(vld1q_f32(dirY + i), vmulq_n_f32(ay, dt));
+        vst1q_f32(dirX + i, dx);
+        vst1q_f32(dirY + i, dy);
+
+        vst1q_f32(posX + i, vaddq_f32(px, vmulq_n_f32(vmulq_n_f32(dx, dt), posScale)));
+        vst1q_f32(posY + i, vaddq_f32(py, vmulq_n_f32(vmulq_n_f32(dy, dt), posScale)));
+    }
+    MathUtilC::accelerateRadialTangential(posX + i, posY + i, dirX + i, dirY + i, radialAccel + i,
+                                          tangentialAccel + i, gravityX, gravityY, dt, posScale, count - i);
+}
+
+inline void MathUtilNeon64::packColorsRGBA8(const float* r, const float* g, const float* b, const float* a,
+                                            bool premultiplyAlpha, unsigned char* dst, int count)
+{
+    const float32x4_t one      = vdupq_n_f32(1.0f);
+    const float32x4_t zero     = vdupq_n_f32(0.0f);
+    const float32x4_t maxValue = vdupq_n_f32(255.0f);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4, dst += 16)
+    {
+        float32x4_t va    = vld1q_f32(a + i);
+        float32x4_t alpha = premultiplyAlpha ? va : one;
+
+        // clamp to [0, 255] before truncating, so channels can be packed without overflow
+        uint32x4_t ri = vcvtq_u32_f32(
+            vminq_f32(vmaxq_f32(vmulq_f32(vmulq_f32(vld1q_f32(r + i), alpha), maxValue), zero), maxValue));
+        uint32x4_t gi = vcvtq_u32_f32(
+            vminq_f32(vmaxq_f32(vmulq_f32(vmulq_f32(vld1q_f32(g + i), alpha), maxValue), zero), maxValue));
+        uint32x4_t bi = vcvtq_u32_f32(
+            vminq_f32(vmaxq_f32(vmulq_f32(vmulq_f32(vld1q_f32(b + i), alpha), maxValue), zero), maxValue));
+        uint32x4_t ai = vcvtq_u32_f32(vminq_f32(vmaxq_f32(vmulq_f32(va, maxValue), zero), maxValue));
+
+        uint32x4_t rgba =
+            vorrq_u32(vorrq_u32(ri, vshlq_n_u32(gi, 8)), vorrq_u32(vshlq_n_u32(bi, 16), vshlq_n_u32(ai, 24)));
+        vst1q_u32(reinterpret_cast<uint32_t*>(dst), rgba);
+    }
+    MathUtilC::packColorsRGBA8(r + i, g + i, b + i, a + i, premultiplyAlpha, dst, count - i);
+}
+
 NS_CC_MATH_END
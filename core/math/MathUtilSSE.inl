@@ -1,3 +1,7 @@
+#ifdef USE_SSE2
+#    include <emmintrin.h>
+#endif
+
 NS_CC_MATH_BEGIN
 
 #ifdef __SSE__
@@ -154,4 +158,224 @@ void MathUtil::transformVec4(const __m128 m[4], const __m128& v, __m128& dst)
 #endif
 
 
+
+#ifdef USE_SSE2
+
+// The array functions process 4 elements at a time, the remaining ones are done by MathUtilC.
+class MathUtilSSE
+{
+public:
+    inline static void addScaledArray(float* dst, const float* src, float scalar, int count);
+
+    inline static void addScalarArray(float* dst, float scalar, int count);
+
+    inline static void multiplyScaledArray(float* dst, const float* src, float scalar, int count);
+
+    inline static void clampMinArray(float* dst, float minValue, int count);
+
+    inline static int findLessEqual(const float* src, float value, int start, int count);
+
+    inline static void sinCosArray(const float* angles, float scale, float* sinDst, float* cosDst, int count);
+
+    inline static void accelerateRadialTangential(float* posX, float* posY, float* dirX, float* dirY,
+                                                  const float* radialAccel, const float* tangentialAccel,
+                                                  float gravityX, float gravityY, float dt, float posScale, int count);
+
+    inline static void packColorsRGBA8(const float* r, const float* g, const float* b, const float* a,
+                                       bool premultiplyAlpha, unsigned char* dst, int count);
+
+private:
+    inline static void sinCos(__m128 x, __m128* s, __m128* c);
+};
+
+inline void MathUtilSSE::addScaledArray(float* dst, const float* src, float scalar, int count)
+{
+    __m128 s = _mm_set1_ps(scalar);
+    int i    = 0;
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), s)));
+    MathUtilC::addScaledArray(dst + i, src + i, scalar, count - i);
+}
+
+inline void MathUtilSSE::addScalarArray(float* dst, float scalar, int count)
+{
+    __m128 s = _mm_set1_ps(scalar);
+    int i    = 0;
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), s));
+    MathUtilC::addScalarArray(dst + i, scalar, count - i);
+}
+
+inline void MathUtilSSE::multiplyScaledArray(float* dst, const float* src, float scalar, int count)
+{
+    __m128 s = _mm_set1_ps(scalar);
+    int i    = 0;
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)), s));
+    MathUtilC::multiplyScaledArray(dst + i, src + i, scalar, count - i);
+}
+
+inline void MathUtilSSE::clampMinArray(float* dst, float minValue, int count)
+{
+    __m128 m = _mm_set1_ps(minValue);
+    int i    = 0;
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(dst + i, _mm_max_ps(_mm_loadu_ps(dst + i), m));
+    MathUtilC::clampMinArray(dst + i, minValue, count - i);
+}
+
+inline int MathUtilSSE::findLessEqual(const float* src, float value, int start, int count)
+{
+    __m128 v = _mm_set1_ps(value);
+    for (; start + 4 <= count; start += 4)
+    {
+        int mask = _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(src + start), v));
+        if (mask)
+        {
+            int offset = 0;
+            while (!(mask & (1 << offset)))
+                ++offset;
+            return start + offset;
+        }
+    }
+    return MathUtilC::findLessEqual(src, value, start, count);
+}
+
+// the single precision sin/cos of cephes, range reduced to [-PI/4, PI/4]
+inline void MathUtilSSE::sinCos(__m128 x, __m128* s, __m128* c)
+{
+    const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+
+    __m128 signSin = _mm_and_ps(x, signMask);
+    x              = _mm_andnot_ps(signMask, x);
+
+    // j = (int)(x * 4 / PI) rounded up to even, the octant of x
+    __m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.27323954473516f)));
+    j         = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+    __m128 y  = _mm_cvtepi32_ps(j);
+
+    __m128 swapSignSin = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, _mm_set1_epi32(4)), 29));
+    __m128 signCos     = _mm_castsi128_ps(
+        _mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(j, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+    __m128 polyMask =
+        _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, _mm_set1_epi32(2)), _mm_setzero_si128()));
+    signSin = _mm_xor_ps(signSin, swapSignSin);
+
+    // x = x - y * PI / 4, in extended precision
+    x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(0.78515625f)));
+    x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(2.4187564849853515625e-4f)));
+    x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(3.77489497744594108e-8f)));
+
+    __m128 z = _mm_mul_ps(x, x);
+
+    // cos polynomial
+    __m128 pc = _mm_set1_ps(2.443315711809948e-5f);
+    pc        = _mm_add_ps(_mm_mul_ps(pc, z), _mm_set1_ps(-1.388731625493765e-3f));
+    pc        = _mm_add_ps(_mm_mul_ps(pc, z), _mm_set1_ps(4.166664568298827e-2f));
+    pc        = _mm_mul_ps(_mm_mul_ps(pc, z), z);
+    pc        = _mm_sub_ps(pc, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+    pc        = _mm_add_ps(pc, _mm_set1_ps(1.0f));
+
+    // sin polynomial
+    __m128 ps = _mm_set1_ps(-1.9515295891e-4f);
+    ps        = _mm_add_ps(_mm_mul_ps(ps, z), _mm_set1_ps(8.3321608736e-3f));
+    ps        = _mm_add_ps(_mm_mul_ps(ps, z), _mm_set1_ps(-1.6666654611e-1f));
+    ps        = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(ps, z), x), x);
+
+    // select the polynomials by octant
+    __m128 sinValue = _mm_or_ps(_mm_and_ps(polyMask, ps), _mm_andnot_ps(polyMask, pc));
+    __m128 cosValue = _mm_or_ps(_mm_and_ps(polyMask, pc), _mm_andnot_ps(polyMask, ps));
+
+    *s = _mm_xor_ps(sinValue, signSin);
+    *c = _mm_xor_ps(cosValue, signCos);
+}
+
+inline void MathUtilSSE::sinCosArray(const float* angles, float scale, float* sinDst, float* cosDst, int count)
+{
+    __m128 sc = _mm_set1_ps(scale);
+    int i     = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 s, c;
+        sinCos(_mm_mul_ps(_mm_loadu_ps(angles + i), sc), &s, &c);
+        _mm_storeu_ps(sinDst + i, s);
+        _mm_storeu_ps(cosDst + i, c);
+    }
+    MathUtilC::sinCosArray(angles + i, scale, sinDst + i, cosDst + i, count - i);
+}
+
+inline void MathUtilSSE::accelerateRadialTangential(float* posX, float* posY, float* dirX, float* dirY,
+                                                    const float* radialAccel, const float* tangentialAccel,
+                                                    float gravityX, float gravityY, float dt, float posScale,
+                                                    int count)
+{
+    const __m128 one       = _mm_set1_ps(1.0f);
+    const __m128 tolerance = _mm_set1_ps(MATH_TOLERANCE);
+    const __m128 signMask  = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+    const __m128 gx        = _mm_set1_ps(gravityX);
+    const __m128 gy        = _mm_set1_ps(gravityY);
+    const __m128 t         = _mm_set1_ps(dt);
+    const __m128 scale     = _mm_set1_ps(posScale);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 px = _mm_loadu_ps(posX + i);
+        __m128 py = _mm_loadu_ps(posY + i);
+
+        // normalized position, zero if too close to the origin
+        __m128 n    = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(px, px), _mm_mul_ps(py, py)));
+        __m128 mask = _mm_cmpge_ps(n, tolerance);
+        n           = _mm_div_ps(one, n);
+        __m128 x    = _mm_and_ps(mask, _mm_mul_ps(px, n));
+        __m128 y    = _mm_and_ps(mask, _mm_mul_ps(py, n));
+
+        __m128 ra = _mm_loadu_ps(radialAccel + i);
+        __m128 ta = _mm_loadu_ps(tangentialAccel + i);
+        __m128 ax = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, ra), _mm_mul_ps(y, _mm_xor_ps(ta, signMask))), gx);
+        __m128 ay = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, ra), _mm_mul_ps(x, ta)), gy);
+
+        __m128 dx = _mm_add_ps(_mm_loadu_ps(dirX + i), _mm_mul_ps(ax, t));
+        __m128 dy = _mm_add_ps(_mm_loadu_ps(dirY + i), _mm_mul_ps(ay, t));
+        _mm_storeu_ps(dirX + i, dx);
+        _mm_storeu_ps(dirY + i, dy);
+
+        _mm_storeu_ps(posX + i, _mm_add_ps(px, _mm_mul_ps(_mm_mul_ps(dx, t), scale)));
+        _mm_storeu_ps(posY + i, _mm_add_ps(py, _mm_mul_ps(_mm_mul_ps(dy, t), scale)));
+    }
+    MathUtilC::accelerateRadialTangential(posX + i, posY + i, dirX + i, dirY + i, radialAccel + i,
+                                          tangentialAccel + i, gravityX, gravityY, dt, posScale, count - i);
+}
+
+inline void MathUtilSSE::packColorsRGBA8(const float* r, const float* g, const float* b, const float* a,
+                                         bool premultiplyAlpha, unsigned char* dst, int count)
+{
+    const __m128 one      = _mm_set1_ps(1.0f);
+    const __m128 zero     = _mm_setzero_ps();
+    const __m128 maxValue = _mm_set1_ps(255.0f);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4, dst += 16)
+    {
+        __m128 va    = _mm_loadu_ps(a + i);
+        __m128 alpha = premultiplyAlpha ? va : one;
+
+        // clamp to [0, 255] before truncating, so channels can be packed without overflow
+        __m128i ri = _mm_cvttps_epi32(
+            _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(r + i), alpha), maxValue), zero), maxValue));
+        __m128i gi = _mm_cvttps_epi32(
+            _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(g + i), alpha), maxValue), zero), maxValue));
+        __m128i bi = _mm_cvttps_epi32(
+            _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(b + i), alpha), maxValue), zero), maxValue));
+        __m128i ai = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(va, maxValue), zero), maxValue));
+
+        __m128i rgba = _mm_or_si128(_mm_or_si128(ri, _mm_slli_epi32(gi, 8)),
+                                    _mm_or_si128(_mm_slli_epi32(bi, 16), _mm_slli_epi32(ai, 24)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), rgba);
+    }
+    MathUtilC::packColorsRGBA8(r + i, g + i, b + i, a + i, premultiplyAlpha, dst, count - i);
+}
+
+#endif  // USE_SSE2
+
 NS_CC_MATH_END
@@ -40,6 +40,7 @@
 #include "platform/CCFileStream.h"
 #include "openssl/md5.h"
 #include "yasio/xxsocket.hpp"
+#include "xxhash.h"
 
 // **NOTE**
 // In the file:
@@ -51,6 +52,7 @@
 //   https://curl.se/libcurl/c/curl_easy_setopt.html
 
 #define CC_CURL_POLL_TIMEOUT_MS 50  // wait until DNS query done
+#define CC_CHUNK_MAX_RETRIES 2      // times a failed range chunk restarts before the task fails
 
 enum
 {
@@ -66,6 +68,27 @@ namespace network
 ////////////////////////////////////////////////////////////////////////////////
 //  Implementation DownloadTaskCURL
 
+class DownloadTaskCURL;
+
+// One HTTP Range request of a chunked file task, written at its own offset of the temp file
+struct DownloadChunkCURL
+{
+    DownloadTaskCURL* owner  = nullptr;
+    CURL* handle             = nullptr;
+    XXH64_state_t* hashState = nullptr;  // hash of the chunk bytes, recorded in the resume manifest
+
+    int index       = 0;
+    int64_t begin   = 0;
+    int64_t length  = 0;
+    int64_t written = 0;
+    double speed    = 0;
+    int retries     = 0;
+
+    bool done         = false;
+    bool rangeChecked = false;
+    bool rangeIgnored = false;  // the server replied the whole file instead of the requested range
+};
+
 class DownloadTaskCURL : public IDownloadTask
 {
     static int _sSerialId;
@@ -99,6 +122,10 @@ public:
 
         _fs.reset();
         _fsMd5.reset();
+        _fsManifest.reset();
+
+        for (auto& chunk : _chunks)
+            XXH64_freeState(chunk.hashState);
 
         if (_requestHeaders)
             curl_slist_free_all(_requestHeaders);
@@ -171,6 +198,7 @@ public:
 
             // init md5 state
             _checksumFileName = _tempFileName + ".chksum";
+            _manifestFileName = _tempFileName + ".manifest";
 
             _fsMd5 = FileUtils::getInstance()->openFileStream(_checksumFileName, FileStream::Mode::OVERLAPPED);
             if(!_fsMd5) {
@@ -204,11 +232,9 @@ public:
         if (!_cancelled)
         {
             _cancelled = true;
-            if (this->_sockfd != -1)
-            {
-                ::shutdown(this->_sockfd, SD_BOTH);  // may cause curl CURLE_SEND_ERROR(55) or CURLE_RECV_ERROR(56)
-                this->_sockfd = -1;
-            }
+            // a chunked task owns one socket per range request
+            for (auto sockfd : this->_sockets)
+                ::shutdown(sockfd, SD_BOTH);  // may cause curl CURLE_SEND_ERROR(55) or CURLE_RECV_ERROR(56)
         }
     }
 
@@ -218,12 +244,24 @@ public:
 
         if (!_cancelled)
         {
-            this->_sockfd = ::socket(addr->family, addr->socktype, addr->protocol);
-            return this->_sockfd;
+            auto sockfd = ::socket(addr->family, addr->socktype, addr->protocol);
+            if (sockfd != -1)
+                this->_sockets.push_back(sockfd);
+            return sockfd;
         }
         return -1;
     }
 
+    int closeSocket(curl_socket_t sockfd)
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+        auto it = std::find(this->_sockets.begin(), this->_sockets.end(), sockfd);
+        if (it != this->_sockets.end())
+            this->_sockets.erase(it);
+        return ::closesocket(sockfd);
+    }
+
     /*
     retval: 0. don't check, 1. check succeed, 2. check failed
     */
@@ -298,6 +336,238 @@ public:
         return ret;
     }
 
+    // build the chunk list of a large file task, chunks recorded in the manifest of a previous run are kept
+    // when the remote file looks unchanged and their bytes in the temp file still match the recorded hash
+    bool initChunksProc(int64_t totalSize, int64_t chunkSize, std::string_view validator)
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        auto pFileUtils = FileUtils::getInstance();
+
+        auto count     = static_cast<int>((totalSize + chunkSize - 1) / chunkSize);
+        auto signature = StringUtils::format("chunks %" PRId64 " %" PRId64 " ", totalSize, chunkSize);
+        signature.append(validator.empty() ? "-" : validator);
+
+        std::vector<std::pair<bool, uint64_t>> recorded(count);
+        bool resume   = false;
+        auto manifest = pFileUtils->getStringFromFile(_manifestFileName);
+        auto eol      = manifest.find('\n');
+        if (eol != std::string::npos && std::string_view{manifest}.substr(0, eol) == signature)
+        {
+            resume = true;
+
+            const char* p = manifest.c_str() + eol + 1;
+            int index = 0, consumed = 0;
+            unsigned long long hash = 0;
+            while (sscanf(p, "%d %llx\n%n", &index, &hash, &consumed) == 2 && consumed > 0)
+            {
+                if (index >= 0 && index < count)
+                    recorded[index] = std::make_pair(true, static_cast<uint64_t>(hash));
+                p += consumed;
+            }
+        }
+
+        // whatever the temp file holds without a matching manifest can't be mapped to chunks
+        _fs.reset();
+        if (!resume)
+            pFileUtils->removeFile(_tempFileName);
+        _fs = pFileUtils->openFileStream(_tempFileName, FileStream::Mode::OVERLAPPED);
+        if (!_fs)
+        {
+            _errCode         = DownloadTask::ERROR_OPEN_FILE_FAILED;
+            _errCodeInternal = 0;
+            _errDescription  = "Can't open file:";
+            _errDescription.append(_tempFileName);
+            return false;
+        }
+
+        // reserve the whole file up front so every chunk is written at its own offset,
+        // the gaps stay sparse on most file systems
+        if (_fs->size() < totalSize)
+        {
+            _fs->seek(totalSize - 1, SEEK_SET);
+            _fs->write("", 1);
+        }
+
+        _fsManifest = pFileUtils->openFileStream(_manifestFileName, FileStream::Mode::WRITE);
+        if (!_fsManifest)
+        {
+            _errCode         = DownloadTask::ERROR_OPEN_FILE_FAILED;
+            _errCodeInternal = 0;
+            _errDescription  = "Can't open manifest file:";
+            _errDescription.append(_manifestFileName);
+            return false;
+        }
+        signature.push_back('\n');
+        _fsManifest->write(signature.data(), static_cast<unsigned int>(signature.size()));
+
+        std::vector<unsigned char> buf;
+        _chunks.resize(count);
+        _totalBytesReceived = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            auto& chunk     = _chunks[i];
+            chunk.owner     = this;
+            chunk.index     = i;
+            chunk.begin     = i * chunkSize;
+            chunk.length    = (std::min)(chunkSize, totalSize - chunk.begin);
+            chunk.hashState = XXH64_createState();
+            XXH64_reset(chunk.hashState, 0);
+
+            if (recorded[i].first && verifyChunkProc(chunk, recorded[i].second, buf))
+            {
+                chunk.done    = true;
+                chunk.written = chunk.length;
+                _totalBytesReceived += chunk.length;
+                writeManifestProc(i, recorded[i].second);
+            }
+        }
+
+        // the md5 of a chunked file is computed once all chunks are on disk
+        MD5_Init(&_md5State);
+        _fsMd5->seek(0, SEEK_SET);
+        _fsMd5->write(&_md5State, sizeof(_md5State));
+
+        _chunked = true;
+        return true;
+    }
+
+    bool verifyChunkProc(const DownloadChunkCURL& chunk, uint64_t hash, std::vector<unsigned char>& buf)
+    {
+        buf.resize(static_cast<size_t>(chunk.length));
+        _fs->seek(chunk.begin, SEEK_SET);
+        if (_fs->read(buf.data(), static_cast<unsigned int>(chunk.length)) != chunk.length)
+            return false;
+        return XXH64(buf.data(), buf.size(), 0) == hash;
+    }
+
+    void writeManifestProc(int index, uint64_t hash)
+    {
+        char line[64];
+        int len = sprintf(line, "%d %016llx\n", index, static_cast<unsigned long long>(hash));
+        _fsManifest->write(line, len);
+    }
+
+    // a previous chunked run preallocated the temp file, it can't be resumed by a sequential download
+    void discardChunksProc()
+    {
+        auto pFileUtils = FileUtils::getInstance();
+        if (_manifestFileName.empty() || !pFileUtils->isFileExistInternal(_manifestFileName))
+            return;
+
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        _fs.reset();
+        pFileUtils->removeFile(_manifestFileName);
+        pFileUtils->removeFile(_tempFileName);
+        _fs = pFileUtils->openFileStream(_tempFileName, FileStream::Mode::APPEND);
+
+        MD5_Init(&_md5State);
+        _fsMd5->seek(0, SEEK_SET);
+        _fsMd5->write(&_md5State, sizeof(_md5State));
+    }
+
+    DownloadChunkCURL* nextChunkProc()
+    {
+        while (_nextChunk < _chunks.size())
+        {
+            auto& chunk = _chunks[_nextChunk++];
+            if (!chunk.done)
+                return &chunk;
+        }
+        return nullptr;
+    }
+
+    DownloadChunkCURL* findChunkProc(CURL* handle)
+    {
+        for (auto& chunk : _chunks)
+        {
+            if (chunk.handle == handle)
+                return &chunk;
+        }
+        return nullptr;
+    }
+
+    // restart a failed chunk from its first byte
+    void resetChunkProc(DownloadChunkCURL& chunk)
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        _totalBytesReceived -= chunk.written;
+        chunk.written      = 0;
+        chunk.rangeChecked = false;
+        XXH64_reset(chunk.hashState, 0);
+    }
+
+    void finishChunkProc(DownloadChunkCURL& chunk)
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        chunk.done = true;
+        writeManifestProc(chunk.index, XXH64_digest(chunk.hashState));
+    }
+
+    // chunks of one task fail independently, keep the error which stopped the task
+    void setChunkErrorProc(int codeInternal, const char* desc)
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        if (_errCode == DownloadTask::ERROR_NO_ERROR)
+        {
+            _errCode         = DownloadTask::ERROR_IMPL_INTERNAL;
+            _errCodeInternal = codeInternal;
+            _errDescription  = desc;
+        }
+    }
+
+    size_t writeChunkProc(DownloadChunkCURL& chunk, unsigned char* buffer, size_t size, size_t count)
+    {
+        auto bytes_transferred = size * count;
+
+        if (!chunk.rangeChecked)
+        {
+            // a server ignoring the Range header replies the whole file, which must not land at the chunk offset
+            long httpResponseCode = 0;
+            curl_easy_getinfo(chunk.handle, CURLINFO_RESPONSE_CODE, &httpResponseCode);
+            chunk.rangeChecked = true;
+            chunk.rangeIgnored = httpResponseCode != 206;
+        }
+        if (chunk.rangeIgnored || chunk.written + static_cast<int64_t>(bytes_transferred) > chunk.length)
+            return 0;  // abort the transfer with CURLE_WRITE_ERROR
+
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        _fs->seek(chunk.begin + chunk.written, SEEK_SET);
+        int ret = _fs->write(buffer, static_cast<unsigned int>(bytes_transferred));
+        if (ret <= 0)
+            return 0;
+
+        XXH64_update(chunk.hashState, buffer, ret);
+        chunk.written += ret;
+        _bytesReceived += ret;
+        _totalBytesReceived += ret;
+
+        curl_easy_getinfo(chunk.handle, CURLINFO_SPEED_DOWNLOAD, &chunk.speed);
+        _speed = 0;
+        for (auto& other : _chunks)
+        {
+            if (other.handle)
+                _speed += other.speed;
+        }
+
+        return ret;
+    }
+
+    // the whole file md5 can't be updated while chunks arrive out of order
+    void updateFileMd5Proc()
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        MD5_Init(&_md5State);
+
+        std::vector<unsigned char> buf(64 * 1024);
+        _fs->seek(0, SEEK_SET);
+        int len = 0;
+        while ((len = _fs->read(buf.data(), static_cast<unsigned int>(buf.size()))) > 0)
+            ::MD5_Update(&_md5State, buf.data(), len);
+
+        _fsMd5->seek(0, SEEK_SET);
+        _fsMd5->write(&_md5State, sizeof(_md5State));
+    }
+
 private:
     friend class DownloaderCURL;
 
@@ -311,8 +581,8 @@ private:
 
     double _speed;
     CURL* _curl;
-    curl_socket_t _sockfd = -1;  // store the sockfd to support cancel download manually
-    bool _cancelled       = false;
+    std::vector<curl_socket_t> _sockets;  // store the sockets to support cancel download manually
+    bool _cancelled = false;
 
     std::string _header;  // temp buffer for receive header string, only used in thread proc
 
@@ -338,6 +608,14 @@ private:
     std::unique_ptr<FileStream> _fsMd5{};  // store md5 state realtime
     MD5state_st _md5State;
 
+    // parallel range download of large files
+    bool _chunked = false;
+    std::string _manifestFileName;
+    std::unique_ptr<FileStream> _fsManifest{};  // records the hash of every finished chunk for resume
+    std::vector<DownloadChunkCURL> _chunks;
+    size_t _nextChunk = 0;
+    int _activeChunks = 0;
+
     void _initInternal()
     {
         _acceptRanges       = (false);
@@ -351,6 +629,13 @@ private:
         _errCodeInternal    = (CURLE_OK);
         _header.resize(0);
         _header.reserve(384);  // pre alloc header string buffer
+
+        for (auto& chunk : _chunks)
+            XXH64_freeState(chunk.hashState);
+        _chunks.clear();
+        _chunked      = false;
+        _nextChunk    = 0;
+        _activeChunks = 0;
     }
 };
 int DownloadTaskCURL::_sSerialId;
@@ -467,6 +752,12 @@ private:
         return coTask->writeDataProc((unsigned char*)buffer, size, count);
     }
 
+    static size_t _outputChunkCallbackProc(void* buffer, size_t size, size_t count, void* userdata)
+    {
+        DownloadChunkCURL* chunk = (DownloadChunkCURL*)userdata;
+        return chunk->owner->writeChunkProc(*chunk, (unsigned char*)buffer, size, count);
+    }
+
     static int _progressCallbackProc(void* ptr,
                                      double totalToDownload,
                                      double nowDownloaded,
@@ -492,6 +783,40 @@ private:
         return pTask.openSocket(propose, addr);
     }
 
+    static int _closeSocketCallback(DownloadTaskCURL& pTask, curl_socket_t sockfd)
+    {
+        return pTask.closeSocket(sockfd);
+    }
+
+    // returns the value of the last occurrence of a response header, redirects leave several responses in
+    // the header buffer
+    static std::string _getHeaderValue(std::string_view header, std::string_view name)
+    {
+        std::string value;
+        size_t offset = 0;
+        while (offset < header.length())
+        {
+            auto eol = header.find('\n', offset);
+            if (eol == std::string_view::npos)
+                eol = header.length();
+            auto line = header.substr(offset, eol - offset);
+            offset    = eol + 1;
+
+            auto colon = line.find(':');
+            if (colon != name.length() ||
+                !std::equal(name.begin(), name.end(), line.begin(), [](char lhs, char rhs) {
+                    return ::tolower(static_cast<unsigned char>(lhs)) == ::tolower(static_cast<unsigned char>(rhs));
+                }))
+                continue;
+
+            auto first = line.find_first_not_of(" \t", colon + 1);
+            auto last  = line.find_last_not_of(" \t\r");
+            value      = first != std::string_view::npos && last >= first ? line.substr(first, last - first + 1)
+                                                                          : std::string_view{};
+        }
+        return value;
+    }
+
     // this function designed call in work thread
     // the curl handle destroyed in _threadProc
     // handle inited for get header
@@ -532,11 +857,13 @@ private:
 
         curl_easy_setopt(handle, CURLOPT_OPENSOCKETFUNCTION, _openSocketCallback);
         curl_easy_setopt(handle, CURLOPT_OPENSOCKETDATA, coTask);
+        curl_easy_setopt(handle, CURLOPT_CLOSESOCKETFUNCTION, _closeSocketCallback);
+        curl_easy_setopt(handle, CURLOPT_CLOSESOCKETDATA, coTask);
 
         if (forContent)
         {
             /** if server acceptRanges and local has part of file, we continue to download **/
-            if (coTask->_acceptRanges && coTask->_totalBytesReceived > 0)
+            if (coTask->_acceptRanges && coTask->_totalBytesReceived > 0 && !coTask->_chunked)
             {
                 char buf[128];
                 sprintf(buf, "%" PRId64 "-", coTask->_totalBytesReceived);
@@ -614,6 +941,25 @@ private:
                 break;
             }
 
+            // large files are fetched as parallel range requests when the server accepts ranges
+            auto totalSize = static_cast<int64_t>(contentLen);
+            if (hints.chunkedDownloadThreshold > 0 && hints.chunkSize > 0 && coTask->_tempFileName.length() &&
+                totalSize >= hints.chunkedDownloadThreshold &&
+                _getHeaderValue(coTask->_header, "Accept-Ranges") == "bytes")
+            {
+                // chunks of a previous run are only reused if the remote file looks unchanged
+                auto validator = _getHeaderValue(coTask->_header, "ETag");
+                if (validator.empty())
+                    validator = _getHeaderValue(coTask->_header, "Last-Modified");
+
+                std::lock_guard<std::recursive_mutex> lock(coTask->_mutex);
+                coTask->_totalBytesExpected = totalSize;
+                coTask->_acceptRanges       = true;
+                coTask->_headerAchieved     = coTask->initChunksProc(totalSize, hints.chunkSize, validator);
+                break;
+            }
+            coTask->discardChunksProc();
+
             // std::transform(coTask._header.begin(), coTask._header.end(), coTask._header.begin(), ::toupper);
             bool acceptRanges = true;  // (string::npos != coTask._header.find("ACCEPT-RANGES")) ? true : false;
 
@@ -642,6 +988,117 @@ private:
         return coTask->_headerAchieved;
     }
 
+    // set handle to download the byte range of chunk and add it to the multi handle
+    bool _startChunkProc(std::shared_ptr<DownloadTask>& task,
+                         DownloadChunkCURL& chunk,
+                         CURL* handle,
+                         CURLM* curlmHandle)
+    {
+        DownloadTaskCURL* coTask = static_cast<DownloadTaskCURL*>(task->_coTask.get());
+
+        curl_easy_reset(handle);
+        _initCurlHandleProc(handle, task, true);
+        curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, _outputChunkCallbackProc);
+        curl_easy_setopt(handle, CURLOPT_WRITEDATA, &chunk);
+
+        char buf[128];
+        sprintf(buf, "%" PRId64 "-%" PRId64, chunk.begin, chunk.begin + chunk.length - 1);
+        curl_easy_setopt(handle, CURLOPT_RANGE, buf);
+
+        chunk.handle = handle;
+        auto mcode   = curl_multi_add_handle(curlmHandle, handle);
+        if (CURLM_OK != mcode)
+        {
+            chunk.handle = nullptr;
+            coTask->setChunkErrorProc(mcode, curl_multi_strerror(mcode));
+            return false;
+        }
+        ++coTask->_activeChunks;
+        return true;
+    }
+
+    // start pending chunks of task up to the per task limit, the first one reuses handle,
+    // returns whether handle was reused
+    bool _startChunksProc(std::shared_ptr<DownloadTask>& task,
+                          CURL* handle,
+                          CURLM* curlmHandle,
+                          std::unordered_map<CURL*, std::shared_ptr<DownloadTask>>& coTaskMap)
+    {
+        DownloadTaskCURL* coTask = static_cast<DownloadTaskCURL*>(task->_coTask.get());
+        auto maxChunks           = static_cast<int>((std::max)(hints.countOfMaxChunksPerTask, 1u));
+        bool reused              = false;
+        while (coTask->_activeChunks < maxChunks)
+        {
+            auto chunk = coTask->nextChunkProc();
+            if (!chunk)
+                break;
+
+            CURL* chunkHandle = reused ? curl_easy_init() : handle;
+            if (nullptr == chunkHandle)
+            {
+                coTask->setChunkErrorProc(0, "Alloc curl handle failed.");
+                break;
+            }
+            if (!_startChunkProc(task, *chunk, chunkHandle, curlmHandle))
+            {
+                if (chunkHandle != handle)
+                    curl_easy_cleanup(chunkHandle);
+                break;
+            }
+
+            if (chunkHandle == handle)
+                reused = true;
+            else
+                coTaskMap[chunkHandle] = task;
+        }
+        return reused;
+    }
+
+    // a range request finished, retry it or move the handle to the next pending chunk,
+    // returns whether handle was reused
+    bool _onChunkDoneProc(std::shared_ptr<DownloadTask>& task, CURL* handle, CURLcode errCode, CURLM* curlmHandle)
+    {
+        DownloadTaskCURL* coTask = static_cast<DownloadTaskCURL*>(task->_coTask.get());
+        auto chunk               = coTask->findChunkProc(handle);
+        if (!chunk)
+            return false;
+
+        chunk->handle = nullptr;
+        chunk->speed  = 0;
+        --coTask->_activeChunks;
+
+        if (CURLE_OK == errCode && chunk->written == chunk->length)
+        {
+            coTask->finishChunkProc(*chunk);
+        }
+        else if (chunk->rangeIgnored)
+        {
+            // the server can't resume, _onDownloadFinished removes the temp files on CURLE_RANGE_ERROR
+            coTask->setChunkErrorProc(CURLE_RANGE_ERROR, "The server ignored the range request of a chunk.");
+        }
+        else if (!coTask->_cancelled && chunk->retries < CC_CHUNK_MAX_RETRIES &&
+                 DownloadTask::ERROR_NO_ERROR == coTask->_errCode)
+        {
+            DLLOG("    _onChunkDoneProc: retry chunk %d with errCode:%d", chunk->index, errCode);
+            ++chunk->retries;
+            coTask->resetChunkProc(*chunk);
+            return _startChunkProc(task, *chunk, handle, curlmHandle);
+        }
+        else
+        {
+            if (CURLE_OK == errCode)
+                errCode = CURLE_PARTIAL_FILE;
+            coTask->setChunkErrorProc(errCode, curl_easy_strerror(errCode));
+        }
+
+        // stop scheduling once the task failed, it finishes with its last running chunk
+        if (DownloadTask::ERROR_NO_ERROR != coTask->_errCode)
+            return false;
+
+        auto next = coTask->nextChunkProc();
+        return next && _startChunkProc(task, *next, handle, curlmHandle);
+    }
+
     void _threadProc()
     {
         DLLOG("++++DownloaderCURL::Impl::_threadProc begin %p", this);
@@ -740,14 +1197,21 @@ private:
                         CURL* curlHandle = m->easy_handle;
                         CURLcode errCode = m->data.result;
 
-                        auto task = coTaskMap[curlHandle];
+                        auto task   = coTaskMap[curlHandle];
+                        auto coTask = static_cast<DownloadTaskCURL*>(task->_coTask.get());
 
                         // remove from multi-handle
                         curl_multi_remove_handle(curlmHandle, curlHandle);
                         bool reinited = false;
                         do
                         {
-                            auto coTask = static_cast<DownloadTaskCURL*>(task->_coTask.get());
+                            if (coTask->_chunked)
+                            {
+                                // a range request of a chunked task, the handle moves on to the next pending chunk
+                                reinited = _onChunkDoneProc(task, curlHandle, errCode, curlmHandle);
+                                break;
+                            }
+
                             if (CURLE_OK != errCode)
                             {
                                 coTask->setErrorProc(DownloadTask::ERROR_IMPL_INTERNAL, errCode,
@@ -769,6 +1233,13 @@ private:
                                 break;
                             }
 
+                            if (coTask->_chunked)
+                            {
+                                // the header handle takes the first pending chunk
+                                reinited = _startChunksProc(task, curlHandle, curlmHandle, coTaskMap);
+                                break;
+                            }
+
                             // after get header info success
                             // wrapper.second->_totalBytesReceived inited by local file size
                             // if the local file size equal with the content size from header, the file has
@@ -809,6 +1280,15 @@ private:
                         // remove from coTaskMap
                         coTaskMap.erase(curlHandle);
 
+                        if (coTask->_chunked)
+                        {
+                            // the task finishes with its last running range request
+                            if (coTask->_activeChunks > 0)
+                                continue;
+                            if (DownloadTask::ERROR_NO_ERROR == coTask->_errCode && !task->checksum.empty())
+                                coTask->updateFileMd5Proc();
+                        }
+
                         // remove from _processSet
                         {
                             std::lock_guard<std::mutex> lock(_processMutex);
@@ -1043,6 +1523,7 @@ void DownloaderCURL::_onDownloadFinished(DownloadTask& task, int checkState)
             auto pFileUtils = FileUtils::getInstance();
             coTask._fs.reset();
             coTask._fsMd5.reset();
+            coTask._fsManifest.reset();
 
             if (checkState & kCheckSumStateSucceed)  // No need download
             {
@@ -1056,6 +1537,7 @@ void DownloaderCURL::_onDownloadFinished(DownloadTask& task, int checkState)
                     coTask._errDescription  = "";
 
                     pFileUtils->removeFile(coTask._tempFileName);
+                    pFileUtils->removeFile(coTask._manifestFileName);
 
                     onTaskProgress(task, _transferDataToBuffer);
 
@@ -1068,6 +1550,7 @@ void DownloaderCURL::_onDownloadFinished(DownloadTask& task, int checkState)
                     coTask._errDescription  = "Check file md5 succeed, but the origin file is missing!";
                     pFileUtils->removeFile(coTask._checksumFileName);
                     pFileUtils->removeFile(coTask._tempFileName);
+                    pFileUtils->removeFile(coTask._manifestFileName);
                 }
 
                 break;
@@ -1080,6 +1563,7 @@ void DownloaderCURL::_onDownloadFinished(DownloadTask& task, int checkState)
                     // If CURLE_RANGE_ERROR, means the server not support resume from download.
                     pFileUtils->removeFile(coTask._checksumFileName);
                     pFileUtils->removeFile(coTask._tempFileName);
+                    pFileUtils->removeFile(coTask._manifestFileName);
                 }
                 break;
             }
@@ -1109,6 +1593,7 @@ void DownloaderCURL::_onDownloadFinished(DownloadTask& task, int checkState)
 
                 pFileUtils->removeFile(coTask._checksumFileName);
                 pFileUtils->removeFile(coTask._tempFileName);
+                pFileUtils->removeFile(coTask._manifestFileName);
                 break;
             }
 
@@ -1117,6 +1602,7 @@ void DownloaderCURL::_onDownloadFinished(DownloadTask& task, int checkState)
             {
                 // success, remove storage from set
                 DownloadTaskCURL::_sStoragePathSet.erase(coTask._tempFileName);
+                pFileUtils->removeFile(coTask._manifestFileName);
                 break;
             }
 
@@ -102,6 +102,14 @@ public:
     uint32_t countOfMaxProcessingTasks;
     uint32_t timeoutInSeconds;
     std::string tempFileNameSuffix;
+
+    // Files at least this large are fetched as parallel HTTP Range chunks when the server
+    // accepts ranges, 0 disables chunked download.
+    int64_t chunkedDownloadThreshold = 4 * 1024 * 1024;
+    // Size of each range chunk, also the granularity of resume.
+    int64_t chunkSize = 1024 * 1024;
+    // Max number of concurrent range requests per chunked task.
+    uint32_t countOfMaxChunksPerTask = 4;
 };
 
 class CC_DLL Downloader final
@@ -116,6 +116,10 @@ HttpClient::HttpClient()
     , _dispatchOnWorkThread(false)
     , _timeoutForConnect(30)
     , _timeoutForRead(60)
+    , _keepAliveTimeout(15)
+    , _channelStates(HttpClient::MAX_CHANNELS)
+    , _openedConnectionCount(0)
+    , _reusedConnectionCount(0)
     , _cookie(nullptr)
     , _clearResponsePredicate(nullptr)
 {
@@ -141,9 +145,10 @@ HttpClient::HttpClient()
 HttpClient::~HttpClient()
 {
     _scheduler->unscheduleAllForTarget(this);
+    // don't let the closing channels start the pending requests
+    clearPendingResponseQueue();
     delete _service;
 
-    clearPendingResponseQueue();
     clearFinishedResponseQueue();
     if (_cookie)
     {
@@ -183,8 +188,18 @@ bool HttpClient::send(HttpRequest* request)
         return false;
 
     auto response = new HttpResponse(request);
-    processResponse(response, request->getUrl());
-    response->release();
+    if (!response->prepareForProcess(request->getUrl()))
+    {
+        finishResponse(response);
+        return true;
+    }
+
+    // the channels are only handed out on the network thread
+    _pendingResponseQueue.push_back(response);
+    _service->schedule(std::chrono::microseconds(0), [this](io_service&) {
+        dispatchPendingResponses();
+        return true;
+    });
     return true;
 }
 
@@ -210,32 +225,232 @@ int HttpClient::tryTakeAvailChannel()
 
 void HttpClient::processResponse(HttpResponse* response, std::string_view url)
 {
-    auto channelIndex = tryTakeAvailChannel();
     response->retain();
 
-    if (channelIndex != -1)
+    if (!response->prepareForProcess(url))
     {
-        if (response->prepareForProcess(url))
+        finishResponse(response);
+        return;
+    }
+    response->_responseHeaders.clear();  // redirect needs clear old response headers
+
+    if (!startRequest(response))
+        _pendingResponseQueue.push_back(response);
+}
+
+bool HttpClient::startRequest(HttpResponse* response)
+{
+    auto& requestUri = response->getRequestUri();
+    std::string host{requestUri.getScheme()};
+    host.append("://").append(requestUri.getHost()).append(":").append(std::to_string(requestUri.getPort()));
+
+    // prefer an idle connection to the same host
+    for (int channelIndex = 0; channelIndex < HttpClient::MAX_CHANNELS; ++channelIndex)
+    {
+        auto& state = _channelStates[channelIndex];
+        if (state.idle && !state.closing && state.host == host)
         {
-            response->_responseHeaders.clear();  // redirect needs clear old response headers
-            auto& requestUri       = response->getRequestUri();
+            state.idle   = false;
+            state.reused = true;
+            ++_reusedConnectionCount;
+
             auto channelHandle     = _service->channel_at(channelIndex);
             channelHandle->ud_.ptr = response;
-            _service->set_option(YOPT_C_REMOTE_ENDPOINT, channelIndex, requestUri.getHost().data(),
-                                 (int)requestUri.getPort());
-            if (requestUri.isSecure())
-                _service->open(channelIndex, YCK_SSL_CLIENT);
-            else
-                _service->open(channelIndex, YCK_TCP_CLIENT);
+            sendRequest(response, channelHandle, state.transport);
+            return true;
         }
+    }
+
+    auto channelIndex = tryTakeAvailChannel();
+    if (channelIndex == -1)
+        return false;
+
+    auto& state            = _channelStates[channelIndex];
+    state.host             = std::move(host);
+    auto channelHandle     = _service->channel_at(channelIndex);
+    channelHandle->ud_.ptr = response;
+    _service->set_option(YOPT_C_REMOTE_ENDPOINT, channelIndex, requestUri.getHost().data(),
+                         (int)requestUri.getPort());
+    if (requestUri.isSecure())
+        _service->open(channelIndex, YCK_SSL_CLIENT);
+    else
+        _service->open(channelIndex, YCK_TCP_CLIENT);
+    return true;
+}
+
+void HttpClient::dispatchPendingResponses()
+{
+    auto lck = _pendingResponseQueue.get_lock();
+    for (auto it = _pendingResponseQueue.unsafe_begin(); it != _pendingResponseQueue.unsafe_end();)
+    {
+        if (startRequest(*it))
+            it = _pendingResponseQueue.unsafe_erase(it);
         else
+            ++it;
+    }
+
+    // the requests left wait for a free channel, close the idle connections to other hosts for them
+    auto waitingCount = _pendingResponseQueue.unsafe_size();
+    for (int channelIndex = 0; channelIndex < HttpClient::MAX_CHANNELS && waitingCount > 0; ++channelIndex)
+    {
+        auto& state = _channelStates[channelIndex];
+        if (state.idle && !state.closing)
         {
-            finishResponse(response);
+            state.idle    = false;
+            state.closing = true;
+            _service->close(channelIndex);
+            --waitingCount;
         }
     }
+}
+
+void HttpClient::sendRequest(HttpResponse* response, yasio::io_channel* channel, yasio::transport_handle_t transport)
+{
+    obstream obs;
+    bool usePostData = false;
+    auto request     = response->getHttpRequest();
+    switch (request->getRequestType())
+    {
+    case HttpRequest::Type::GET:
+        obs.write_bytes("GET");
+        break;
+    case HttpRequest::Type::POST:
+        obs.write_bytes("POST");
+        usePostData = true;
+        break;
+    case HttpRequest::Type::DELETE:
+        obs.write_bytes("DELETE");
+        break;
+    case HttpRequest::Type::PUT:
+        obs.write_bytes("PUT");
+        usePostData = true;
+        break;
+    default:
+        obs.write_bytes("GET");
+        break;
+    }
+    obs.write_bytes(" ");
+
+    auto& uri = response->getRequestUri();
+    obs.write_bytes(uri.getPath());
+    if (!usePostData)
+    {
+        auto query = uri.getQuery();
+        if (!query.empty())
+        {
+            obs.write_byte('?');
+            obs.write_bytes(query);
+        }
+    }
+    obs.write_bytes(" HTTP/1.1\r\n");
+
+    obs.write_bytes("Host: ");
+    obs.write_bytes(uri.getHost());
+    obs.write_bytes("\r\n");
+
+    // process custom headers
+    struct HeaderFlag
+    {
+        enum
+        {
+            UESR_AGENT   = 1,
+            CONTENT_TYPE = 1 << 1,
+            ACCEPT       = 1 << 2,
+        };
+    };
+    int headerFlags = 0;
+    auto& headers   = request->getHeaders();
+    if (!headers.empty())
+    {
+        using namespace cxx17;  // for string_view literal
+        for (auto& header : headers)
+        {
+            obs.write_bytes(header);
+            obs.write_bytes("\r\n");
+
+            if (cxx20::ic::starts_with(cxx17::string_view{header}, "User-Agent:"_sv))
+                headerFlags |= HeaderFlag::UESR_AGENT;
+            else if (cxx20::ic::starts_with(cxx17::string_view{header}, "Content-Type:"_sv))
+                headerFlags |= HeaderFlag::CONTENT_TYPE;
+            else if (cxx20::ic::starts_with(cxx17::string_view{header}, "Accept:"_sv))
+                headerFlags |= HeaderFlag::ACCEPT;
+        }
+    }
+
+    if (_cookie)
+    {
+        auto cookies = _cookie->checkAndGetFormatedMatchCookies(uri);
+        if (!cookies.empty())
+        {
+            obs.write_bytes("Cookie: ");
+            obs.write_bytes(cookies);
+        }
+    }
+
+    if (!(headerFlags & HeaderFlag::UESR_AGENT))
+        obs.write_bytes("User-Agent: yasio-http\r\n");
+
+    if (!(headerFlags & HeaderFlag::ACCEPT))
+        obs.write_bytes("Accept: */*;q=0.8\r\n");
+
+    if (getKeepAliveTimeout() <= 0)
+        obs.write_bytes("Connection: close\r\n");
+
+    if (usePostData)
+    {
+        if (!(headerFlags & HeaderFlag::CONTENT_TYPE))
+            obs.write_bytes("Content-Type: application/x-www-form-urlencoded;charset=UTF-8\r\n");
+
+        char strContentLength[128] = {0};
+        auto requestData           = request->getRequestData();
+        auto requestDataSize       = request->getRequestDataSize();
+        sprintf(strContentLength, "Content-Length: %d\r\n\r\n", static_cast<int>(requestDataSize));
+        obs.write_bytes(strContentLength);
+
+        if (requestData && requestDataSize > 0)
+            obs.write_bytes(cxx17::string_view{requestData, static_cast<size_t>(requestDataSize)});
+    }
     else
     {
-        _pendingResponseQueue.push_back(response);
+        obs.write_bytes("\r\n");
+    }
+
+    _service->write(transport, std::move(obs.buffer()));
+
+    int channelIndex   = channel->index();
+    auto& timerForRead = channel->get_user_timer();
+    timerForRead.cancel(*_service);
+    timerForRead.expires_from_now(std::chrono::seconds(this->_timeoutForRead));
+    timerForRead.async_wait(*_service, [=](io_service& s) {
+        response->updateInternalCode(yasio::errc::read_timeout);
+        s.close(channelIndex);  // timeout
+        return true;
+    });
+}
+
+void HttpClient::recycleChannel(yasio::io_channel* channel)
+{
+    int channelIndex = channel->index();
+    auto& state      = _channelStates[channelIndex];
+    channel->ud_.ptr = nullptr;
+
+    if (state.transport != nullptr && !state.closing)
+    {
+        // keep the connection for the next request to the same host
+        state.idle = true;
+
+        auto& timerForIdle = channel->get_user_timer();
+        timerForIdle.cancel(*_service);
+        timerForIdle.expires_from_now(std::chrono::seconds(getKeepAliveTimeout()));
+        timerForIdle.async_wait(*_service, [=](io_service& s) {
+            s.close(channelIndex);  // idle timeout
+            return true;
+        });
+    }
+    else
+    {
+        state = ChannelState{};
+        _availChannelQueue.push_front(channelIndex);
     }
 }
 
@@ -243,9 +458,22 @@ void HttpClient::handleNetworkEvent(yasio::io_event* event)
 {
     int channelIndex       = event->cindex();
     auto channel           = _service->channel_at(event->cindex());
+    auto& state            = _channelStates[channelIndex];
     HttpResponse* response = (HttpResponse*)channel->ud_.ptr;
     if (!response)
+    {
+        // an idle connection was closed by the server, by its idle timeout or to serve another host
+        if (event->kind() == YEK_ON_CLOSE)
+        {
+            // the transport is gone, don't keep the channel in the idle pool
+            state.transport = nullptr;
+            state.idle      = false;
+            channel->get_user_timer().cancel(*_service);
+            recycleChannel(channel);
+            dispatchPendingResponses();
+        }
         return;
+    }
 
     bool responseFinished = response->isFinished();
     switch (event->kind())
@@ -254,131 +482,22 @@ void HttpClient::handleNetworkEvent(yasio::io_event* event)
         if (!responseFinished)
             response->handleInput(event->packet());
 
-        if (response->isFinished())
+        if (!responseFinished && response->isFinished())
         {
             response->updateInternalCode(yasio::errc::eof);
-            _service->close(event->cindex());
+            if (getKeepAliveTimeout() > 0 && response->isKeepAlive())
+                handleNetworkEOF(response, channel, yasio::errc::eof);
+            else
+                _service->close(event->cindex());
         }
         break;
     case YEK_ON_OPEN:
         if (event->status() == 0)
         {
-            obstream obs;
-            bool usePostData = false;
-            auto request     = response->getHttpRequest();
-            switch (request->getRequestType())
-            {
-            case HttpRequest::Type::GET:
-                obs.write_bytes("GET");
-                break;
-            case HttpRequest::Type::POST:
-                obs.write_bytes("POST");
-                usePostData = true;
-                break;
-            case HttpRequest::Type::DELETE:
-                obs.write_bytes("DELETE");
-                break;
-            case HttpRequest::Type::PUT:
-                obs.write_bytes("PUT");
-                usePostData = true;
-                break;
-            default:
-                obs.write_bytes("GET");
-                break;
-            }
-            obs.write_bytes(" ");
-
-            auto& uri = response->getRequestUri();
-            obs.write_bytes(uri.getPath());
-            if (!usePostData)
-            {
-                auto query = uri.getQuery();
-                if (!query.empty())
-                {
-                    obs.write_byte('?');
-                    obs.write_bytes(query);
-                }
-            }
-            obs.write_bytes(" HTTP/1.1\r\n");
-
-            obs.write_bytes("Host: ");
-            obs.write_bytes(uri.getHost());
-            obs.write_bytes("\r\n");
-
-            // process custom headers
-            struct HeaderFlag
-            {
-                enum
-                {
-                    UESR_AGENT   = 1,
-                    CONTENT_TYPE = 1 << 1,
-                    ACCEPT       = 1 << 2,
-                };
-            };
-            int headerFlags = 0;
-            auto& headers   = request->getHeaders();
-            if (!headers.empty())
-            {
-                using namespace cxx17;  // for string_view literal
-                for (auto& header : headers)
-                {
-                    obs.write_bytes(header);
-                    obs.write_bytes("\r\n");
-
-                    if (cxx20::ic::starts_with(cxx17::string_view{header}, "User-Agent:"_sv))
-                        headerFlags |= HeaderFlag::UESR_AGENT;
-                    else if (cxx20::ic::starts_with(cxx17::string_view{header}, "Content-Type:"_sv))
-                        headerFlags |= HeaderFlag::CONTENT_TYPE;
-                    else if (cxx20::ic::starts_with(cxx17::string_view{header}, "Accept:"_sv))
-                        headerFlags |= HeaderFlag::ACCEPT;
-                }
-            }
-
-            if (_cookie)
-            {
-                auto cookies = _cookie->checkAndGetFormatedMatchCookies(uri);
-                if (!cookies.empty())
-                {
-                    obs.write_bytes("Cookie: ");
-                    obs.write_bytes(cookies);
-                }
-            }
-
-            if (!(headerFlags & HeaderFlag::UESR_AGENT))
-                obs.write_bytes("User-Agent: yasio-http\r\n");
-
-            if (!(headerFlags & HeaderFlag::ACCEPT))
-                obs.write_bytes("Accept: */*;q=0.8\r\n");
-
-            if (usePostData)
-            {
-                if (!(headerFlags & HeaderFlag::CONTENT_TYPE))
-                    obs.write_bytes("Content-Type: application/x-www-form-urlencoded;charset=UTF-8\r\n");
-
-                char strContentLength[128] = {0};
-                auto requestData           = request->getRequestData();
-                auto requestDataSize       = request->getRequestDataSize();
-                sprintf(strContentLength, "Content-Length: %d\r\n\r\n", static_cast<int>(requestDataSize));
-                obs.write_bytes(strContentLength);
-
-                if (requestData && requestDataSize > 0)
-                    obs.write_bytes(cxx17::string_view{requestData, static_cast<size_t>(requestDataSize)});
-            }
-            else
-            {
-                obs.write_bytes("\r\n");
-            }
-
-            _service->write(event->transport(), std::move(obs.buffer()));
-
-            auto& timerForRead = channel->get_user_timer();
-            timerForRead.cancel(*_service);
-            timerForRead.expires_from_now(std::chrono::seconds(this->_timeoutForRead));
-            timerForRead.async_wait(*_service, [=](io_service& s) {
-                response->updateInternalCode(yasio::errc::read_timeout);
-                s.close(channelIndex);  // timeout
-                return true;
-            });
+            state.transport = event->transport();
+            state.reused    = false;
+            ++_openedConnectionCount;
+            sendRequest(response, channel, state.transport);
         }
         else
         {
@@ -386,6 +505,17 @@ void HttpClient::handleNetworkEvent(yasio::io_event* event)
         }
         break;
     case YEK_ON_CLOSE:
+        state.transport = nullptr;
+        state.idle      = false;
+        // the server may have closed the kept alive connection while the request was sent, send it again once
+        if (state.reused && response->_receivedBytes == 0 && response->getInternalCode() == 0)
+        {
+            channel->get_user_timer().cancel(*_service);
+            recycleChannel(channel);
+            if (!startRequest(response))
+                _pendingResponseQueue.push_front(response);
+            return;
+        }
         handleNetworkEOF(response, channel, event->status());
         break;
     }
@@ -395,6 +525,10 @@ void HttpClient::handleNetworkEOF(HttpResponse* response, yasio::io_channel* cha
 {
     channel->get_user_timer().cancel(*_service);
     response->updateInternalCode(internalErrorCode);
+
+    // the channel stays connected when the response completed on a kept alive connection
+    recycleChannel(channel);
+
     auto responseCode = response->getResponseCode();
     switch (responseCode)
     {
@@ -409,9 +543,9 @@ void HttpClient::handleNetworkEOF(HttpResponse* response, yasio::io_channel* cha
                 if (responseCode == 302)
                     response->getHttpRequest()->setRequestType(HttpRequest::Type::GET);
                 CCLOG("Process url redirect (%d): %s", responseCode, iter->second.c_str());
-                _availChannelQueue.push_front(channel->index());
                 processResponse(response, iter->second);
                 response->release();
+                dispatchPendingResponses();
                 return;
             }
         }
@@ -419,21 +553,8 @@ void HttpClient::handleNetworkEOF(HttpResponse* response, yasio::io_channel* cha
 
     finishResponse(response);
 
-    // recycle channel
-    channel->ud_.ptr = nullptr;
-    _availChannelQueue.push_front(channel->index());
-
     // try process pending response
-    auto lck = _pendingResponseQueue.get_lock();
-    if (!_pendingResponseQueue.unsafe_empty())
-    {
-        auto pendingResponse = _pendingResponseQueue.unsafe_front();
-        _pendingResponseQueue.unsafe_pop_front();
-        lck.unlock();
-
-        processResponse(pendingResponse, pendingResponse->getHttpRequest()->getUrl());
-        pendingResponse->release();
-    }
+    dispatchPendingResponses();
 }
 
 // Poll and notify main thread if responses exists in queue
@@ -530,6 +651,18 @@ int HttpClient::getTimeoutForRead()
     return _timeoutForRead;
 }
 
+void HttpClient::setKeepAliveTimeout(int value)
+{
+    std::lock_guard<std::recursive_mutex> lock(_keepAliveTimeoutMutex);
+    _keepAliveTimeout = value;
+}
+
+int HttpClient::getKeepAliveTimeout()
+{
+    std::lock_guard<std::recursive_mutex> lock(_keepAliveTimeoutMutex);
+    return _keepAliveTimeout;
+}
+
 std::string_view HttpClient::getCookieFilename()
 {
     std::lock_guard<std::recursive_mutex> lock(_cookieFileMutex);
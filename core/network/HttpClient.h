@@ -29,6 +29,7 @@
 #ifndef __CCHTTPCLIENT_H__
 #define __CCHTTPCLIENT_H__
 
+#include <atomic>
 #include <thread>
 #include <condition_variable>
 #include <deque>
@@ -154,6 +155,31 @@ public:
      */
     int getTimeoutForRead();
 
+    /**
+     * Set how long a connection stays open waiting for the next request to the same host.
+     * Requests to a host that has an idle connection are sent on it instead of opening a new one.
+     *
+     * @param value the timeout in seconds, 0 closes the connection after each response. 15 by default.
+     */
+    void setKeepAliveTimeout(int value);
+
+    /**
+     * Get how long a connection stays open waiting for the next request to the same host.
+     *
+     * @return int the timeout in seconds.
+     */
+    int getKeepAliveTimeout();
+
+    /**
+     * Get how many connections were opened since the client was created.
+     */
+    unsigned int getOpenedConnectionCount() const { return _openedConnectionCount; }
+
+    /**
+     * Get how many requests were sent on an already open connection since the client was created.
+     */
+    unsigned int getReusedConnectionCount() const { return _reusedConnectionCount; }
+
     HttpCookie* getCookie() const { return _cookie; }
 
     std::recursive_mutex& getCookieFileMutex() { return _cookieFileMutex; }
@@ -207,8 +233,16 @@ private:
 
     void processResponse(HttpResponse* response, std::string_view url);
 
+    bool startRequest(HttpResponse* response);
+
+    void sendRequest(HttpResponse* response, yasio::io_channel* channel, yasio::transport_handle_t transport);
+
+    void dispatchPendingResponses();
+
     int tryTakeAvailChannel();
 
+    void recycleChannel(yasio::io_channel* channel);
+
     void handleNetworkEvent(yasio::io_event* event);
 
     void handleNetworkEOF(HttpResponse* response, yasio::io_channel* channel, int internalErrorCode);
@@ -220,6 +254,16 @@ private:
     void invokeResposneCallbackAndRelease(HttpResponse* response);
 
 private:
+    // The connection of a channel, only used by the network thread
+    struct ChannelState
+    {
+        std::string host;                               // scheme, host and port the channel is connected to
+        yasio::transport_handle_t transport = nullptr;  // the open connection, kept between requests when alive
+        bool idle    = false;                           // waiting for the next request to the same host
+        bool closing = false;                           // closed to serve a request to another host
+        bool reused  = false;                           // the current request was sent on a kept alive connection
+    };
+
     bool _isInited;
 
     yasio::io_service* _service;
@@ -232,6 +276,13 @@ private:
     int _timeoutForRead;
     std::recursive_mutex _timeoutForReadMutex;
 
+    int _keepAliveTimeout;
+    std::recursive_mutex _keepAliveTimeoutMutex;
+
+    std::vector<ChannelState> _channelStates;
+    std::atomic<unsigned int> _openedConnectionCount;
+    std::atomic<unsigned int> _reusedConnectionCount;
+
     Scheduler* _scheduler;
     std::recursive_mutex _schedulerMutex;
 
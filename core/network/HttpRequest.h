@@ -51,6 +51,7 @@ class HttpClient;
 class HttpResponse;
 
 typedef std::function<void(HttpClient* client, HttpResponse* response)> ccHttpRequestCallback;
+typedef std::function<void(HttpResponse* response, const char* data, size_t len)> ccHttpResponseDataCallback;
 
 /**
  * Defines the object which users must packed for HttpClient::send(HttpRequest*) method.
@@ -210,6 +211,22 @@ public:
      */
     const ccHttpRequestCallback& getCallback() const { return _pCallback; }
 
+    /**
+     * Set a callback receiving the response body as it arrives, the body isn't accumulated in
+     * HttpResponse::getResponseData then. Useful for big downloads or for parsing the body while it's received.
+     *
+     * @param callback the ccHttpResponseDataCallback function.
+     * @note The callback is invoked on the network thread, the response callback is still invoked once finished.
+     */
+    void setResponseDataCallback(const ccHttpResponseDataCallback& callback) { _pDataCallback = callback; }
+
+    /**
+     * Get ccHttpResponseDataCallback callback function.
+     *
+     * @return const ccHttpResponseDataCallback& ccHttpResponseDataCallback callback function.
+     */
+    const ccHttpResponseDataCallback& getResponseDataCallback() const { return _pDataCallback; }
+
     /**
      * Set custom-defined headers.
      *
@@ -247,13 +264,14 @@ private:
 
 protected:
     // properties
-    Type _requestType;                  /// kHttpRequestGet, kHttpRequestPost or other enums
-    std::string _url;                   /// target url that this request is sent to
-    yasio::sbyte_buffer _requestData;   /// used for POST
-    std::string _tag;                   /// user defined tag, to identify different requests in response callback
-    ccHttpRequestCallback _pCallback;   /// C++11 style callbacks
-    void* _pUserData;                   /// You can add your customed data here
-    std::vector<std::string> _headers;  /// custom http headers
+    Type _requestType;                          /// kHttpRequestGet, kHttpRequestPost or other enums
+    std::string _url;                           /// target url that this request is sent to
+    yasio::sbyte_buffer _requestData;           /// used for POST
+    std::string _tag;                           /// user defined tag, to identify different requests in response callback
+    ccHttpRequestCallback _pCallback;           /// C++11 style callbacks
+    ccHttpResponseDataCallback _pDataCallback;  /// receives the response body when set
+    void* _pUserData;                           /// You can add your customed data here
+    std::vector<std::string> _headers;          /// custom http headers
     std::vector<std::string> _hosts;
 
     std::shared_ptr<std::promise<HttpResponse*>> _syncState;
@@ -141,8 +141,14 @@ private:
      */
     bool isFinished() const { return _finished; }
 
+    /**
+     * Whether the response completed and the server lets the connection be used for the next request.
+     */
+    bool isKeepAlive() const { return _responseCode != -1 && llhttp_should_keep_alive(&_context); }
+
     void handleInput(const yasio::sbyte_buffer& data)
     {
+        _receivedBytes += data.size();
         enum llhttp_errno err = llhttp_execute(&_context, data.data(), data.size());
         if (err != HPE_OK)
         {
@@ -161,8 +167,9 @@ private:
         _finished = false;
         _responseData.clear();
         _currentHeader.clear();
-        _responseCode = -1;
-        _internalCode = 0;
+        _responseCode  = -1;
+        _internalCode  = 0;
+        _receivedBytes = 0;
 
         Uri uri = Uri::parse(url);
         if (!uri.isValid())
@@ -223,8 +230,13 @@ private:
     }
     static int on_body(llhttp_t* context, const char* at, size_t length)
     {
-        auto thiz = (HttpResponse*)context->data;
-        thiz->_responseData.insert(thiz->_responseData.end(), at, at + length);
+        auto thiz          = (HttpResponse*)context->data;
+        auto& dataCallback = thiz->_pHttpRequest->getResponseDataCallback();
+        // the body of a redirection isn't the one the user asked for
+        if (dataCallback && context->status_code / 100 != 3)
+            dataCallback(thiz, at, length);
+        else
+            thiz->_responseData.insert(thiz->_responseData.end(), at, at + length);
         return 0;
     }
     static int on_complete(llhttp_t* context)
@@ -248,6 +260,7 @@ protected:
     ResponseHeaderMap _responseHeaders;  /// the returned raw header data. You can also dump it as a string
     int _responseCode = -1;              /// the status code returned from libcurl, e.g. 200, 404
     int _internalCode = 0;               /// the ret code of perform
+    size_t _receivedBytes = 0;           /// bytes received on the connection for this response
     llhttp_t _context;
     llhttp_settings_t _contextSettings;
 };
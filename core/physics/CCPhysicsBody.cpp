@@ -109,6 +109,7 @@ PhysicsBody::PhysicsBody()
     , _recordedAngle(0.0)
     , _recordScaleX(1.f)
     , _recordScaleY(1.f)
+    , _syncedRotation(0.0f)
 {
     _name = COMPONENT_NAME;
 }
@@ -326,8 +327,19 @@ void PhysicsBody::removeJoint(PhysicsJoint* joint)
     }
 }
 
+void PhysicsBody::waitForWorldStep() const
+{
+    // the chipmunk body must not change while the world is stepped on a background thread
+    if (_world)
+    {
+        _world->waitForStep();
+    }
+}
+
 void PhysicsBody::setDynamic(bool dynamic)
 {
+    waitForWorldStep();
+
     if (dynamic != _dynamic)
     {
         _dynamic = dynamic;
@@ -346,6 +358,8 @@ void PhysicsBody::setDynamic(bool dynamic)
 
 void PhysicsBody::setRotationEnable(bool enable)
 {
+    waitForWorldStep();
+
     if (_rotationEnabled != enable)
     {
         cpBodySetMoment(_cpBody, enable ? _moment : PHYSICS_INFINITY);
@@ -355,11 +369,15 @@ void PhysicsBody::setRotationEnable(bool enable)
 
 void PhysicsBody::setGravityEnable(bool enable)
 {
+    waitForWorldStep();
+
     _gravityEnabled = enable;
 }
 
 void PhysicsBody::setRotation(float rotation)
 {
+    waitForWorldStep();
+
     _recordedRotation = rotation;
     _recordedAngle    = -(rotation + _rotationOffset) * (M_PI / 180.0);
     cpBodySetAngle(_cpBody, _recordedAngle);
@@ -367,6 +385,8 @@ void PhysicsBody::setRotation(float rotation)
 
 void PhysicsBody::setScale(float scaleX, float scaleY)
 {
+    waitForWorldStep();
+
     for (auto& shape : _shapes)
     {
         _area -= shape->getArea();
@@ -387,6 +407,8 @@ void PhysicsBody::setScale(float scaleX, float scaleY)
 
 void PhysicsBody::setPosition(float positionX, float positionY)
 {
+    waitForWorldStep();
+
     cpVect tt;
 
     tt.x = positionX + _positionOffset.x;
@@ -397,12 +419,19 @@ void PhysicsBody::setPosition(float positionX, float positionY)
 
 Vec2 PhysicsBody::getPosition() const
 {
+    if (_world && _world->_stepPending)
+    {
+        return _syncedPosition;
+    }
+
     cpVect tt = cpBodyGetPosition(_cpBody);
     return Vec2(tt.x - _positionOffset.x, tt.y - _positionOffset.y);
 }
 
 void PhysicsBody::setPositionOffset(const Vec2& position)
 {
+    waitForWorldStep();
+
     if (!_positionOffset.equals(position))
     {
         Vec2 pos        = getPosition();
@@ -413,6 +442,11 @@ void PhysicsBody::setPositionOffset(const Vec2& position)
 
 float PhysicsBody::getRotation()
 {
+    if (_world && _world->_stepPending)
+    {
+        return _syncedRotation;
+    }
+
     if (_recordedAngle != cpBodyGetAngle(_cpBody))
     {
         _recordedAngle    = cpBodyGetAngle(_cpBody);
@@ -423,6 +457,8 @@ float PhysicsBody::getRotation()
 
 PhysicsShape* PhysicsBody::addShape(PhysicsShape* shape, bool addMassAndMoment /* = true*/)
 {
+    waitForWorldStep();
+
     if (shape == nullptr)
         return nullptr;
 
@@ -453,6 +489,8 @@ PhysicsShape* PhysicsBody::addShape(PhysicsShape* shape, bool addMassAndMoment /
 
 void PhysicsBody::applyForce(const Vec2& force, const Vec2& offset)
 {
+    waitForWorldStep();
+
     if (_dynamic && _mass != PHYSICS_INFINITY)
     {
         cpBodyApplyForceAtLocalPoint(_cpBody, PhysicsHelper::vec22cpv(force), PhysicsHelper::vec22cpv(offset));
@@ -461,21 +499,29 @@ void PhysicsBody::applyForce(const Vec2& force, const Vec2& offset)
 
 void PhysicsBody::resetForces()
 {
+    waitForWorldStep();
+
     cpBodySetForce(_cpBody, PhysicsHelper::vec22cpv(Vec2(0, 0)));
 }
 
 void PhysicsBody::applyImpulse(const Vec2& impulse, const Vec2& offset)
 {
+    waitForWorldStep();
+
     cpBodyApplyImpulseAtLocalPoint(_cpBody, PhysicsHelper::vec22cpv(impulse), PhysicsHelper::vec22cpv(offset));
 }
 
 void PhysicsBody::applyTorque(float torque)
 {
+    waitForWorldStep();
+
     cpBodySetTorque(_cpBody, torque);
 }
 
 void PhysicsBody::setMass(float mass)
 {
+    waitForWorldStep();
+
     if (mass <= 0)
     {
         return;
@@ -510,6 +556,8 @@ void PhysicsBody::setMass(float mass)
 
 void PhysicsBody::addMass(float mass)
 {
+    waitForWorldStep();
+
     if (mass == PHYSICS_INFINITY)
     {
         _mass        = PHYSICS_INFINITY;
@@ -557,6 +605,8 @@ void PhysicsBody::addMass(float mass)
 
 void PhysicsBody::addMoment(float moment)
 {
+    waitForWorldStep();
+
     if (moment == PHYSICS_INFINITY)
     {
         // if moment is PHYSICS_INFINITY, the moment of the body will become PHYSICS_INFINITY
@@ -599,6 +649,8 @@ void PhysicsBody::addMoment(float moment)
 
 void PhysicsBody::setVelocity(const Vec2& velocity)
 {
+    waitForWorldStep();
+
     if (cpBodyGetType(_cpBody) == CP_BODY_TYPE_STATIC)
     {
         CCLOG("physics warning: you can't set velocity for a static body.");
@@ -625,6 +677,8 @@ Vec2 PhysicsBody::getVelocityAtWorldPoint(const Vec2& point)
 
 void PhysicsBody::setAngularVelocity(float velocity)
 {
+    waitForWorldStep();
+
     if (cpBodyGetType(_cpBody) == CP_BODY_TYPE_STATIC)
     {
         CCLOG("physics warning: you can't set angular velocity for a static body.");
@@ -641,6 +695,8 @@ float PhysicsBody::getAngularVelocity()
 
 void PhysicsBody::setVelocityLimit(float limit)
 {
+    waitForWorldStep();
+
     _velocityLimit = limit;
 }
 
@@ -651,6 +707,8 @@ float PhysicsBody::getVelocityLimit()
 
 void PhysicsBody::setAngularVelocityLimit(float limit)
 {
+    waitForWorldStep();
+
     _angularVelocityLimit = limit;
 }
 
@@ -661,6 +719,8 @@ float PhysicsBody::getAngularVelocityLimit()
 
 void PhysicsBody::setMoment(float moment)
 {
+    waitForWorldStep();
+
     _moment          = moment;
     _momentDefault   = false;
     _momentSetByUser = true;
@@ -699,6 +759,8 @@ void PhysicsBody::removeShape(int tag, bool reduceMassAndMoment /* = true*/)
 
 void PhysicsBody::removeShape(PhysicsShape* shape, bool reduceMassAndMoment /* = true*/)
 {
+    waitForWorldStep();
+
     if (_shapes.getIndex(shape) != -1)
     {
         // deduce the area, mass and moment
@@ -725,6 +787,8 @@ void PhysicsBody::removeShape(PhysicsShape* shape, bool reduceMassAndMoment /* =
 
 void PhysicsBody::removeAllShapes(bool reduceMassAndMoment /* = true*/)
 {
+    waitForWorldStep();
+
     for (auto& child : _shapes)
     {
         PhysicsShape* shape = dynamic_cast<PhysicsShape*>(child);
@@ -758,6 +822,8 @@ void PhysicsBody::removeFromWorld()
 
 void PhysicsBody::setEnabled(bool enable)
 {
+    waitForWorldStep();
+
     if (_enabled != enable)
     {
         _enabled = enable;
@@ -783,6 +849,8 @@ bool PhysicsBody::isResting() const
 
 void PhysicsBody::setResting(bool rest) const
 {
+    waitForWorldStep();
+
     if (rest && !isResting())
     {
         cpBodySleep(_cpBody);
@@ -806,6 +874,8 @@ void PhysicsBody::update(float delta)
 
 void PhysicsBody::setCategoryBitmask(int bitmask)
 {
+    waitForWorldStep();
+
     for (auto& shape : _shapes)
     {
         shape->setCategoryBitmask(bitmask);
@@ -826,6 +896,8 @@ int PhysicsBody::getCategoryBitmask() const
 
 void PhysicsBody::setContactTestBitmask(int bitmask)
 {
+    waitForWorldStep();
+
     for (auto& shape : _shapes)
     {
         shape->setContactTestBitmask(bitmask);
@@ -846,6 +918,8 @@ int PhysicsBody::getContactTestBitmask() const
 
 void PhysicsBody::setCollisionBitmask(int bitmask)
 {
+    waitForWorldStep();
+
     for (auto& shape : _shapes)
     {
         shape->setCollisionBitmask(bitmask);
@@ -866,6 +940,8 @@ int PhysicsBody::getCollisionBitmask() const
 
 void PhysicsBody::setGroup(int group)
 {
+    waitForWorldStep();
+
     for (auto& shape : _shapes)
     {
         shape->setGroup(group);
@@ -886,6 +962,8 @@ int PhysicsBody::getGroup() const
 
 void PhysicsBody::setRotationOffset(float rotation)
 {
+    waitForWorldStep();
+
     if (std::abs(_rotationOffset - rotation) > 0.5f)
     {
         float rot       = getRotation();
@@ -553,6 +553,9 @@ protected:
 
     void removeJoint(PhysicsJoint* joint);
 
+    // blocks until a background step of the world is done, called before the chipmunk body is changed
+    void waitForWorldStep() const;
+
     void updateDamping() { _isDamping = _linearDamping != 0.0f || _angularDamping != 0.0f; }
 
     void addToPhysicsWorld();
@@ -608,6 +611,10 @@ protected:
     float _recordPosX;
     float _recordPosY;
 
+    // transform of the last applied step, reported while the world is stepped on a background thread
+    Vec2 _syncedPosition;
+    float _syncedRotation;
+
     friend class PhysicsWorld;
     friend class PhysicsShape;
     friend class PhysicsJoint;
@@ -40,6 +40,8 @@
 #    include "base/CCDirector.h"
 #    include "base/CCEventDispatcher.h"
 #    include "base/CCEventCustom.h"
+#    include "base/CCEventListenerCustom.h"
+#    include "base/CCJobSystem.h"
 
 NS_CC_BEGIN
 const float PHYSICS_INFINITY = FLT_MAX;
@@ -75,6 +77,17 @@ typedef struct PointQueryCallbackInfo
     PhysicsQueryPointCallbackFunc func;
     void* data;
 } PointQueryCallbackInfo;
+
+typedef struct RectBatchQueryInfo
+{
+    cpBB bb;
+    std::vector<PhysicsShape*>* shapes;
+    // shapes found for the previous rects of the batch are kept before this index
+    size_t first;
+} RectBatchQueryInfo;
+
+// number of queries run by one job of a batched query
+const size_t BATCH_QUERY_CHUNK_SIZE = 64;
 }  // namespace
 
 class PhysicsWorldCallback
@@ -95,6 +108,10 @@ public:
                                cpFloat distance,
                                cpVect gradient,
                                PointQueryCallbackInfo* info);
+    static cpCollisionID queryRectBatchFunc(RectBatchQueryInfo* info,
+                                            cpShape* shape,
+                                            cpCollisionID id,
+                                            void* data);
     static void getShapesAtPointFunc(cpShape* shape,
                                      cpVect point,
                                      cpFloat distance,
@@ -138,7 +155,16 @@ void PhysicsWorldCallback::collisionSeparateCallbackFunc(cpArbiter* arb, cpSpace
 
     world->collisionSeparateCallback(*contact);
 
-    delete contact;
+    if (world->_stepPending || world->_dispatchingContacts)
+    {
+        // the arbiter is freed, the contact lives until its deferred events are dispatched
+        contact->_contactInfo = nullptr;
+        world->_separatedContacts.push_back(contact);
+    }
+    else
+    {
+        delete contact;
+    }
 }
 
 void PhysicsWorldCallback::rayCastCallbackFunc(cpShape* shape,
@@ -191,6 +217,28 @@ void PhysicsWorldCallback::getShapesAtPointFunc(cpShape* shape,
     arr->pushBack(physicsShape);
 }
 
+cpCollisionID PhysicsWorldCallback::queryRectBatchFunc(RectBatchQueryInfo* info,
+                                                       cpShape* shape,
+                                                       cpCollisionID id,
+                                                       void* /*data*/)
+{
+    // the tree leaves of moving shapes are inflated, so test the shape's own bounding box
+    if (cpBBIntersects(info->bb, shape->bb))
+    {
+        PhysicsShape* physicsShape = static_cast<PhysicsShape*>(cpShapeGetUserData(shape));
+        CC_ASSERT(physicsShape != nullptr);
+
+        // a PhysicsShape may own several chipmunk shapes
+        auto begin = info->shapes->begin() + info->first;
+        if (std::find(begin, info->shapes->end(), physicsShape) == info->shapes->end())
+        {
+            info->shapes->push_back(physicsShape);
+        }
+    }
+
+    return id;
+}
+
 void PhysicsWorldCallback::queryPointFunc(cpShape* shape,
                                           cpVect /*point*/,
                                           cpFloat /*distance*/,
@@ -395,9 +443,18 @@ bool PhysicsWorld::collisionBeginCallback(PhysicsContact& contact)
 
     if (contact.isNotificationEnabled())
     {
-        contact.setEventCode(PhysicsContact::EventCode::BEGIN);
-        contact.setWorld(this);
-        _eventDispatcher->dispatchEvent(&contact);
+        if (_stepPending)
+        {
+            // the event dispatcher isn't thread safe, the event is dispatched once the background step is applied
+            contact.generateContactData();
+            _deferredContacts.push_back({&contact, PhysicsContact::EventCode::BEGIN});
+        }
+        else
+        {
+            contact.setEventCode(PhysicsContact::EventCode::BEGIN);
+            contact.setWorld(this);
+            _eventDispatcher->dispatchEvent(&contact);
+        }
     }
 
     return ret ? contact.resetResult() : false;
@@ -405,7 +462,7 @@ bool PhysicsWorld::collisionBeginCallback(PhysicsContact& contact)
 
 bool PhysicsWorld::collisionPreSolveCallback(PhysicsContact& contact)
 {
-    if (!contact.isNotificationEnabled())
+    if (!contact.isNotificationEnabled() || _stepPending)
     {
         return true;
     }
@@ -419,7 +476,7 @@ bool PhysicsWorld::collisionPreSolveCallback(PhysicsContact& contact)
 
 void PhysicsWorld::collisionPostSolveCallback(PhysicsContact& contact)
 {
-    if (!contact.isNotificationEnabled())
+    if (!contact.isNotificationEnabled() || _stepPending)
     {
         return;
     }
@@ -436,6 +493,12 @@ void PhysicsWorld::collisionSeparateCallback(PhysicsContact& contact)
         return;
     }
 
+    if (_stepPending)
+    {
+        _deferredContacts.push_back({&contact, PhysicsContact::EventCode::SEPARATE});
+        return;
+    }
+
     contact.setEventCode(PhysicsContact::EventCode::SEPARATE);
     contact.setWorld(this);
     _eventDispatcher->dispatchEvent(&contact);
@@ -447,6 +510,7 @@ void PhysicsWorld::rayCast(PhysicsRayCastCallbackFunc func, const Vec2& point1,
 
     if (func != nullptr)
     {
+        waitForStep();
         if (!_delayAddBodies.empty() || !_delayRemoveBodies.empty())
         {
             updateBodies();
@@ -466,6 +530,7 @@ void PhysicsWorld::queryRect(PhysicsQueryRectCallbackFunc func, const Rect& rect
 
     if (func != nullptr)
     {
+        waitForStep();
         if (!_delayAddBodies.empty() || !_delayRemoveBodies.empty())
         {
             updateBodies();
@@ -484,6 +549,7 @@ void PhysicsWorld::queryPoint(PhysicsQueryPointCallbackFunc func, const Vec2& po
 
     if (func != nullptr)
     {
+        waitForStep();
         if (!_delayAddBodies.empty() || !_delayRemoveBodies.empty())
         {
             updateBodies();
@@ -498,6 +564,7 @@ void PhysicsWorld::queryPoint(PhysicsQueryPointCallbackFunc func, const Vec2& po
 
 Vector<PhysicsShape*> PhysicsWorld::getShapes(const Vec2& point) const
 {
+    waitForStep();
     Vector<PhysicsShape*> arr;
     cpSpacePointQuery(_cpSpace, PhysicsHelper::vec22cpv(point), 0, CP_SHAPE_FILTER_ALL,
                       (cpSpacePointQueryFunc)PhysicsWorldCallback::getShapesAtPointFunc, &arr);
@@ -507,11 +574,124 @@ Vector<PhysicsShape*> PhysicsWorld::getShapes(const Vec2& point) const
 
 PhysicsShape* PhysicsWorld::getShape(const Vec2& point) const
 {
+    waitForStep();
     cpShape* shape =
         cpSpacePointQueryNearest(_cpSpace, PhysicsHelper::vec22cpv(point), 0, CP_SHAPE_FILTER_ALL, nullptr);
     return shape == nullptr ? nullptr : static_cast<PhysicsShape*>(cpShapeGetUserData(shape));
 }
 
+size_t PhysicsWorld::rayCastBatch(const Vec2* starts,
+                                  const Vec2* ends,
+                                  size_t count,
+                                  PhysicsRayCastInfo* results,
+                                  bool parallel)
+{
+    CCASSERT(count == 0 || (starts != nullptr && ends != nullptr && results != nullptr), "invalid ray batch");
+
+    waitForStep();
+    if (!_delayAddBodies.empty() || !_delayRemoveBodies.empty())
+    {
+        updateBodies();
+    }
+
+    // cpSpaceSegmentQueryFirst doesn't lock the space, so the rays can be cast from several threads at once
+    auto castRays = [this, starts, ends, results](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            cpSegmentQueryInfo info;
+            cpShape* shape = cpSpaceSegmentQueryFirst(_cpSpace, PhysicsHelper::vec22cpv(starts[i]),
+                                                      PhysicsHelper::vec22cpv(ends[i]), 0.0f, CP_SHAPE_FILTER_ALL,
+                                                      &info);
+
+            auto& result    = results[i];
+            result.shape    = shape ? static_cast<PhysicsShape*>(cpShapeGetUserData(shape)) : nullptr;
+            result.start    = starts[i];
+            result.end      = ends[i];
+            result.contact  = PhysicsHelper::cpv2vec2(info.point);
+            result.normal   = PhysicsHelper::cpv2vec2(info.normal);
+            result.fraction = static_cast<float>(info.alpha);
+            result.data     = nullptr;
+        }
+    };
+
+    if (parallel && count > BATCH_QUERY_CHUNK_SIZE)
+    {
+        JobSystem::getInstance()->parallelForRange(0, count, BATCH_QUERY_CHUNK_SIZE, castRays);
+    }
+    else
+    {
+        castRays(0, count);
+    }
+
+    size_t hits = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (results[i].shape)
+        {
+            ++hits;
+        }
+    }
+
+    return hits;
+}
+
+void PhysicsWorld::queryRectBatch(const Rect* rects,
+                                  size_t count,
+                                  std::vector<PhysicsShape*>& shapes,
+                                  std::vector<size_t>& offsets,
+                                  bool parallel)
+{
+    CCASSERT(count == 0 || rects != nullptr, "invalid rect batch");
+
+    waitForStep();
+    if (!_delayAddBodies.empty() || !_delayRemoveBodies.empty())
+    {
+        updateBodies();
+    }
+
+    // every chunk of rects collects its shapes separately, they are concatenated in order afterwards
+    const size_t chunkCount = (count + BATCH_QUERY_CHUNK_SIZE - 1) / BATCH_QUERY_CHUNK_SIZE;
+    std::vector<std::vector<PhysicsShape*>> chunkShapes(chunkCount);
+    offsets.assign(count + 1, 0);
+
+    auto queryChunk = [this, rects, count, &chunkShapes, &offsets](size_t chunk) {
+        auto& found      = chunkShapes[chunk];
+        const size_t end = std::min(count, (chunk + 1) * BATCH_QUERY_CHUNK_SIZE);
+        for (size_t i = chunk * BATCH_QUERY_CHUNK_SIZE; i < end; ++i)
+        {
+            RectBatchQueryInfo info = {PhysicsHelper::rect2cpbb(rects[i]), &found, found.size()};
+            cpSpatialIndexQuery(_cpSpace->dynamicShapes, &info, info.bb,
+                                (cpSpatialIndexQueryFunc)PhysicsWorldCallback::queryRectBatchFunc, nullptr);
+            cpSpatialIndexQuery(_cpSpace->staticShapes, &info, info.bb,
+                                (cpSpatialIndexQueryFunc)PhysicsWorldCallback::queryRectBatchFunc, nullptr);
+            offsets[i + 1] = found.size() - info.first;
+        }
+    };
+
+    if (parallel && chunkCount > 1)
+    {
+        JobSystem::getInstance()->parallelFor(chunkCount, queryChunk);
+    }
+    else
+    {
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+        {
+            queryChunk(chunk);
+        }
+    }
+
+    shapes.clear();
+    for (auto& found : chunkShapes)
+    {
+        shapes.insert(shapes.end(), found.begin(), found.end());
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        offsets[i + 1] += offsets[i];
+    }
+}
+
 bool PhysicsWorld::init()
 {
     do
@@ -520,7 +700,6 @@ bool PhysicsWorld::init()
         _cpSpace = cpSpaceNew();
 #    else
         _cpSpace = cpHastySpaceNew();
-        cpHastySpaceSetThreads(_cpSpace, 0);
 #    endif
         CC_BREAK_IF(_cpSpace == nullptr);
 
@@ -578,6 +757,7 @@ void PhysicsWorld::doAddBody(PhysicsBody* body)
 
 void PhysicsWorld::addBodyOrDelay(PhysicsBody* body)
 {
+    waitForStep();
     auto removeBodyIter = _delayRemoveBodies.find(body);
     if (removeBodyIter != _delayRemoveBodies.end())
     {
@@ -656,6 +836,7 @@ void PhysicsWorld::removeBodyOrDelay(PhysicsBody* body)
         return;
     }
 
+    waitForStep();
     if (cpSpaceIsLocked(_cpSpace))
     {
         if (_delayRemoveBodies.getIndex(body) == CC_INVALID_INDEX)
@@ -673,6 +854,7 @@ void PhysicsWorld::removeJoint(PhysicsJoint* joint, bool destroy)
 {
     if (joint)
     {
+        waitForStep();
         if (joint->getWorld() != this && destroy)
         {
             CCLOG(
@@ -744,6 +926,7 @@ void PhysicsWorld::removeShape(PhysicsShape* shape)
 {
     if (shape)
     {
+        waitForStep();
         for (auto cps : shape->_cpShapes)
         {
             if (cpSpaceContainsShape(_cpSpace, cps))
@@ -788,6 +971,7 @@ void PhysicsWorld::addShape(PhysicsShape* physicsShape)
 {
     if (physicsShape)
     {
+        waitForStep();
         for (auto shape : physicsShape->_cpShapes)
         {
             cpSpaceAddShape(_cpSpace, shape);
@@ -879,6 +1063,7 @@ PhysicsBody* PhysicsWorld::getBody(int tag) const
 
 void PhysicsWorld::setGravity(const Vec2& gravity)
 {
+    waitForStep();
     _gravity = gravity;
     cpSpaceSetGravity(_cpSpace, PhysicsHelper::vec22cpv(gravity));
 }
@@ -909,6 +1094,8 @@ void PhysicsWorld::step(float delta)
 
 void PhysicsWorld::update(float delta, bool userCall /* = false*/)
 {
+    // the nodes must hold the result of a background step before they are read again
+    applyStep();
 
     if (_preUpdateCallback)
         _preUpdateCallback();  // fix #11154
@@ -935,13 +1122,49 @@ void PhysicsWorld::update(float delta, bool userCall /* = false*/)
         return;
     }
 
+    _stepBodies.assign(_bodies.begin(), _bodies.end());
+
+    // contact listeners run user code that expects the cocos thread, so those frames are stepped synchronously
+    if (_asyncStepping && !userCall && !_eventDispatcher->hasEventListener(PHYSICSCONTACT_EVENT_NAME))
+    {
+        for (auto body : _stepBodies)
+        {
+            body->_syncedPosition = body->getPosition();
+            body->_syncedRotation = body->getRotation();
+        }
+
+        _stepPending = true;
+        auto done    = std::make_shared<std::promise<void>>();
+        _stepFuture  = done->get_future();
+        JobSystem::getInstance()->submit(
+            [this, delta, done]() {
+                simulate(delta, false);
+                done->set_value();
+            },
+            JobSystem::Priority::HIGH);
+        return;
+    }
+
+    simulate(delta, userCall);
+
+    if (_debugDrawMask != DEBUGDRAW_NONE)
+    {
+        debugDraw();
+    }
+
+    // Update physics position, should loop as the same sequence as node tree.
+    // PhysicsWorld::afterSimulation() will depend on the sequence.
+    afterSimulation(_scene, sceneToWorldTransform, 0.f);
+
+    if (_postUpdateCallback)
+        _postUpdateCallback();  // fix #11154
+}
+
+void PhysicsWorld::simulate(float delta, bool userCall)
+{
     if (userCall)
     {
-#    if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
-        cpSpaceStep(_cpSpace, delta);
-#    else
-        cpHastySpaceStep(_cpSpace, delta);
-#    endif
+        stepSpace(delta);
     }
     else
     {
@@ -953,11 +1176,7 @@ void PhysicsWorld::update(float delta, bool userCall /* = false*/)
             while (_updateTime > step)
             {
                 _updateTime -= step;
-#    if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
-                cpSpaceStep(_cpSpace, dt);
-#    else
-                cpHastySpaceStep(_cpSpace, dt);
-#    endif
+                stepSpace(dt);
             }
         }
         else
@@ -967,12 +1186,8 @@ void PhysicsWorld::update(float delta, bool userCall /* = false*/)
                 const float dt = _updateTime * _speed / _substeps;
                 for (int i = 0; i < _substeps; ++i)
                 {
-#    if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
-                    cpSpaceStep(_cpSpace, dt);
-#    else
-                    cpHastySpaceStep(_cpSpace, dt);
-#    endif
-                    for (auto& body : _bodies)
+                    stepSpace(dt);
+                    for (auto& body : _stepBodies)
                     {
                         body->update(dt);
                     }
@@ -982,20 +1197,120 @@ void PhysicsWorld::update(float delta, bool userCall /* = false*/)
             }
         }
     }
+}
+
+void PhysicsWorld::stepSpace(float dt)
+{
+#    if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    cpSpaceStep(_cpSpace, dt);
+#    else
+    cpHastySpaceStep(_cpSpace, dt);
+#    endif
+}
+
+void PhysicsWorld::waitForStep() const
+{
+    if (_stepFuture.valid())
+    {
+        _stepFuture.wait();
+        _stepFuture = std::future<void>();
+    }
+}
+
+void PhysicsWorld::applyStep()
+{
+    if (!_stepPending)
+    {
+        return;
+    }
+
+    waitForStep();
+    _stepPending = false;
 
     if (_debugDrawMask != DEBUGDRAW_NONE)
     {
         debugDraw();
     }
 
-    // Update physics position, should loop as the same sequence as node tree.
-    // PhysicsWorld::afterSimulation() will depend on the sequence.
-    afterSimulation(_scene, sceneToWorldTransform, 0.f);
+    afterSimulation(_scene, _scene->getNodeToParentTransform(), 0.f);
+    dispatchDeferredContacts();
 
     if (_postUpdateCallback)
         _postUpdateCallback();  // fix #11154
 }
 
+void PhysicsWorld::dispatchDeferredContacts()
+{
+    // a listener removing a body separates contacts that may still be in the list, they are kept until the end
+    _dispatchingContacts = true;
+    for (size_t i = 0; i < _deferredContacts.size(); ++i)
+    {
+        auto contact = _deferredContacts[i].contact;
+        if (contact->isNotificationEnabled())
+        {
+            contact->setEventCode(_deferredContacts[i].eventCode);
+            contact->setWorld(this);
+            _eventDispatcher->dispatchEvent(contact);
+            contact->resetResult();
+        }
+    }
+    _dispatchingContacts = false;
+    _deferredContacts.clear();
+
+    for (auto contact : _separatedContacts)
+    {
+        delete contact;
+    }
+    _separatedContacts.clear();
+}
+
+void PhysicsWorld::setThreadCount(int threads)
+{
+#    if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    CC_UNUSED_PARAM(threads);
+    CCLOG("Physics Warning: the threaded solver isn't available on this platform");
+#    else
+    if (threads <= 0)
+    {
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    waitForStep();
+    cpHastySpaceSetThreads(_cpSpace, threads);
+#    endif
+}
+
+int PhysicsWorld::getThreadCount() const
+{
+#    if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    return 1;
+#    else
+    return static_cast<int>(cpHastySpaceGetThreads(_cpSpace));
+#    endif
+}
+
+void PhysicsWorld::setAsyncStepping(bool async)
+{
+    if (_asyncStepping == async)
+    {
+        return;
+    }
+
+    _asyncStepping = async;
+    if (async)
+    {
+        // apply the step before the next frame's input and scheduler callbacks may touch the bodies
+        _afterDrawListener =
+            _eventDispatcher->addCustomEventListener(Director::EVENT_AFTER_DRAW, [this](EventCustom*) { applyStep(); });
+    }
+    else
+    {
+        applyStep();
+        _eventDispatcher->removeEventListener(_afterDrawListener);
+        _afterDrawListener = nullptr;
+    }
+}
+
 PhysicsWorld* PhysicsWorld::construct(Scene* scene)
 {
     PhysicsWorld* world = new PhysicsWorld();
@@ -1025,10 +1340,27 @@ PhysicsWorld::PhysicsWorld()
     , _debugDraw(nullptr)
     , _debugDrawMask(DEBUGDRAW_NONE)
     , _eventDispatcher(nullptr)
+    , _asyncStepping(false)
+    , _stepPending(false)
+    , _afterDrawListener(nullptr)
+    , _dispatchingContacts(false)
 {}
 
 PhysicsWorld::~PhysicsWorld()
 {
+    waitForStep();
+    _stepPending = false;
+    _deferredContacts.clear();
+    for (auto contact : _separatedContacts)
+    {
+        delete contact;
+    }
+    _separatedContacts.clear();
+    if (_afterDrawListener)
+    {
+        _eventDispatcher->removeEventListener(_afterDrawListener);
+    }
+
     removeAllJoints(true);
     removeAllBodies();
     if (_cpSpace)
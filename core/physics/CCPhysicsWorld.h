@@ -29,10 +29,12 @@
 #include "base/ccConfig.h"
 #if CC_USE_PHYSICS
 
+#    include <future>
 #    include <list>
 #    include "base/CCVector.h"
 #    include "math/CCMath.h"
 #    include "physics/CCPhysicsBody.h"
+#    include "physics/CCPhysicsContact.h"
 
 struct cpSpace;
 
@@ -50,6 +52,7 @@ class Scene;
 class DrawNode;
 class PhysicsDebugDraw;
 class EventDispatcher;
+class EventListenerCustom;
 
 class PhysicsWorld;
 
@@ -210,6 +213,41 @@ public:
      */
     PhysicsShape* getShape(const Vec2& point) const;
 
+    /**
+     * Casts a batch of rays and finds the closest shape hit by each of them.
+     *
+     * No callback is invoked, results[i] receives the closest hit of the ray from starts[i] to ends[i] and its shape
+     * is nullptr when that ray hit nothing. Sensor shapes are ignored.
+     * @param   starts   The begin positions of the rays.
+     * @param   ends   The end positions of the rays.
+     * @param   count   The number of rays.
+     * @param   results   An array of count PhysicsRayCastInfo objects which receives the hits.
+     * @param   parallel   true to split the batch across the JobSystem workers, the spatial index is only read.
+     * @return The number of rays which hit a shape.
+     */
+    size_t rayCastBatch(const Vec2* starts,
+                        const Vec2* ends,
+                        size_t count,
+                        PhysicsRayCastInfo* results,
+                        bool parallel = true);
+
+    /**
+     * Finds the shapes overlapping each rect of a batch.
+     *
+     * The shapes whose bounding box overlaps rects[i] are stored in shapes[offsets[i]] up to, but not including,
+     * shapes[offsets[i + 1]], offsets receives count + 1 entries.
+     * @param   rects   The rects to query.
+     * @param   count   The number of rects.
+     * @param   shapes   Receives the shapes found, grouped by rect.
+     * @param   offsets   Receives the index of the first shape of each rect.
+     * @param   parallel   true to split the batch across the JobSystem workers, the spatial index is only read.
+     */
+    void queryRectBatch(const Rect* rects,
+                        size_t count,
+                        std::vector<PhysicsShape*>& shapes,
+                        std::vector<size_t>& offsets,
+                        bool parallel = true);
+
     /**
      * Get all the bodies that in this physics world.
      *
@@ -374,6 +412,45 @@ public:
      */
     void step(float delta);
 
+    /**
+     * Set the number of threads used by the constraint solver.
+     *
+     * The solver iterations are split across the threads, which only pays off for scenes with many contacts and
+     * joints. With more than one thread the results are no longer reproducible from run to run.
+     * @attention Chipmunk caps the threaded solver at 2 threads, and it isn't available on win32.
+     * @param threads The number of solver threads, 0 means the number of hardware threads. Default value is 1.
+     */
+    void setThreadCount(int threads);
+
+    /**
+     * Get the number of threads used by the constraint solver.
+     *
+     * @return An integer number.
+     */
+    int getThreadCount() const;
+
+    /**
+     * Step the physics world on a background thread.
+     *
+     * The automatic step is started at the end of update() and runs while the scene is visited and rendered, its
+     * result is applied to the nodes once the frame is drawn. The nodes are therefore drawn one step behind the
+     * simulation, and the bodies report the transform of the last applied step while a step is running.
+     * @attention Contact events can't be dispatched from the background thread, frames with contact listeners
+     * registered are stepped synchronously. The begin and separate events of a background step are dispatched once
+     * the step is applied instead, for the listeners added while it ran; they can't reject the contact, and presolve
+     * and postsolve events aren't sent. Changing a body waits for the step, shapes and joints must not be changed
+     * while the scene is drawn.
+     * @param async A bool object, default value is false.
+     */
+    void setAsyncStepping(bool async);
+
+    /**
+     * Get whether the physics world is stepped on a background thread.
+     *
+     * @return A bool object.
+     */
+    bool isAsyncStepping() const { return _asyncStepping; }
+
 protected:
     static PhysicsWorld* construct(Scene* scene);
     bool init();
@@ -398,6 +475,12 @@ protected:
     virtual void updateBodies();
     virtual void updateJoints();
 
+    void simulate(float delta, bool userCall);
+    void stepSpace(float dt);
+    void waitForStep() const;
+    void applyStep();
+    void dispatchDeferredContacts();
+
 protected:
     Vec2 _gravity;
     float _speed;
@@ -427,6 +510,24 @@ protected:
     std::function<void()> _preUpdateCallback;
     std::function<void()> _postUpdateCallback;
 
+    bool _asyncStepping;
+    // true from the start of a background step until its result is applied to the nodes
+    bool _stepPending;
+    mutable std::future<void> _stepFuture;
+    std::vector<PhysicsBody*> _stepBodies;
+    EventListenerCustom* _afterDrawListener;
+
+    // contact events of a background step, a contact listener may have been added after the step started
+    struct DeferredContact
+    {
+        PhysicsContact* contact;
+        PhysicsContact::EventCode eventCode;
+    };
+    std::vector<DeferredContact> _deferredContacts;
+    // contacts separated while their events are deferred, deleted once they are dispatched
+    std::vector<PhysicsContact*> _separatedContacts;
+    bool _dispatchingContacts;
+
 protected:
     PhysicsWorld();
     virtual ~PhysicsWorld();
@@ -86,6 +86,7 @@ bool Physics3DRigidBody::init(Physics3DRigidBodyDes* info)
     _type           = Physics3DObject::PhysicsObjType::RIGID_BODY;
     _physics3DShape = info->shape;
     _physics3DShape->retain();
+    _btRigidBody->setUserPointer(static_cast<Physics3DObject*>(this));
     if (info->disableSleep)
         _btRigidBody->setActivationState(DISABLE_DEACTIVATION);
     return true;
@@ -530,6 +531,7 @@ bool Physics3DCollider::init(Physics3DColliderDes* info)
     _physics3DShape = info->shape;
     _physics3DShape->retain();
     _btGhostObject = new btCollider(this);
+    _btGhostObject->setUserPointer(static_cast<Physics3DObject*>(this));
     _btGhostObject->setCollisionShape(_physics3DShape->getbtShape());
 
     setTrigger(info->isTrigger);
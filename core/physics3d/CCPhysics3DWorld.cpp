@@ -25,6 +25,7 @@
 
 #include "physics3d/CCPhysics3D.h"
 #include "renderer/CCRenderer.h"
+#include "base/CCJobSystem.h"
 
 #if CC_USE_3D_PHYSICS
 
@@ -32,6 +33,60 @@
 
 NS_CC_BEGIN
 
+namespace
+{
+// number of queries run by one job of a batched query
+const size_t BATCH_QUERY_CHUNK_SIZE = 64;
+
+// same narrowphase as btCollisionWorld::rayTest, without the ray test stack shared by btDbvtBroadphase
+struct BatchRayTester : public btDbvt::ICollide
+{
+    BatchRayTester(const btVector3& from, const btVector3& to, btCollisionWorld::ClosestRayResultCallback& result)
+        : _result(result)
+    {
+        _from.setIdentity();
+        _from.setOrigin(from);
+        _to.setIdentity();
+        _to.setOrigin(to);
+    }
+
+    void Process(const btDbvtNode* leaf) override
+    {
+        auto proxy  = static_cast<btBroadphaseProxy*>(leaf->data);
+        auto object = static_cast<btCollisionObject*>(proxy->m_clientObject);
+        if (_result.needsCollision(proxy))
+        {
+            btCollisionWorld::rayTestSingle(_from, _to, object, object->getCollisionShape(),
+                                            object->getWorldTransform(), _result);
+        }
+    }
+
+    btTransform _from;
+    btTransform _to;
+    btCollisionWorld::ClosestRayResultCallback& _result;
+};
+
+struct BatchAABBCollector : public btDbvt::ICollide
+{
+    explicit BatchAABBCollector(std::vector<Physics3DObject*>& objects) : _objects(objects) {}
+
+    void Process(const btDbvtNode* leaf) override
+    {
+        auto proxy  = static_cast<btBroadphaseProxy*>(leaf->data);
+        auto object = static_cast<btCollisionObject*>(proxy->m_clientObject);
+        // the tree leaves of moving objects are inflated, so test the object's own bounding box
+        if (object->getUserPointer() && TestAabbAgainstAabb2(_min, _max, proxy->m_aabbMin, proxy->m_aabbMax))
+        {
+            _objects.push_back(static_cast<Physics3DObject*>(object->getUserPointer()));
+        }
+    }
+
+    std::vector<Physics3DObject*>& _objects;
+    btVector3 _min;
+    btVector3 _max;
+};
+}  // namespace
+
 Physics3DWorld::Physics3DWorld()
     : _needCollisionChecking(false)
     , _collisionCheckingFlag(false)
@@ -326,8 +381,120 @@ bool Physics3DWorld::sweepShape(Physics3DShape* shape,
     return false;
 }
 
+size_t Physics3DWorld::rayCastBatch(const cocos2d::Vec3* startPos,
+                                    const cocos2d::Vec3* endPos,
+                                    size_t count,
+                                    Physics3DWorld::HitResult* results,
+                                    bool parallel)
+{
+    CCASSERT(count == 0 || (startPos != nullptr && endPos != nullptr && results != nullptr), "invalid ray batch");
+
+    auto castRays = [this, startPos, endPos, results](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            auto btStart = convertVec3TobtVector3(startPos[i]);
+            auto btEnd   = convertVec3TobtVector3(endPos[i]);
+            btCollisionWorld::ClosestRayResultCallback btResult(btStart, btEnd);
+            BatchRayTester tester(btStart, btEnd, btResult);
+            btDbvt::rayTest(_broadphase->m_sets[0].m_root, btStart, btEnd, tester);
+            btDbvt::rayTest(_broadphase->m_sets[1].m_root, btStart, btEnd, tester);
+
+            auto& result = results[i];
+            if (btResult.hasHit())
+            {
+                result.hitObj      = getPhysicsObject(btResult.m_collisionObject);
+                result.hitPosition = convertbtVector3ToVec3(btResult.m_hitPointWorld);
+                result.hitNormal   = convertbtVector3ToVec3(btResult.m_hitNormalWorld);
+            }
+            else
+            {
+                result.hitObj = nullptr;
+            }
+        }
+    };
+
+    if (parallel && count > BATCH_QUERY_CHUNK_SIZE)
+    {
+        JobSystem::getInstance()->parallelForRange(0, count, BATCH_QUERY_CHUNK_SIZE, castRays);
+    }
+    else
+    {
+        castRays(0, count);
+    }
+
+    size_t hits = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (results[i].hitObj)
+        {
+            ++hits;
+        }
+    }
+
+    return hits;
+}
+
+void Physics3DWorld::queryAABBBatch(const AABB* boxes,
+                                    size_t count,
+                                    std::vector<Physics3DObject*>& objects,
+                                    std::vector<size_t>& offsets,
+                                    bool parallel)
+{
+    CCASSERT(count == 0 || boxes != nullptr, "invalid box batch");
+
+    // every chunk of boxes collects its objects separately, they are concatenated in order afterwards
+    const size_t chunkCount = (count + BATCH_QUERY_CHUNK_SIZE - 1) / BATCH_QUERY_CHUNK_SIZE;
+    std::vector<std::vector<Physics3DObject*>> chunkObjects(chunkCount);
+    offsets.assign(count + 1, 0);
+
+    auto queryChunk = [this, boxes, count, &chunkObjects, &offsets](size_t chunk) {
+        auto& found      = chunkObjects[chunk];
+        const size_t end = std::min(count, (chunk + 1) * BATCH_QUERY_CHUNK_SIZE);
+        BatchAABBCollector collector(found);
+        for (size_t i = chunk * BATCH_QUERY_CHUNK_SIZE; i < end; ++i)
+        {
+            const size_t first = found.size();
+            collector._min     = convertVec3TobtVector3(boxes[i]._min);
+            collector._max     = convertVec3TobtVector3(boxes[i]._max);
+            auto volume        = btDbvtVolume::FromMM(collector._min, collector._max);
+            _broadphase->m_sets[0].collideTV(_broadphase->m_sets[0].m_root, volume, collector);
+            _broadphase->m_sets[1].collideTV(_broadphase->m_sets[1].m_root, volume, collector);
+            offsets[i + 1] = found.size() - first;
+        }
+    };
+
+    if (parallel && chunkCount > 1)
+    {
+        JobSystem::getInstance()->parallelFor(chunkCount, queryChunk);
+    }
+    else
+    {
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+        {
+            queryChunk(chunk);
+        }
+    }
+
+    objects.clear();
+    for (auto& found : chunkObjects)
+    {
+        objects.insert(objects.end(), found.begin(), found.end());
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        offsets[i + 1] += offsets[i];
+    }
+}
+
 Physics3DObject* Physics3DWorld::getPhysicsObject(const btCollisionObject* btObj)
 {
+    // set by Physics3DRigidBody and Physics3DCollider, saves walking the object list
+    if (btObj->getUserPointer())
+    {
+        return static_cast<Physics3DObject*>(btObj->getUserPointer());
+    }
+
     for (auto it : _objects)
     {
         if (it->getObjType() == Physics3DObject::PhysicsObjType::RIGID_BODY)
@@ -28,6 +28,7 @@
 
 #include "math/CCMath.h"
 #include "base/CCRef.h"
+#include "3d/CCAABB.h"
 #include "base/ccConfig.h"
 
 #if CC_USE_3D_PHYSICS
@@ -146,6 +147,41 @@ public:
                     const cocos2d::Mat4& endTransform,
                     HitResult* result);
 
+    /**
+     * Casts a batch of rays, results[i] receives the closest hit of the ray from starts[i] to endPos[i].
+     *
+     * The broadphase tree is traversed with a stack per ray instead of the world's shared one, so the rays can be cast
+     * from the JobSystem workers at once. The world must not be stepped or changed meanwhile.
+     * @param startPos The start positions of the rays.
+     * @param endPos The end positions of the rays.
+     * @param count The number of rays.
+     * @param results An array of count HitResult objects, hitObj is nullptr for the rays that hit nothing.
+     * @param parallel true to split the batch across the JobSystem workers.
+     * @return The number of rays which hit an object.
+     */
+    size_t rayCastBatch(const cocos2d::Vec3* startPos,
+                        const cocos2d::Vec3* endPos,
+                        size_t count,
+                        HitResult* results,
+                        bool parallel = true);
+
+    /**
+     * Finds the objects whose broadphase bounding box overlaps each box of a batch.
+     *
+     * The objects overlapping boxes[i] are stored in objects[offsets[i]] up to, but not including,
+     * objects[offsets[i + 1]], offsets receives count + 1 entries.
+     * @param boxes The boxes to query.
+     * @param count The number of boxes.
+     * @param objects Receives the objects found, grouped by box.
+     * @param offsets Receives the index of the first object of each box.
+     * @param parallel true to split the batch across the JobSystem workers.
+     */
+    void queryAABBBatch(const AABB* boxes,
+                        size_t count,
+                        std::vector<Physics3DObject*>& objects,
+                        std::vector<size_t>& offsets,
+                        bool parallel = true);
+
     CC_CONSTRUCTOR_ACCESS :
 
         Physics3DWorld();
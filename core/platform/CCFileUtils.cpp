@@ -37,6 +37,9 @@ THE SOFTWARE.
 #include "platform/CCSAXParser.h"
 //#include "base/ccUtils.h"
 #include "platform/CCPosixFileStream.h"
+#include "base/ZipUtils.h"
+#include "yasio/cxx17/string_view.hpp"
+#include "mio/mio.hpp"
 
 #ifdef MINIZIP_FROM_SYSTEM
 #    include <minizip/unzip.h>
@@ -488,7 +491,11 @@ void FileUtils::setDelegate(FileUtils* delegate)
 
 FileUtils::FileUtils() : _writablePath("") {}
 
-FileUtils::~FileUtils() {}
+FileUtils::~FileUtils()
+{
+    for (auto& archive : _mountedArchives)
+        delete archive.second;
+}
 
 bool FileUtils::writeStringToFile(std::string_view dataStr, std::string_view fullPath) const
 {
@@ -585,6 +592,50 @@ void FileUtils::getDataFromFile(std::string_view filename, std::function<void(Da
         std::move(callback));
 }
 
+MappedData FileUtils::getMappedDataFromFile(std::string_view filename) const
+{
+    if (filename.empty())
+        return MappedData::Null;
+
+    const auto fullPath = fullPathForFilename(filename);
+
+    std::string_view archiveFileName;
+    if (auto archive = findArchiveFile(fullPath, &archiveFileName))
+    {
+        // stored entries are viewed in the archive mapping, compressed ones have to be inflated into a buffer
+        auto data = archive->getStoredFileData(archiveFileName);
+        if (!data.isNull())
+            return data;
+    }
+    else
+    {
+        int fd = posix_open_cxx(fullPath, O_READ_FLAGS);
+        if (fd != -1)
+        {
+            auto size = posix_lseek64(fd, 0, SEEK_END);
+            if (size >= static_cast<decltype(size)>(_mappedFileSizeThreshold))
+            {
+                // the mapping keeps the file alive, the descriptor isn't needed anymore
+                auto mapping = std::make_shared<mio::mmap_source>();
+                std::error_code error;
+                mapping->map(posix_fd2fh(fd), 0, mio::map_entire_file, error);
+                posix_close(fd);
+
+                if (!error && mapping->is_mapped())
+                {
+                    auto bytes = reinterpret_cast<const uint8_t*>(mapping->data());
+                    auto len   = static_cast<ssize_t>(mapping->size());
+                    return MappedData(std::move(mapping), bytes, len);
+                }
+            }
+            else
+                posix_close(fd);
+        }
+    }
+
+    return MappedData(getDataFromFile(fullPath));
+}
+
 FileUtils::Status FileUtils::getContents(std::string_view filename, ResizableBuffer* buffer) const
 {
     if (filename.empty())
@@ -594,6 +645,10 @@ FileUtils::Status FileUtils::getContents(std::string_view filename, ResizableBuf
 
     const auto fullPath = fileUtils->fullPathForFilename(filename);
 
+    std::string_view archiveFileName;
+    if (auto archive = findArchiveFile(fullPath, &archiveFileName))
+        return archive->getFileData(archiveFileName, buffer) ? Status::OK : Status::ReadFailed;
+
     auto fileStream = fileUtils->openFileStream(fullPath, FileStream::Mode::READ);
     if (!fileStream)
         return Status::OpenFailed;
@@ -1015,18 +1070,79 @@ std::string FileUtils::getFullPathForFilenameWithinDirectory(std::string_view di
     }
     ret += filename;
     // if the file doesn't exist, return an empty string
-    if (!isFileExistInternal(ret))
+    if (!findArchiveFile(ret) && !isFileExistInternal(ret))
     {
         ret.clear();
     }
     return ret;
 }
 
+bool FileUtils::mountArchive(std::string_view archivePath, std::string_view mountPoint)
+{
+    DECLARE_GUARD;
+
+    auto archive = new MappedZipFile(archivePath);
+    if (!archive->isOpen())
+    {
+        delete archive;
+        return false;
+    }
+
+    // ensure mountPoint ends with `/` as a directory
+    std::string dirname{mountPoint};
+    if (!dirname.empty() && dirname.back() != '/')
+        dirname += '/';
+
+    unmountArchive(dirname);
+    _mountedArchives.emplace_back(std::move(dirname), archive);
+    _fullPathCache.clear();
+    return true;
+}
+
+void FileUtils::unmountArchive(std::string_view mountPoint)
+{
+    DECLARE_GUARD;
+
+    std::string_view dirname = mountPoint;
+    if (!dirname.empty() && dirname.back() == '/')
+        dirname.remove_suffix(1);
+
+    for (auto it = _mountedArchives.begin(); it != _mountedArchives.end(); ++it)
+    {
+        std::string_view mounted{it->first};
+        if (mounted.substr(0, mounted.size() - 1) == dirname)
+        {
+            delete it->second;
+            _mountedArchives.erase(it);
+            _fullPathCache.clear();
+            break;
+        }
+    }
+}
+
+MappedZipFile* FileUtils::findArchiveFile(std::string_view fullPath, std::string_view* fileName) const
+{
+    for (auto& archive : _mountedArchives)
+    {
+        if (!cxx20::starts_with(fullPath, std::string_view{archive.first}))
+            continue;
+
+        auto name = fullPath.substr(archive.first.size());
+        if (archive.second->fileExists(name))
+        {
+            if (fileName)
+                *fileName = name;
+            return archive.second;
+        }
+    }
+    return nullptr;
+}
+
 bool FileUtils::isFileExist(std::string_view filename) const
 {
     if (isAbsolutePath(filename))
     {
-        return isFileExistInternal(filename);
+        return findArchiveFile(filename) || isFileExistInternal(filename);
     }
     else
     {
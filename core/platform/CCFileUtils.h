@@ -44,6 +44,8 @@ THE SOFTWARE.
 
 NS_CC_BEGIN
 
+class MappedZipFile;
+
 /**
  * @addtogroup platform
  * @{
@@ -183,6 +185,31 @@ public:
      */
     virtual void getDataFromFile(std::string_view filename, std::function<void(Data)> callback) const;
 
+    /**
+     *  Gets the contents of a file without copying them when possible.
+     *
+     *  Files on disk are memory mapped, the returned view shares the mapping and its pages are only read when
+     *  they are accessed. The stored (not compressed) files of the mounted archives are viewed in the archive
+     *  mapping whatever their size. Files smaller than getMappedFileSizeThreshold(), compressed archive files and
+     *  files which aren't on disk (like the apk assets on Android) are read into a buffer by getContents.
+     *
+     *  @note The mapped bytes are read only, use MappedData::takeBuffer to get a writable buffer.
+     *  @param filename The resource file name which contains the path.
+     *  @return The contents of the file, MappedData::Null if it can't be read.
+     */
+    virtual MappedData getMappedDataFromFile(std::string_view filename) const;
+
+    /**
+     *  Sets the size from which getMappedDataFromFile maps a file rather than reading it, 64KB by default.
+     *  Mapping a small file costs more than reading it.
+     */
+    void setMappedFileSizeThreshold(size_t size) { _mappedFileSizeThreshold = size; }
+
+    /**
+     *  Gets the size from which getMappedDataFromFile maps a file rather than reading it.
+     */
+    size_t getMappedFileSizeThreshold() const { return _mappedFileSizeThreshold; }
+
     enum class Status
     {
         OK                 = 0,
@@ -637,6 +664,24 @@ public:
      */
     virtual void isFileExist(std::string_view filename, std::function<void(bool)> callback) const;
 
+    /**
+     *  Mounts a zip archive, its files are then seen under mountPoint like regular files by isFileExist,
+     *  fullPathForFilename and getContents. The archive is memory mapped and indexed once (see MappedZipFile),
+     *  reads don't seek a shared file handle and can run from several threads at once.
+     *
+     *  @note Add mountPoint to the search paths to load the files with relative paths. Like the search paths,
+     *  the mounted archives are not protected against concurrent changes, mount them before loading from other threads.
+     *  @param archivePath The absolute path of the zip file.
+     *  @param mountPoint The absolute directory the files appear in, for instance getWritablePath() + "dlc/".
+     *  @return True if the archive was mounted, false if it can't be opened.
+     */
+    bool mountArchive(std::string_view archivePath, std::string_view mountPoint);
+
+    /**
+     *  Unmounts the archive mounted at mountPoint.
+     */
+    void unmountArchive(std::string_view mountPoint);
+
     /**
      *  Gets filename extension is a suffix (separated from the base filename by a dot) in lower case.
      *  Examples of filename extensions are .png, .jpeg, .exe, .dmg and .txt.
@@ -923,6 +968,22 @@ protected:
      */
     virtual std::string fullPathForDirectory(std::string_view dirname) const;
 
+    /**
+     *  Returns the mounted archive containing fullPath, and the name of the file inside it.
+     *  @return nullptr if fullPath isn't a file of a mounted archive.
+     */
+    MappedZipFile* findArchiveFile(std::string_view fullPath, std::string_view* fileName = nullptr) const;
+
+    /**
+     *  The mounted archives and their mount points, see mountArchive.
+     */
+    std::vector<std::pair<std::string, MappedZipFile*>> _mountedArchives;
+
+    /**
+     *  The size from which getMappedDataFromFile maps files.
+     */
+    size_t _mappedFileSizeThreshold = 64 * 1024;
+
     /**
      * mutex used to protect fields.
      */
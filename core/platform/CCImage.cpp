@@ -607,13 +607,11 @@ bool Image::initWithImageFile(std::string_view path)
     bool ret  = false;
     _filePath = FileUtils::getInstance()->fullPathForFilename(path);
 
-    Data data = FileUtils::getInstance()->getDataFromFile(_filePath);
+    auto data = FileUtils::getInstance()->getMappedDataFromFile(_filePath);
 
     if (!data.isNull())
     {
-        ssize_t n = 0;
-        auto buf  = data.takeBuffer(&n);
-        ret       = initWithImageData(buf, n, true);
+        ret = initWithImageData(std::move(data));
     }
 
     return ret;
@@ -624,13 +622,11 @@ bool Image::initWithImageFileThreadSafe(std::string_view fullpath)
     bool ret  = false;
     _filePath = fullpath;
 
-    Data data = FileUtils::getInstance()->getDataFromFile(_filePath);
+    auto data = FileUtils::getInstance()->getMappedDataFromFile(_filePath);
 
     if (!data.isNull())
     {
-        ssize_t n = 0;
-        auto buf  = data.takeBuffer(&n);
-        ret       = initWithImageData(buf, n, true);
+        ret = initWithImageData(std::move(data));
     }
 
     return ret;
@@ -641,6 +637,28 @@ bool Image::initWithImageData(const uint8_t* data, ssize_t dataLen)
     return initWithImageData(const_cast<uint8_t*>(data), dataLen, false);
 }
 
+bool Image::initWithImageData(MappedData data)
+{
+    switch (detectFormat(data.getBytes(), data.getSize()))
+    {
+    case Format::PVR:
+    case Format::ETC1:
+    case Format::ETC2:
+    case Format::S3TC:
+    case Format::ATITC:
+    case Format::ASTC:
+    {
+        // the hardware decoder keeps the data, it must own it
+        ssize_t n = 0;
+        auto buf  = data.takeBuffer(&n);
+        return initWithImageData(buf, n, true);
+    }
+    default:
+        // decode from the contents directly, the compressed files are inflated to a buffer of their own
+        return initWithImageData(data.getBytes(), data.getSize());
+    }
+}
+
 bool Image::initWithImageData(uint8_t* data, ssize_t dataLen, bool ownData)
 {
     bool ret = false;
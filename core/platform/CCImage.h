@@ -162,6 +162,16 @@ public:
     bool initWithImageData(const uint8_t* data, ssize_t dataLen);
     bool initWithImageData(uint8_t* data, ssize_t dataLen, bool ownData);
 
+    /**
+    @brief Load image from file contents, see FileUtils::getMappedDataFromFile.
+    The encoded formats are decoded straight from the contents, the hardware decoded formats get a buffer of their own.
+    @param data  the file contents.
+    @return true if loaded correctly.
+    * @js NA
+    * @lua NA
+    */
+    bool initWithImageData(MappedData data);
+
     // @warning kFmtRawData only support RGBA8888
     bool initWithRawData(const uint8_t* data,
                          ssize_t dataLen,
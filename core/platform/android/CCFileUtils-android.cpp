@@ -52,6 +52,7 @@ NS_CC_BEGIN
 
 AAssetManager* FileUtilsAndroid::assetmanager = nullptr;
 ZipFile* FileUtilsAndroid::obbfile            = nullptr;
+MappedZipFile* FileUtilsAndroid::obbarchive   = nullptr;
 
 void FileUtilsAndroid::setassetmanager(AAssetManager* a)
 {
@@ -88,6 +89,7 @@ FileUtilsAndroid::~FileUtilsAndroid()
         delete obbfile;
         obbfile = nullptr;
     }
+    CC_SAFE_DELETE(obbarchive);
 }
 
 bool FileUtilsAndroid::init()
@@ -99,7 +101,8 @@ bool FileUtilsAndroid::init()
     std::string assetsPath(getApkPath());
     if (assetsPath.find("/obb/") != std::string::npos)
     {
-        obbfile = new ZipFile(assetsPath);
+        obbfile    = new ZipFile(assetsPath);
+        obbarchive = new MappedZipFile(assetsPath);
     }
 
     return FileUtils::init();
@@ -379,9 +382,9 @@ FileUtils::Status FileUtilsAndroid::getContents(std::string_view filename, Resiz
         relativePath = fullPath;
     }
 
-    if (obbfile)
+    if (obbarchive)
     {
-        if (obbfile->getFileData(relativePath, buffer))
+        if (obbarchive->getFileData(relativePath, buffer))
             return FileUtils::Status::OK;
     }
 
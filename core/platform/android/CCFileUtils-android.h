@@ -38,6 +38,7 @@ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
 NS_CC_BEGIN
 
 class ZipFile;
+class MappedZipFile;
 
 /**
  * @addtogroup platform
@@ -81,6 +82,8 @@ private:
 
     static AAssetManager* assetmanager;
     static ZipFile* obbfile;
+    // memory mapped view of the obb, used by getContents
+    static MappedZipFile* obbarchive;
 };
 
 // end of platform group
@@ -221,7 +221,8 @@ std::string FileUtilsApple::getFullPathForFilenameWithinDirectory(std::string_vi
         std::string fullPath{directory};
         fullPath += filename;
         // Search path is an absolute path.
-        if ([s_fileManager fileExistsAtPath:[NSString stringWithUTF8String:fullPath.c_str()]])
+        if (findArchiveFile(fullPath) ||
+            [s_fileManager fileExistsAtPath:[NSString stringWithUTF8String:fullPath.c_str()]])
         {
             return fullPath;
         }
@@ -381,6 +381,29 @@ GLViewImpl* GLViewImpl::createWithFullScreen(std::string_view viewName,
     return nullptr;
 }
 
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+GLViewImpl* GLViewImpl::createHeadless(std::string_view viewName, Rect rect)
+{
+    auto ret = new GLViewImpl(false);
+
+    // The null platform opens no display connection, the window is only a size for the OSMesa buffer
+    glfwSetErrorCallback(GLFWEventHandler::onGLFWError);
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    if (glfwInit())
+    {
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+        ret->_headless = true;
+        if (ret->initWithRect(viewName, rect, 1.0f, false))
+        {
+            ret->autorelease();
+            return ret;
+        }
+    }
+    CC_SAFE_DELETE(ret);
+    return nullptr;
+}
+#endif
+
 bool GLViewImpl::initWithRect(std::string_view viewName, Rect rect, float frameZoomFactor, bool resizable)
 {
     setViewName(viewName);
@@ -430,6 +453,12 @@ bool GLViewImpl::initWithRect(std::string_view viewName, Rect rect, float frameZ
             message.append(_glfwError);
         }
 
+        if (_headless)
+        {
+            log("%s", message.c_str());
+            return false;
+        }
+
         ccMessageBox(message.c_str(), "Error launch application");
         utils::killCurrentProcess();  // kill current process, don't cause crash when driver issue.
         return false;
@@ -481,6 +510,12 @@ bool GLViewImpl::initWithRect(std::string_view viewName, Rect rect, float frameZ
         sprintf(strComplain,
                 "OpenGL 1.5 or higher is required (your version is %s). Please upgrade the driver of your video card.",
                 glVersion);
+        if (_headless)
+        {
+            log("%s", strComplain);
+            return false;
+        }
+
         ccMessageBox(strComplain, "OpenGL version too old");
         utils::killCurrentProcess();  // kill current process, don't cause crash when driver issue.
         return false;
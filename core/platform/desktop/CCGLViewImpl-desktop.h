@@ -70,6 +70,14 @@ public:
     static GLViewImpl* createWithFullScreen(std::string_view viewName,
                                             const GLFWvidmode& videoMode,
                                             GLFWmonitor* monitor);
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+    /**
+     * Creates a view which needs no display, e.g. to run on CI machines. It lives on the null platform of GLFW and
+     * renders into an OSMesa software context, so libOSMesa must be installed. Captures read back through
+     * Renderer::readPixels as usual.
+     */
+    static GLViewImpl* createHeadless(std::string_view viewName, Rect rect);
+#endif
 
     /*
      *frameZoomFactor for frame. This method is for debugging big resolution (e.g.new ipad) app on desktop.
@@ -181,6 +189,8 @@ protected:
     void onGLFWWindowFocusCallback(GLFWwindow* window, int focused);
 
     bool _captured;
+    // created by createHeadless, failures are reported to the caller instead of ending the process
+    bool _headless = false;
     bool _isInRetinaMonitor;
     bool _isRetinaEnabled;
     int _retinaFactor;  // Should be 1 or 2
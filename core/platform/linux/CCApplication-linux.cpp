@@ -28,28 +28,24 @@ THE SOFTWARE.
 #include <sys/time.h>
 #include <string>
 #include "base/CCDirector.h"
+#include "base/CCFramePacer.h"
 #include "base/ccUtils.h"
+#include "base/ccUTF8.h"
 #include "platform/CCFileUtils.h"
+#include "platform/desktop/CCGLViewImpl-desktop.h"
+#include "platform/CCImage.h"
+#include "renderer/CCRenderer.h"
 
 NS_CC_BEGIN
 
 // sharedApplication pointer
 Application* Application::sm_pSharedApplication = nullptr;
 
-static int32_t getCurrentMillSecond()
-{
-    int32_t lLastTime;
-    struct timeval stCurrentTime;
-
-    gettimeofday(&stCurrentTime, NULL);
-    lLastTime = stCurrentTime.tv_sec * 1000 + stCurrentTime.tv_usec * 0.001;  // milliseconds
-    return lLastTime;
-}
-
-Application::Application() : _animationInterval(1.0f / 60.0f * 1000.0f)
+Application::Application()
 {
     CC_ASSERT(!sm_pSharedApplication);
     sm_pSharedApplication = this;
+    FramePacer::getInstance()->setFrameInterval(1.0 / 60.0);
 }
 
 Application::~Application()
@@ -61,33 +57,29 @@ Application::~Application()
 int Application::run()
 {
     initGLContextAttrs();
+    if (_headless)
+        return runHeadless();
+
     // Initialize instance and cocos2d.
     if (!applicationDidFinishLaunching())
     {
         return 0;
     }
 
-    int32_t lastTime = 0L;
-    int32_t curTime  = 0L;
-
     auto director = Director::getInstance();
     auto glview   = director->getOpenGLView();
 
     // Retain glview to avoid glview being released in the while loop
     glview->retain();
 
+    auto framePacer = FramePacer::getInstance();
     while (!glview->windowShouldClose())
     {
-        lastTime = getCurrentMillSecond();
-
         director->mainLoop();
         glview->pollEvents();
-
-        curTime = getCurrentMillSecond();
-        if (curTime - lastTime < _animationInterval)
-        {
-            usleep((_animationInterval - curTime + lastTime) * 1000);
-        }
+        // the pacer is destroyed with the Director, when the mainLoop above purged it the window is closing
+        if (!glview->windowShouldClose())
+            framePacer->waitForNextFrame();
     }
     /* Only work on Desktop
      *  Director::mainLoop is really one frame logic
@@ -104,10 +96,86 @@ int Application::run()
     return EXIT_SUCCESS;
 }
 
+void Application::setHeadlessOptions(const HeadlessOptions& options)
+{
+    _headless        = true;
+    _headlessOptions = options;
+}
+
+int Application::runHeadless()
+{
+    const auto& options = _headlessOptions;
+
+    auto director = Director::getInstance();
+    auto glview   = GLViewImpl::createHeadless("headless", Rect(0, 0, options.width, options.height));
+    if (!glview)
+    {
+        log("Can't create the headless view, is libOSMesa installed?");
+        return EXIT_FAILURE;
+    }
+    director->setOpenGLView(glview);
+
+    if (!applicationDidFinishLaunching())
+    {
+        return 0;
+    }
+
+    glview->retain();
+
+    auto framePacer = FramePacer::getInstance();
+    if (options.frameCount > framePacer->getHistorySize())
+        framePacer->setHistorySize(options.frameCount);
+    framePacer->clearHistory();
+
+    std::string stats = "frame,update_ms,visit_ms,render_ms,swap_ms,frame_ms,draw_calls,vertices\n";
+    for (unsigned int frame = 0; options.frameCount == 0 || frame < options.frameCount; ++frame)
+    {
+        if (options.captureInterval > 0 && frame % options.captureInterval == 0)
+        {
+            auto path = StringUtils::format("%s/frame_%06u.png", options.captureDirectory.c_str(), frame);
+            utils::captureScreen([path](RefPtr<Image> image) {
+                if (!image || !image->saveToFile(path))
+                    log("Can't save the frame capture %s", path.c_str());
+            });
+        }
+
+        // the frames run back to back, the fixed delta time keeps them deterministic
+        director->mainLoop(options.deltaTime);
+        glview->pollEvents();
+        if (glview->windowShouldClose())
+            break;
+
+        const auto& timings = framePacer->getLastFrameTimings();
+        auto renderer       = director->getRenderer();
+        stats += StringUtils::format("%u,%.3f,%.3f,%.3f,%.3f,%.3f,%d,%d\n", frame, timings.update, timings.visit,
+                                     timings.render, timings.swap, timings.frame,
+                                     static_cast<int>(renderer->getDrawnBatches()),
+                                     static_cast<int>(renderer->getDrawnVertices()));
+    }
+
+    // the pacer is gone if the application ended the Director during the run
+    if (glview->isOpenGLReady())
+    {
+        auto frameStats = framePacer->getFrameTimeStats();
+        // logged in release builds as well, the batch runs are read from their output
+        log("Headless run: %u frames, frame time mean %.3f ms, deviation %.3f ms, max %.3f ms",
+            static_cast<unsigned int>(frameStats.frames), frameStats.mean, frameStats.deviation, frameStats.max);
+    }
+    if (!options.statsPath.empty() && !FileUtils::getInstance()->writeStringToFile(stats, options.statsPath))
+        log("Can't write the frame statistics to %s", options.statsPath.c_str());
+
+    if (glview->isOpenGLReady())
+    {
+        director->end();
+        director->mainLoop();
+    }
+    glview->release();
+    return EXIT_SUCCESS;
+}
+
 void Application::setAnimationInterval(float interval)
 {
-    // TODO do something else
-    _animationInterval = interval * 1000.0f;
+    FramePacer::getInstance()->setFrameInterval(interval);
 }
 
 void Application::setResourceRootPath(std::string_view rootResDir)
@@ -51,6 +51,34 @@ public:
      */
     virtual void setAnimationInterval(float interval) override;
 
+    /**
+     @brief Options of the headless batch mode, see setHeadlessOptions.
+     */
+    struct HeadlessOptions
+    {
+        /** Size of the offscreen frame buffer in pixels. */
+        float width  = 960.0f;
+        float height = 640.0f;
+        /** Delta time of every frame in seconds, the frames run back to back. */
+        float deltaTime = 1.0f / 60.0f;
+        /** Number of frames run() runs before returning, 0 runs until the Director ends. */
+        unsigned int frameCount = 0;
+        /** Every captureInterval-th frame is saved to captureDirectory as frame_<n>.png, 0 captures none. */
+        unsigned int captureInterval = 0;
+        std::string captureDirectory;
+        /** CSV file receiving the timings and draw statistics of every frame, empty writes none. */
+        std::string statsPath;
+    };
+
+    /**
+     @brief Makes run() render without a display, through GLViewImpl::createHeadless. The view is created before
+     applicationDidFinishLaunching(), so AppDelegates creating their view only when the Director has none work as is.
+     Must be called before run().
+     */
+    void setHeadlessOptions(const HeadlessOptions& options);
+    bool isHeadless() const { return _headless; }
+    const HeadlessOptions& getHeadlessOptions() const { return _headlessOptions; }
+
     /**
      @brief Run the message loop.
      */
@@ -104,8 +132,11 @@ public:
     virtual Platform getTargetPlatform() override;
 
 protected:
-    int32_t _animationInterval;  // micro second
+    int runHeadless();
+
     std::string _resourceRootPath;
+    bool _headless = false;
+    HeadlessOptions _headlessOptions;
 
     static Application* sm_pSharedApplication;
 };
@@ -99,7 +99,6 @@ public:
 protected:
     static Application* sm_pSharedApplication;
 
-    int32_t _animationInterval;  // micro second
     std::string _resourceRootPath;
     std::string _startupScriptFilename;
 };
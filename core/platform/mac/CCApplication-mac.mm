@@ -31,27 +31,19 @@ THE SOFTWARE.
 #include "platform/CCFileUtils.h"
 #include "math/CCMath.h"
 #include "base/CCDirector.h"
+#include "base/CCFramePacer.h"
 #include "base/ccUtils.h"
 #include "renderer/backend/metal/DeviceMTL.h"
 
 NS_CC_BEGIN
 
-static int32_t getCurrentMillSecond()
-{
-    int32_t lLastTime = 0;
-    struct timeval stCurrentTime;
-
-    gettimeofday(&stCurrentTime, NULL);
-    lLastTime = stCurrentTime.tv_sec * 1000 + stCurrentTime.tv_usec * 0.001;  // milliseconds
-    return lLastTime;
-}
-
 Application* Application::sm_pSharedApplication = nullptr;
 
-Application::Application() : _animationInterval(1.0f / 60.0f * 1000.0f)
+Application::Application()
 {
     CCASSERT(!sm_pSharedApplication, "sm_pSharedApplication already exist");
     sm_pSharedApplication = this;
+    FramePacer::getInstance()->setFrameInterval(1.0 / 60.0);
 }
 
 Application::~Application()
@@ -68,27 +60,20 @@ int Application::run()
         return 1;
     }
 
-    int32_t lastTime = 0L;
-    int32_t curTime  = 0L;
-
     auto director = Director::getInstance();
     auto glview   = director->getOpenGLView();
 
     // Retain glview to avoid glview being released in the while loop
     glview->retain();
 
+    auto framePacer = FramePacer::getInstance();
     while (!glview->windowShouldClose())
     {
-        lastTime = getCurrentMillSecond();
-
         director->mainLoop();
         glview->pollEvents();
-
-        curTime = getCurrentMillSecond();
-        if (curTime - lastTime < _animationInterval)
-        {
-            usleep(static_cast<useconds_t>((_animationInterval - curTime + lastTime) * 1000));
-        }
+        // the pacer is destroyed with the Director, when the mainLoop above purged it the window is closing
+        if (!glview->windowShouldClose())
+            framePacer->waitForNextFrame();
     }
 
     /* Only work on Desktop
@@ -109,7 +94,7 @@ int Application::run()
 
 void Application::setAnimationInterval(float interval)
 {
-    _animationInterval = interval * 1000.0f;
+    FramePacer::getInstance()->setFrameInterval(interval);
 }
 
 Application::Platform Application::getTargetPlatform()
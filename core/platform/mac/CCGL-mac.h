@@ -39,6 +39,8 @@ THE SOFTWARE.
 #    define glDeleteVertexArrays glDeleteVertexArraysAPPLE
 #    define glGenVertexArrays glGenVertexArraysAPPLE
 #    define glBindVertexArray glBindVertexArrayAPPLE
+#    define glVertexAttribDivisor glVertexAttribDivisorARB
+#    define glDrawElementsInstanced glDrawElementsInstancedARB
 #    define glClearDepthf glClearDepth
 #    define glDepthRangef glDepthRange
 #    define glReleaseShaderCompiler(xxx)
@@ -26,6 +26,7 @@ THE SOFTWARE.
 ****************************************************************************/
 #include "platform/CCApplication.h"
 #include "base/CCDirector.h"
+#include "base/CCFramePacer.h"
 #include <algorithm>
 #include "platform/CCFileUtils.h"
 #include <shellapi.h>
@@ -47,8 +48,7 @@ Application* Application::sm_pSharedApplication = nullptr;
 
 Application::Application() : _instance(nullptr), _accelTable(nullptr)
 {
-    _instance                   = GetModuleHandle(nullptr);
-    _animationInterval.QuadPart = 0;
+    _instance = GetModuleHandle(nullptr);
     CC_ASSERT(!sm_pSharedApplication);
     sm_pSharedApplication = this;
 }
@@ -75,12 +75,6 @@ int Application::run()
         timeBeginPeriod(wTimerRes);
     }
 
-    // Main message loop:
-    LARGE_INTEGER nLast;
-    LARGE_INTEGER nNow;
-
-    QueryPerformanceCounter(&nLast);
-
     initGLContextAttrs();
 
     // Initialize instance and cocos2d.
@@ -95,33 +89,16 @@ int Application::run()
     // Retain glview to avoid glview being released in the while loop
     glview->retain();
 
-    LONGLONG interval = 0LL;
-    LONG waitMS       = 0L;
-
-    LARGE_INTEGER freq;
-    QueryPerformanceFrequency(&freq);
-
+    // The FramePacer sleeps through most of the wait and spins the rest, so the 1 ms timer resolution set above
+    // only has to cover its spin threshold.
+    auto framePacer = FramePacer::getInstance();
     while (!glview->windowShouldClose())
     {
-        QueryPerformanceCounter(&nNow);
-        interval = nNow.QuadPart - nLast.QuadPart;
-        if (interval >= _animationInterval.QuadPart)
-        {
-            nLast.QuadPart = nNow.QuadPart;
-            director->mainLoop();
-            glview->pollEvents();
-        }
-        else
-        {
-            // The precision of timer on Windows is set to highest (1ms) by 'timeBeginPeriod' from above code,
-            // but it's still not precise enough. For example, if the precision of timer is 1ms,
-            // Sleep(3) may make a sleep of 2ms or 4ms. Therefore, we subtract 1ms here to make Sleep time shorter.
-            // If 'waitMS' is equal or less than 1ms, don't sleep and run into next loop to
-            // boost CPU to next frame accurately.
-            waitMS = static_cast<LONG>((_animationInterval.QuadPart - interval) * 1000LL / freq.QuadPart - 1L);
-            if (waitMS > 1L)
-                Sleep(waitMS);
-        }
+        director->mainLoop();
+        glview->pollEvents();
+        // the pacer is destroyed with the Director, when the mainLoop above purged it the window is closing
+        if (!glview->windowShouldClose())
+            framePacer->waitForNextFrame();
     }
 
     // Director should still do a cleanup if the window was closed manually.
@@ -145,9 +122,7 @@ int Application::run()
 
 void Application::setAnimationInterval(float interval)
 {
-    LARGE_INTEGER freq;
-    QueryPerformanceFrequency(&freq);
-    _animationInterval.QuadPart = (LONGLONG)(interval * freq.QuadPart);
+    FramePacer::getInstance()->setFrameInterval(interval);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -26,6 +26,7 @@ THE SOFTWARE.
 ****************************************************************************/
 #include "platform/win32/CCFileUtils-win32.h"
 #include "platform/CCCommon.h"
+#include "base/ZipUtils.h"
 #include <Shlobj.h>
 #include <cstdlib>
 #include <regex>
@@ -175,6 +176,10 @@ FileUtils::Status FileUtilsWin32::getContents(std::string_view filename, Resizab
     // read the file from hardware
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filename);
 
+    std::string_view archiveFileName;
+    if (auto archive = findArchiveFile(fullPath, &archiveFileName))
+        return archive->getFileData(archiveFileName, buffer) ? FileUtils::Status::OK : FileUtils::Status::ReadFailed;
+
     HANDLE fileHandle = ::CreateFileW(ntcvt::from_chars(fullPath).c_str(), GENERIC_READ,
                                       FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, NULL, nullptr);
     if (fileHandle == INVALID_HANDLE_VALUE)
@@ -36,6 +36,7 @@
 NS_CC_BEGIN
 
 class GLProgramState;
+class Pass;
 class EventListenerCustom;
 class EventCustom;
 class Material;
@@ -73,11 +74,31 @@ public:
 
     void init(float globalZOrder, const Mat4& transform);
 
+    /**
+    Whether the command is drawn with an instancing program, which reads the model view matrix and the color from
+    per instance attributes. The renderer draws the instanced commands sharing the same buffers, program and textures
+    with a single draw call.
+    */
+    void setInstanced(bool instanced) { _instanced = instanced; }
+    bool isInstanced() const { return _instanced; }
+
+    /** The color of the instance, passed to the program with the model view matrix. */
+    void setInstanceColor(const Vec4& color) { _instanceColor = color; }
+    const Vec4& getInstanceColor() const { return _instanceColor; }
+
+    /** The pass drawing the command, its before callback applies the render state and the uniforms of the pass. */
+    void setPass(Pass* pass) { _pass = pass; }
+    Pass* getPass() const { return _pass; }
+
 #if CC_ENABLE_CACHE_TEXTURE_DATA
     void listenRendererRecreated(EventCustom* event);
 #endif
 
 protected:
+    bool _instanced = false;
+    Vec4 _instanceColor{1.0f, 1.0f, 1.0f, 1.0f};
+    Pass* _pass = nullptr;
+
 #if CC_ENABLE_CACHE_TEXTURE_DATA
     EventListenerCustom* _rendererRecreatedListener;
 #endif
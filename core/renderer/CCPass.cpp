@@ -185,6 +185,7 @@ void Pass::draw(MeshCommand* meshCommand,
 
     meshCommand->setBeforeCallback(CC_CALLBACK_0(Pass::onBeforeVisitCmd, this, meshCommand));
     meshCommand->setAfterCallback(CC_CALLBACK_0(Pass::onAfterVisitCmd, this, meshCommand));
+    meshCommand->setPass(this);
     meshCommand->init(globalZOrder, modelView);
     meshCommand->setPrimitiveType(primitive);
     meshCommand->setIndexBuffer(indexBuffer, indexFormat);
@@ -36,6 +36,7 @@
 #include "base/CCDirector.h"
 #include "renderer/CCRenderer.h"
 #include "renderer/CCMaterial.h"
+#include "xxhash.h"
 
 NS_CC_BEGIN
 
@@ -68,6 +69,28 @@ void RenderState::bindPass(Pass* pass, MeshCommand* command)
     _state.apply(&pipelineDescriptor);
 }
 
+uint32_t RenderState::getPassStatesHash(Pass* pass)
+{
+    auto* technique   = pass->_technique;
+    auto* material    = technique->_material;
+    uint32_t hashes[] = {material->getStateBlock().getHash(), technique->getStateBlock().getHash(),
+                         pass->_renderState._state.getHash()};
+    return XXH32(hashes, sizeof(hashes), 0);
+}
+
+bool RenderState::isSamePassStates(Pass* lhs, Pass* rhs)
+{
+    if (lhs == rhs)
+        return true;
+
+    // the blocks are applied in turn, so each one of them must match rather than their combination
+    auto* lhsTechnique = lhs->_technique;
+    auto* rhsTechnique = rhs->_technique;
+    return lhs->_renderState._state == rhs->_renderState._state &&
+           lhsTechnique->getStateBlock() == rhsTechnique->getStateBlock() &&
+           lhsTechnique->_material->getStateBlock() == rhsTechnique->_material->getStateBlock();
+}
+
 RenderState::StateBlock& RenderState::getStateBlock() const
 {
     return _state;
@@ -345,8 +368,21 @@ bool RenderState::StateBlock::isDirty() const
 
 uint32_t RenderState::StateBlock::getHash() const
 {
-    // XXX
-    return 0x12345678;
+    // the values of the states which aren't modified stay at their defaults
+    uint32_t values[] = {
+        static_cast<uint32_t>(_modifiedBits),  _cullFaceEnabled, _depthTestEnabled, _depthWriteEnabled,
+        static_cast<uint32_t>(_depthFunction), _blendEnabled,    static_cast<uint32_t>(_blendSrc),
+        static_cast<uint32_t>(_blendDst),      static_cast<uint32_t>(_cullFaceSide), static_cast<uint32_t>(_frontFace)};
+    return XXH32(values, sizeof(values), 0);
+}
+
+bool RenderState::StateBlock::operator==(const StateBlock& other) const
+{
+    return _modifiedBits == other._modifiedBits && _cullFaceEnabled == other._cullFaceEnabled &&
+           _depthTestEnabled == other._depthTestEnabled && _depthWriteEnabled == other._depthWriteEnabled &&
+           _depthFunction == other._depthFunction && _blendEnabled == other._blendEnabled &&
+           _blendSrc == other._blendSrc && _blendDst == other._blendDst && _cullFaceSide == other._cullFaceSide &&
+           _frontFace == other._frontFace;
 }
 
 void RenderState::StateBlock::setBlend(bool enabled)
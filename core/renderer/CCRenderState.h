@@ -67,6 +67,16 @@ public:
      */
     void bindPass(Pass* pass, MeshCommand*);
 
+    /**
+     * Hashes the state blocks bindPass applies for the pass, the ones of its technique and material included.
+     */
+    static uint32_t getPassStatesHash(Pass* pass);
+
+    /**
+     * Returns true if bindPass applies the same states for both passes.
+     */
+    static bool isSamePassStates(Pass* lhs, Pass* rhs);
+
     /**
      * Defines a block of fixed-function render states that can be applied to a
      * RenderState object.
@@ -199,6 +209,9 @@ public:
         uint32_t getHash() const;
         bool isDirty() const;
 
+        bool operator==(const StateBlock& other) const;
+        bool operator!=(const StateBlock& other) const { return !(*this == other); }
+
         /** StateBlock bits to be used with invalidate */
         enum
         {
@@ -42,6 +42,8 @@
 #include "base/CCEventDispatcher.h"
 #include "base/CCEventListenerCustom.h"
 #include "base/CCEventType.h"
+#include "base/CCFrameProfiler.h"
+#include "base/CCJobSystem.h"
 #include "2d/CCCamera.h"
 #include "2d/CCScene.h"
 #include "xxhash.h"
@@ -151,6 +153,17 @@ void RenderQueue::realloc(size_t reserveSize)
     }
 }
 
+void RenderQueue::append(const RenderQueue& other)
+{
+    for (int i = 0; i < QUEUE_GROUP::QUEUE_COUNT; ++i)
+    {
+        _commands[i].insert(_commands[i].end(), other._commands[i].begin(), other._commands[i].end());
+    }
+}
+
+// the render queue of the calling thread while recording in parallel
+static thread_local RenderQueue* s_recordingQueue = nullptr;
+
 //
 //
 //
@@ -184,6 +197,7 @@ Renderer::~Renderer()
 
     free(_triBatchesToDraw);
 
+    CC_SAFE_RELEASE(_instanceBuffer);
     CC_SAFE_RELEASE(_depthStencilState);
     CC_SAFE_RELEASE(_commandBuffer);
     CC_SAFE_RELEASE(_renderPipeline);
@@ -213,6 +227,13 @@ void Renderer::init()
 
 void Renderer::addCommand(RenderCommand* command)
 {
+    if (s_recordingQueue)
+    {
+        CCASSERT(command->getType() != RenderCommand::Type::UNKNOWN_COMMAND, "Invalid Command Type");
+        s_recordingQueue->push_back(command);
+        return;
+    }
+
     int renderQueueID = _commandGroupStack.top();
     addCommand(command, renderQueueID);
 }
@@ -220,6 +241,7 @@ void Renderer::addCommand(RenderCommand* command)
 void Renderer::addCommand(RenderCommand* command, int renderQueueID)
 {
     CCASSERT(!_isRendering, "Cannot add command while rendering");
+    CCASSERT(!s_recordingQueue, "Cannot add command to a render queue while recording in parallel");
     CCASSERT(renderQueueID >= 0, "Invalid render queue");
     CCASSERT(command->getType() != RenderCommand::Type::UNKNOWN_COMMAND, "Invalid Command Type");
 
@@ -229,22 +251,98 @@ void Renderer::addCommand(RenderCommand* command, int renderQueueID)
 void Renderer::pushGroup(int renderQueueID)
 {
     CCASSERT(!_isRendering, "Cannot change render queue while rendering");
+    CCASSERT(!s_recordingQueue, "Cannot change render queue while recording in parallel");
     _commandGroupStack.push(renderQueueID);
 }
 
 void Renderer::popGroup()
 {
     CCASSERT(!_isRendering, "Cannot change render queue while rendering");
+    CCASSERT(!s_recordingQueue, "Cannot change render queue while recording in parallel");
     _commandGroupStack.pop();
 }
 
 int Renderer::createRenderQueue()
 {
+    CCASSERT(!s_recordingQueue, "Cannot create render queue while recording in parallel");
     RenderQueue newRenderQueue;
     _renderGroups.push_back(newRenderQueue);
     return (int)_renderGroups.size() - 1;
 }
 
+void Renderer::setRecordingThreadCount(unsigned int count)
+{
+    _recordingThreadCount = count;
+}
+
+unsigned int Renderer::getRecordingThreadCount() const
+{
+    unsigned int workerCount = JobSystem::getInstance()->getWorkerCount();
+    if (_recordingThreadCount != 0)
+        return std::min(_recordingThreadCount, workerCount);
+    return workerCount;
+}
+
+bool Renderer::isRecordingThread()
+{
+    return s_recordingQueue != nullptr;
+}
+
+void Renderer::recordParallel(size_t count, const std::function<void(size_t)>& record)
+{
+    CCASSERT(!_isRendering, "Cannot record commands while rendering");
+    CCASSERT(!s_recordingQueue, "Nested parallel recording is not supported");
+
+    if (_recordingQueues.size() < count)
+        _recordingQueues.resize(count);
+
+    // workers start with the model view matrix of the caller, and use their own stack
+    auto director           = Director::getInstance();
+    const Mat4 parentMatrix = director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+
+    auto recordInQueue = [&](size_t index) {
+        std::stack<Mat4> matrixStack;
+        matrixStack.push(parentMatrix);
+        director->setThreadModelViewMatrixStack(&matrixStack);
+
+        auto& queue = _recordingQueues[index];
+        queue.clear();
+        s_recordingQueue = &queue;
+        record(index);
+        s_recordingQueue = nullptr;
+
+        director->setThreadModelViewMatrixStack(nullptr);
+    };
+
+    JobSystem::getInstance()->parallelFor(count, recordInQueue, _recordingThreadCount);
+
+    // the tasks deferred by recording threads, e.g. dirty flags of shared objects
+    for (auto& task : _afterRecordingTasks)
+        task();
+    _afterRecordingTasks.clear();
+}
+
+void Renderer::mergeRecordedCommands(size_t index)
+{
+    CCASSERT(index < _recordingQueues.size(), "Invalid recording index");
+
+    auto& queue = _recordingQueues[index];
+    _renderGroups[_commandGroupStack.top()].append(queue);
+    queue.clear();
+}
+
+void Renderer::runAfterRecording(std::function<void()> task)
+{
+    if (!s_recordingQueue)
+    {
+        task();
+        return;
+    }
+
+    std::lock_guard<std::mutex> lck(_afterRecordingMutex);
+    _afterRecordingTasks.emplace_back(std::move(task));
+}
+
 void Renderer::processGroupCommand(GroupCommand* command)
 {
     flush();
@@ -272,6 +370,18 @@ void Renderer::processRenderCommand(RenderCommand* command)
 
         auto cmd = static_cast<TrianglesCommand*>(command);
 
+        if (_vertexStreamingEnabled && (_queuedStreamed || _queuedTriangleCommands.empty()))
+        {
+            // vertices are written once, when queued
+            _queuedStreamed = streamVerticesAndIndices(cmd);
+            if (_queuedStreamed)
+            {
+                _queuedTriangleCommands.push_back(cmd);
+                break;
+            }
+            // the stream buffers can't be mapped, copy the vertices like without streaming until the next flush
+        }
+
         // flush own queue when buffer is full
         if (_queuedTotalVertexCount + cmd->getVertexCount() > VBO_SIZE ||
             _queuedTotalIndexCount + cmd->getIndexCount() > INDEX_VBO_SIZE)
@@ -303,7 +413,10 @@ void Renderer::processRenderCommand(RenderCommand* command)
     break;
     case RenderCommand::Type::MESH_COMMAND:
         flush2D();
-        drawMeshCommand(command);
+        if (static_cast<MeshCommand*>(command)->isInstanced())
+            queueInstancedMeshCommand(static_cast<MeshCommand*>(command));
+        else
+            drawMeshCommand(command);
         break;
     case RenderCommand::Type::GROUP_COMMAND:
         processGroupCommand(static_cast<GroupCommand*>(command));
@@ -367,6 +480,8 @@ void Renderer::doVisitRenderQueue(const std::vector<RenderCommand*>& renderComma
 
 void Renderer::render()
 {
+    CC_PROFILE_ZONE("Renderer::render");
+
     // TODO: setup camera or MVP
     _isRendering = true;
     //    if (_glViewAssigned)
@@ -399,6 +514,15 @@ void Renderer::endFrame()
 #endif
     _queuedTotalIndexCount  = 0;
     _queuedTotalVertexCount = 0;
+    _instanceBufferOffset   = 0;
+
+    if (_vertexStreamingEnabled)
+    {
+        _streamBufferManager.putbackAllBuffers();
+        _streamFilledVertex = 0;
+        _streamFilledIndex  = 0;
+        _streamDiscard      = true;
+    }
 }
 
 void Renderer::clean()
@@ -587,6 +711,107 @@ void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd, unsigned int
     _filledIndex += indexCount;
 }
 
+bool Renderer::streamVerticesAndIndices(const TrianglesCommand* cmd)
+{
+    unsigned int vertexCount = (unsigned int)cmd->getVertexCount();
+    unsigned int indexCount  = (unsigned int)cmd->getIndexCount();
+    CCASSERT(vertexCount <= STREAM_VBO_SIZE && indexCount <= STREAM_INDEX_VBO_SIZE,
+             "VBO for vertex is not big enough, please break the data down or use customized render command");
+
+    // draw the queued commands and move on to the next buffers when these are full
+    if (_streamFilledVertex + vertexCount > STREAM_VBO_SIZE || _streamFilledIndex + indexCount > STREAM_INDEX_VBO_SIZE)
+    {
+        drawBatchedTriangles();
+        _streamBufferManager.prepareNextBuffer();
+        _streamFilledVertex = 0;
+        _streamFilledIndex  = 0;
+        _streamDiscard      = true;
+    }
+
+    if (!_streamVerts && !mapStreamBuffers())
+        return false;
+
+    if (_queuedTriangleCommands.empty())
+        _streamQueuedIndex = _streamFilledIndex;
+
+    // the mapped memory may be write combined, so it is only written
+    V3F_C4B_T2F* verts    = _streamVerts + (_streamFilledVertex - _streamMappedVertex);
+    const auto srcVerts   = cmd->getVertices();
+    const Mat4& modelView = cmd->getModelView();
+    for (unsigned int i = 0; i < vertexCount; ++i)
+    {
+        V3F_C4B_T2F vertex = srcVerts[i];
+        modelView.transformPoint(&vertex.vertices);
+        verts[i] = vertex;
+    }
+
+    unsigned int* indices = _streamIndices + (_streamFilledIndex - _streamMappedIndex);
+    const auto srcIndices = cmd->getIndices();
+    for (unsigned int i = 0; i < indexCount; ++i)
+        indices[i] = _streamFilledVertex + srcIndices[i];
+
+    _streamFilledVertex += vertexCount;
+    _streamFilledIndex += indexCount;
+    return true;
+}
+
+bool Renderer::mapStreamBuffers()
+{
+    auto vertexBuffer = _streamBufferManager.getVertexBuffer();
+    auto indexBuffer  = _streamBufferManager.getIndexBuffer();
+
+    // map the rest of the buffers, only the parts written before draw are used
+    const std::size_t vertexSize = sizeof(V3F_C4B_T2F);
+    const std::size_t indexSize  = sizeof(unsigned int);
+    _streamVerts   = (V3F_C4B_T2F*)vertexBuffer->map(
+        _streamFilledVertex * vertexSize, (STREAM_VBO_SIZE - _streamFilledVertex) * vertexSize, _streamDiscard);
+    _streamIndices = (unsigned int*)indexBuffer->map(
+        _streamFilledIndex * indexSize, (STREAM_INDEX_VBO_SIZE - _streamFilledIndex) * indexSize, _streamDiscard);
+    if (!_streamVerts || !_streamIndices)
+    {
+        unmapStreamBuffers();
+        return false;
+    }
+
+    _streamMappedVertex = _streamFilledVertex;
+    _streamMappedIndex  = _streamFilledIndex;
+    _streamDiscard      = false;
+    return true;
+}
+
+void Renderer::unmapStreamBuffers()
+{
+    _streamBufferManager.getVertexBuffer()->unmap();
+    _streamBufferManager.getIndexBuffer()->unmap();
+    _streamVerts   = nullptr;
+    _streamIndices = nullptr;
+}
+
+void Renderer::setVertexStreamingEnabled(bool enabled)
+{
+    CCASSERT(!_isRendering, "vertex streaming can't be changed while rendering");
+
+    if (enabled && !_streamBufferManager.isInitialized())
+        _streamBufferManager.init(backend::BufferUsage::STREAM);
+
+    _streamBufferManager.putbackAllBuffers();
+    _streamFilledVertex = 0;
+    _streamFilledIndex  = 0;
+    _streamDiscard      = true;
+
+    // check that the backend can map the buffers
+    if (enabled && (!_streamBufferManager.isInitialized() || !mapStreamBuffers()))
+    {
+        CCLOG("Renderer: vertex streaming is not supported");
+        enabled = false;
+    }
+    else if (enabled)
+    {
+        unmapStreamBuffers();
+    }
+    _vertexStreamingEnabled = enabled;
+}
+
 void Renderer::drawBatchedTriangles()
 {
     if (_queuedTriangleCommands.empty())
@@ -600,6 +825,10 @@ void Renderer::drawBatchedTriangles()
     unsigned int vertexBufferFillOffset = 0;
     unsigned int indexBufferFillOffset  = 0;
 #endif
+    // streamed vertices and indices were written when queued
+    const bool streaming = _queuedStreamed;
+    if (streaming)
+        indexBufferFillOffset = _streamQueuedIndex;
 
     _triBatchesToDraw[0].offset        = indexBufferFillOffset;
     _triBatchesToDraw[0].indicesToDraw = 0;
@@ -617,7 +846,8 @@ void Renderer::drawBatchedTriangles()
         auto currentMaterialID = cmd->getMaterialID();
         const bool batchable   = !cmd->isSkipBatching();
 
-        fillVerticesAndIndices(cmd, vertexBufferFillOffset);
+        if (!streaming)
+            fillVerticesAndIndices(cmd, vertexBufferFillOffset);
 
         // in the same batch ?
         if (batchable && (prevMaterialID == currentMaterialID || firstCommand))
@@ -657,20 +887,37 @@ void Renderer::drawBatchedTriangles()
         firstCommand   = false;
     }
     batchesTotal++;
+
+    backend::Buffer* vertexBuffer    = _vertexBuffer;
+    backend::Buffer* indexBuffer     = _indexBuffer;
+    backend::IndexFormat indexFormat = backend::IndexFormat::U_SHORT;
+    std::size_t indexSize            = sizeof(_indices[0]);
+    if (streaming)
+    {
+        unmapStreamBuffers();
+        vertexBuffer = _streamBufferManager.getVertexBuffer();
+        indexBuffer  = _streamBufferManager.getIndexBuffer();
+        indexFormat  = backend::IndexFormat::U_INT;
+        indexSize    = sizeof(unsigned int);
+    }
+    else
+    {
 #ifdef CC_USE_METAL
-    _vertexBuffer->updateSubData(_verts, vertexBufferFillOffset * sizeof(_verts[0]), _filledVertex * sizeof(_verts[0]));
-    _indexBuffer->updateSubData(_indices, indexBufferFillOffset * sizeof(_indices[0]),
-                                _filledIndex * sizeof(_indices[0]));
+        _vertexBuffer->updateSubData(_verts, vertexBufferFillOffset * sizeof(_verts[0]),
+                                     _filledVertex * sizeof(_verts[0]));
+        _indexBuffer->updateSubData(_indices, indexBufferFillOffset * sizeof(_indices[0]),
+                                    _filledIndex * sizeof(_indices[0]));
 #else
-    _vertexBuffer->updateData(_verts, _filledVertex * sizeof(_verts[0]));
-    _indexBuffer->updateData(_indices, _filledIndex * sizeof(_indices[0]));
+        _vertexBuffer->updateData(_verts, _filledVertex * sizeof(_verts[0]));
+        _indexBuffer->updateData(_indices, _filledIndex * sizeof(_indices[0]));
 #endif
+    }
 
     /************** 2: Draw *************/
     beginRenderPass();
 
-    _commandBuffer->setVertexBuffer(_vertexBuffer);
-    _commandBuffer->setIndexBuffer(_indexBuffer);
+    _commandBuffer->setVertexBuffer(vertexBuffer);
+    _commandBuffer->setIndexBuffer(indexBuffer);
 
     for (int i = 0; i < batchesTotal; ++i)
     {
@@ -678,8 +925,8 @@ void Renderer::drawBatchedTriangles()
         _commandBuffer->updatePipelineState(_currentRT, drawInfo.cmd->getPipelineDescriptor());
         auto& pipelineDescriptor = drawInfo.cmd->getPipelineDescriptor();
         _commandBuffer->setProgramState(pipelineDescriptor.programState);
-        _commandBuffer->drawElements(backend::PrimitiveType::TRIANGLE, backend::IndexFormat::U_SHORT,
-                                     drawInfo.indicesToDraw, drawInfo.offset * sizeof(_indices[0]));
+        _commandBuffer->drawElements(backend::PrimitiveType::TRIANGLE, indexFormat, drawInfo.indicesToDraw,
+                                     drawInfo.offset * indexSize);
 
         _drawnBatches++;
         _drawnVertices += _triBatchesToDraw[i].indicesToDraw;
@@ -689,6 +936,7 @@ void Renderer::drawBatchedTriangles()
 
     /************** 3: Cleanup *************/
     _queuedTriangleCommands.clear();
+    _queuedStreamed = false;
 
 #ifdef CC_USE_METAL
     _queuedIndexCount  = 0;
@@ -736,6 +984,212 @@ void Renderer::drawMeshCommand(RenderCommand* command)
     drawCustomCommand(command);
 }
 
+bool Renderer::isInstancingSupported() const
+{
+    static bool instancingSupported =
+        backend::Device::getInstance()->getDeviceInfo()->checkForFeatureSupported(backend::FeatureType::INSTANCING);
+    return instancingSupported;
+}
+
+static uint64_t hashUniformBuffers(backend::ProgramState* programState, uint64_t seed)
+{
+    char* buffer     = nullptr;
+    std::size_t size = 0;
+    programState->getVertexUniformBuffer(&buffer, size);
+    auto hash = buffer ? XXH64(buffer, size, seed) : seed;
+    programState->getFragmentUniformBuffer(&buffer, size);
+    return buffer ? XXH64(buffer, size, hash) : hash;
+}
+
+static bool isSameUniformBuffers(backend::ProgramState* lhs, backend::ProgramState* rhs)
+{
+    char* lhsBuffer     = nullptr;
+    char* rhsBuffer     = nullptr;
+    std::size_t lhsSize = 0;
+    std::size_t rhsSize = 0;
+    lhs->getVertexUniformBuffer(&lhsBuffer, lhsSize);
+    rhs->getVertexUniformBuffer(&rhsBuffer, rhsSize);
+    if (lhsSize != rhsSize || (lhsSize && memcmp(lhsBuffer, rhsBuffer, lhsSize) != 0))
+        return false;
+
+    lhs->getFragmentUniformBuffer(&lhsBuffer, lhsSize);
+    rhs->getFragmentUniformBuffer(&rhsBuffer, rhsSize);
+    return lhsSize == rhsSize && (lhsSize == 0 || memcmp(lhsBuffer, rhsBuffer, lhsSize) == 0);
+}
+
+static uint64_t hashInstancedMeshCommand(MeshCommand* command)
+{
+    auto programState     = command->getPipelineDescriptor().programState;
+    const void* objects[] = {programState->getProgram(), command->getVertexBuffer(), command->getIndexBuffer()};
+    uint64_t drawInfo[]   = {(uint64_t)command->getPrimitiveType(), (uint64_t)command->getIndexFormat(),
+                             (uint64_t)command->getIndexDrawOffset(), (uint64_t)command->getIndexDrawCount()};
+
+    auto hash = XXH64(drawInfo, sizeof(drawInfo), XXH64(objects, sizeof(objects), 0));
+
+    // the batch is drawn with the render state and the uniforms of its first command
+    uint32_t passStates = RenderState::getPassStatesHash(command->getPass());
+    hash                = hashUniformBuffers(programState, XXH64(&passStates, sizeof(passStates), hash));
+
+    // the texture maps aren't ordered, each texture is mixed on its own
+    for (const auto* textureInfos : {&programState->getVertexTextureInfos(), &programState->getFragmentTextureInfos()})
+    {
+        for (const auto& textureInfo : *textureInfos)
+        {
+            for (auto texture : textureInfo.second.textures)
+                hash += XXH64(&texture, sizeof(texture), textureInfo.first);
+        }
+    }
+    return hash;
+}
+
+static bool isSameTextures(const std::unordered_map<int, backend::TextureInfo>& lhs,
+                           const std::unordered_map<int, backend::TextureInfo>& rhs)
+{
+    if (lhs.size() != rhs.size())
+        return false;
+
+    for (const auto& textureInfo : lhs)
+    {
+        auto it = rhs.find(textureInfo.first);
+        if (it == rhs.end() || it->second.textures != textureInfo.second.textures)
+            return false;
+    }
+    return true;
+}
+
+static bool canDrawInstancesTogether(MeshCommand* lhs, MeshCommand* rhs)
+{
+    auto lhsProgramState = lhs->getPipelineDescriptor().programState;
+    auto rhsProgramState = rhs->getPipelineDescriptor().programState;
+    return lhsProgramState->getProgram() == rhsProgramState->getProgram() &&
+           lhs->getVertexBuffer() == rhs->getVertexBuffer() && lhs->getIndexBuffer() == rhs->getIndexBuffer() &&
+           lhs->getPrimitiveType() == rhs->getPrimitiveType() && lhs->getIndexFormat() == rhs->getIndexFormat() &&
+           lhs->getIndexDrawOffset() == rhs->getIndexDrawOffset() &&
+           lhs->getIndexDrawCount() == rhs->getIndexDrawCount() &&
+           isSameTextures(lhsProgramState->getVertexTextureInfos(), rhsProgramState->getVertexTextureInfos()) &&
+           isSameTextures(lhsProgramState->getFragmentTextureInfos(), rhsProgramState->getFragmentTextureInfos()) &&
+           RenderState::isSamePassStates(lhs->getPass(), rhs->getPass()) &&
+           isSameUniformBuffers(lhsProgramState, rhsProgramState);
+}
+
+void Renderer::queueInstancedMeshCommand(MeshCommand* command)
+{
+    // only the commands of the opaque 3D queue can be drawn out of order
+    // the render state applied by the before callback can only be compared through the pass
+    if (!command->is3D() || command->isTransparent() || command->isSkipBatching() || command->getGlobalOrder() != 0 ||
+        !command->getPass())
+    {
+        flush3D();
+        drawInstances(&command, 1);
+        return;
+    }
+
+    // the model view and projection uniforms are only set by the before callback, set them now so that the uniforms
+    // of the commands can be compared
+    command->getPass()->updateMVPUniform(command->getMV());
+
+    auto hash = hashInstancedMeshCommand(command);
+    auto it   = _instanceBatchIndexes.find(hash);
+    if (it != _instanceBatchIndexes.end() && canDrawInstancesTogether(_instanceBatches[it->second].front(), command))
+    {
+        _instanceBatches[it->second].push_back(command);
+        return;
+    }
+
+    if (_instanceBatchCount == _instanceBatches.size())
+        _instanceBatches.emplace_back();
+    auto& batch = _instanceBatches[_instanceBatchCount];
+    batch.clear();
+    batch.push_back(command);
+    _instanceBatchIndexes[hash] = _instanceBatchCount++;
+}
+
+void Renderer::drawInstancedMeshCommands()
+{
+    if (_instanceBatchCount == 0)
+        return;
+
+    for (std::size_t i = 0; i < _instanceBatchCount; ++i)
+        drawInstances(_instanceBatches[i].data(), _instanceBatches[i].size());
+
+    _instanceBatchCount = 0;
+    _instanceBatchIndexes.clear();
+}
+
+void Renderer::drawInstances(MeshCommand* const* commands, std::size_t count)
+{
+    // 3 rows of the model view matrix, then the color
+    static const std::size_t INSTANCE_STRIDE = sizeof(Vec4) * 4;
+    static const char* INSTANCE_ATTRIBUTES[] = {"a_instanceModelView0", "a_instanceModelView1", "a_instanceModelView2",
+                                                "a_instanceColor"};
+
+    auto first        = commands[0];
+    auto programState = first->getPipelineDescriptor().programState;
+    auto program      = programState->getProgram();
+
+    // the instances written in a frame are kept until the frame ends, the buffer grows until they fit
+    const auto size = count * INSTANCE_STRIDE;
+    if (!_instanceBuffer || _instanceBufferOffset + size > _instanceBufferCapacity * INSTANCE_STRIDE)
+    {
+        CC_SAFE_RELEASE(_instanceBuffer);
+        _instanceBufferCapacity = std::max(std::max(_instanceBufferCapacity * 2, count), (std::size_t)1024);
+        _instanceBuffer         = backend::Device::getInstance()->newBuffer(
+            _instanceBufferCapacity * INSTANCE_STRIDE, backend::BufferType::VERTEX, backend::BufferUsage::STREAM);
+        _instanceBufferOffset   = 0;
+    }
+
+    auto data = static_cast<Vec4*>(_instanceBuffer->map(_instanceBufferOffset, size, _instanceBufferOffset == 0));
+    if (!data)
+    {
+        CCLOG("Renderer: instancing is not supported");
+        return;
+    }
+    for (std::size_t i = 0; i < count; ++i, data += 4)
+    {
+        const auto& mv = commands[i]->getMV().m;
+        data[0].set(mv[0], mv[4], mv[8], mv[12]);
+        data[1].set(mv[1], mv[5], mv[9], mv[13]);
+        data[2].set(mv[2], mv[6], mv[10], mv[14]);
+        data[3] = commands[i]->getInstanceColor();
+    }
+    _instanceBuffer->unmap();
+
+    auto& layout = _instanceLayouts[program->getProgramType()];
+    if (!layout.isValid())
+    {
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            auto location = program->getAttributeLocation(INSTANCE_ATTRIBUTES[i]);
+            if (location >= 0)
+                layout.setAttribute(INSTANCE_ATTRIBUTES[i], location, backend::VertexFormat::FLOAT4,
+                                    i * sizeof(Vec4), false);
+        }
+        layout.setLayout(INSTANCE_STRIDE);
+    }
+
+    // the render state and the uniforms of the first command apply to all the instances
+    if (first->getBeforeCallback())
+        first->getBeforeCallback()();
+
+    beginRenderPass();
+    _commandBuffer->setVertexBuffer(first->getVertexBuffer());
+    _commandBuffer->updatePipelineState(_currentRT, first->getPipelineDescriptor());
+    _commandBuffer->setProgramState(programState);
+    _commandBuffer->setLineWidth(first->getLineWidth());
+    _commandBuffer->setIndexBuffer(first->getIndexBuffer());
+    _commandBuffer->setInstanceBuffer(_instanceBuffer, &layout, _instanceBufferOffset);
+    _commandBuffer->drawElementsInstanced(first->getPrimitiveType(), first->getIndexFormat(),
+                                          first->getIndexDrawCount(), first->getIndexDrawOffset(), count);
+    _drawnVertices += first->getIndexDrawCount() * count;
+    _drawnBatches++;
+    endRenderPass();
+
+    if (first->getAfterCallback())
+        first->getAfterCallback()();
+
+    _instanceBufferOffset += size;
+}
+
 void Renderer::flush()
 {
     flush2D();
@@ -749,7 +1203,7 @@ void Renderer::flush2D()
 
 void Renderer::flush3D()
 {
-    // TODO 3d batch rendering
+    drawInstancedMeshCommands();
 }
 
 void Renderer::flushTriangles()
@@ -922,8 +1376,9 @@ Renderer::TriangleCommandBufferManager::~TriangleCommandBufferManager()
         indexBuffer->release();
 }
 
-void Renderer::TriangleCommandBufferManager::init()
+void Renderer::TriangleCommandBufferManager::init(backend::BufferUsage usage)
 {
+    _usage = usage;
     createBuffer();
 }
 
@@ -958,45 +1413,39 @@ void Renderer::TriangleCommandBufferManager::createBuffer()
 {
     auto device = backend::Device::getInstance();
 
-#ifdef CC_USE_METAL
-    // Metal doesn't need to update buffer to make sure it has the correct size.
-    auto vertexBuffer = device->newBuffer(Renderer::VBO_SIZE * sizeof(_verts[0]), backend::BufferType::VERTEX,
-                                          backend::BufferUsage::DYNAMIC);
+    const bool stream = backend::BufferUsage::STREAM == _usage;
+    const std::size_t vertexBufferSize =
+        (stream ? Renderer::STREAM_VBO_SIZE : Renderer::VBO_SIZE) * sizeof(V3F_C4B_T2F);
+    const std::size_t indexBufferSize = stream ? Renderer::STREAM_INDEX_VBO_SIZE * sizeof(unsigned int)
+                                               : Renderer::INDEX_VBO_SIZE * sizeof(unsigned short);
+
+    auto vertexBuffer = device->newBuffer(vertexBufferSize, backend::BufferType::VERTEX, _usage);
     if (!vertexBuffer)
         return;
 
-    auto indexBuffer = device->newBuffer(Renderer::INDEX_VBO_SIZE * sizeof(_indices[0]), backend::BufferType::INDEX,
-                                         backend::BufferUsage::DYNAMIC);
+    auto indexBuffer = device->newBuffer(indexBufferSize, backend::BufferType::INDEX, _usage);
     if (!indexBuffer)
     {
         vertexBuffer->release();
         return;
     }
-#else
-    auto tmpData = malloc(Renderer::VBO_SIZE * sizeof(V3F_C4B_T2F));
-    if (!tmpData)
-        return;
-
-    auto vertexBuffer = device->newBuffer(Renderer::VBO_SIZE * sizeof(V3F_C4B_T2F), backend::BufferType::VERTEX,
-                                          backend::BufferUsage::DYNAMIC);
-    if (!vertexBuffer)
-    {
-        free(tmpData);
-        return;
-    }
-    vertexBuffer->updateData(tmpData, Renderer::VBO_SIZE * sizeof(V3F_C4B_T2F));
 
-    auto indexBuffer = device->newBuffer(Renderer::INDEX_VBO_SIZE * sizeof(unsigned short), backend::BufferType::INDEX,
-                                         backend::BufferUsage::DYNAMIC);
-    if (!indexBuffer)
+#ifndef CC_USE_METAL
+    // Metal doesn't need to update buffer to make sure it has the correct size, stream buffers are allocated when
+    // mapped.
+    if (!stream)
     {
+        auto tmpData = malloc(vertexBufferSize);
+        if (!tmpData)
+        {
+            vertexBuffer->release();
+            indexBuffer->release();
+            return;
+        }
+        vertexBuffer->updateData(tmpData, vertexBufferSize);
+        indexBuffer->updateData(tmpData, indexBufferSize);
         free(tmpData);
-        vertexBuffer->release();
-        return;
     }
-    indexBuffer->updateData(tmpData, Renderer::INDEX_VBO_SIZE * sizeof(unsigned short));
-
-    free(tmpData);
 #endif
 
     _vertexBufferPool.push_back(vertexBuffer);
@@ -28,10 +28,14 @@
 #include <stack>
 #include <array>
 #include <deque>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
 
 #include "platform/CCPlatformMacros.h"
 #include "renderer/CCRenderCommand.h"
 #include "renderer/backend/Types.h"
+#include "renderer/backend/VertexLayout.h"
 
 /**
  * @addtogroup renderer
@@ -103,6 +107,8 @@ public:
     void clear();
     /**Realloc command queues and reserve with given size. Note: this clears any existing commands.*/
     void realloc(size_t reserveSize);
+    /**Append all commands of other queue, the result is the same as pushing them one by one.*/
+    void append(const RenderQueue& other);
     /**Get a sub group of the render queue.*/
     std::vector<RenderCommand*>& getSubQueue(QUEUE_GROUP group) { return _commands[group]; }
     /**Get the number of render commands contained in a subqueue.*/
@@ -133,6 +139,10 @@ public:
     static const int VBO_SIZE = 65536;
     /**The max number of indices in a index buffer.*/
     static const int INDEX_VBO_SIZE = VBO_SIZE * 6 / 4;
+    /**The max number of vertices in a streaming vertex buffer, which uses 32 bits indices.*/
+    static const int STREAM_VBO_SIZE = 262144;
+    /**The max number of indices in a streaming index buffer.*/
+    static const int STREAM_INDEX_VBO_SIZE = STREAM_VBO_SIZE * 6 / 4;
     /**The rendercommands which can be batched will be saved into a list, this is the reserved size of this list.*/
     static const int BATCH_TRIAGCOMMAND_RESERVED_SIZE = 64;
     /**Reserved for material id, which means that the command could not be batched.*/
@@ -163,6 +173,65 @@ public:
     /** Renders into the GLView all the queued `RenderCommand` objects */
     void render();
 
+    /**
+     * Enable/disable recording the children of parallel root nodes on worker threads.
+     * @see Node::setParallelRoot
+     */
+    void setParallelRecordingEnabled(bool enabled) { _parallelRecordingEnabled = enabled; }
+
+    /** Whether the children of parallel root nodes are recorded on worker threads. */
+    bool isParallelRecordingEnabled() const { return _parallelRecordingEnabled; }
+
+    /**
+     * Set the number of JobSystem workers used for parallel recording, the cocos thread always takes part in it.
+     * @param count The number of worker threads, 0 means all the workers of the shared JobSystem.
+     */
+    void setRecordingThreadCount(unsigned int count);
+
+    /** Get the number of worker threads used for parallel recording. */
+    unsigned int getRecordingThreadCount() const;
+
+    /**
+     * Invokes `record(index)` for every index in [0, count) on the JobSystem workers and waits for them.
+     * Commands added by `record(index)` go into a private render queue of that index, and are merged
+     * into the current render queue with `mergeRecordedCommands(index)`, so the final order doesn't
+     * depend on thread scheduling.
+     * @note Nodes visited by `record` must only add commands, pushing groups from worker threads is not supported.
+     */
+    void recordParallel(size_t count, const std::function<void(size_t)>& record);
+
+    /** Appends the commands recorded for index by the last `recordParallel` into the current render queue. */
+    void mergeRecordedCommands(size_t index);
+
+    /** Returns true if the calling thread is recording commands inside `recordParallel`. */
+    static bool isRecordingThread();
+
+    /**
+     * Runs the task on the cocos thread once the current `recordParallel` finished,
+     * or immediately if not called from a recording thread.
+     */
+    void runAfterRecording(std::function<void()> task);
+
+    /**
+     * Enable/disable streaming the vertices of `TrianglesCommand`s. When enabled, vertices are transformed directly
+     * into large mapped buffers (persistently mapped and triple-buffered when the backend supports it, orphaned
+     * otherwise), instead of being copied to an intermediate array and uploaded, and batches are not split every
+     * VBO_SIZE vertices.
+     * It stays disabled if the backend can't map buffers, and should not be changed while rendering.
+     */
+    void setVertexStreamingEnabled(bool enabled);
+
+    /** Whether the vertices of `TrianglesCommand`s are streamed into mapped buffers. */
+    bool isVertexStreamingEnabled() const { return _vertexStreamingEnabled; }
+
+    /**
+     * Whether the backend can draw instanced `MeshCommand`s. Opaque instanced commands sharing the same buffers,
+     * program and textures are drawn with one instanced draw call, their model view matrices and colors are streamed
+     * into a per instance vertex buffer.
+     * @see MeshCommand::setInstanced
+     */
+    bool isInstancingSupported() const;
+
     /** Cleans all `RenderCommand`s in the queue */
     void clean();
 
@@ -425,9 +494,14 @@ protected:
 
         /**
          * Create a new vertex buffer and a index buffer and push it to cache.
+         * @param usage BufferUsage::STREAM buffers hold STREAM_VBO_SIZE vertices with 32 bits indices, the others
+         * VBO_SIZE vertices with 16 bits indices.
          * @note Should invoke firstly.
          */
-        void init();
+        void init(backend::BufferUsage usage = backend::BufferUsage::DYNAMIC);
+
+        /** Whether buffers were created by `init()`. */
+        bool isInitialized() const { return !_vertexBufferPool.empty(); }
 
         /**
          * Reset avalable buffer index to zero.
@@ -448,7 +522,8 @@ protected:
     private:
         void createBuffer();
 
-        int _currentBufferIndex = 0;
+        int _currentBufferIndex     = 0;
+        backend::BufferUsage _usage = backend::BufferUsage::DYNAMIC;
         std::vector<backend::Buffer*> _vertexBufferPool;
         std::vector<backend::Buffer*> _indexBufferPool;
     };
@@ -458,6 +533,13 @@ protected:
     void drawCustomCommand(RenderCommand* command);
     void drawMeshCommand(RenderCommand* command);
 
+    /// Queues an opaque instanced command in the batch of the commands it can be drawn with, others are drawn at once.
+    void queueInstancedMeshCommand(MeshCommand* command);
+    /// Draws the queued batches of instanced commands.
+    void drawInstancedMeshCommands();
+    /// Draws the commands with one instanced draw call, they share the buffers, program and textures of the first one.
+    void drawInstances(MeshCommand* const* commands, std::size_t count);
+
     bool beginFrame();  /// Indicate the begining of a frame
     void endFrame();    /// Finish a frame.
 
@@ -477,6 +559,11 @@ protected:
 
     void fillVerticesAndIndices(const TrianglesCommand* cmd, unsigned int vertexBufferOffset);
 
+    /// Transforms the vertices of the command into the mapped stream buffers, moving to the next ones if full.
+    bool streamVerticesAndIndices(const TrianglesCommand* cmd);
+    bool mapStreamBuffers();
+    void unmapStreamBuffers();
+
     void pushStateBlock();
 
     void popStateBlock();
@@ -493,8 +580,24 @@ protected:
 
     std::vector<RenderQueue> _renderGroups;
 
+    // parallel recording
+    bool _parallelRecordingEnabled     = false;
+    unsigned int _recordingThreadCount = 0;
+    std::vector<RenderQueue> _recordingQueues;
+    std::vector<std::function<void()>> _afterRecordingTasks;
+    std::mutex _afterRecordingMutex;
+
     std::vector<TrianglesCommand*> _queuedTriangleCommands;
 
+    // for instanced MeshCommand, the batches are kept to reuse their storage
+    std::vector<std::vector<MeshCommand*>> _instanceBatches;
+    std::size_t _instanceBatchCount = 0;
+    std::unordered_map<uint64_t, std::size_t> _instanceBatchIndexes;
+    backend::Buffer* _instanceBuffer    = nullptr;
+    std::size_t _instanceBufferCapacity = 0;  // in instances
+    std::size_t _instanceBufferOffset   = 0;  // in bytes, written in the current frame
+    std::unordered_map<uint32_t, backend::VertexLayout> _instanceLayouts;  // by program type
+
     // the pool for clear commands
     std::vector<CallbackCommand*> _clearCommandsPool;
 
@@ -505,6 +608,19 @@ protected:
     backend::Buffer* _indexBuffer  = nullptr;
     TriangleCommandBufferManager _triangleCommandBufferManager;
 
+    // for streamed TrianglesCommand, the vertices are written into the mapped buffers
+    bool _vertexStreamingEnabled = false;
+    TriangleCommandBufferManager _streamBufferManager;
+    V3F_C4B_T2F* _streamVerts        = nullptr;  // mapped from _streamMappedVertex
+    unsigned int* _streamIndices     = nullptr;  // mapped from _streamMappedIndex
+    unsigned int _streamMappedVertex = 0;
+    unsigned int _streamMappedIndex  = 0;
+    unsigned int _streamFilledVertex = 0;
+    unsigned int _streamFilledIndex  = 0;
+    unsigned int _streamQueuedIndex  = 0;  // first index of the queued commands
+    bool _streamDiscard              = true;
+    bool _queuedStreamed             = false;  // the queued commands were streamed, else they are copied
+
     backend::CommandBuffer* _commandBuffer = nullptr;
     backend::RenderPassDescriptor _renderPassDesc;
 
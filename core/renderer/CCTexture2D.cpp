@@ -44,6 +44,7 @@ THE SOFTWARE.
 #include "platform/CCPlatformMacros.h"
 #include "base/CCDirector.h"
 #include "base/CCNinePatchImageParser.h"
+#include "base/CCFrameProfiler.h"
 #include "renderer/backend/Device.h"
 #include "renderer/backend/ProgramState.h"
 #include "renderer/ccShaders.h"
@@ -294,6 +295,8 @@ bool Texture2D::updateWithMipmaps(MipmapInfo* mipmaps,
                                   bool preMultipliedAlpha,
                                   int index)
 {
+    CC_PROFILE_ZONE("Texture2D::updateWithMipmaps");
+
     // the pixelFormat must be a certain value
     CCASSERT(pixelFormat != PixelFormat::NONE, "the \"pixelFormat\" param must be a certain value!");
     CCASSERT(pixelsWide > 0 && pixelsHigh > 0, "Invalid size");
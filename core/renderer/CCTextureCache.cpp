@@ -33,6 +33,8 @@ THE SOFTWARE.
 #include <stack>
 #include <cctype>
 #include <list>
+#include <chrono>
+#include <algorithm>
 
 #include "renderer/CCTexture2D.h"
 #include "base/ccMacros.h"
@@ -42,6 +44,7 @@ THE SOFTWARE.
 #include "platform/CCFileUtils.h"
 #include "base/ccUtils.h"
 #include "base/CCNinePatchImageParser.h"
+#include "base/CCFrameProfiler.h"
 #include "renderer/backend/Device.h"
 
 using namespace std;
@@ -62,7 +65,23 @@ std::string TextureCache::getETC1AlphaFileSuffix()
     return s_etc1AlphaFileSuffix;
 }
 
-TextureCache::TextureCache() : _loadingThread(nullptr), _needQuit(false), _asyncRefCount(0) {}
+struct TextureCache::PreloadBatch
+{
+    unsigned int id;
+    PreloadProgressCallback progress;
+    std::vector<std::string> pending;  // full paths of the entries this batch waits for
+    size_t total    = 0;
+    size_t loaded   = 0;
+    size_t reported = 0;
+};
+
+TextureCache::TextureCache()
+    : _loadingThread(nullptr)
+    , _needQuit(false)
+    , _asyncRefCount(0)
+    , _nextPreloadBatchId(0)
+    , _preloadUploadTimeBudget(0.004f)
+{}
 
 TextureCache::~TextureCache()
 {
@@ -71,6 +90,9 @@ TextureCache::~TextureCache()
     for (auto& texture : _textures)
         texture.second->release();
 
+    for (auto& batch : _preloadBatches)
+        delete batch.second;
+
     CC_SAFE_DELETE(_loadingThread);
 }
 
@@ -336,27 +358,8 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
             // convert image to texture
             if (asyncStruct->loadSuccess)
             {
-                Image* image = &(asyncStruct->image);
-                // generate texture in render thread
-                texture = new Texture2D();
-
-                texture->initWithImage(image, asyncStruct->pixelFormat);
-                // parse 9-patch info
-                this->parseNinePatchImage(image, texture, asyncStruct->filename);
-#if CC_ENABLE_CACHE_TEXTURE_DATA
-                // cache the texture file name
-                VolatileTextureMgr::addImageTexture(texture, asyncStruct->filename);
-#endif
-                // cache the texture. retain it, since it is added in the map
-                _textures.emplace(asyncStruct->filename, texture);
-                texture->retain();
-
-                texture->autorelease();
-                // ETC1 ALPHA supports.
-                if (asyncStruct->imageAlpha.getFileType() == Image::Format::ETC1)
-                {
-                    texture->updateWithImage(&asyncStruct->imageAlpha, Texture2D::getDefaultAlphaPixelFormat(), 1);
-                }
+                texture = createAsyncTexture(asyncStruct->filename, &asyncStruct->image, &asyncStruct->imageAlpha,
+                                             asyncStruct->pixelFormat);
             }
             else
             {
@@ -383,8 +386,252 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
     }
 }
 
+Texture2D* TextureCache::createAsyncTexture(std::string_view path,
+                                            Image* image,
+                                            Image* imageAlpha,
+                                            backend::PixelFormat pixelFormat)
+{
+    CC_PROFILE_ZONE("TextureCache::createAsyncTexture");
+
+    // generate texture in render thread
+    Texture2D* texture = new Texture2D();
+
+    texture->initWithImage(image, pixelFormat);
+    // parse 9-patch info
+    this->parseNinePatchImage(image, texture, path);
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    // cache the texture file name
+    VolatileTextureMgr::addImageTexture(texture, path);
+#endif
+    // cache the texture. retain it, since it is added in the map
+    _textures.emplace(path, texture);
+    texture->retain();
+
+    texture->autorelease();
+    // ETC1 ALPHA supports.
+    if (imageAlpha->getFileType() == Image::Format::ETC1)
+    {
+        texture->updateWithImage(imageAlpha, Texture2D::getDefaultAlphaPixelFormat(), 1);
+    }
+    return texture;
+}
+
+struct TextureCache::PreloadEntry
+{
+    PreloadEntry(std::string_view fn, JobSystem::Priority jobPriority)
+        : filename(fn), pixelFormat(Texture2D::getDefaultAlphaPixelFormat()), priority(jobPriority)
+    {}
+
+    std::string filename;
+    Image image;
+    Image imageAlpha;
+    backend::PixelFormat pixelFormat;
+    JobSystem::Priority priority;
+    std::atomic<bool> cancelled{false};  // no batch wants it anymore, skip decoding
+    bool decoded     = false;
+    bool loadSuccess = false;
+
+    // cocos thread only
+    std::vector<PreloadBatch*> batches;
+};
+
+struct TextureCache::PreloadResults
+{
+    std::mutex mutex;
+    std::deque<std::shared_ptr<PreloadEntry>> entries;
+};
+
+/**
+ The preloadTexturesAsync logic follow the steps:
+ - each path not cached yet gets a PreloadEntry, shared by all the batches requesting it while it's in flight
+ (GL thread)
+ - a job decodes the entry on a JobSystem worker and pushes it into _preloadResults (worker threads)
+ - preloadUpdate pops the decoded entries until the upload time budget is spent, creates the textures, then reports
+ the progress of the batches (GL thread)
+
+ Cancelling a batch detaches it from its entries, an entry nobody waits for is flagged so its job skips decoding.
+ If another batch asks for it before the job ran, the entry is decoded again when its skipped result comes back.
+ */
+unsigned int TextureCache::preloadTexturesAsync(const std::vector<std::string>& paths,
+                                                const PreloadProgressCallback& progress,
+                                                JobSystem::Priority priority)
+{
+    if (!_preloadResults)
+        _preloadResults = std::make_shared<PreloadResults>();
+
+    auto batch      = new PreloadBatch();
+    batch->id       = ++_nextPreloadBatchId;
+    batch->progress = progress;
+
+    hlookup::string_set requested;
+    auto fileUtils = FileUtils::getInstance();
+    for (auto& path : paths)
+    {
+        std::string fullpath = fileUtils->fullPathForFilename(path);
+        if (!requested.insert(fullpath).second)
+            continue;
+
+        ++batch->total;
+        if (fullpath.empty() || _textures.find(fullpath) != _textures.end())
+        {
+            if (fullpath.empty())
+                CCLOG("cocos2d: TextureCache::preloadTexturesAsync can't find %s", path.c_str());
+            ++batch->loaded;
+            continue;
+        }
+
+        auto& entry = _preloadEntries[fullpath];
+        if (!entry)
+        {
+            entry = std::make_shared<PreloadEntry>(fullpath, priority);
+            JobSystem::getInstance()->submit([entry, results = _preloadResults] { decodePreloadEntry(entry, results); },
+                                             priority);
+        }
+        entry->cancelled = false;
+        entry->batches.push_back(batch);
+        batch->pending.push_back(std::move(fullpath));
+    }
+
+    _preloadBatches.emplace(batch->id, batch);
+
+    auto scheduler = Director::getInstance()->getScheduler();
+    if (!scheduler->isScheduled(CC_SCHEDULE_SELECTOR(TextureCache::preloadUpdate), this))
+        scheduler->schedule(CC_SCHEDULE_SELECTOR(TextureCache::preloadUpdate), this, 0, false);
+    return batch->id;
+}
+
+void TextureCache::cancelPreload(unsigned int batchId)
+{
+    auto batchIt = _preloadBatches.find(batchId);
+    if (batchIt == _preloadBatches.end())
+        return;
+
+    auto batch = batchIt->second;
+    for (auto& path : batch->pending)
+    {
+        auto entryIt = _preloadEntries.find(path);
+        if (entryIt == _preloadEntries.end())
+            continue;
+
+        auto& entry = entryIt->second;
+        entry->batches.erase(std::remove(entry->batches.begin(), entry->batches.end(), batch), entry->batches.end());
+        if (entry->batches.empty())
+            entry->cancelled = true;
+    }
+
+    _preloadBatches.erase(batchIt);
+    delete batch;
+}
+
+void TextureCache::decodePreloadEntry(std::shared_ptr<PreloadEntry> entry, std::shared_ptr<PreloadResults> results)
+{
+    if (!entry->cancelled)
+    {
+        CC_PROFILE_ZONE("TextureCache::decodePreloadEntry");
+        entry->loadSuccess = entry->image.initWithImageFileThreadSafe(entry->filename);
+
+        // ETC1 ALPHA supports.
+        if (entry->loadSuccess && entry->image.getFileType() == Image::Format::ETC1 && !s_etc1AlphaFileSuffix.empty())
+        {  // check whether alpha texture exists & load it
+            auto alphaFile = entry->filename + s_etc1AlphaFileSuffix;
+            if (FileUtils::getInstance()->isFileExist(alphaFile))
+                entry->imageAlpha.initWithImageFileThreadSafe(alphaFile);
+        }
+        entry->decoded = true;
+    }
+
+    std::lock_guard<std::mutex> lock(results->mutex);
+    results->entries.push_back(std::move(entry));
+}
+
+void TextureCache::preloadUpdate(float /*dt*/)
+{
+    using namespace std::chrono;
+    auto start  = steady_clock::now();
+    auto budget = duration<float>(_preloadUploadTimeBudget);
+
+    bool uploaded = false;
+    while (!uploaded || steady_clock::now() - start < budget)
+    {
+        std::shared_ptr<PreloadEntry> entry;
+        {
+            std::lock_guard<std::mutex> lock(_preloadResults->mutex);
+            if (_preloadResults->entries.empty())
+                break;
+            entry = std::move(_preloadResults->entries.front());
+            _preloadResults->entries.pop_front();
+        }
+
+        if (!entry->decoded && !entry->batches.empty())
+        {
+            // skipped after a cancel, but requested again since
+            JobSystem::getInstance()->submit([entry, results = _preloadResults] { decodePreloadEntry(entry, results); },
+                                             entry->priority);
+            continue;
+        }
+
+        _preloadEntries.erase(entry->filename);
+        if (entry->batches.empty())
+            continue;
+
+        if (_textures.find(entry->filename) == _textures.end())
+        {
+            if (entry->loadSuccess)
+            {
+                createAsyncTexture(entry->filename, &entry->image, &entry->imageAlpha, entry->pixelFormat);
+                uploaded = true;
+            }
+            else
+            {
+                CCLOG("cocos2d: failed to call TextureCache::preloadTexturesAsync(%s)", entry->filename.c_str());
+            }
+        }
+
+        for (auto batch : entry->batches)
+            ++batch->loaded;
+    }
+
+    // progress callbacks may start or cancel batches
+    std::vector<unsigned int> batchIds;
+    batchIds.reserve(_preloadBatches.size());
+    for (auto& batch : _preloadBatches)
+        batchIds.push_back(batch.first);
+
+    for (auto batchId : batchIds)
+    {
+        auto batchIt = _preloadBatches.find(batchId);
+        if (batchIt == _preloadBatches.end())
+            continue;
+
+        auto batch = batchIt->second;
+        if (batch->loaded == batch->reported && batch->loaded != batch->total)
+            continue;
+
+        bool finished   = batch->loaded == batch->total;
+        batch->reported = batch->loaded;
+        if (finished)
+        {
+            _preloadBatches.erase(batchIt);
+            if (batch->progress)
+                batch->progress(batch->loaded, batch->total);
+            delete batch;
+        }
+        else if (batch->progress)
+        {
+            batch->progress(batch->loaded, batch->total);
+        }
+    }
+
+    if (_preloadBatches.empty() && _preloadEntries.empty())
+    {
+        Director::getInstance()->getScheduler()->unschedule(CC_SCHEDULE_SELECTOR(TextureCache::preloadUpdate), this);
+    }
+}
+
 Texture2D* TextureCache::addImage(std::string_view path)
 {
+    CC_PROFILE_ZONE("TextureCache::addImage");
+
     Texture2D* texture = nullptr;
     Image* image       = nullptr;
     // Split up directory and filename
@@ -463,6 +710,8 @@ void TextureCache::parseNinePatchImage(cocos2d::Image* image, cocos2d::Texture2D
 
 Texture2D* TextureCache::addImage(Image* image, std::string_view key)
 {
+    CC_PROFILE_ZONE("TextureCache::addImage");
+
     CCASSERT(image != nullptr, "TextureCache: image MUST not be nil");
     CCASSERT(image->getData() != nullptr, "TextureCache: image MUST not be nil");
 
@@ -633,6 +882,16 @@ std::string TextureCache::getTextureFilePath(cocos2d::Texture2D* texture) const
 
 void TextureCache::waitForQuit()
 {
+    // the decode jobs don't reference the cache, only skip the ones not started yet
+    for (auto& batch : _preloadBatches)
+        delete batch.second;
+    _preloadBatches.clear();
+    for (auto& entry : _preloadEntries)
+        entry.second->cancelled = true;
+    _preloadEntries.clear();
+    _preloadResults = nullptr;
+    Director::getInstance()->getScheduler()->unschedule(CC_SCHEDULE_SELECTOR(TextureCache::preloadUpdate), this);
+
     // notify sub thread to quick
     std::unique_lock<std::mutex> ul(_requestMutex);
     _needQuit = true;
@@ -38,6 +38,7 @@ THE SOFTWARE.
 #include <functional>
 
 #include "base/CCRef.h"
+#include "base/CCJobSystem.h"
 #include "renderer/CCTexture2D.h"
 #include "platform/CCImage.h"
 
@@ -123,6 +124,36 @@ public:
      */
     virtual void unbindAllImageAsync();
 
+    /** Callback of preloadTexturesAsync, invoked with the number of textures done and the total of the batch. */
+    typedef std::function<void(size_t loaded, size_t total)> PreloadProgressCallback;
+
+    /** Loads a batch of textures in the background.
+     * The images are decoded by the JobSystem workers, several at once, and turned into textures on the cocos thread
+     * within the upload time budget of each frame. A path already cached, or requested by another batch still in
+     * flight, is not decoded again. Missing or undecodable files count as done, the failure is logged.
+     * @param paths The files to load, duplicates are counted once.
+     * @param progress Called on the cocos thread at most once per frame while the batch makes progress, the last call
+     * has loaded == total. May be null.
+     * @param priority Priority of the decode jobs.
+     * @return The batch id to pass to cancelPreload.
+     */
+    unsigned int preloadTexturesAsync(const std::vector<std::string>& paths,
+                                      const PreloadProgressCallback& progress,
+                                      JobSystem::Priority priority = JobSystem::Priority::NORMAL);
+
+    /** Cancels a batch started by preloadTexturesAsync, its progress callback won't be called anymore.
+     * Textures already uploaded stay in the cache, images only requested by this batch are not decoded if their
+     * job didn't start yet.
+     */
+    void cancelPreload(unsigned int batchId);
+
+    /** Sets the time in seconds spent uploading preloaded textures per frame, at least one is uploaded per frame.
+     * The default is 0.004.
+     */
+    void setPreloadUploadTimeBudget(float seconds) { _preloadUploadTimeBudget = seconds; }
+
+    float getPreloadUploadTimeBudget() const { return _preloadUploadTimeBudget; }
+
     /** Returns a Texture2D object given an Image.
      * If the image was not previously loaded, it will create a new Texture2D object and it will return it.
      * Otherwise it will return a reference of a previously loaded image.
@@ -201,8 +232,18 @@ public:
     void renameTextureWithKey(std::string_view srcName, std::string_view dstName);
 
 private:
+    struct PreloadEntry;
+    struct PreloadBatch;
+    struct PreloadResults;
+
     void addImageAsyncCallBack(float dt);
     void loadImage();
+    void preloadUpdate(float dt);
+    static void decodePreloadEntry(std::shared_ptr<PreloadEntry> entry, std::shared_ptr<PreloadResults> results);
+    Texture2D* createAsyncTexture(std::string_view path,
+                                  Image* image,
+                                  Image* imageAlpha,
+                                  backend::PixelFormat pixelFormat);
     void parseNinePatchImage(Image* image, Texture2D* texture, std::string_view path);
 
 public:
@@ -226,6 +267,13 @@ protected:
 
     hlookup::string_map<Texture2D*> _textures;
 
+    // batch preloading, see preloadTexturesAsync
+    hlookup::string_map<std::shared_ptr<PreloadEntry>> _preloadEntries;  // being decoded, by full path
+    std::unordered_map<unsigned int, PreloadBatch*> _preloadBatches;
+    std::shared_ptr<PreloadResults> _preloadResults;  // shared with the decode jobs, they may outlive the cache
+    unsigned int _nextPreloadBatchId;
+    float _preloadUploadTimeBudget;
+
     static std::string s_etc1AlphaFileSuffix;
 };
 
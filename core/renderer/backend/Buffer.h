@@ -73,6 +73,22 @@ public:
      */
     virtual void usingDefaultStoredData(bool needDefaultStoredData) = 0;
 
+    /**
+     * Map a region of the buffer to write it directly, without an intermediate copy.
+     * The region can only be written, and `unmap()` should be invoked before the buffer is used to draw.
+     * @param offset Specifies the offset in bytes of the region.
+     * @param size Specifies the size in bytes of the region.
+     * @param discard Specifies whether the whole content of the buffer can be discarded. If false, the region should
+     * not be referenced by a draw issued since the last discard, the GPU may still be reading it.
+     * @return The address of the region, or nullptr if the buffer can't be mapped.
+     */
+    virtual void* map(std::size_t offset, std::size_t size, bool discard) { return nullptr; }
+
+    /**
+     * Finish writing the region mapped by `map()`.
+     */
+    virtual void unmap() {}
+
     /**
      * Get buffer size in bytes.
      * @return The buffer size in bytes.
@@ -169,6 +169,31 @@ public:
                               std::size_t count,
                               std::size_t offset) = 0;
 
+    /**
+     * Set per instance attributes for the next `drawElementsInstanced()`.
+     * @param buffer A buffer object that the device will read per instance attributes from.
+     * @param layout The layout of the per instance attributes, its indexes are attribute locations of the program.
+     * @param offset Byte offset within buffer of the attributes of the first instance.
+     */
+    virtual void setInstanceBuffer(Buffer* buffer, const VertexLayout* layout, std::size_t offset) {}
+
+    /**
+     * Draw several instances of primitives with an index list, attributes set by `setInstanceBuffer()` advance once
+     * per instance.
+     * @param primitiveType The type of primitives that elements are assembled into.
+     * @param indexType The type if indexes, either 16 bit integer or 32 bit integer.
+     * @param count The number of indexes to read from the index buffer for each instance.
+     * @param offset Byte offset within indexBuffer to start reading indexes from.
+     * @param instanceCount The number of instances to draw.
+     * @note Only available if FeatureType::INSTANCING is supported.
+     */
+    virtual void drawElementsInstanced(PrimitiveType primitiveType,
+                                       IndexFormat indexType,
+                                       std::size_t count,
+                                       std::size_t offset,
+                                       std::size_t instanceCount)
+    {}
+
     /**
      * Do some resources release.
      */
@@ -43,7 +43,10 @@ enum class FeatureType : uint32_t
     VAO,
     MAPBUFFER,
     DEPTH24,
-    ASTC
+    ASTC,
+    BUFFER_STORAGE,
+    INSTANCING,
+    UNIFORM_BUFFER
 };
 
 /**
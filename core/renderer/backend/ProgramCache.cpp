@@ -123,6 +123,25 @@ bool ProgramCache::init()
     registerProgramFactory(ProgramType::TERRAIN_3D, CC3D_terrain_vert, CC3D_terrain_frag);
     registerProgramFactory(ProgramType::PARTICLE_TEXTURE_3D, CC3D_particle_vert, CC3D_particleTexture_frag);
     registerProgramFactory(ProgramType::PARTICLE_COLOR_3D, CC3D_particle_vert, CC3D_particleColor_frag);
+    const char* dualQuaternionDef = "\n#define USE_DUAL_QUATERNION 1 \n";
+    registerProgramFactory(ProgramType::SKINPOSITION_DQ_TEXTURE_3D,
+                           std::string{dualQuaternionDef} + CC3D_skinPositionTexture_vert, CC3D_colorTexture_frag);
+    registerProgramFactory(ProgramType::SKINPOSITION_DQ_NORMAL_TEXTURE_3D,
+                           lightDef + dualQuaternionDef + CC3D_skinPositionNormalTexture_vert,
+                           lightDef + CC3D_colorNormalTexture_frag);
+    registerProgramFactory(ProgramType::SKINPOSITION_DQ_BUMPEDNORMAL_TEXTURE_3D,
+                           lightDef + normalMapDef + dualQuaternionDef + CC3D_skinPositionNormalTexture_vert,
+                           lightDef + normalMapDef + CC3D_colorNormalTexture_frag);
+    const char* instancingDef = "\n#define USE_INSTANCING 1 \n";
+    registerProgramFactory(ProgramType::POSITION_TEXTURE_3D_INSTANCED,
+                           std::string{instancingDef} + CC3D_positionTexture_vert,
+                           std::string{instancingDef} + CC3D_colorTexture_frag);
+    registerProgramFactory(ProgramType::POSITION_NORMAL_TEXTURE_3D_INSTANCED,
+                           lightDef + instancingDef + CC3D_positionNormalTexture_vert,
+                           lightDef + instancingDef + CC3D_colorNormalTexture_frag);
+    registerProgramFactory(ProgramType::POSITION_BUMPEDNORMAL_TEXTURE_3D_INSTANCED,
+                           lightDef + normalMapDef + instancingDef + CC3D_positionNormalTexture_vert,
+                           lightDef + normalMapDef + instancingDef + CC3D_colorNormalTexture_frag);
     registerProgramFactory(ProgramType::HSV, positionTextureColor_vert, hsv_frag);
     registerProgramFactory(ProgramType::HSV_DUAL_SAMPLER, positionTextureColor_vert, dualSampler_hsv_frag);
 
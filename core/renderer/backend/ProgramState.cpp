@@ -32,6 +32,7 @@
 #include "base/CCEventType.h"
 #include "base/CCDirector.h"
 #include <algorithm>
+#include <atomic>
 
 #include "xxhash.h"
 
@@ -93,6 +94,8 @@ void convertMat3ToMat4x3(const float* src, float* dst)
 
 // static field
 std::vector<ProgramState::AutoBindingResolver*> ProgramState::_customAutoBindingResolvers;
+hlookup::string_map<ProgramState::SharedUniformBlock> ProgramState::_sharedUniformBlocks;
+std::function<void(uint64_t)> ProgramState::_destroyedCallback;
 
 TextureInfo::TextureInfo(std::vector<int>&& _slots, std::vector<backend::TextureBackend*>&& _textures)
     : TextureInfo(std::move(_slots), std::vector<int>(_slots.size(), 0), std::move(_textures))
@@ -189,6 +192,9 @@ ProgramState::ProgramState(Program* program)
 
 bool ProgramState::init(Program* program)
 {
+    static std::atomic<uint64_t> s_nextInstanceID{1};
+    _instanceID = s_nextInstanceID.fetch_add(1, std::memory_order_relaxed);
+
     CC_SAFE_RETAIN(program);
     _program                 = program;
     _vertexUniformBufferSize = _program->getUniformBufferSize(ShaderStage::VERTEX);
@@ -232,6 +238,9 @@ void ProgramState::resetUniforms()
 
 ProgramState::~ProgramState()
 {
+    if (_destroyedCallback)
+        _destroyedCallback(_instanceID);
+
 #ifdef CC_USE_METAL
     XXH32_freeState(_uniformHashState);
 #endif
@@ -423,6 +432,38 @@ void ProgramState::updateUniformID(int uniformID)
     }
 }
 
+void ProgramState::setSharedUniformBlock(std::string_view blockName, const void* data, std::size_t size)
+{
+    auto iter = _sharedUniformBlocks.find(blockName);
+    if (iter == _sharedUniformBlocks.end())
+    {
+        if (_sharedUniformBlocks.size() >= MAX_SHARED_UNIFORM_BLOCKS)
+        {
+            CCLOG("cocos2d: %s: too many shared uniform blocks, ignoring %s", __FUNCTION__, blockName.data());
+            return;
+        }
+
+        SharedUniformBlock block;
+        block.binding = static_cast<int>(_sharedUniformBlocks.size());
+        iter          = _sharedUniformBlocks.emplace(std::string{blockName}, std::move(block)).first;
+    }
+
+    auto& block = iter.value();
+    block.data.assign(static_cast<const char*>(data), static_cast<const char*>(data) + size);
+    ++block.version;
+}
+
+const ProgramState::SharedUniformBlock* ProgramState::getSharedUniformBlock(std::string_view blockName)
+{
+    auto iter = _sharedUniformBlocks.find(blockName);
+    return iter != _sharedUniformBlocks.end() ? &iter->second : nullptr;
+}
+
+void ProgramState::setDestroyedCallback(std::function<void(uint64_t)> callback)
+{
+    _destroyedCallback = std::move(callback);
+}
+
 void ProgramState::setTexture(backend::TextureBackend* texture)
 {
     for (int slot = 0; slot < texture->getCount() && slot < CC_META_TEXTURES; ++slot)
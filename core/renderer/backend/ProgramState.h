@@ -229,6 +229,46 @@ public:
      */
     void getFragmentUniformBuffer(char** buffer, std::size_t& size) const;
 
+    /** The data of a uniform block shared by all the programs, see setSharedUniformBlock(). */
+    struct SharedUniformBlock
+    {
+        std::vector<char> data;
+        /** Incremented by every setSharedUniformBlock() call, tells the backend to upload the data again. */
+        uint32_t version = 0;
+        /** The uniform buffer binding point reserved for the block. */
+        int binding = 0;
+    };
+
+    /** Maximum number of shared uniform blocks, they use the binding points below it. */
+    static constexpr int MAX_SHARED_UNIFORM_BLOCKS = 8;
+
+    /**
+     * Set the data of a uniform block shared by all the programs, i.e. per frame parameters like the view and
+     * projection matrices, the time or the lights. Scene::render() sets the CameraBlock and the LightBlock, see
+     * CCScene.cpp for their layout. The data is uploaded once, when the first program declaring the block is drawn,
+     * and stays bound for the other ones. The uniforms of the other blocks are set per ProgramState with setUniform()
+     * like any uniform. Only used by the OpenGL backend, the GL context must support GL 3.1 or
+     * GL_ARB_uniform_buffer_object.
+     * @param blockName Specifies the name of the uniform block in the shaders.
+     * @param data Specifies the block data, laid out following the std140 rules.
+     * @param size Specifies the size of the data in bytes.
+     */
+    static void setSharedUniformBlock(std::string_view blockName, const void* data, std::size_t size);
+
+    /**
+     * Get a shared uniform block.
+     * @param blockName Specifies the name of the uniform block in the shaders.
+     * @return The block, or nullptr if it was never set.
+     */
+    static const SharedUniformBlock* getSharedUniformBlock(std::string_view blockName);
+
+    /**
+     * Set a function called with the getInstanceID() of every destroyed ProgramState, lets the backend release what
+     * it kept for the ProgramState.
+     * @param callback Specifies the function, nullptr to remove it.
+     */
+    static void setDestroyedCallback(std::function<void(uint64_t)> callback);
+
     /**
      * An abstract base class that can be extended to support custom material auto bindings.
      *
@@ -294,6 +334,12 @@ public:
 
     inline std::shared_ptr<VertexLayout> getVertexLayout() const { return _vertexLayout; }
 
+    /**
+     * Gets an identifier unique to this ProgramState for the lifetime of the process. Unlike the address, it isn't
+     * reused when the ProgramState is deleted, so the backends can key per ProgramState caches with it.
+     */
+    uint64_t getInstanceID() const { return _instanceID; }
+
     /**
      * Gets uniformID, it's part of materialID for batch draw
      */
@@ -392,9 +438,12 @@ protected:
     std::unordered_map<std::string, std::string> _autoBindings;
 
     static std::vector<AutoBindingResolver*> _customAutoBindingResolvers;
+    static hlookup::string_map<SharedUniformBlock> _sharedUniformBlocks;
+    static std::function<void(uint64_t)> _destroyedCallback;
     std::shared_ptr<VertexLayout> _vertexLayout = std::make_shared<VertexLayout>();
 
-    uint32_t _uniformID = 0;
+    uint32_t _uniformID  = 0;
+    uint64_t _instanceID = 0;
 #ifdef CC_USE_METAL
     struct XXH32_state_s* _uniformHashState = nullptr;
 #endif
@@ -37,7 +37,8 @@ CC_BACKEND_BEGIN
 enum class BufferUsage : uint32_t
 {
     STATIC,
-    DYNAMIC
+    DYNAMIC,
+    STREAM  ///< rewritten every frame through Buffer::map()
 };
 
 enum class BufferType : uint32_t
@@ -351,6 +352,12 @@ struct UniformInfo
     // only used in metal
     bool isMatrix    = false;
     bool needConvert = false;
+
+    // only used in opengl, std140 layout of the uniforms declared in a uniform block
+    int blockIndex            = -1;
+    unsigned int blockOffset  = 0;
+    unsigned int arrayStride  = 0;
+    unsigned int matrixStride = 0;
 };
 
 struct UniformLocation
@@ -435,6 +442,14 @@ struct ProgramType
         HSV_DUAL_SAMPLER,
         HSV_ETC1 = HSV_DUAL_SAMPLER,
 
+        SKINPOSITION_DQ_TEXTURE_3D,               // CC3D_skinPositionTexture_vert,        CC3D_colorTexture_frag
+        SKINPOSITION_DQ_NORMAL_TEXTURE_3D,        // CC3D_skinPositionNormalTexture_vert,  CC3D_colorNormalTexture_frag
+        SKINPOSITION_DQ_BUMPEDNORMAL_TEXTURE_3D,  // CC3D_skinPositionNormalTexture_vert,  CC3D_colorNormalTexture_frag
+
+        POSITION_TEXTURE_3D_INSTANCED,               // CC3D_positionTexture_vert,        CC3D_colorTexture_frag
+        POSITION_NORMAL_TEXTURE_3D_INSTANCED,        // CC3D_positionNormalTexture_vert,  CC3D_colorNormalTexture_frag
+        POSITION_BUMPEDNORMAL_TEXTURE_3D_INSTANCED,  // CC3D_positionNormalTexture_vert,  CC3D_colorNormalTexture_frag
+
         BUILTIN_COUNT,
 
         CUSTOM_PROGRAM = 0x1000,  // user-define program, used by engine
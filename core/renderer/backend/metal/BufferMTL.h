@@ -51,7 +51,7 @@ public:
      * @param type Specifies the target buffer object. The symbolic constant must be BufferType::VERTEX or
      * BufferType::INDEX.
      * @param usage Specifies the expected usage pattern of the data store. The symbolic constant must be
-     * BufferUsage::STATIC, BufferUsage::DYNAMIC.
+     * BufferUsage::STATIC, BufferUsage::DYNAMIC or BufferUsage::STREAM.
      */
     BufferMTL(id<MTLDevice> mtlDevice, std::size_t size, BufferType type, BufferUsage usage);
     ~BufferMTL();
@@ -80,6 +80,12 @@ public:
      */
     virtual void usingDefaultStoredData(bool needDefaultStoredData) override{};
 
+    /**
+     * Map a region of the buffer of current frame, the memory is shared with the GPU so no unmapping is needed.
+     * @see `Buffer::map(std::size_t offset, std::size_t size, bool discard)`
+     */
+    virtual void* map(std::size_t offset, std::size_t size, bool discard) override;
+
     /// @name Setters & Getters
     id<MTLBuffer> getMTLBuffer() const;
 
@@ -449,6 +449,10 @@ bool DeviceInfoMTL::checkForFeatureSupported(FeatureType feature)
     case FeatureType::ASTC:
         featureSupported = supportASTC(_featureSet);
         break;
+    case FeatureType::BUFFER_STORAGE:
+        // buffers are created with MTLResourceStorageModeShared, their contents are always accessible
+        featureSupported = true;
+        break;
     default:
         break;
     }
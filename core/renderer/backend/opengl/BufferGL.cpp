@@ -28,6 +28,8 @@
 #include "base/CCEventType.h"
 #include "base/CCEventDispatcher.h"
 #include "renderer/backend/opengl/MacrosGL.h"
+#include "renderer/backend/opengl/StateCacheGL.h"
+#include "renderer/backend/Device.h"
 
 CC_BACKEND_BEGIN
 
@@ -41,6 +43,8 @@ GLenum toGLUsage(const BufferUsage& usage)
         return GL_STATIC_DRAW;
     case BufferUsage::DYNAMIC:
         return GL_DYNAMIC_DRAW;
+    case BufferUsage::STREAM:
+        return GL_STREAM_DRAW;
     default:
         return GL_DYNAMIC_DRAW;
     }
@@ -56,12 +60,25 @@ BufferGL::BufferGL(std::size_t size, BufferType type, BufferUsage usage) : Buffe
         EventListenerCustom::create(EVENT_RENDERER_RECREATED, [this](EventCustom*) { this->reloadBuffer(); });
     Director::getInstance()->getEventDispatcher()->addEventListenerWithFixedPriority(_backToForegroundListener, -1);
 #endif
+
+#if CC_GL_BUFFER_STORAGE
+    if (BufferUsage::STREAM == _usage)
+        initPersistentStorage();
+#endif
 }
 
 BufferGL::~BufferGL()
 {
+#if CC_GL_BUFFER_STORAGE
+    for (auto& fence : _fences)
+    {
+        if (fence)
+            glDeleteSync(fence);
+    }
+#endif
+
     if (_buffer)
-        glDeleteBuffers(1, &_buffer);
+        StateCacheGL::deleteBuffer(_buffer);
 
 #if CC_ENABLE_CACHE_TEXTURE_DATA
     CC_SAFE_DELETE_ARRAY(_data);
@@ -102,20 +119,122 @@ void BufferGL::fillBuffer(void* data, std::size_t offset, std::size_t size)
 }
 #endif
 
+GLenum BufferGL::getTarget() const
+{
+    return BufferType::VERTEX == _type ? GL_ARRAY_BUFFER : GL_ELEMENT_ARRAY_BUFFER;
+}
+
+#if CC_GL_BUFFER_STORAGE
+bool BufferGL::initPersistentStorage()
+{
+    static bool bufferStorageSupported =
+        Device::getInstance()->getDeviceInfo()->checkForFeatureSupported(FeatureType::BUFFER_STORAGE);
+    if (!bufferStorageSupported || !_buffer)
+        return false;
+
+    // the storage is immutable, and stays mapped until the buffer is deleted
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    StateCacheGL::bindBuffer(getTarget(), _buffer);
+    glBufferStorage(getTarget(), _size * MAX_STREAM_REGIONS, nullptr, flags);
+    _persistentData = (char*)glMapBufferRange(getTarget(), 0, _size * MAX_STREAM_REGIONS, flags);
+    CHECK_GL_ERROR_DEBUG();
+    if (!_persistentData)
+    {
+        // the storage can't be reallocated, start again with a new buffer
+        StateCacheGL::deleteBuffer(_buffer);
+        glGenBuffers(1, &_buffer);
+        return false;
+    }
+
+    _bufferAllocated = _size;
+    return true;
+}
+#endif
+
+void* BufferGL::map(std::size_t offset, std::size_t size, bool discard)
+{
+    CCASSERT(offset + size <= _size, "buffer size overflow");
+    CCASSERT(!_mapped, "the buffer is already mapped");
+
+    if (!_buffer)
+        return nullptr;
+
+#if CC_GL_BUFFER_STORAGE
+    if (_persistentData)
+    {
+        if (discard)
+        {
+            // fence the draws from the current region, and move on to the oldest one
+            _fences[_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            _region          = (_region + 1) % MAX_STREAM_REGIONS;
+            if (_fences[_region])
+            {
+                while (glClientWaitSync(_fences[_region], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED)
+                    ;
+                glDeleteSync(_fences[_region]);
+                _fences[_region] = nullptr;
+            }
+        }
+        _mapped = true;
+        return _persistentData + _region * _size + offset;
+    }
+#endif
+
+#if CC_GL_MAP_BUFFER_RANGE
+    StateCacheGL::bindBuffer(getTarget(), _buffer);
+    if (discard || !_bufferAllocated)
+    {
+        // orphan the storage, the driver keeps the old one alive while the GPU reads it
+        glBufferData(getTarget(), _size, nullptr, toGLUsage(_usage));
+        _bufferAllocated = _size;
+    }
+    auto data = glMapBufferRange(getTarget(), offset, size,
+                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    CHECK_GL_ERROR_DEBUG();
+    _mapped = data != nullptr;
+    return data;
+#else
+    return nullptr;
+#endif
+}
+
+void BufferGL::unmap()
+{
+    if (!_mapped)
+        return;
+
+    _mapped = false;
+    if (_persistentData)
+        return;
+
+#if CC_GL_MAP_BUFFER_RANGE
+    StateCacheGL::bindBuffer(getTarget(), _buffer);
+    glUnmapBuffer(getTarget());
+    CHECK_GL_ERROR_DEBUG();
+#endif
+}
+
 void BufferGL::updateData(void* data, std::size_t size)
 {
     assert(size && size <= _size);
 
+    if (_persistentData)
+    {
+        memcpy(map(0, size, true), data, size);
+        unmap();
+        return;
+    }
+
     if (_buffer)
     {
         if (BufferType::VERTEX == _type)
         {
-            glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+            StateCacheGL::bindBuffer(GL_ARRAY_BUFFER, _buffer);
             glBufferData(GL_ARRAY_BUFFER, size, data, toGLUsage(_usage));
         }
         else
         {
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffer);
+            StateCacheGL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffer);
             glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, toGLUsage(_usage));
         }
         CHECK_GL_ERROR_DEBUG();
@@ -133,17 +252,24 @@ void BufferGL::updateSubData(void* data, std::size_t offset, std::size_t size)
     CCASSERT(_bufferAllocated != 0, "updateData should be invoke before updateSubData");
     CCASSERT(offset + size <= _bufferAllocated, "buffer size overflow");
 
+    if (_persistentData)
+    {
+        memcpy(map(offset, size, false), data, size);
+        unmap();
+        return;
+    }
+
     if (_buffer)
     {
         CHECK_GL_ERROR_DEBUG();
         if (BufferType::VERTEX == _type)
         {
-            glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+            StateCacheGL::bindBuffer(GL_ARRAY_BUFFER, _buffer);
             glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
         }
         else
         {
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffer);
+            StateCacheGL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffer);
             glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, size, data);
         }
 
@@ -26,6 +26,7 @@
 
 #include "../Buffer.h"
 #include "platform/CCGL.h"
+#include "renderer/backend/opengl/MacrosGL.h"
 #include "base/CCEventListenerCustom.h"
 
 #include <vector>
@@ -47,7 +48,7 @@ public:
      * @param type Specifies the target buffer object. The symbolic constant must be BufferType::VERTEX or
      * BufferType::INDEX.
      * @param usage Specifies the expected usage pattern of the data store. The symbolic constant must be
-     * BufferUsage::STATIC, BufferUsage::DYNAMIC.
+     * BufferUsage::STATIC, BufferUsage::DYNAMIC or BufferUsage::STREAM.
      */
     BufferGL(std::size_t size, BufferType type, BufferUsage usage);
     ~BufferGL();
@@ -78,13 +79,41 @@ public:
      */
     virtual void usingDefaultStoredData(bool needDefaultStoredData) override;
 
+    /**
+     * Map a region of the buffer to write it directly.
+     * A BufferUsage::STREAM buffer is mapped persistently when the driver supports buffer storage, and cycles through
+     * MAX_STREAM_REGIONS regions guarded by fences on discard. Otherwise discarding orphans the buffer, and nullptr is
+     * returned where glMapBufferRange isn't available.
+     * @see `Buffer::map(std::size_t offset, std::size_t size, bool discard)`
+     */
+    virtual void* map(std::size_t offset, std::size_t size, bool discard) override;
+
+    /**
+     * Finish writing the region mapped by `map()`.
+     */
+    virtual void unmap() override;
+
     /**
      * Get buffer object.
      * @return Buffer object.
      */
     inline GLuint getHandler() const { return _buffer; }
 
+    /**
+     * Get the offset in bytes of the region in use, which has to be added to the offsets of draws.
+     * It is only non zero for persistently mapped buffers.
+     */
+    inline std::size_t getBindOffset() const { return _region * _size; }
+
+    /// Number of regions of a persistently mapped buffer, the GPU can read at most MAX_STREAM_REGIONS - 1 of them.
+    static constexpr int MAX_STREAM_REGIONS = 3;
+
 private:
+    GLenum getTarget() const;
+#if CC_GL_BUFFER_STORAGE
+    bool initPersistentStorage();
+#endif
+
 #if CC_ENABLE_CACHE_TEXTURE_DATA
     void reloadBuffer();
     void fillBuffer(void* data, std::size_t offset, std::size_t size);
@@ -97,6 +126,14 @@ private:
     std::size_t _bufferAllocated = 0;
     char* _data                  = nullptr;
     bool _needDefaultStoredData  = true;
+
+    // mapping
+    bool _mapped          = false;
+    int _region           = 0;
+    char* _persistentData = nullptr;
+#if CC_GL_BUFFER_STORAGE
+    GLsync _fences[MAX_STREAM_REGIONS] = {};
+#endif
 };
 // end of _opengl group
 ///> @}
@@ -34,6 +34,7 @@
 #include "base/CCDirector.h"
 #include "renderer/backend/opengl/MacrosGL.h"
 #include "renderer/backend/opengl/UtilsGL.h"
+#include "renderer/backend/opengl/StateCacheGL.h"
 #include "RenderTargetGL.h"
 #include <algorithm>
 
@@ -41,6 +42,40 @@ CC_BACKEND_BEGIN
 
 namespace
 {
+#if CC_GL_UNIFORM_BUFFER
+const GLsizeiptr UNIFORM_RING_SIZE = 1024 * 1024;
+
+// copies a uniform from the tightly packed ProgramState buffer to its std140 place in the block
+void packBlockMember(const UniformInfo& member, const char* src, char* dst)
+{
+    unsigned int columns = 1;
+    switch (member.type)
+    {
+    case GL_FLOAT_MAT2:
+        columns = 2;
+        break;
+    case GL_FLOAT_MAT3:
+        columns = 3;
+        break;
+    case GL_FLOAT_MAT4:
+        columns = 4;
+        break;
+    default:
+        break;
+    }
+
+    const auto columnSize   = member.size / columns;
+    const auto matrixStride = member.matrixStride ? member.matrixStride : columnSize;
+    for (int element = 0; element < member.count; ++element)
+    {
+        auto elementDst = dst + member.blockOffset + element * member.arrayStride;
+        auto elementSrc = src + element * member.size;
+        for (unsigned int column = 0; column < columns; ++column)
+            memcpy(elementDst + column * matrixStride, elementSrc + column * columnSize, columnSize);
+    }
+}
+#endif
+
 void applyTexture(TextureBackend* texture, int slot, int index)
 {
     switch (texture->getTextureType())
@@ -58,11 +93,29 @@ void applyTexture(TextureBackend* texture, int slot, int index)
 }
 }  // namespace
 
-CommandBufferGL::CommandBufferGL() {}
+CommandBufferGL::CommandBufferGL()
+{
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    // runs before the resources recreate themselves, the new context starts with the default state
+    _backToForegroundListener =
+        EventListenerCustom::create(EVENT_RENDERER_RECREATED, [](EventCustom*) { StateCacheGL::invalidate(); });
+    Director::getInstance()->getEventDispatcher()->addEventListenerWithFixedPriority(_backToForegroundListener, -2);
+#endif
+#if CC_GL_UNIFORM_BUFFER
+    ProgramState::setDestroyedCallback([this](uint64_t instanceID) { _materialBlockRanges.erase(instanceID); });
+#endif
+}
 
 CommandBufferGL::~CommandBufferGL()
 {
+#if CC_GL_UNIFORM_BUFFER
+    ProgramState::setDestroyedCallback(nullptr);
+#endif
+    CC_SAFE_RELEASE_NULL(_instanceBuffer);
     cleanResources();
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    Director::getInstance()->getEventDispatcher()->removeEventListener(_backToForegroundListener);
+#endif
 }
 
 bool CommandBufferGL::beginFrame()
@@ -102,9 +155,9 @@ void CommandBufferGL::beginRenderPass(const RenderTarget* rt, const RenderPassDe
 
         mask |= GL_DEPTH_BUFFER_BIT;
         glClearDepth(descirptor.clearDepthValue);
-        glEnable(GL_DEPTH_TEST);
-        glDepthMask(GL_TRUE);
-        glDepthFunc(GL_ALWAYS);
+        StateCacheGL::enable(GL_DEPTH_TEST);
+        StateCacheGL::depthMask(GL_TRUE);
+        StateCacheGL::depthFunc(GL_ALWAYS);
     }
 
     CHECK_GL_ERROR_DEBUG();
@@ -124,10 +177,10 @@ void CommandBufferGL::beginRenderPass(const RenderTarget* rt, const RenderPassDe
     if (bitmask::any(clearFlags, TargetBufferFlags::DEPTH))
     {
         if (!oldDepthTest)
-            glDisable(GL_DEPTH_TEST);
+            StateCacheGL::disable(GL_DEPTH_TEST);
 
-        glDepthMask(oldDepthWrite);
-        glDepthFunc(oldDepthFunc);
+        StateCacheGL::depthMask(oldDepthWrite);
+        StateCacheGL::depthFunc(oldDepthFunc);
         glClearDepth(oldDepthClearValue);
     }
 
@@ -178,7 +231,7 @@ void CommandBufferGL::setCullMode(CullMode mode)
 
 void CommandBufferGL::setWinding(Winding winding)
 {
-    glFrontFace(UtilsGL::toGLFrontFace(winding));
+    StateCacheGL::frontFace(UtilsGL::toGLFrontFace(winding));
 }
 
 void CommandBufferGL::setIndexBuffer(Buffer* buffer)
@@ -223,25 +276,54 @@ void CommandBufferGL::drawElements(PrimitiveType primitiveType,
                                    std::size_t offset)
 {
     prepareDrawing();
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer->getHandler());
+    StateCacheGL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer->getHandler());
     glDrawElements(UtilsGL::toGLPrimitiveType(primitiveType), count, UtilsGL::toGLIndexType(indexType),
-                   (GLvoid*)offset);
+                   (GLvoid*)(offset + _indexBuffer->getBindOffset()));
     CHECK_GL_ERROR_DEBUG();
     cleanResources();
 }
 
+void CommandBufferGL::setInstanceBuffer(Buffer* buffer, const VertexLayout* layout, std::size_t offset)
+{
+    assert(buffer != nullptr && layout != nullptr);
+
+    CC_SAFE_RETAIN(buffer);
+    CC_SAFE_RELEASE(_instanceBuffer);
+    _instanceBuffer = static_cast<BufferGL*>(buffer);
+    _instanceLayout = layout;
+    _instanceOffset = offset;
+}
+
+void CommandBufferGL::drawElementsInstanced(PrimitiveType primitiveType,
+                                            IndexFormat indexType,
+                                            std::size_t count,
+                                            std::size_t offset,
+                                            std::size_t instanceCount)
+{
+#if defined(CC_USE_GL)
+    prepareDrawing();
+    StateCacheGL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer->getHandler());
+    glDrawElementsInstanced(UtilsGL::toGLPrimitiveType(primitiveType), count, UtilsGL::toGLIndexType(indexType),
+                            (GLvoid*)(offset + _indexBuffer->getBindOffset()), instanceCount);
+    CHECK_GL_ERROR_DEBUG();
+#endif
+    unbindInstanceBuffer();
+    cleanResources();
+}
+
 void CommandBufferGL::endRenderPass()
 {
     CC_SAFE_RELEASE_NULL(_indexBuffer);
     CC_SAFE_RELEASE_NULL(_vertexBuffer);
+    unbindInstanceBuffer();
 }
 
 void CommandBufferGL::endFrame() {}
 
-void CommandBufferGL::prepareDrawing() const
+void CommandBufferGL::prepareDrawing()
 {
     const auto& program = _renderPipeline->getProgram();
-    glUseProgram(program->getHandler());
+    StateCacheGL::useProgram(program->getHandler());
 
     bindVertexBuffer(program);
     setUniforms(program);
@@ -255,12 +337,12 @@ void CommandBufferGL::prepareDrawing() const
     // Set cull mode.
     if (CullMode::NONE == _cullMode)
     {
-        glDisable(GL_CULL_FACE);
+        StateCacheGL::disable(GL_CULL_FACE);
     }
     else
     {
-        glEnable(GL_CULL_FACE);
-        glCullFace(UtilsGL::toGLCullMode(_cullMode));
+        StateCacheGL::enable(GL_CULL_FACE);
+        StateCacheGL::cullFace(UtilsGL::toGLCullMode(_cullMode));
     }
 }
 
@@ -272,20 +354,56 @@ void CommandBufferGL::bindVertexBuffer(ProgramGL* program) const
     if (!vertexLayout->isValid())
         return;
 
-    glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer->getHandler());
+    StateCacheGL::bindBuffer(GL_ARRAY_BUFFER, _vertexBuffer->getHandler());
 
+    const auto bindOffset  = _vertexBuffer->getBindOffset();
     const auto& attributes = vertexLayout->getAttributes();
     for (const auto& attributeInfo : attributes)
     {
         const auto& attribute = attributeInfo.second;
-        glEnableVertexAttribArray(attribute.index);
-        glVertexAttribPointer(attribute.index, UtilsGL::getGLAttributeSize(attribute.format),
-                              UtilsGL::toGLAttributeType(attribute.format), attribute.needToBeNormallized,
-                              vertexLayout->getStride(), (GLvoid*)attribute.offset);
+        StateCacheGL::enableVertexAttribArray(attribute.index);
+        StateCacheGL::vertexAttribPointer(attribute.index, UtilsGL::getGLAttributeSize(attribute.format),
+                                          UtilsGL::toGLAttributeType(attribute.format), attribute.needToBeNormallized,
+                                          vertexLayout->getStride(), (GLvoid*)(attribute.offset + bindOffset));
     }
+
+#if defined(CC_USE_GL)
+    if (!_instanceBuffer)
+        return;
+
+    // per instance attributes advance once per instance instead of once per vertex
+    StateCacheGL::bindBuffer(GL_ARRAY_BUFFER, _instanceBuffer->getHandler());
+    const auto instanceOffset = _instanceOffset + _instanceBuffer->getBindOffset();
+    for (const auto& attributeInfo : _instanceLayout->getAttributes())
+    {
+        const auto& attribute = attributeInfo.second;
+        StateCacheGL::enableVertexAttribArray(attribute.index);
+        StateCacheGL::vertexAttribPointer(attribute.index, UtilsGL::getGLAttributeSize(attribute.format),
+                                          UtilsGL::toGLAttributeType(attribute.format), attribute.needToBeNormallized,
+                                          _instanceLayout->getStride(), (GLvoid*)(attribute.offset + instanceOffset));
+        glVertexAttribDivisor(attribute.index, 1);
+    }
+#endif
 }
 
-void CommandBufferGL::setUniforms(ProgramGL* program) const
+void CommandBufferGL::unbindInstanceBuffer()
+{
+    if (!_instanceBuffer)
+        return;
+
+#if defined(CC_USE_GL)
+    // the attribute locations may be used per vertex by the next program
+    for (const auto& attributeInfo : _instanceLayout->getAttributes())
+    {
+        glVertexAttribDivisor(attributeInfo.second.index, 0);
+        StateCacheGL::disableVertexAttribArray(attributeInfo.second.index);
+    }
+#endif
+    CC_SAFE_RELEASE_NULL(_instanceBuffer);
+    _instanceLayout = nullptr;
+}
+
+void CommandBufferGL::setUniforms(ProgramGL* program)
 {
     if (_programState)
     {
@@ -298,16 +416,29 @@ void CommandBufferGL::setUniforms(ProgramGL* program) const
         char* buffer           = nullptr;
         _programState->getVertexUniformBuffer(&buffer, bufferSize);
 
-        int i = 0;
+        // the program keeps its uniform values across draws, only upload the ones the ProgramState changed
+        auto shadow = program->getUniformShadow();
         for (auto& iter : uniformInfos)
         {
             auto& uniformInfo = iter.second;
-            if (uniformInfo.size <= 0)
+            if (uniformInfo.size <= 0 || uniformInfo.blockIndex >= 0)
                 continue;
 
+            auto data       = buffer + uniformInfo.bufferOffset;
+            auto shadowData = shadow + uniformInfo.bufferOffset;
+            auto dataSize   = static_cast<std::size_t>(uniformInfo.size) * uniformInfo.count;
+#if CC_ENABLE_GL_STATE_CACHE
+            if (memcmp(shadowData, data, dataSize) == 0)
+            {
+                StateCacheGL::countUniform(true);
+                continue;
+            }
+#endif
+            memcpy(shadowData, data, dataSize);
+            StateCacheGL::countUniform(false);
+
             int elementCount = uniformInfo.count;
-            setUniform(uniformInfo.isArray, uniformInfo.location, elementCount, uniformInfo.type,
-                       (void*)(buffer + uniformInfo.bufferOffset));
+            setUniform(uniformInfo.isArray, uniformInfo.location, elementCount, uniformInfo.type, data);
         }
 
         const auto& textureInfo = _programState->getVertexTextureInfos();
@@ -333,15 +464,106 @@ void CommandBufferGL::setUniforms(ProgramGL* program) const
                 ++i;
             }
 
+            auto& slotShadow = program->getSamplerSlotShadow()[location];
+#if CC_ENABLE_GL_STATE_CACHE
+            if (slotShadow == slots)
+            {
+                StateCacheGL::countUniform(true);
+                continue;
+            }
+#endif
+            slotShadow = slots;
+            StateCacheGL::countUniform(false);
+
             auto arrayCount = slots.size();
             if (arrayCount == 1)  // Most of the time， not use sampler2DArray, should be 1
                 glUniform1i(location, slots[0]);
             else
                 glUniform1iv(location, static_cast<GLsizei>(arrayCount), static_cast<const GLint*>(slots.data()));
         }
+
+#if CC_GL_UNIFORM_BUFFER
+        setUniformBlocks(program);
+#endif
     }
 }
 
+#if CC_GL_UNIFORM_BUFFER
+void CommandBufferGL::setUniformBlocks(ProgramGL* program)
+{
+    const auto& blocks = program->getUniformBlocks();
+    if (blocks.empty())
+        return;
+
+    if (!_uniformRing)
+        _uniformRing = std::make_unique<UniformRingBufferGL>(UNIFORM_RING_SIZE);
+
+    // the ranges of an older generation are useless, forget the ProgramStates drawn since
+    if (_materialBlockGeneration != _uniformRing->getGeneration())
+    {
+        _materialBlockRanges.clear();
+        _materialBlockGeneration = _uniformRing->getGeneration();
+    }
+
+    std::size_t bufferSize = 0;
+    char* buffer           = nullptr;
+    _programState->getVertexUniformBuffer(&buffer, bufferSize);
+
+    auto& materialRanges = _materialBlockRanges[_programState->getInstanceID()];
+    materialRanges.resize(blocks.size());
+
+    // an upload orphaning the ring loses the blocks uploaded before it, they are uploaded again by a second pass
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        const auto generation = _uniformRing->getGeneration();
+        for (std::size_t i = 0; i < blocks.size(); ++i)
+        {
+            const auto& block = blocks[i];
+            _blockData.assign(block.size, 0);
+
+            GLint binding            = 0;
+            UniformBlockRange* range = nullptr;
+            bool dirty               = false;
+            if (auto shared = ProgramState::getSharedUniformBlock(block.name))
+            {
+                binding = shared->binding;
+                range   = &_sharedBlockRanges[binding];
+                memcpy(_blockData.data(), shared->data.data(), std::min(shared->data.size(), _blockData.size()));
+                dirty          = range->version != shared->version || range->data.size() < _blockData.size();
+                range->version = shared->version;
+            }
+            else
+            {
+                binding = static_cast<GLint>(ProgramState::MAX_SHARED_UNIFORM_BLOCKS + i);
+                range   = &materialRanges[i];
+                for (const auto& member : block.members)
+                    packBlockMember(member, buffer + member.bufferOffset, _blockData.data());
+                dirty = range->data != _blockData;
+            }
+
+#    if CC_ENABLE_GL_STATE_CACHE
+            dirty = dirty || range->offset < 0 || range->generation != _uniformRing->getGeneration();
+#    else
+            dirty = true;
+#    endif
+            if (dirty)
+            {
+                range->offset     = _uniformRing->upload(_blockData.data(), _blockData.size());
+                range->generation = _uniformRing->getGeneration();
+                range->data       = _blockData;
+            }
+            StateCacheGL::countUniform(!dirty);
+
+            program->setUniformBlockBinding(i, binding);
+            StateCacheGL::bindUniformBufferRange(binding, _uniformRing->getHandler(), range->offset, block.size);
+        }
+
+        if (generation == _uniformRing->getGeneration())
+            break;
+    }
+}
+#endif
+
 #define DEF_TO_INT(pointer, index) (*((GLint*)(pointer) + index))
 #define DEF_TO_FLOAT(pointer, index) (*((GLfloat*)(pointer) + index))
 void CommandBufferGL::setUniform(bool isArray, GLuint location, unsigned int size, GLenum uniformType, void* data) const
@@ -438,12 +660,12 @@ void CommandBufferGL::setScissorRect(bool isEnabled, float x, float y, float wid
 {
     if (isEnabled)
     {
-        glEnable(GL_SCISSOR_TEST);
+        StateCacheGL::enable(GL_SCISSOR_TEST);
         glScissor(x, y, width, height);
     }
     else
     {
-        glDisable(GL_SCISSOR_TEST);
+        StateCacheGL::disable(GL_SCISSOR_TEST);
     }
 }
 
@@ -28,9 +28,13 @@
 #include "../CommandBuffer.h"
 #include "base/CCEventListenerCustom.h"
 #include "platform/CCGL.h"
+#include "renderer/backend/opengl/MacrosGL.h"
 
 #include "CCStdC.h"
+#include "UniformRingBufferGL.h"
 
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 CC_BACKEND_BEGIN
@@ -154,6 +158,28 @@ public:
                               std::size_t count,
                               std::size_t offset) override;
 
+    /**
+     * Set per instance attributes for the next `drawElementsInstanced()`.
+     * @param buffer A buffer object that the device will read per instance attributes from.
+     * @param layout The layout of the per instance attributes, its indexes are attribute locations of the program.
+     * @param offset Byte offset within buffer of the attributes of the first instance.
+     */
+    virtual void setInstanceBuffer(Buffer* buffer, const VertexLayout* layout, std::size_t offset) override;
+
+    /**
+     * Draw several instances of primitives with an index list.
+     * @param primitiveType The type of primitives that elements are assembled into.
+     * @param indexType The type if indexes, either 16 bit integer or 32 bit integer.
+     * @param count The number of indexes to read from the index buffer for each instance.
+     * @param offset Byte offset within indexBuffer to start reading indexes from.
+     * @param instanceCount The number of instances to draw.
+     */
+    virtual void drawElementsInstanced(PrimitiveType primitiveType,
+                                       IndexFormat indexType,
+                                       std::size_t count,
+                                       std::size_t offset,
+                                       std::size_t instanceCount) override;
+
     /**
      * Do some resources release.
      */
@@ -202,15 +228,22 @@ private:
         unsigned int h = 0;
     };
 
-    void prepareDrawing() const;
+    void prepareDrawing();
     void bindVertexBuffer(ProgramGL* program) const;
-    void setUniforms(ProgramGL* program) const;
+    void unbindInstanceBuffer();
+    void setUniforms(ProgramGL* program);
+#if CC_GL_UNIFORM_BUFFER
+    void setUniformBlocks(ProgramGL* program);
+#endif
     void setUniform(bool isArray, GLuint location, unsigned int size, GLenum uniformType, void* data) const;
     void cleanResources();
 
     BufferGL* _vertexBuffer                   = nullptr;
     ProgramState* _programState               = nullptr;
     BufferGL* _indexBuffer                    = nullptr;
+    BufferGL* _instanceBuffer                 = nullptr;
+    const VertexLayout* _instanceLayout       = nullptr;
+    std::size_t _instanceOffset               = 0;
     RenderPipelineGL* _renderPipeline         = nullptr;
     CullMode _cullMode                        = CullMode::NONE;
     DepthStencilStateGL* _depthStencilStateGL = nullptr;
@@ -220,6 +253,26 @@ private:
 #if CC_ENABLE_CACHE_TEXTURE_DATA
     EventListenerCustom* _backToForegroundListener = nullptr;
 #endif
+
+#if CC_GL_UNIFORM_BUFFER
+    /// Where the data of a uniform block was last uploaded in the ring buffer.
+    struct UniformBlockRange
+    {
+        uint32_t generation = 0;
+        GLintptr offset     = -1;
+        /// version of a shared block, data of the other ones
+        uint32_t version = 0;
+        std::vector<char> data;
+    };
+
+    std::unique_ptr<UniformRingBufferGL> _uniformRing;
+    UniformBlockRange _sharedBlockRanges[ProgramState::MAX_SHARED_UNIFORM_BLOCKS];
+    /// keyed by ProgramState::getInstanceID(), an address could be reused by a new ProgramState, erased when the
+    /// ProgramState is destroyed
+    std::unordered_map<uint64_t, std::vector<UniformBlockRange>> _materialBlockRanges;
+    uint32_t _materialBlockGeneration = 0;
+    std::vector<char> _blockData;
+#endif
 };
 
 // end of _opengl group
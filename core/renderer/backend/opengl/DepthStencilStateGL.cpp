@@ -27,13 +27,14 @@
 
 #include "renderer/backend/opengl/MacrosGL.h"
 #include "renderer/backend/opengl/UtilsGL.h"
+#include "renderer/backend/opengl/StateCacheGL.h"
 
 CC_BACKEND_BEGIN
 
 void DepthStencilStateGL::reset()
 {
-    glDisable(GL_DEPTH_TEST);
-    glDisable(GL_STENCIL_TEST);
+    StateCacheGL::disable(GL_DEPTH_TEST);
+    StateCacheGL::disable(GL_STENCIL_TEST);
 }
 
 void DepthStencilStateGL::apply(unsigned int stencilReferenceValueFront, unsigned int stencilReferenceValueBack) const
@@ -42,36 +43,38 @@ void DepthStencilStateGL::apply(unsigned int stencilReferenceValueFront, unsigne
     // depth test
     if (bitmask::any(dsFlags, DepthStencilFlags::DEPTH_TEST))
     {
-        glEnable(GL_DEPTH_TEST);
+        StateCacheGL::enable(GL_DEPTH_TEST);
     }
     else
     {
-        glDisable(GL_DEPTH_TEST);
+        StateCacheGL::disable(GL_DEPTH_TEST);
     }
 
     if (bitmask::any(dsFlags, DepthStencilFlags::DEPTH_WRITE))
-        glDepthMask(GL_TRUE);
+        StateCacheGL::depthMask(GL_TRUE);
     else
-        glDepthMask(GL_FALSE);
+        StateCacheGL::depthMask(GL_FALSE);
 
-    glDepthFunc(UtilsGL::toGLComareFunction(_depthStencilInfo.depthCompareFunction));
+    StateCacheGL::depthFunc(UtilsGL::toGLComareFunction(_depthStencilInfo.depthCompareFunction));
 
     // stencil test
     if (bitmask::any(dsFlags, DepthStencilFlags::STENCIL_TEST))
     {
-        glEnable(GL_STENCIL_TEST);
+        StateCacheGL::enable(GL_STENCIL_TEST);
 
         if (_isBackFrontStencilEqual)
         {
-            glStencilFunc(UtilsGL::toGLComareFunction(_depthStencilInfo.frontFaceStencil.stencilCompareFunction),
-                          stencilReferenceValueFront, _depthStencilInfo.frontFaceStencil.readMask);
-            glStencilOp(UtilsGL::toGLStencilOperation(_depthStencilInfo.frontFaceStencil.stencilFailureOperation),
-                        UtilsGL::toGLStencilOperation(_depthStencilInfo.frontFaceStencil.depthFailureOperation),
-                        UtilsGL::toGLStencilOperation(_depthStencilInfo.frontFaceStencil.depthStencilPassOperation));
-            glStencilMask(_depthStencilInfo.frontFaceStencil.writeMask);
+            const auto& stencil = _depthStencilInfo.frontFaceStencil;
+            StateCacheGL::stencilFunc(UtilsGL::toGLComareFunction(stencil.stencilCompareFunction),
+                                      stencilReferenceValueFront, stencil.readMask);
+            StateCacheGL::stencilOp(UtilsGL::toGLStencilOperation(stencil.stencilFailureOperation),
+                                    UtilsGL::toGLStencilOperation(stencil.depthFailureOperation),
+                                    UtilsGL::toGLStencilOperation(stencil.depthStencilPassOperation));
+            StateCacheGL::stencilMask(stencil.writeMask);
         }
         else
         {
+            StateCacheGL::invalidateStencil();
             glStencilFuncSeparate(GL_BACK,
                                   UtilsGL::toGLComareFunction(_depthStencilInfo.backFaceStencil.stencilCompareFunction),
                                   stencilReferenceValueBack, _depthStencilInfo.backFaceStencil.readMask);
@@ -93,7 +96,7 @@ void DepthStencilStateGL::apply(unsigned int stencilReferenceValueFront, unsigne
         }
     }
     else
-        glDisable(GL_STENCIL_TEST);
+        StateCacheGL::disable(GL_STENCIL_TEST);
 
     CHECK_GL_ERROR_DEBUG();
 }
@@ -25,6 +25,8 @@
 
 #include "DeviceInfoGL.h"
 #include "platform/CCGL.h"
+#include "StateCacheGL.h"
+#include "MacrosGL.h"
 
 #if !defined(GL_COMPRESSED_RGBA8_ETC2_EAC)
 #    define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
@@ -51,7 +53,7 @@ static bool checkReallySupportsASTC()
 
     GLuint texID = 0;
     glGenTextures(1, &texID);
-    glBindTexture(GL_TEXTURE_2D, texID);
+    StateCacheGL::bindTexture(GL_TEXTURE_2D, texID);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -82,8 +84,8 @@ static bool checkReallySupportsASTC()
     }
 #endif
 
-    glBindTexture(GL_TEXTURE_2D, 0);  // unbind texture
-    glDeleteTextures(1, &texID);
+    StateCacheGL::bindTexture(GL_TEXTURE_2D, 0);  // unbind texture
+    StateCacheGL::deleteTexture(texID);
 
     return !error;
 }
@@ -163,6 +165,23 @@ bool DeviceInfoGL::checkForFeatureSupported(FeatureType feature)
     case FeatureType::ASTC:
         featureSupported = checkReallySupportsASTC();
         break;
+    case FeatureType::BUFFER_STORAGE:
+#if CC_GL_BUFFER_STORAGE
+        featureSupported = checkForGLVersion(4, 4) || checkForGLExtension("GL_ARB_buffer_storage");
+#endif
+        break;
+    case FeatureType::INSTANCING:
+#if defined(CC_USE_GL)
+        // glDrawElementsInstanced is core in GL 3.1, glVertexAttribDivisor in GL 3.3
+        featureSupported = (checkForGLVersion(3, 1) || checkForGLExtension("GL_ARB_draw_instanced")) &&
+                           (checkForGLVersion(3, 3) || checkForGLExtension("GL_ARB_instanced_arrays"));
+#endif
+        break;
+    case FeatureType::UNIFORM_BUFFER:
+#if CC_GL_UNIFORM_BUFFER
+        featureSupported = checkForGLVersion(3, 1) || checkForGLExtension("GL_ARB_uniform_buffer_object");
+#endif
+        break;
     default:
         break;
     }
@@ -174,6 +193,21 @@ bool DeviceInfoGL::checkForGLExtension(std::string_view searchName) const
     return _glExtensions.find(searchName) != std::string::npos;
 }
 
+bool DeviceInfoGL::checkForGLVersion(int major, int minor) const
+{
+    // "4.6.0 NVIDIA 535.54" on desktop, "OpenGL ES 3.2 ..." on GLES
+    auto version = getVersion();
+    if (!version)
+        return false;
+    while (*version && !isdigit((unsigned char)*version))
+        ++version;
+
+    int versionMajor = 0, versionMinor = 0;
+    if (sscanf(version, "%d.%d", &versionMajor, &versionMinor) != 2)
+        return false;
+    return versionMajor > major || (versionMajor == major && versionMinor >= minor);
+}
+
 bool DeviceInfoGL::checkSupportsCompressedFormat(int compressedFormat)
 {
     const int MAX_ALLOCA_SIZE = 512;
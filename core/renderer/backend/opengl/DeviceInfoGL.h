@@ -80,6 +80,8 @@ public:
 
 private:
     bool checkForGLExtension(std::string_view searchName) const;
+    /// Whether the context version is at least major.minor.
+    bool checkForGLVersion(int major, int minor) const;
 
     static bool checkSupportsCompressedFormat(int compressedFormat);
 
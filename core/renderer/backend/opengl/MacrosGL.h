@@ -25,6 +25,7 @@
 #pragma once
 
 #include "base/ccMacros.h"
+#include "platform/CCGL.h"
 
 #if !defined(COCOS2D_DEBUG) || COCOS2D_DEBUG == 0
 #    define CHECK_GL_ERROR_DEBUG()
@@ -69,3 +70,28 @@
             CC_ASSERT(__gl_error_code == GL_NO_ERROR, "Error"); \
         } while (0)
 #endif
+
+/**
+ * Whether the GL headers declare the entry points of the optional buffer paths. The macOS legacy headers stop at
+ * GL 2.1 and GLES 2 has no glMapBufferRange, the features still have to be checked at runtime with
+ * DeviceInfo::checkForFeatureSupported.
+ */
+#if defined(CC_USE_GL) && CC_TARGET_PLATFORM != CC_PLATFORM_MAC && \
+    (defined(GL_VERSION_4_4) || defined(GL_ARB_buffer_storage))
+#    define CC_GL_BUFFER_STORAGE 1
+#else
+#    define CC_GL_BUFFER_STORAGE 0
+#endif
+
+#if defined(CC_USE_GL) && CC_TARGET_PLATFORM != CC_PLATFORM_MAC && \
+    (defined(GL_VERSION_3_1) || defined(GL_ARB_uniform_buffer_object))
+#    define CC_GL_UNIFORM_BUFFER 1
+#else
+#    define CC_GL_UNIFORM_BUFFER 0
+#endif
+
+#if defined(GL_VERSION_3_0) || defined(GL_ES_VERSION_3_0) || defined(GL_ARB_map_buffer_range)
+#    define CC_GL_MAP_BUFFER_RANGE 1
+#else
+#    define CC_GL_MAP_BUFFER_RANGE 0
+#endif
@@ -31,6 +31,8 @@
 #include "base/CCEventDispatcher.h"
 #include "base/CCEventType.h"
 #include "renderer/backend/opengl/UtilsGL.h"
+#include "renderer/backend/opengl/StateCacheGL.h"
+#include "renderer/backend/Device.h"
 
 CC_BACKEND_BEGIN
 
@@ -78,7 +80,7 @@ ProgramGL::~ProgramGL()
     CC_SAFE_RELEASE(_vertexShaderModule);
     CC_SAFE_RELEASE(_fragmentShaderModule);
     if (_program)
-        glDeleteProgram(_program);
+        StateCacheGL::deleteProgram(_program);
 
 #if CC_ENABLE_CACHE_TEXTURE_DATA
     Director::getInstance()->getEventDispatcher()->removeEventListener(_backToForegroundListener);
@@ -165,25 +167,25 @@ void ProgramGL::computeLocations()
     _builtinAttributeLocation[Attribute::TEXCOORD] = location;
 
     /// u_MVPMatrix
-    location                                                 = glGetUniformLocation(_program, UNIFORM_NAME_MVP_MATRIX);
+    location                                                 = _activeUniformInfos[UNIFORM_NAME_MVP_MATRIX].location;
     _builtinUniformLocation[Uniform::MVP_MATRIX].location[0] = location;
     _builtinUniformLocation[Uniform::MVP_MATRIX].location[1] =
         _activeUniformInfos[UNIFORM_NAME_MVP_MATRIX].bufferOffset;
 
     /// u_textColor
-    location                                                 = glGetUniformLocation(_program, UNIFORM_NAME_TEXT_COLOR);
+    location                                                 = _activeUniformInfos[UNIFORM_NAME_TEXT_COLOR].location;
     _builtinUniformLocation[Uniform::TEXT_COLOR].location[0] = location;
     _builtinUniformLocation[Uniform::TEXT_COLOR].location[1] =
         _activeUniformInfos[UNIFORM_NAME_TEXT_COLOR].bufferOffset;
 
     /// u_effectColor
-    location = glGetUniformLocation(_program, UNIFORM_NAME_EFFECT_COLOR);
+    location = _activeUniformInfos[UNIFORM_NAME_EFFECT_COLOR].location;
     _builtinUniformLocation[Uniform::EFFECT_COLOR].location[0] = location;
     _builtinUniformLocation[Uniform::EFFECT_COLOR].location[1] =
         _activeUniformInfos[UNIFORM_NAME_EFFECT_COLOR].bufferOffset;
 
     /// u_effectType
-    location = glGetUniformLocation(_program, UNIFORM_NAME_EFFECT_TYPE);
+    location = _activeUniformInfos[UNIFORM_NAME_EFFECT_TYPE].location;
     _builtinUniformLocation[Uniform::EFFECT_TYPE].location[0] = location;
     _builtinUniformLocation[Uniform::EFFECT_TYPE].location[1] =
         _activeUniformInfos[UNIFORM_NAME_EFFECT_TYPE].bufferOffset;
@@ -258,6 +260,14 @@ void ProgramGL::computeUniformInfos()
     if (!numOfUniforms)
         return;
 
+    GLint numOfBlocks = 0;
+#if CC_GL_UNIFORM_BUFFER
+    static bool uniformBufferSupported =
+        Device::getInstance()->getDeviceInfo()->checkForFeatureSupported(FeatureType::UNIFORM_BUFFER);
+    if (uniformBufferSupported)
+        glGetProgramiv(_program, GL_ACTIVE_UNIFORM_BLOCKS, &numOfBlocks);
+#endif
+
 #define MAX_UNIFORM_NAME_LENGTH 256
     UniformInfo uniform;
     GLint length     = 0;
@@ -279,6 +289,20 @@ void ProgramGL::computeUniformInfos()
                 uniform.isArray = true;
             }
         }
+#if CC_GL_UNIFORM_BUFFER
+        if (numOfBlocks > 0)
+        {
+            GLuint index = i;
+            GLint value  = 0;
+            glGetActiveUniformsiv(_program, 1, &index, GL_UNIFORM_BLOCK_INDEX, &uniform.blockIndex);
+            glGetActiveUniformsiv(_program, 1, &index, GL_UNIFORM_OFFSET, &value);
+            uniform.blockOffset = value;
+            glGetActiveUniformsiv(_program, 1, &index, GL_UNIFORM_ARRAY_STRIDE, &value);
+            uniform.arrayStride = value;
+            glGetActiveUniformsiv(_program, 1, &index, GL_UNIFORM_MATRIX_STRIDE, &value);
+            uniform.matrixStride = value;
+        }
+#endif
         uniform.location                 = glGetUniformLocation(_program, uniformName);
         uniform.size                     = UtilsGL::getGLDataTypeSize(uniform.type);
         uniform.bufferOffset             = (uniform.size == 0) ? 0 : _totalBufferSize;
@@ -286,6 +310,58 @@ void ProgramGL::computeUniformInfos()
         _totalBufferSize += uniform.size * uniform.count;
         _maxLocation = _maxLocation <= uniform.location ? (uniform.location + 1) : _maxLocation;
     }
+
+    if (numOfBlocks > 0)
+        computeUniformBlocks();
+
+    // a freshly linked program holds zero in every uniform
+    _uniformShadow.assign(_totalBufferSize, 0);
+    _samplerSlotShadow.clear();
+}
+
+void ProgramGL::computeUniformBlocks()
+{
+#if CC_GL_UNIFORM_BUFFER
+    GLint numOfBlocks = 0;
+    glGetProgramiv(_program, GL_ACTIVE_UNIFORM_BLOCKS, &numOfBlocks);
+
+    _uniformBlocks.clear();
+    _uniformBlocks.resize(numOfBlocks);
+    GLchar blockName[MAX_UNIFORM_NAME_LENGTH + 1];
+    for (int i = 0; i < numOfBlocks; ++i)
+    {
+        GLsizei length = 0;
+        glGetActiveUniformBlockName(_program, i, MAX_UNIFORM_NAME_LENGTH, &length, blockName);
+        auto& block = _uniformBlocks[i];
+        block.name.assign(blockName, length);
+        block.index = i;
+        glGetActiveUniformBlockiv(_program, i, GL_UNIFORM_BLOCK_DATA_SIZE, &block.size);
+    }
+
+    // block members have no GL location, give them unused ones so that ProgramState stores their values
+    for (auto& iter : _activeUniformInfos)
+    {
+        auto& uniform = iter.second;
+        if (uniform.blockIndex < 0 || uniform.blockIndex >= numOfBlocks)
+            continue;
+
+        uniform.location = _maxLocation < 0 ? 0 : _maxLocation;
+        _maxLocation     = uniform.location + 1;
+        _uniformBlocks[uniform.blockIndex].members.push_back(uniform);
+    }
+#endif
+}
+
+void ProgramGL::setUniformBlockBinding(std::size_t block, GLint binding)
+{
+#if CC_GL_UNIFORM_BUFFER
+    auto& blockInfo = _uniformBlocks[block];
+    if (blockInfo.binding == binding)
+        return;
+
+    blockInfo.binding = binding;
+    glUniformBlockBinding(_program, blockInfo.index, binding);
+#endif
 }
 
 int ProgramGL::getAttributeLocation(Attribute name) const
@@ -53,6 +53,19 @@ struct AttributeInfo
     std::string name;
 };
 
+/**
+ * Store uniform block information, the block members are left out of the plain uniform uploads.
+ */
+struct UniformBlockInfo
+{
+    std::string name;
+    GLuint index = 0;
+    GLint size   = 0;
+    /// binding point set with glUniformBlockBinding, -1 until the block is first drawn
+    GLint binding = -1;
+    std::vector<UniformInfo> members;
+};
+
 /**
  * @addtogroup _opengl
  * @{
@@ -151,10 +164,37 @@ public:
      */
     virtual const hlookup::string_map<UniformInfo>& getAllActiveUniformInfo(ShaderStage stage) const override;
 
+    /**
+     * Get the uniform values held by the GL program, laid out like the uniform buffer.
+     * CommandBufferGL compares against it to skip the uploads which wouldn't change anything.
+     * @return The shadow buffer, getUniformBufferSize() bytes long.
+     */
+    char* getUniformShadow() { return _uniformShadow.data(); }
+
+    /**
+     * Get the texture slots last assigned to the sampler uniforms, key is the uniform location.
+     * @return The sampler slots.
+     */
+    std::unordered_map<int, std::vector<int>>& getSamplerSlotShadow() { return _samplerSlotShadow; }
+
+    /**
+     * Get the uniform blocks declared by the shaders, always empty if uniform buffers aren't supported.
+     * @return The uniform blocks, in block index order.
+     */
+    const std::vector<UniformBlockInfo>& getUniformBlocks() const { return _uniformBlocks; }
+
+    /**
+     * Assign a uniform buffer binding point to a uniform block, nothing is done if it already uses it.
+     * @param block Specifies the index of the block in getUniformBlocks().
+     * @param binding Specifies the binding point.
+     */
+    void setUniformBlockBinding(std::size_t block, GLint binding);
+
 private:
     void compileProgram();
     bool getAttributeLocation(std::string_view attributeName, unsigned int& location) const;
     void computeUniformInfos();
+    void computeUniformBlocks();
     void computeLocations();
 #if CC_ENABLE_CACHE_TEXTURE_DATA
     virtual void reloadProgram();
@@ -185,6 +225,10 @@ private:
     UniformLocation _builtinUniformLocation[UNIFORM_MAX];
     int _builtinAttributeLocation[Attribute::ATTRIBUTE_MAX];
     std::unordered_map<int, int> _bufferOffset;
+
+    std::vector<char> _uniformShadow;
+    std::unordered_map<int, std::vector<int>> _samplerSlotShadow;
+    std::vector<UniformBlockInfo> _uniformBlocks;
 };
 // end of _opengl group
 /// @}
@@ -28,6 +28,7 @@ Copyright (c) 2020 c4games.com.
 #include "DepthStencilStateGL.h"
 #include "ProgramGL.h"
 #include "UtilsGL.h"
+#include "StateCacheGL.h"
 
 #include <assert.h>
 
@@ -61,15 +62,15 @@ void RenderPipelineGL::updateBlendState(const BlendDescriptor& descriptor)
 
     if (blendEnabled)
     {
-        glEnable(GL_BLEND);
-        glBlendEquationSeparate(rgbBlendOperation, alphaBlendOperation);
-        glBlendFuncSeparate(sourceRGBBlendFactor, destinationRGBBlendFactor, sourceAlphaBlendFactor,
-                            destinationAlphaBlendFactor);
+        StateCacheGL::enable(GL_BLEND);
+        StateCacheGL::blendEquationSeparate(rgbBlendOperation, alphaBlendOperation);
+        StateCacheGL::blendFuncSeparate(sourceRGBBlendFactor, destinationRGBBlendFactor, sourceAlphaBlendFactor,
+                                        destinationAlphaBlendFactor);
     }
     else
-        glDisable(GL_BLEND);
+        StateCacheGL::disable(GL_BLEND);
 
-    glColorMask(writeMaskRed, writeMaskGreen, writeMaskBlue, writeMaskAlpha);
+    StateCacheGL::colorMask(writeMaskRed, writeMaskGreen, writeMaskBlue, writeMaskAlpha);
 }
 
 RenderPipelineGL::~RenderPipelineGL()
@@ -0,0 +1,463 @@
+/****************************************************************************
+ Copyright (c) 2018-2019 Xiamen Yaji Software Co., Ltd.
+
+ https://adxeproject.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "StateCacheGL.h"
+
+#include <algorithm>
+#include <iterator>
+
+CC_BACKEND_BEGIN
+
+namespace
+{
+// marks a shadowed value which doesn't match any GL value
+const GLuint UNKNOWN = 0xFFFFFFFF;
+
+const int MAX_TEXTURE_UNITS  = 32;
+const int MAX_VERTEX_ATTRIBS = 32;
+const int MAX_UNIFORM_RANGES = 32;
+
+enum Capability
+{
+    CAP_BLEND,
+    CAP_DEPTH_TEST,
+    CAP_STENCIL_TEST,
+    CAP_CULL_FACE,
+    CAP_SCISSOR_TEST,
+    CAP_COUNT,
+};
+
+struct AttribPointer
+{
+    GLuint buffer = UNKNOWN;
+    GLint size;
+    GLenum type;
+    GLboolean normalized;
+    GLsizei stride;
+    const GLvoid* pointer;
+};
+
+struct UniformRange
+{
+    GLuint buffer = UNKNOWN;
+    GLintptr offset;
+    GLsizeiptr size;
+};
+
+struct State
+{
+    GLuint program;
+    GLuint arrayBuffer;
+    GLuint elementBuffer;
+
+    GLuint activeUnit;
+    GLuint textures2D[MAX_TEXTURE_UNITS];
+    GLuint texturesCube[MAX_TEXTURE_UNITS];
+
+    GLuint capabilities[CAP_COUNT];
+
+    GLuint blendEquation[2];
+    GLuint blendFunc[4];
+    GLuint colorMask;
+
+    GLuint depthMask;
+    GLuint depthFunc;
+
+    GLuint stencilFunc[3];
+    GLuint stencilOp[3];
+    GLuint stencilMask;
+
+    GLuint cullFace;
+    GLuint frontFace;
+
+    GLuint enabledAttribs;
+    GLuint knownAttribs;
+    AttribPointer attribPointers[MAX_VERTEX_ATTRIBS];
+
+    UniformRange uniformRanges[MAX_UNIFORM_RANGES];
+};
+
+State s_state;
+StateCacheGL::Stats s_stats;
+
+struct StateInitializer
+{
+    StateInitializer() { StateCacheGL::invalidate(); }
+} s_stateInitializer;
+
+// returns true when the call must reach the driver, and stores the new value
+inline bool update(GLuint& shadow, GLuint value)
+{
+#if CC_ENABLE_GL_STATE_CACHE
+    if (shadow == value)
+    {
+        ++s_stats.skippedCalls;
+        return false;
+    }
+#endif
+    shadow = value;
+    ++s_stats.issuedCalls;
+    return true;
+}
+
+inline bool update(GLuint* shadow, const GLuint* values, int count)
+{
+#if CC_ENABLE_GL_STATE_CACHE
+    if (std::equal(values, values + count, shadow))
+    {
+        ++s_stats.skippedCalls;
+        return false;
+    }
+#endif
+    std::copy(values, values + count, shadow);
+    ++s_stats.issuedCalls;
+    return true;
+}
+
+int toCapability(GLenum capability)
+{
+    switch (capability)
+    {
+    case GL_BLEND:
+        return CAP_BLEND;
+    case GL_DEPTH_TEST:
+        return CAP_DEPTH_TEST;
+    case GL_STENCIL_TEST:
+        return CAP_STENCIL_TEST;
+    case GL_CULL_FACE:
+        return CAP_CULL_FACE;
+    case GL_SCISSOR_TEST:
+        return CAP_SCISSOR_TEST;
+    default:
+        return -1;
+    }
+}
+}  // namespace
+
+void StateCacheGL::useProgram(GLuint program)
+{
+    if (update(s_state.program, program))
+        glUseProgram(program);
+}
+
+void StateCacheGL::deleteProgram(GLuint program)
+{
+    // the name may be reused by the next program created
+    if (s_state.program == program)
+        s_state.program = UNKNOWN;
+    glDeleteProgram(program);
+}
+
+void StateCacheGL::bindBuffer(GLenum target, GLuint buffer)
+{
+    GLuint* shadow = nullptr;
+    if (target == GL_ARRAY_BUFFER)
+        shadow = &s_state.arrayBuffer;
+    else if (target == GL_ELEMENT_ARRAY_BUFFER)
+        shadow = &s_state.elementBuffer;
+
+    if (!shadow || update(*shadow, buffer))
+        glBindBuffer(target, buffer);
+}
+
+void StateCacheGL::deleteBuffer(GLuint buffer)
+{
+    // deleting a bound buffer binds 0 in its place
+    if (s_state.arrayBuffer == buffer)
+        s_state.arrayBuffer = 0;
+    if (s_state.elementBuffer == buffer)
+        s_state.elementBuffer = 0;
+    for (auto& attribPointer : s_state.attribPointers)
+    {
+        if (attribPointer.buffer == buffer)
+            attribPointer.buffer = UNKNOWN;
+    }
+    for (auto& uniformRange : s_state.uniformRanges)
+    {
+        if (uniformRange.buffer == buffer)
+            uniformRange.buffer = UNKNOWN;
+    }
+    glDeleteBuffers(1, &buffer);
+}
+
+#if CC_GL_UNIFORM_BUFFER
+void StateCacheGL::bindUniformBufferRange(GLuint binding, GLuint buffer, GLintptr offset, GLsizeiptr size)
+{
+    if (binding < MAX_UNIFORM_RANGES)
+    {
+        auto& shadow = s_state.uniformRanges[binding];
+#    if CC_ENABLE_GL_STATE_CACHE
+        if (shadow.buffer == buffer && shadow.offset == offset && shadow.size == size)
+        {
+            ++s_stats.skippedCalls;
+            return;
+        }
+#    endif
+        shadow.buffer = buffer;
+        shadow.offset = offset;
+        shadow.size   = size;
+    }
+
+    ++s_stats.issuedCalls;
+    glBindBufferRange(GL_UNIFORM_BUFFER, binding, buffer, offset, size);
+}
+#endif
+
+void StateCacheGL::bindTexture(GLenum target, GLuint texture)
+{
+    GLuint* shadow = nullptr;
+    if (s_state.activeUnit < MAX_TEXTURE_UNITS)
+    {
+        if (target == GL_TEXTURE_2D)
+            shadow = &s_state.textures2D[s_state.activeUnit];
+        else if (target == GL_TEXTURE_CUBE_MAP)
+            shadow = &s_state.texturesCube[s_state.activeUnit];
+    }
+
+    if (!shadow || update(*shadow, texture))
+        glBindTexture(target, texture);
+}
+
+void StateCacheGL::bindTextureN(GLuint unit, GLenum target, GLuint texture)
+{
+    if (update(s_state.activeUnit, unit))
+        glActiveTexture(GL_TEXTURE0 + unit);
+    bindTexture(target, texture);
+}
+
+void StateCacheGL::deleteTexture(GLuint texture)
+{
+    for (int i = 0; i < MAX_TEXTURE_UNITS; ++i)
+    {
+        if (s_state.textures2D[i] == texture)
+            s_state.textures2D[i] = 0;
+        if (s_state.texturesCube[i] == texture)
+            s_state.texturesCube[i] = 0;
+    }
+    glDeleteTextures(1, &texture);
+}
+
+void StateCacheGL::enable(GLenum capability)
+{
+    int index = toCapability(capability);
+    if (index < 0 || update(s_state.capabilities[index], GL_TRUE))
+        glEnable(capability);
+}
+
+void StateCacheGL::disable(GLenum capability)
+{
+    int index = toCapability(capability);
+    if (index < 0 || update(s_state.capabilities[index], GL_FALSE))
+        glDisable(capability);
+}
+
+void StateCacheGL::blendEquationSeparate(GLenum rgbOperation, GLenum alphaOperation)
+{
+    const GLuint values[] = {rgbOperation, alphaOperation};
+    if (update(s_state.blendEquation, values, 2))
+        glBlendEquationSeparate(rgbOperation, alphaOperation);
+}
+
+void StateCacheGL::blendFuncSeparate(GLenum sourceRGB,
+                                     GLenum destinationRGB,
+                                     GLenum sourceAlpha,
+                                     GLenum destinationAlpha)
+{
+    const GLuint values[] = {sourceRGB, destinationRGB, sourceAlpha, destinationAlpha};
+    if (update(s_state.blendFunc, values, 4))
+        glBlendFuncSeparate(sourceRGB, destinationRGB, sourceAlpha, destinationAlpha);
+}
+
+void StateCacheGL::colorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)
+{
+    GLuint mask = (red ? 1 : 0) | (green ? 2 : 0) | (blue ? 4 : 0) | (alpha ? 8 : 0);
+    if (update(s_state.colorMask, mask))
+        glColorMask(red, green, blue, alpha);
+}
+
+void StateCacheGL::depthMask(GLboolean flag)
+{
+    if (update(s_state.depthMask, flag ? GL_TRUE : GL_FALSE))
+        glDepthMask(flag);
+}
+
+void StateCacheGL::depthFunc(GLenum func)
+{
+    if (update(s_state.depthFunc, func))
+        glDepthFunc(func);
+}
+
+void StateCacheGL::stencilFunc(GLenum func, GLint ref, GLuint mask)
+{
+    const GLuint values[] = {func, static_cast<GLuint>(ref), mask};
+    if (update(s_state.stencilFunc, values, 3))
+        glStencilFunc(func, ref, mask);
+}
+
+void StateCacheGL::stencilOp(GLenum stencilFail, GLenum depthFail, GLenum depthStencilPass)
+{
+    const GLuint values[] = {stencilFail, depthFail, depthStencilPass};
+    if (update(s_state.stencilOp, values, 3))
+        glStencilOp(stencilFail, depthFail, depthStencilPass);
+}
+
+void StateCacheGL::stencilMask(GLuint mask)
+{
+    if (update(s_state.stencilMask, mask))
+        glStencilMask(mask);
+}
+
+void StateCacheGL::invalidateStencil()
+{
+    std::fill(std::begin(s_state.stencilFunc), std::end(s_state.stencilFunc), UNKNOWN);
+    std::fill(std::begin(s_state.stencilOp), std::end(s_state.stencilOp), UNKNOWN);
+    s_state.stencilMask = UNKNOWN;
+}
+
+void StateCacheGL::cullFace(GLenum mode)
+{
+    if (update(s_state.cullFace, mode))
+        glCullFace(mode);
+}
+
+void StateCacheGL::frontFace(GLenum mode)
+{
+    if (update(s_state.frontFace, mode))
+        glFrontFace(mode);
+}
+
+void StateCacheGL::enableVertexAttribArray(GLuint index)
+{
+    const GLuint bit = index < MAX_VERTEX_ATTRIBS ? 1u << index : 0;
+#if CC_ENABLE_GL_STATE_CACHE
+    if ((s_state.knownAttribs & s_state.enabledAttribs & bit) != 0)
+    {
+        ++s_stats.skippedCalls;
+        return;
+    }
+#endif
+    s_state.knownAttribs |= bit;
+    s_state.enabledAttribs |= bit;
+    ++s_stats.issuedCalls;
+    glEnableVertexAttribArray(index);
+}
+
+void StateCacheGL::disableVertexAttribArray(GLuint index)
+{
+    const GLuint bit = index < MAX_VERTEX_ATTRIBS ? 1u << index : 0;
+#if CC_ENABLE_GL_STATE_CACHE
+    if ((s_state.knownAttribs & bit) != 0 && (s_state.enabledAttribs & bit) == 0)
+    {
+        ++s_stats.skippedCalls;
+        return;
+    }
+#endif
+    s_state.knownAttribs |= bit;
+    s_state.enabledAttribs &= ~bit;
+    ++s_stats.issuedCalls;
+    glDisableVertexAttribArray(index);
+}
+
+void StateCacheGL::vertexAttribPointer(GLuint index,
+                                       GLint size,
+                                       GLenum type,
+                                       GLboolean normalized,
+                                       GLsizei stride,
+                                       const GLvoid* pointer)
+{
+    if (index < MAX_VERTEX_ATTRIBS)
+    {
+        auto& shadow = s_state.attribPointers[index];
+#if CC_ENABLE_GL_STATE_CACHE
+        if (shadow.buffer != UNKNOWN && shadow.buffer == s_state.arrayBuffer && shadow.size == size &&
+            shadow.type == type && shadow.normalized == normalized && shadow.stride == stride &&
+            shadow.pointer == pointer)
+        {
+            ++s_stats.skippedCalls;
+            return;
+        }
+#endif
+        shadow.buffer     = s_state.arrayBuffer;
+        shadow.size       = size;
+        shadow.type       = type;
+        shadow.normalized = normalized;
+        shadow.stride     = stride;
+        shadow.pointer    = pointer;
+    }
+
+    ++s_stats.issuedCalls;
+    glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+}
+
+void StateCacheGL::countUniform(bool skipped)
+{
+    if (skipped)
+        ++s_stats.skippedUniforms;
+    else
+        ++s_stats.issuedUniforms;
+}
+
+void StateCacheGL::invalidate()
+{
+    s_state.program       = UNKNOWN;
+    s_state.arrayBuffer   = UNKNOWN;
+    s_state.elementBuffer = UNKNOWN;
+
+    s_state.activeUnit = UNKNOWN;
+    std::fill(std::begin(s_state.textures2D), std::end(s_state.textures2D), UNKNOWN);
+    std::fill(std::begin(s_state.texturesCube), std::end(s_state.texturesCube), UNKNOWN);
+
+    std::fill(std::begin(s_state.capabilities), std::end(s_state.capabilities), UNKNOWN);
+
+    std::fill(std::begin(s_state.blendEquation), std::end(s_state.blendEquation), UNKNOWN);
+    std::fill(std::begin(s_state.blendFunc), std::end(s_state.blendFunc), UNKNOWN);
+    s_state.colorMask = UNKNOWN;
+
+    s_state.depthMask = UNKNOWN;
+    s_state.depthFunc = UNKNOWN;
+
+    invalidateStencil();
+
+    s_state.cullFace  = UNKNOWN;
+    s_state.frontFace = UNKNOWN;
+
+    s_state.enabledAttribs = 0;
+    s_state.knownAttribs   = 0;
+    for (auto& attribPointer : s_state.attribPointers)
+        attribPointer.buffer = UNKNOWN;
+    for (auto& uniformRange : s_state.uniformRanges)
+        uniformRange.buffer = UNKNOWN;
+}
+
+const StateCacheGL::Stats& StateCacheGL::getStats()
+{
+    return s_stats;
+}
+
+void StateCacheGL::resetStats()
+{
+    s_stats = Stats();
+}
+
+CC_BACKEND_END
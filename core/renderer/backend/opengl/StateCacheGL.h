@@ -0,0 +1,121 @@
+/****************************************************************************
+ Copyright (c) 2018-2019 Xiamen Yaji Software Co., Ltd.
+
+ https://adxeproject.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/ccConfig.h"
+#include "platform/CCGL.h"
+#include "renderer/backend/Macros.h"
+#include "renderer/backend/opengl/MacrosGL.h"
+
+#include <cstdint>
+
+CC_BACKEND_BEGIN
+/**
+ * @addtogroup _opengl
+ * @{
+ */
+
+/**
+ * Shadows the OpenGL state changed by the backend and drops the calls which wouldn't change it.
+ *
+ * Every value starts unknown, so the first call setting it always reaches the driver. Code issuing GL calls behind
+ * the backend's back must call invalidate() afterwards. Define CC_ENABLE_GL_STATE_CACHE to 0 to issue every call,
+ * the counters are still updated then.
+ */
+struct StateCacheGL
+{
+    struct Stats
+    {
+        /** State changes forwarded to the driver. */
+        uint32_t issuedCalls = 0;
+        /** State changes dropped because the value was already set. */
+        uint32_t skippedCalls = 0;
+        /** glUniform* calls made by CommandBufferGL. */
+        uint32_t issuedUniforms = 0;
+        /** Uniform uploads dropped because the program already held the value. */
+        uint32_t skippedUniforms = 0;
+    };
+
+    static void useProgram(GLuint program);
+    static void deleteProgram(GLuint program);
+
+    /** Only GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER are shadowed, other targets are forwarded. */
+    static void bindBuffer(GLenum target, GLuint buffer);
+    static void deleteBuffer(GLuint buffer);
+#if CC_GL_UNIFORM_BUFFER
+    /** Binds a range of buffer to a GL_UNIFORM_BUFFER binding point, the first 32 points are shadowed. */
+    static void bindUniformBufferRange(GLuint binding, GLuint buffer, GLintptr offset, GLsizeiptr size);
+#endif
+
+    /** Binds texture to the active unit, only GL_TEXTURE_2D and GL_TEXTURE_CUBE_MAP are shadowed. */
+    static void bindTexture(GLenum target, GLuint texture);
+    /** Makes unit the active texture unit and binds texture to it. */
+    static void bindTextureN(GLuint unit, GLenum target, GLuint texture);
+    static void deleteTexture(GLuint texture);
+
+    /** Shadowed for GL_BLEND, GL_DEPTH_TEST, GL_STENCIL_TEST, GL_CULL_FACE and GL_SCISSOR_TEST. */
+    static void enable(GLenum capability);
+    static void disable(GLenum capability);
+
+    static void blendEquationSeparate(GLenum rgbOperation, GLenum alphaOperation);
+    static void blendFuncSeparate(GLenum sourceRGB, GLenum destinationRGB, GLenum sourceAlpha, GLenum destinationAlpha);
+    static void colorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha);
+
+    static void depthMask(GLboolean flag);
+    static void depthFunc(GLenum func);
+
+    static void stencilFunc(GLenum func, GLint ref, GLuint mask);
+    static void stencilOp(GLenum stencilFail, GLenum depthFail, GLenum depthStencilPass);
+    static void stencilMask(GLuint mask);
+    /** Separate front and back stencil state isn't shadowed, it is forgotten instead. */
+    static void invalidateStencil();
+
+    static void cullFace(GLenum mode);
+    static void frontFace(GLenum mode);
+
+    static void enableVertexAttribArray(GLuint index);
+    static void disableVertexAttribArray(GLuint index);
+    /** The pointer is shadowed together with the buffer bound to GL_ARRAY_BUFFER. */
+    static void vertexAttribPointer(GLuint index,
+                                    GLint size,
+                                    GLenum type,
+                                    GLboolean normalized,
+                                    GLsizei stride,
+                                    const GLvoid* pointer);
+
+    /** Counts a glUniform* call, issued or dropped by the caller. */
+    static void countUniform(bool skipped);
+
+    /** Forgets all the shadowed state, e.g. after the GL context was recreated. */
+    static void invalidate();
+
+    /** The counters accumulate until resetStats() is called. */
+    static const Stats& getStats();
+    static void resetStats();
+};
+
+// end of _opengl group
+/// @}
+CC_BACKEND_END
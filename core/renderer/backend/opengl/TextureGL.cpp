@@ -78,11 +78,11 @@ void TextureInfoGL::applySampler(const SamplerDescriptor& descriptor, bool isPow
 
     // apply sampler for all internal textures
     foreach ([=](GLuint texID, int index) {
-        glBindTexture(target, textures[index]);
+        StateCacheGL::bindTexture(target, textures[index]);
 
         setCurrentTexParameters(target);
 
-        glBindTexture(target, 0);  // unbind
+        StateCacheGL::bindTexture(target, 0);  // unbind
     })
         ;
 }
@@ -97,8 +97,7 @@ void TextureInfoGL::setCurrentTexParameters(GLenum target)
 
 void TextureInfoGL::apply(int slot, int index, GLenum target) const
 {
-    glActiveTexture(GL_TEXTURE0 + slot);
-    glBindTexture(target, index < CC_META_TEXTURES ? textures[index] : textures[0]);
+    StateCacheGL::bindTextureN(slot, target, index < CC_META_TEXTURES ? textures[index] : textures[0]);
 }
 
 GLuint TextureInfoGL::ensure(int index, GLenum target)
@@ -109,7 +108,7 @@ GLuint TextureInfoGL::ensure(int index, GLenum target)
     auto& texID = this->textures[index];
     if (!texID)
         glGenTextures(1, &texID);
-    glBindTexture(target, texID);
+    StateCacheGL::bindTexture(target, texID);
 
     setCurrentTexParameters(target);  // set once
 
@@ -126,7 +125,7 @@ void TextureInfoGL::recreateAll(GLenum target)
     {
         if (texID)
         {
-            glDeleteTextures(1, &texID);
+            StateCacheGL::deleteTexture(texID);
             texID = 0;
             ensure(idx, target);
         }
@@ -306,7 +305,7 @@ void Texture2DGL::generateMipmaps()
     if (!_hasMipmaps)
     {
         _hasMipmaps = true;
-        glBindTexture(GL_TEXTURE_2D, this->getHandler());
+        StateCacheGL::bindTexture(GL_TEXTURE_2D, this->getHandler());
         glGenerateMipmap(GL_TEXTURE_2D);
     }
 }
@@ -363,7 +362,7 @@ void TextureCubeGL::updateFaceData(TextureCubeFace side, void* data, int index)
                  _textureInfo.format, _textureInfo.type, data);
 
     CHECK_GL_ERROR_DEBUG();
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    StateCacheGL::bindTexture(GL_TEXTURE_CUBE_MAP, 0);
 }
 
 void TextureCubeGL::generateMipmaps()
@@ -374,7 +373,7 @@ void TextureCubeGL::generateMipmaps()
     if (!_hasMipmaps)
     {
         _hasMipmaps = true;
-        glBindTexture(GL_TEXTURE_CUBE_MAP, this->getHandler());
+        StateCacheGL::bindTexture(GL_TEXTURE_CUBE_MAP, this->getHandler());
         glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
     }
 }
@@ -27,6 +27,7 @@
 #include <array>
 #include "../Texture.h"
 #include "platform/CCGL.h"
+#include "StateCacheGL.h"
 #include "base/CCEventListenerCustom.h"
 
 CC_BACKEND_BEGIN
@@ -56,7 +57,7 @@ struct TextureInfoGL
 
     void destroy()
     {
-        foreach ([=](GLuint texID, int) { glDeleteTextures(1, &texID); })
+        foreach ([=](GLuint texID, int) { StateCacheGL::deleteTexture(texID); })
             ;
         textures.fill(0);
     }
@@ -0,0 +1,85 @@
+/****************************************************************************
+ Copyright (c) 2021 Bytedance Inc.
+
+ https://adxeproject.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "UniformRingBufferGL.h"
+#include "StateCacheGL.h"
+#include "renderer/backend/opengl/MacrosGL.h"
+
+#include <string.h>
+
+CC_BACKEND_BEGIN
+
+#if CC_GL_UNIFORM_BUFFER
+UniformRingBufferGL::UniformRingBufferGL(GLsizeiptr capacity) : _capacity(capacity)
+{
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &_alignment);
+    if (_alignment <= 0)
+        _alignment = 256;
+
+    glGenBuffers(1, &_buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, _buffer);
+    glBufferData(GL_UNIFORM_BUFFER, _capacity, nullptr, GL_STREAM_DRAW);
+    CHECK_GL_ERROR_DEBUG();
+}
+
+UniformRingBufferGL::~UniformRingBufferGL()
+{
+    if (_buffer)
+        StateCacheGL::deleteBuffer(_buffer);
+}
+
+GLintptr UniformRingBufferGL::upload(const void* data, GLsizeiptr size)
+{
+    CCASSERT(size <= _capacity, "uniform data larger than the ring buffer");
+
+    glBindBuffer(GL_UNIFORM_BUFFER, _buffer);
+
+    auto offset = (_head + _alignment - 1) / _alignment * _alignment;
+    if (offset + size > _capacity)
+    {
+        // the draws already issued keep the old storage alive
+        glBufferData(GL_UNIFORM_BUFFER, _capacity, nullptr, GL_STREAM_DRAW);
+        offset = 0;
+        ++_generation;
+    }
+
+    auto mapped = glMapBufferRange(GL_UNIFORM_BUFFER, offset, size,
+                                   GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (mapped)
+    {
+        memcpy(mapped, data, size);
+        glUnmapBuffer(GL_UNIFORM_BUFFER);
+    }
+    else
+    {
+        glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+    }
+    CHECK_GL_ERROR_DEBUG();
+
+    _head = offset + size;
+    return offset;
+}
+#endif
+
+CC_BACKEND_END
@@ -0,0 +1,83 @@
+/****************************************************************************
+ Copyright (c) 2021 Bytedance Inc.
+
+ https://adxeproject.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/ccMacros.h"
+#include "platform/CCGL.h"
+#include "renderer/backend/Macros.h"
+#include "renderer/backend/opengl/MacrosGL.h"
+
+#include <cstdint>
+
+CC_BACKEND_BEGIN
+/**
+ * @addtogroup _opengl
+ * @{
+ */
+
+#if CC_GL_UNIFORM_BUFFER
+/**
+ * A GL_UNIFORM_BUFFER filled from front to back with the uniform block data of the draws.
+ *
+ * Uploaded ranges are never written again, so they are mapped without synchronization. When the buffer is full its
+ * storage is orphaned and the filling starts over, the ranges given out before are lost then, see getGeneration().
+ */
+class UniformRingBufferGL
+{
+public:
+    /**
+     * @param capacity Specifies the size of the buffer in bytes.
+     */
+    explicit UniformRingBufferGL(GLsizeiptr capacity);
+    ~UniformRingBufferGL();
+
+    /**
+     * Copy data at the next free offset aligned for binding.
+     * @param data Specifies the data to copy.
+     * @param size Specifies the size of the data in bytes, at most the capacity.
+     * @return The offset the data was copied to.
+     */
+    GLintptr upload(const void* data, GLsizeiptr size);
+
+    /**
+     * Get the generation of the buffer storage, incremented each time it is orphaned.
+     * Ranges returned by upload() are valid as long as the generation doesn't change.
+     */
+    uint32_t getGeneration() const { return _generation; }
+
+    GLuint getHandler() const { return _buffer; }
+
+private:
+    GLuint _buffer       = 0;
+    GLsizeiptr _capacity = 0;
+    GLintptr _head       = 0;
+    GLint _alignment     = 256;
+    uint32_t _generation = 0;
+};
+#endif
+
+// end of _opengl group
+/// @}
+CC_BACKEND_END
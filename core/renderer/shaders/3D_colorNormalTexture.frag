@@ -93,7 +93,11 @@ varying vec3 v_normal;
 
 #endif
 
+#ifdef USE_INSTANCING
+varying vec4 v_instanceColor;
+#else
 uniform vec4 u_color;
+#endif
 #ifdef USE_NORMAL_MAPPING
 uniform sampler2D u_normalTex;
 #endif
@@ -171,10 +175,15 @@ void main(void)
     }
 #endif
 
+#ifdef USE_INSTANCING
+    vec4 color = v_instanceColor;
+#else
+    vec4 color = u_color;
+#endif
 #if ((MAX_DIRECTIONAL_LIGHT_NUM > 0) || (MAX_POINT_LIGHT_NUM > 0) || (MAX_SPOT_LIGHT_NUM > 0))
-    gl_FragColor = texture2D(u_texture, TextureCoordOut) * u_color * combinedColor;
+    gl_FragColor = texture2D(u_texture, TextureCoordOut) * color * combinedColor;
 #else
-    gl_FragColor = texture2D(u_texture, TextureCoordOut) * u_color;
+    gl_FragColor = texture2D(u_texture, TextureCoordOut) * color;
 #endif
 
 }
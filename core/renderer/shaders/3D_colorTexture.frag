@@ -30,11 +30,19 @@ varying mediump vec2 TextureCoordOut;
 #else
 varying vec2 TextureCoordOut;
 #endif
+#ifdef USE_INSTANCING
+varying vec4 v_instanceColor;
+#else
 uniform vec4 u_color;
+#endif
 uniform sampler2D u_texture; 
 
 void main(void)
 {
+#ifdef USE_INSTANCING
+    gl_FragColor = texture2D(u_texture, TextureCoordOut) * v_instanceColor;
+#else
     gl_FragColor = texture2D(u_texture, TextureCoordOut) * u_color;
+#endif
 }
 )";
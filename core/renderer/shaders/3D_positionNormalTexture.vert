@@ -47,6 +47,14 @@ attribute vec3 a_normal;
 attribute vec3 a_tangent;
 attribute vec3 a_binormal;
 #endif
+#ifdef USE_INSTANCING
+// rows of the model view matrix and color of the instance
+attribute vec4 a_instanceModelView0;
+attribute vec4 a_instanceModelView1;
+attribute vec4 a_instanceModelView2;
+attribute vec4 a_instanceColor;
+varying vec4 v_instanceColor;
+#endif
 varying vec2 TextureCoordOut;
 
 #ifdef USE_NORMAL_MAPPING
@@ -77,12 +85,23 @@ uniform mat3 u_NormalMatrix;
 
 void main(void)
 {
+#ifdef USE_INSTANCING
+    vec4 ePosition = vec4(dot(a_instanceModelView0, a_position), dot(a_instanceModelView1, a_position),
+                          dot(a_instanceModelView2, a_position), 1.0);
+    // the upper 3x3 of the model view matrix, which transforms the normals if the scale is uniform
+    mat3 normalMatrix = mat3(a_instanceModelView0.x, a_instanceModelView1.x, a_instanceModelView2.x,
+                             a_instanceModelView0.y, a_instanceModelView1.y, a_instanceModelView2.y,
+                             a_instanceModelView0.z, a_instanceModelView1.z, a_instanceModelView2.z);
+    v_instanceColor = a_instanceColor;
+#else
     vec4 ePosition = u_MVMatrix * a_position;
+    mat3 normalMatrix = u_NormalMatrix;
+#endif
 #ifdef USE_NORMAL_MAPPING
     #if ((MAX_DIRECTIONAL_LIGHT_NUM > 0) || (MAX_POINT_LIGHT_NUM > 0) || (MAX_SPOT_LIGHT_NUM > 0))
-        vec3 eTangent = normalize(u_NormalMatrix * a_tangent);
-        vec3 eBinormal = normalize(u_NormalMatrix * a_binormal);
-        vec3 eNormal = normalize(u_NormalMatrix * a_normal);
+        vec3 eTangent = normalize(normalMatrix * a_tangent);
+        vec3 eBinormal = normalize(normalMatrix * a_binormal);
+        vec3 eNormal = normalize(normalMatrix * a_normal);
     #endif
     #if (MAX_DIRECTIONAL_LIGHT_NUM > 0)
         for (int i = 0; i < MAX_DIRECTIONAL_LIGHT_NUM; ++i)
@@ -132,7 +151,7 @@ void main(void)
     #endif
 
     #if ((MAX_DIRECTIONAL_LIGHT_NUM > 0) || (MAX_POINT_LIGHT_NUM > 0) || (MAX_SPOT_LIGHT_NUM > 0))
-        v_normal = u_NormalMatrix * a_normal;
+        v_normal = normalMatrix * a_normal;
     #endif
 #endif
 
@@ -176,7 +195,11 @@ attribute vec3 a_binormal;
 
 const int SKINNING_JOINT_COUNT = 60;
 // Uniforms
+#ifdef USE_DUAL_QUATERNION
+uniform vec4 u_matrixPalette[SKINNING_JOINT_COUNT * 2];
+#else
 uniform vec4 u_matrixPalette[SKINNING_JOINT_COUNT * 3];
+#endif
 
 uniform mat4 u_MVMatrix;
 uniform mat3 u_NormalMatrix;
@@ -206,8 +229,59 @@ varying vec3 v_normal;
 #endif
 #endif
 
+#ifdef USE_DUAL_QUATERNION
+// Blend the real and dual quaternions of the vertex bones, u_matrixPalette holds 2 vec4 per bone
+void getBlendedDualQuaternion(out vec4 blendReal, out vec4 blendDual)
+{
+    int matrixIndex = int(a_blendIndex[0]) * 2;
+    vec4 real0 = u_matrixPalette[matrixIndex];
+    blendReal = real0 * a_blendWeight[0];
+    blendDual = u_matrixPalette[matrixIndex + 1] * a_blendWeight[0];
+
+    for (int i = 1; i < 4; ++i)
+    {
+        float blendWeight = a_blendWeight[i];
+        if (blendWeight > 0.0)
+        {
+            matrixIndex = int(a_blendIndex[i]) * 2;
+            vec4 real = u_matrixPalette[matrixIndex];
+            // blend along the shortest arc
+            if (dot(real0, real) < 0.0)
+                blendWeight = -blendWeight;
+            blendReal += real * blendWeight;
+            blendDual += u_matrixPalette[matrixIndex + 1] * blendWeight;
+        }
+    }
+
+    float len = length(blendReal);
+    blendReal /= len;
+    blendDual /= len;
+}
+
+vec3 rotateByQuaternion(vec4 q, vec3 v)
+{
+    return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);
+}
+
+vec3 transformByDualQuaternion(vec4 real, vec4 dual, vec3 p)
+{
+    vec3 translation = 2.0 * (real.w * dual.xyz - dual.w * real.xyz + cross(real.xyz, dual.xyz));
+    return rotateByQuaternion(real, p) + translation;
+}
+#endif
+
 void getPositionAndNormal(out vec4 position, out vec3 normal, out vec3 tangent, out vec3 binormal)
 {
+#ifdef USE_DUAL_QUATERNION
+    vec4 blendReal, blendDual;
+    getBlendedDualQuaternion(blendReal, blendDual);
+    position = vec4(transformByDualQuaternion(blendReal, blendDual, a_position), 1.0);
+    normal = rotateByQuaternion(blendReal, a_normal);
+#ifdef USE_NORMAL_MAPPING
+    tangent = rotateByQuaternion(blendReal, a_tangent);
+    binormal = rotateByQuaternion(blendReal, a_binormal);
+#endif
+#else
     float blendWeight = a_blendWeight[0];
 
     int matrixIndex = int (a_blendIndex[0]) * 3;
@@ -265,6 +339,7 @@ void getPositionAndNormal(out vec4 position, out vec3 normal, out vec3 tangent,
     binormal.z = dot(b, matrixPalette3);
 #endif
 #endif
+#endif
 }
 
 void main()
@@ -27,6 +27,15 @@ const char* CC3D_positionTexture_vert = R"(
 
 attribute vec4 a_position;
 attribute vec2 a_texCoord;
+#ifdef USE_INSTANCING
+// rows of the model view matrix and color of the instance
+attribute vec4 a_instanceModelView0;
+attribute vec4 a_instanceModelView1;
+attribute vec4 a_instanceModelView2;
+attribute vec4 a_instanceColor;
+varying vec4 v_instanceColor;
+uniform mat4 u_PMatrix;
+#endif
 
 varying vec2 TextureCoordOut;
 
@@ -34,7 +43,14 @@ uniform mat4 u_MVPMatrix;
 
 void main(void)
 {
+#ifdef USE_INSTANCING
+    vec4 ePosition = vec4(dot(a_instanceModelView0, a_position), dot(a_instanceModelView1, a_position),
+                          dot(a_instanceModelView2, a_position), 1.0);
+    gl_Position = u_PMatrix * ePosition;
+    v_instanceColor = a_instanceColor;
+#else
     gl_Position = u_MVPMatrix * a_position;
+#endif
     TextureCoordOut = a_texCoord;
     TextureCoordOut.y = 1.0 - TextureCoordOut.y;
 }
@@ -50,14 +66,64 @@ attribute vec2 a_texCoord;
 
 const int SKINNING_JOINT_COUNT = 60;
 // Uniforms
+#ifdef USE_DUAL_QUATERNION
+uniform vec4 u_matrixPalette[SKINNING_JOINT_COUNT * 2];
+#else
 uniform vec4 u_matrixPalette[SKINNING_JOINT_COUNT * 3];
+#endif
 uniform mat4 u_MVPMatrix;
 
 // Varyings
 varying vec2 TextureCoordOut;
 
+#ifdef USE_DUAL_QUATERNION
+// Blend the real and dual quaternions of the vertex bones, u_matrixPalette holds 2 vec4 per bone
+void getBlendedDualQuaternion(out vec4 blendReal, out vec4 blendDual)
+{
+    int matrixIndex = int(a_blendIndex[0]) * 2;
+    vec4 real0 = u_matrixPalette[matrixIndex];
+    blendReal = real0 * a_blendWeight[0];
+    blendDual = u_matrixPalette[matrixIndex + 1] * a_blendWeight[0];
+
+    for (int i = 1; i < 4; ++i)
+    {
+        float blendWeight = a_blendWeight[i];
+        if (blendWeight > 0.0)
+        {
+            matrixIndex = int(a_blendIndex[i]) * 2;
+            vec4 real = u_matrixPalette[matrixIndex];
+            // blend along the shortest arc
+            if (dot(real0, real) < 0.0)
+                blendWeight = -blendWeight;
+            blendReal += real * blendWeight;
+            blendDual += u_matrixPalette[matrixIndex + 1] * blendWeight;
+        }
+    }
+
+    float len = length(blendReal);
+    blendReal /= len;
+    blendDual /= len;
+}
+
+vec3 rotateByQuaternion(vec4 q, vec3 v)
+{
+    return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);
+}
+
+vec3 transformByDualQuaternion(vec4 real, vec4 dual, vec3 p)
+{
+    vec3 translation = 2.0 * (real.w * dual.xyz - dual.w * real.xyz + cross(real.xyz, dual.xyz));
+    return rotateByQuaternion(real, p) + translation;
+}
+#endif
+
 vec4 getPosition()
 {
+#ifdef USE_DUAL_QUATERNION
+    vec4 blendReal, blendDual;
+    getBlendedDualQuaternion(blendReal, blendDual);
+    return vec4(transformByDualQuaternion(blendReal, blendDual, a_position), 1.0);
+#else
     float blendWeight = a_blendWeight[0];
 
     int matrixIndex = int (a_blendIndex[0]) * 3;
@@ -101,6 +167,7 @@ vec4 getPosition()
     _skinnedPosition.w = position.w;
 
     return _skinnedPosition;
+#endif
 }
 
 void main()
@@ -31,6 +31,8 @@
 #include <vector>
 #include <map>
 #include <list>
+#include <algorithm>
+#include <functional>
 #include "ExtensionExport.h"
 
 NS_CC_BEGIN
@@ -60,12 +62,20 @@ struct CC_EX_DLL Particle3D
     std::unordered_map<std::string, void*> userDefs;
 };
 
+/**
+ * Pool of reusable datas, split into the active datas and the free ones.
+ *
+ * Both lists are arrays of pointers, the datas created with addDatas() are also stored contiguously, so iterating the
+ * active datas walks linear memory. The active datas stay in creation order, some affectors chain each particle to
+ * the previous one: locking a data leaves a hole in its slot, the holes are closed in one pass once the iteration
+ * with getFirst() and getNext() is over, or when the active list is read.
+ */
 template <typename T>
 class CC_EX_DLL DataPool
 {
 public:
-    typedef typename std::list<T*> PoolList;
-    typedef typename std::list<T*>::iterator PoolIterator;
+    typedef typename std::vector<T*> PoolList;
+    typedef typename std::vector<T*>::iterator PoolIterator;
 
     DataPool(){};
     ~DataPool(){};
@@ -74,85 +84,168 @@ public:
     {
         if (_locked.empty())
             return nullptr;
-        T* p = _locked.front();
-        //_released.push_back(p);
-        //_locked.erase(_locked.begin());
-        _released.splice(_released.end(), _locked, _locked.begin());
+        // the most recently locked data is the most likely to still be in the cache
+        T* p = _locked.back();
+        _locked.pop_back();
+        _released.push_back(p);
         return p;
     }
 
+    /** Locks the data returned by the last getFirst() or getNext() call. */
     void lockLatestData()
     {
-        _locked.push_back(*_releasedIter);
-        _releasedIter = _released.erase(_releasedIter);
-        if (_releasedIter != _released.begin() && _releasedIter != _released.end())
-        {
-            --_releasedIter;
-        }
+        // after a compaction the index may already point at the next data, the latest one is locked then
+        if (_revisitIndex || _releasedIndex >= _released.size() || !_released[_releasedIndex])
+            return;
+
+        _locked.push_back(_released[_releasedIndex]);
+        _released[_releasedIndex] = nullptr;
+        ++_holes;
     }
 
     void lockData(T* data)
     {
-        PoolIterator tempIter = _releasedIter;
-        T* ptr                = getFirst();
-        while (ptr)
-        {
-            if (ptr == data)
-                break;
-            ptr = getNext();
-        }
-        if (ptr)
-            lockLatestData();
-        _releasedIter = tempIter;
+        auto iter = std::find(_released.begin(), _released.end(), data);
+        if (iter == _released.end() || !data)
+            return;
+
+        // an ongoing iteration isn't disturbed by a hole
+        _locked.push_back(data);
+        *iter = nullptr;
+        ++_holes;
     }
 
     void lockAllDatas()
     {
-        _locked.splice(_locked.end(), _released);
-        //_locked.insert(_locked.end(), _released.begin(), _released.end());
-        //_released.clear();
-        _releasedIter = _released.begin();
+        compact();
+        _locked.insert(_locked.end(), _released.begin(), _released.end());
+        _released.clear();
+        _releasedIndex = 0;
+        _revisitIndex  = false;
     }
 
     T* getFirst()
     {
-        _releasedIter = _released.begin();
-        if (_releasedIter == _released.end())
-            return nullptr;
-        return *_releasedIter;
+        compact();
+        _releasedIndex = 0;
+        _revisitIndex  = false;
+        return _released.empty() ? nullptr : _released.front();
     }
 
     T* getNext()
     {
-        if (_releasedIter == _released.end())
-            return nullptr;
-        ++_releasedIter;
-        if (_releasedIter == _released.end())
-            return nullptr;
-        return *_releasedIter;
+        if (_revisitIndex)
+            _revisitIndex = false;
+        else
+            ++_releasedIndex;
+
+        for (; _releasedIndex < _released.size(); ++_releasedIndex)
+        {
+            if (_released[_releasedIndex])
+                return _released[_releasedIndex];
+        }
+        compact();
+        return nullptr;
     }
 
-    const PoolList& getActiveDataList() const { return _released; };
+    const PoolList& getActiveDataList() const
+    {
+        compact();
+        return _released;
+    };
     const PoolList& getUnActiveDataList() const { return _locked; };
 
+    /** Adds a free data, the pool owns it. */
     void addData(T* data) { _locked.push_back(data); }
 
-    bool empty() const { return _released.empty(); };
+    /**
+     * Creates count free datas in one contiguous array, the pool owns them.
+     * @return The first data of the array.
+     */
+    template <typename U = T>
+    U* addDatas(std::size_t count)
+    {
+        if (count == 0)
+            return nullptr;
+
+        U* datas = new U[count];
+        _blocks.push_back({reinterpret_cast<const char*>(datas), reinterpret_cast<const char*>(datas + count),
+                           [](T* first) { delete[] static_cast<U*>(first); }});
+        _locked.reserve(_locked.size() + count);
+        _released.reserve(_locked.size() + _released.size());
+        for (std::size_t i = 0; i < count; ++i)
+            _locked.push_back(datas + i);
+        return datas;
+    }
+
+    bool empty() const { return _released.size() == _holes; };
 
     void removeAllDatas()
     {
         lockAllDatas();
         for (auto iter : _locked)
         {
-            delete iter;
+            if (!isInBlock(iter))
+                delete iter;
+        }
+        for (auto& block : _blocks)
+        {
+            block.destroy(reinterpret_cast<T*>(const_cast<char*>(block.begin)));
         }
         _locked.clear();
+        _blocks.clear();
     }
 
 private:
-    PoolIterator _releasedIter;
-    PoolList _released;
+    struct Block
+    {
+        const char* begin;
+        const char* end;
+        void (*destroy)(T*);
+    };
+
+    // closes the holes left by the locked datas, keeping the order of the active ones and the iteration position
+    void compact() const
+    {
+        if (_holes == 0)
+            return;
+
+        std::size_t write   = 0;
+        std::size_t current = _released.size();
+        for (std::size_t read = 0; read < _released.size(); ++read)
+        {
+            if (read == _releasedIndex)
+            {
+                current = write;
+                // the next data moves into the hole of the current one, getNext() must not skip it
+                _revisitIndex = _released[read] == nullptr;
+            }
+            if (_released[read])
+                _released[write++] = _released[read];
+        }
+        _releasedIndex = std::min(current, write);
+        _released.resize(write);
+        _holes = 0;
+    }
+
+    bool isInBlock(const T* data) const
+    {
+        auto address = reinterpret_cast<const char*>(data);
+        for (const auto& block : _blocks)
+        {
+            if (!std::less<const char*>()(address, block.begin) && std::less<const char*>()(address, block.end))
+                return true;
+        }
+        return false;
+    }
+
+    // the active list is compacted lazily, even by the const accessors
+    mutable std::size_t _releasedIndex = 0;
+    mutable bool _revisitIndex         = false;
+    mutable std::size_t _holes         = 0;
+    mutable PoolList _released;
     PoolList _locked;
+    std::vector<Block> _blocks;
 };
 
 typedef DataPool<Particle3D> ParticlePool;
@@ -68,6 +68,14 @@ public:
     virtual void initParticleForEmission(PUParticle3D* particle);
     void process(PUParticle3D* particle, float delta, bool firstParticle);
 
+    /** Whether updatePUAffector() may run for different particles at the same time.
+    @remarks
+        Only declare it when updatePUAffector() writes to the particle passed in and nothing else, reading the
+        affector and the particle system only. The system may then run the affector across the JobSystem workers,
+        after preUpdateAffector() and before postUpdateAffector() were called on the cocos thread.
+    */
+    virtual bool isParallelSafe() const { return false; }
+
     void setLocalPosition(const Vec3& pos) { _position = pos; };
     const Vec3 getLocalPosition() const { return _position; };
     void setMass(float mass);
@@ -50,6 +50,7 @@ public:
     static PUColorAffector* create();
 
     virtual void updatePUAffector(PUParticle3D* particle, float deltaTime) override;
+    virtual bool isParallelSafe() const override { return true; }
 
     /**
      */
@@ -42,6 +42,7 @@ public:
 
     virtual void preUpdateAffector(float deltaTime) override;
     virtual void updatePUAffector(PUParticle3D* particle, float deltaTime) override;
+    virtual bool isParallelSafe() const override { return true; }
 
     /**
      */
@@ -39,6 +39,7 @@ public:
 
     virtual void preUpdateAffector(float deltaTime) override;
     virtual void updatePUAffector(PUParticle3D* particle, float deltaTime) override;
+    virtual bool isParallelSafe() const override { return true; }
 
     virtual void copyAttributesTo(PUAffector* affector) override;
 
@@ -38,6 +38,7 @@
 #include "extensions/Particle3D/PU/CCPUObserverManager.h"
 #include "extensions/Particle3D/PU/CCPUBehaviour.h"
 #include "platform/CCFileUtils.h"
+#include "base/CCJobSystem.h"
 
 NS_CC_BEGIN
 
@@ -88,6 +89,9 @@ void PUParticle3D::initForEmission()
     // Reset freeze flag
     freezed = false;
 
+    // A recycled particle must not inherit the parallel pass of its previous life
+    affectedInParallel = false;
+
     if (!behaviours.empty())
     {
         for (auto& it : behaviours)
@@ -141,6 +145,7 @@ PUParticle3D::PUParticle3D()
     , ownDimensions(false)
     , eventFlags(0)
     , freezed(false)
+    , affectedInParallel(false)
     , timeToLive(DEFAULT_TTL)
     , totalTimeToLive(DEFAULT_TTL)
     , timeFraction(0.0f)
@@ -178,13 +183,20 @@ void PUParticle3D::copyBehaviours(const ParticleBehaviourList& list)
 
 //-----------------------------------------------------------------------
 
-const float PUParticleSystem3D::DEFAULT_WIDTH                        = 50;
-const float PUParticleSystem3D::DEFAULT_HEIGHT                       = 50;
-const float PUParticleSystem3D::DEFAULT_DEPTH                        = 50;
-const unsigned int PUParticleSystem3D::DEFAULT_PARTICLE_QUOTA        = 500;
-const unsigned int PUParticleSystem3D::DEFAULT_EMITTED_EMITTER_QUOTA = 50;
-const unsigned int PUParticleSystem3D::DEFAULT_EMITTED_SYSTEM_QUOTA  = 10;
-const float PUParticleSystem3D::DEFAULT_MAX_VELOCITY                 = 9999.0f;
+const float PUParticleSystem3D::DEFAULT_WIDTH                              = 50;
+const float PUParticleSystem3D::DEFAULT_HEIGHT                             = 50;
+const float PUParticleSystem3D::DEFAULT_DEPTH                              = 50;
+const unsigned int PUParticleSystem3D::DEFAULT_PARTICLE_QUOTA              = 500;
+const unsigned int PUParticleSystem3D::DEFAULT_EMITTED_EMITTER_QUOTA       = 50;
+const unsigned int PUParticleSystem3D::DEFAULT_EMITTED_SYSTEM_QUOTA        = 10;
+const float PUParticleSystem3D::DEFAULT_MAX_VELOCITY                       = 9999.0f;
+const unsigned int PUParticleSystem3D::DEFAULT_PARALLEL_AFFECTOR_THRESHOLD = 1024;
+
+namespace
+{
+// Particles each job of the parallel affector pass processes
+const size_t PARALLEL_AFFECTOR_CHUNK_SIZE = 256;
+}  // namespace
 
 PUParticleSystem3D::PUParticleSystem3D()
     : _emittedEmitterQuota(DEFAULT_EMITTED_EMITTER_QUOTA)
@@ -198,6 +210,8 @@ PUParticleSystem3D::PUParticleSystem3D()
     , _defaultDepth(DEFAULT_DEPTH)
     , _maxVelocity(DEFAULT_MAX_VELOCITY)
     , _maxVelocitySet(false)
+    , _parallelAffectorsEnabled(false)
+    , _parallelAffectorThreshold(DEFAULT_PARALLEL_AFFECTOR_THRESHOLD)
     , _isMarkedForEmission(false)
     , _parentParticleSystem(nullptr)
 {
@@ -547,39 +561,41 @@ void PUParticleSystem3D::prepared()
                 if (emitter->getEmitsType() == PUParticle3D::PT_EMITTER)
                 {
                     PUEmitter* emitted = static_cast<PUEmitter*>(emitter->getEmitsEntityPtr());
+                    auto particles     = _emittedEmitterParticlePool[emitted->getName()].addDatas<PUParticle3D>(
+                        _emittedEmitterQuota);
                     for (unsigned int i = 0; i < _emittedEmitterQuota; ++i)
                     {
-                        auto p               = new PUParticle3D();
+                        auto p               = particles + i;
                         p->particleType      = PUParticle3D::PT_EMITTER;
                         p->particleEntityPtr = emitted->clone();
                         p->particleEntityPtr->retain();
                         p->copyBehaviours(_behaviourTemplates);
-                        _emittedEmitterParticlePool[emitted->getName()].addData(p);
                     }
                 }
                 else if (emitter->getEmitsType() == PUParticle3D::PT_TECHNIQUE)
                 {
                     PUParticleSystem3D* emitted = static_cast<PUParticleSystem3D*>(emitter->getEmitsEntityPtr());
+                    auto particles              = _emittedSystemParticlePool[emitted->getName()].addDatas<PUParticle3D>(
+                        _emittedSystemQuota);
                     for (unsigned int i = 0; i < _emittedSystemQuota; ++i)
                     {
                         PUParticleSystem3D* clonePS = emitted->clone();
-                        auto p                      = new PUParticle3D();
+                        auto p                      = particles + i;
                         p->particleType             = PUParticle3D::PT_TECHNIQUE;
                         p->particleEntityPtr        = clonePS;
                         p->particleEntityPtr->retain();
                         p->copyBehaviours(_behaviourTemplates);
-                        _emittedSystemParticlePool[emitted->getName()].addData(p);
                         clonePS->prepared();
                     }
                     // emitted->stopParticle();
                 }
             }
 
+            // one contiguous array per pool, the affectors walk the particles in memory order
+            auto particles = _particlePool.addDatas<PUParticle3D>(_particleQuota);
             for (unsigned int i = 0; i < _particleQuota; ++i)
             {
-                auto p = new PUParticle3D();
-                p->copyBehaviours(_behaviourTemplates);
-                _particlePool.addData(p);
+                particles[i].copyBehaviours(_behaviourTemplates);
             }
             _poolPrepared = true;
         }
@@ -1240,6 +1256,8 @@ void PUParticleSystem3D::copyAttributesTo(PUParticleSystem3D* system)
     system->_defaultDepth                = _defaultDepth;
     system->_maxVelocity                 = _maxVelocity;
     system->_maxVelocitySet              = _maxVelocitySet;
+    system->_parallelAffectorsEnabled    = _parallelAffectorsEnabled;
+    system->_parallelAffectorThreshold   = _parallelAffectorThreshold;
     system->_matName                     = _matName;
     system->_isMarkedForEmission         = _isMarkedForEmission;
     system->_parentParticleSystem        = _parentParticleSystem;
@@ -1318,6 +1336,8 @@ void PUParticleSystem3D::processParticle(ParticlePool& pool,
                                          bool& firstParticle,
                                          float elapsedTime)
 {
+    processParallelAffectors(pool, firstActiveParticle, elapsedTime);
+
     Vec3 scale             = getDerivedScale();
     PUParticle3D* particle = static_cast<PUParticle3D*>(pool.getFirst());
     // Mat4 ltow = getNodeToWorldTransform();
@@ -1329,7 +1349,11 @@ void PUParticleSystem3D::processParticle(ParticlePool& pool,
 
         if (!isExpired(particle, elapsedTime))
         {
-            particle->process(elapsedTime);
+            // Particles emitted during this loop missed the parallel pass
+            bool affectedInParallel      = particle->affectedInParallel;
+            particle->affectedInParallel = false;
+            if (!affectedInParallel)
+                particle->process(elapsedTime);
 
             // if (_emitter && _emitter->isEnabled())
             //     _emitter->updateEmitter(particle, elapsedTime);
@@ -1344,9 +1368,10 @@ void PUParticleSystem3D::processParticle(ParticlePool& pool,
 
             for (auto& it : _affectors)
             {
-                if (it->isEnabled())
+                auto affector = static_cast<PUAffector*>(it);
+                if (affector->isEnabled() && !(affectedInParallel && affector->isParallelSafe()))
                 {
-                    (static_cast<PUAffector*>(it))->process(particle, elapsedTime, firstActiveParticle);
+                    affector->process(particle, elapsedTime, firstActiveParticle);
                 }
             }
 
@@ -1405,6 +1430,7 @@ void PUParticleSystem3D::processParticle(ParticlePool& pool,
         }
         else
         {
+            particle->affectedInParallel = false;
             initParticleForExpiration(particle, elapsedTime);
             pool.lockLatestData();
         }
@@ -1433,6 +1459,76 @@ void PUParticleSystem3D::processParticle(ParticlePool& pool,
     }
 }
 
+void PUParticleSystem3D::processParallelAffectors(ParticlePool& pool, bool firstActiveParticle, float elapsedTime)
+{
+    const auto& particles = pool.getActiveDataList();
+    if (!_parallelAffectorsEnabled || particles.size() < _parallelAffectorThreshold)
+        return;
+
+    _parallelAffectors.clear();
+    for (auto& it : _affectors)
+    {
+        auto affector = static_cast<PUAffector*>(it);
+        if (affector->isEnabled() && affector->isParallelSafe())
+            _parallelAffectors.push_back(affector);
+    }
+    if (_parallelAffectors.empty())
+        return;
+
+    // Bring the particles to the state the serial loop would hand them to the affectors in, behaviours may touch
+    // shared state so they stay on this thread
+    for (auto it : particles)
+    {
+        auto particle = static_cast<PUParticle3D*>(it);
+        if (particle->timeToLive < elapsedTime)
+            continue;
+
+        particle->process(elapsedTime);
+        particle->affectedInParallel = true;
+        if (firstActiveParticle)
+        {
+            for (auto affector : _parallelAffectors)
+                affector->firstParticleUpdate(particle, elapsedTime);
+            firstActiveParticle = false;
+        }
+    }
+
+    JobSystem::getInstance()->parallelForRange(
+        0, particles.size(), PARALLEL_AFFECTOR_CHUNK_SIZE, [this, &particles, elapsedTime](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                auto particle = static_cast<PUParticle3D*>(particles[i]);
+                if (!particle->affectedInParallel)
+                    continue;
+
+                for (auto affector : _parallelAffectors)
+                    affector->process(particle, elapsedTime, false);
+            }
+        });
+}
+
+void PUParticleSystem3D::setParallelAffectorsEnabled(bool enabled)
+{
+    _parallelAffectorsEnabled = enabled;
+    for (auto iter : _children)
+    {
+        PUParticleSystem3D* system = dynamic_cast<PUParticleSystem3D*>(iter);
+        if (system)
+            system->setParallelAffectorsEnabled(enabled);
+    }
+}
+
+void PUParticleSystem3D::setParallelAffectorThreshold(unsigned int threshold)
+{
+    _parallelAffectorThreshold = threshold;
+    for (auto iter : _children)
+    {
+        PUParticleSystem3D* system = dynamic_cast<PUParticleSystem3D*>(iter);
+        if (system)
+            system->setParallelAffectorThreshold(threshold);
+    }
+}
+
 bool PUParticleSystem3D::makeParticleLocal(PUParticle3D* particle)
 {
     if (!particle)
@@ -1540,13 +1636,13 @@ int PUParticleSystem3D::getAliveParticleCount() const
 
     for (auto& iter : _emittedSystemParticlePool)
     {
-        auto pool = iter.second;
-        sz += pool.getActiveDataList().size();
-        PUParticle3D* particle = static_cast<PUParticle3D*>(pool.getFirst());
-        while (particle)
+        // iterate the list rather than a copy of the pool, this runs for every draw
+        const auto& activeList = iter.second.getActiveDataList();
+        sz += activeList.size();
+        for (auto particle : activeList)
         {
-            sz += static_cast<PUParticleSystem3D*>(particle->particleEntityPtr)->getAliveParticleCount();
-            particle = static_cast<PUParticle3D*>(pool.getNext());
+            sz += static_cast<PUParticleSystem3D*>(static_cast<PUParticle3D*>(particle)->particleEntityPtr)
+                      ->getAliveParticleCount();
         }
     }
     return sz;
@@ -173,6 +173,9 @@ struct CC_EX_DLL PUParticle3D : public Particle3D
     void setFreezed(bool fzd) { freezed = fzd; }
     bool freezed;
 
+    // Set while the parallel safe affectors have already processed the particle in the current update
+    bool affectedInParallel;
+
     // Time to live, number of seconds left of particles natural life
     float timeToLive;
 
@@ -216,6 +219,7 @@ public:
     static const unsigned int DEFAULT_EMITTED_EMITTER_QUOTA;
     static const unsigned int DEFAULT_EMITTED_SYSTEM_QUOTA;
     static const float DEFAULT_MAX_VELOCITY;
+    static const unsigned int DEFAULT_PARALLEL_AFFECTOR_THRESHOLD;
 
     static PUParticleSystem3D* create();
     static PUParticleSystem3D* create(std::string_view filePath);
@@ -296,6 +300,22 @@ public:
      */
     void setMaxVelocity(float maxVelocity);
 
+    /**
+     * Runs the affectors declared parallel safe (see PUAffector::isParallelSafe) in chunks on the JobSystem workers,
+     * for pools holding at least getParallelAffectorThreshold() active particles. These affectors then process a
+     * particle before the emitters and the other affectors do. Disabled by default, the serial update is deterministic.
+     * Applies to the child particle systems too.
+     */
+    void setParallelAffectorsEnabled(bool enabled);
+    bool isParallelAffectorsEnabled() const { return _parallelAffectorsEnabled; }
+
+    /**
+     * Set the number of active particles a pool needs before its affectors run in parallel, smaller pools are
+     * updated serially. Applies to the child particle systems too.
+     */
+    void setParallelAffectorThreshold(unsigned int threshold);
+    unsigned int getParallelAffectorThreshold() const { return _parallelAffectorThreshold; }
+
     void setMaterialName(std::string_view name) { _matName = name; };
     std::string_view getMaterialName() const { return _matName; };
 
@@ -364,6 +384,7 @@ protected:
     void executeEmitParticles(PUEmitter* emitter, unsigned requested, float elapsedTime);
     void emitParticles(ParticlePool& pool, PUEmitter* emitter, unsigned requested, float elapsedTime);
     void processParticle(ParticlePool& pool, bool& firstActiveParticle, bool& firstParticle, float elapsedTime);
+    void processParallelAffectors(ParticlePool& pool, bool firstActiveParticle, float elapsedTime);
     void processMotion(PUParticle3D* particle, float timeElapsed, const Vec3& scl, bool firstParticle);
     void notifyRescaled(const Vec3& scl);
     void initParticleForEmission(PUParticle3D* particle);
@@ -407,6 +428,10 @@ protected:
     float _maxVelocity;  // Attributes that limit the velocity of the particles in this technique.
     bool _maxVelocitySet;
 
+    bool _parallelAffectorsEnabled;
+    unsigned int _parallelAffectorThreshold;
+    std::vector<PUAffector*> _parallelAffectors;  // Scratch list of the affectors run in parallel
+
     std::string _matName;  // material name
 
     bool _isMarkedForEmission;
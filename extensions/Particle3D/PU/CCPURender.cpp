@@ -532,7 +532,7 @@ void PUParticle3DModelRender::render(Renderer* renderer, const Mat4& transform,
     }
 
     const ParticlePool& particlePool          = particleSystem->getParticlePool();
-    ParticlePool::PoolList activeParticleList = particlePool.getActiveDataList();
+    const ParticlePool::PoolList& activeParticleList = particlePool.getActiveDataList();
     Mat4 mat;
     Mat4 rotMat;
     Mat4 sclMat;
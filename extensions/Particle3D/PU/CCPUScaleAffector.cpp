@@ -261,6 +261,17 @@ void PUScaleAffector::updatePUAffector(PUParticle3D* particle, float deltaTime)
     }
 }
 
+bool PUScaleAffector::isParallelSafe() const
+{
+    // Random attributes draw from the shared random engine
+    for (auto dynScale : {_dynScaleX, _dynScaleY, _dynScaleZ, _dynScaleXYZ})
+    {
+        if (dynScale && dynScale->getType() == PUDynamicAttribute::DAT_RANDOM)
+            return false;
+    }
+    return true;
+}
+
 PUScaleAffector* PUScaleAffector::create()
 {
     auto psa = new PUScaleAffector();
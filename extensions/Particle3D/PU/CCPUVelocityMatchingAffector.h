@@ -41,6 +41,8 @@ public:
     static PUVelocityMatchingAffector* create();
 
     virtual void updatePUAffector(PUParticle3D* particle, float deltaTime) override;
+    // Only while the neighbour search of updatePUAffector() stays disabled, it reads other particles.
+    virtual bool isParallelSafe() const override { return true; }
     /** Todo
      */
     float getRadius() const;
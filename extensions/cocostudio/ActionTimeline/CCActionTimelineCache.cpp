@@ -445,8 +445,8 @@ ActionTimeline* ActionTimelineCache::loadAnimationActionWithFlatBuffersFile(std:
 
     CC_ASSERT(FileUtils::getInstance()->isFileExist(fullPath));
 
-    Data buf = FileUtils::getInstance()->getDataFromFile(fullPath);
-    action   = createActionWithDataBuffer(buf);
+    auto buf = FileUtils::getInstance()->getMappedDataFromFile(fullPath);
+    action   = createActionWithDataBuffer(buf.getBytes());
     _animationActions.insert(fileName, action);
 
     return action;
@@ -463,15 +463,15 @@ ActionTimeline* ActionTimelineCache::loadAnimationWithDataBuffer(const cocos2d::
 
     CC_ASSERT(FileUtils::getInstance()->isFileExist(fullPath));
 
-    action = createActionWithDataBuffer(data);
+    action = createActionWithDataBuffer(data.getBytes());
     _animationActions.insert(fileName, action);
 
     return action;
 }
 
-ActionTimeline* ActionTimelineCache::createActionWithDataBuffer(const cocos2d::Data& data)
+ActionTimeline* ActionTimelineCache::createActionWithDataBuffer(const uint8_t* bytes)
 {
-    auto csparsebinary = GetCSParseBinary(data.getBytes());
+    auto csparsebinary = GetCSParseBinary(bytes);
 
     auto nodeAction = csparsebinary->action();
     auto action     = ActionTimeline::create();
@@ -122,7 +122,7 @@ protected:
     Frame* loadBlendFrameWithFlatBuffers(const flatbuffers::BlendFrame* flatbuffers);
     void loadEasingDataWithFlatBuffers(Frame* frame, const flatbuffers::EasingData* flatbuffers);
 
-    inline ActionTimeline* createActionWithDataBuffer(const cocos2d::Data& data);
+    inline ActionTimeline* createActionWithDataBuffer(const uint8_t* bytes);
 
 protected:
     typedef std::function<Frame*(const rapidjson::Value& json)> FrameCreateFunc;
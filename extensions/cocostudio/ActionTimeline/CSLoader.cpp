@@ -906,15 +906,12 @@ Node* CSLoader::createNode(const Data& data, const ccNodeLoadCallback& callback)
             int readerVersion = 0, writterVersion = 0;
             // parse writter version
             int revisionIndex = 0;
-            fast_split(csBuildId->c_str(), '.', [&](const char* start, const char* end) {
-                auto endv  = const_cast<char*>(end);
-                char charS = *endv;
+            fast_split(csBuildId->c_str(), '.', [&](const char* start, const char* /*end*/) {
+                // atoi stops at the next '.', the buffer may be a read only mapping and isn't written
                 switch (++revisionIndex)
                 {
                 case 3:
-                    *endv          = '\0';
                     writterVersion = atoi(start);
-                    *endv          = charS;
                     break;
                 }
             });
@@ -1006,7 +1003,7 @@ Node* CSLoader::nodeWithFlatBuffersFile(std::string_view fileName, const ccNodeL
 
     CC_ASSERT(FileUtils::getInstance()->isFileExist(fullPath));
 
-    Data buf = FileUtils::getInstance()->getDataFromFile(fullPath);
+    auto buf = FileUtils::getInstance()->getMappedDataFromFile(fullPath);
 
     if (buf.isNull())
     {
@@ -1023,15 +1020,12 @@ Node* CSLoader::nodeWithFlatBuffersFile(std::string_view fileName, const ccNodeL
         int readerVersion = 0, writterVersion = 0;
         // parse writter version
         int revisionIndex = 0;
-        fast_split(csBuildId->c_str(), '.', [&](const char* start, const char* end) {
-            auto endv  = const_cast<char*>(end);
-            char charS = *endv;
+        fast_split(csBuildId->c_str(), '.', [&](const char* start, const char* /*end*/) {
+            // atoi stops at the next '.', the buffer may be a read only mapping and isn't written
             switch (++revisionIndex)
             {
             case 3:
-                *endv          = '\0';
                 writterVersion = atoi(start);
-                *endv          = charS;
                 break;
             }
         });
@@ -123,6 +123,9 @@ static int lua_downloader_new(lua_State* L)
         hints.countOfMaxProcessingTasks = get_field_int(L, "countOfMaxProcessingTasks", 6);
         hints.timeoutInSeconds          = get_field_int(L, "timeoutInSeconds", 45);
         hints.tempFileNameSuffix        = get_field_string(L, "tempFileNameSuffix", ".tmp");
+        hints.chunkedDownloadThreshold  = get_field_int(L, "chunkedDownloadThreshold", 4 * 1024 * 1024);
+        hints.chunkSize                 = get_field_int(L, "chunkSize", 1024 * 1024);
+        hints.countOfMaxChunksPerTask   = get_field_int(L, "countOfMaxChunksPerTask", 4);
 
         auto ptr   = lua_newuserdata(L, sizeof(Downloader));
         downloader = new (ptr) Downloader(hints);
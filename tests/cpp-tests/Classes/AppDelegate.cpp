@@ -29,6 +29,7 @@
 
 #include "cocos2d.h"
 #include "controller.h"
+#include "BenchmarkTest/BenchmarkRunner.h"
 // #include "extensions/cocostudio/CocoStudio.h"
 #include "extensions/cocos-ext.h"
 
@@ -118,6 +119,11 @@ bool AppDelegate::applicationDidFinishLaunching()
 
     _testController = TestController::getInstance();
 
+    // the benchmark scenes replace the test list right away
+    auto benchmarkRunner = BenchmarkRunner::getInstance();
+    if (benchmarkRunner->isRunAtLaunch())
+        benchmarkRunner->start();
+
     return true;
 }
 
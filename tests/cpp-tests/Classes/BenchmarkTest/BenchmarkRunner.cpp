@@ -0,0 +1,407 @@
+/****************************************************************************
+ Copyright (c) 2021 Bytedance Inc.
+
+ https://adxeproject.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "BenchmarkRunner.h"
+#include "BenchmarkTest.h"
+#include "cocos2d.h"
+
+#include "rapidjson/document.h"
+#include "rapidjson/prettywriter.h"
+#include "rapidjson/stringbuffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+
+USING_NS_CC;
+
+// set by the CPP_TESTS_BENCHMARK_ALLOCATIONS cmake option, off by default to keep the system operator new
+#ifndef CC_BENCHMARK_COUNT_ALLOCATIONS
+#    define CC_BENCHMARK_COUNT_ALLOCATIONS 0
+#endif
+
+#if CC_BENCHMARK_COUNT_ALLOCATIONS
+static std::atomic<uint64_t> s_allocationCount{0};
+
+// Replacing the global operator new counts the allocations of the whole executable, the engine included when it's
+// linked statically. Memory taken with malloc directly isn't counted.
+void* operator new(std::size_t size)
+{
+    s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (auto p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+#endif
+
+bool BenchmarkThresholds::set(std::string_view metric, float threshold)
+{
+    if (metric == "cpu_ms")
+        cpuTime = threshold;
+    else if (metric == "draw_calls")
+        drawCalls = threshold;
+    else if (metric == "vertices")
+        vertices = threshold;
+    else if (metric == "allocations")
+        allocations = threshold;
+    else
+        return false;
+    return true;
+}
+
+static BenchmarkRunner* s_sharedBenchmarkRunner = nullptr;
+
+BenchmarkRunner* BenchmarkRunner::getInstance()
+{
+    if (!s_sharedBenchmarkRunner)
+        s_sharedBenchmarkRunner = new BenchmarkRunner();
+    return s_sharedBenchmarkRunner;
+}
+
+void BenchmarkRunner::destroyInstance()
+{
+    CC_SAFE_DELETE(s_sharedBenchmarkRunner);
+}
+
+uint64_t BenchmarkRunner::getAllocationCount()
+{
+#if CC_BENCHMARK_COUNT_ALLOCATIONS
+    return s_allocationCount.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+void BenchmarkRunner::start()
+{
+    if (_running)
+        return;
+
+    auto director = Director::getInstance();
+    _running      = true;
+    _passed       = true;
+    _results.clear();
+    _regressions.clear();
+
+    // the stats overlay adds its own draw calls and allocations, and one update per frame keeps the samples aligned
+    _displayStats  = director->isDisplayStats();
+    _fixedTimeStep = director->getFixedTimeStep();
+    director->setDisplayStats(false);
+    director->setFixedTimeStep(0);
+
+    auto dispatcher       = director->getEventDispatcher();
+    _beforeUpdateListener = dispatcher->addCustomEventListener(Director::EVENT_BEFORE_UPDATE,
+                                                               [this](EventCustom*) { onBeforeUpdate(); });
+    _afterDrawListener =
+        dispatcher->addCustomEventListener(Director::EVENT_AFTER_DRAW, [this](EventCustom*) { onAfterDraw(); });
+
+    loadScene(0);
+}
+
+void BenchmarkRunner::loadScene(size_t index)
+{
+    _sceneIndex       = index;
+    _sceneFrame       = 0;
+    _hasPendingSample = false;
+    _samples.clear();
+    _samples.reserve(_options.frames);
+
+    // the particle systems draw from rand()
+    std::srand(1);
+    Director::getInstance()->replaceScene(getBenchmarkScenes()[index].create());
+}
+
+void BenchmarkRunner::onBeforeUpdate()
+{
+    if (_hasPendingSample)
+    {
+        // the pacer records a frame after its swap, so its last timings belong to the sample of the frame before
+        const auto& timings    = FramePacer::getInstance()->getLastFrameTimings();
+        _pendingSample.cpuTime = timings.update + timings.visit + timings.render;
+        _hasPendingSample      = false;
+
+        if (_sceneFrame++ >= _options.warmupFrames)
+            _samples.push_back(_pendingSample);
+
+        if (_sceneFrame >= _options.warmupFrames + _options.frames)
+        {
+            finishScene();
+            if (_sceneIndex + 1 >= getBenchmarkScenes().size())
+            {
+                finish();
+                return;
+            }
+            loadScene(_sceneIndex + 1);
+        }
+    }
+    _frameStartAllocations = getAllocationCount();
+}
+
+void BenchmarkRunner::onAfterDraw()
+{
+    auto director = Director::getInstance();
+    auto renderer = director->getRenderer();
+
+    _pendingSample.drawCalls   = static_cast<float>(renderer->getDrawnBatches());
+    _pendingSample.vertices    = static_cast<float>(renderer->getDrawnVertices());
+    _pendingSample.allocations = static_cast<float>(getAllocationCount() - _frameStartAllocations);
+    _pendingSample.deltaTime   = director->getDeltaTime();
+    _hasPendingSample          = true;
+}
+
+static BenchmarkMetric summarize(std::vector<double>& values)
+{
+    BenchmarkMetric metric;
+    if (values.empty())
+        return metric;
+
+    std::sort(values.begin(), values.end());
+    for (auto value : values)
+        metric.mean += value;
+    metric.mean /= values.size();
+    metric.median = values[values.size() / 2];
+    // nearest rank
+    metric.p95 = values[std::min(values.size() - 1, static_cast<size_t>(std::ceil(values.size() * 0.95)) - 1)];
+    metric.max = values.back();
+    return metric;
+}
+
+void BenchmarkRunner::finishScene()
+{
+    BenchmarkSceneResult result;
+    result.name   = getBenchmarkScenes()[_sceneIndex].name;
+    result.frames = static_cast<unsigned int>(_samples.size());
+
+    std::vector<double> values(_samples.size());
+    auto summarizeField = [&](float FrameSample::*field) {
+        for (size_t i = 0; i < _samples.size(); ++i)
+            values[i] = _samples[i].*field;
+        return summarize(values);
+    };
+    result.cpuTime     = summarizeField(&FrameSample::cpuTime);
+    result.drawCalls   = summarizeField(&FrameSample::drawCalls);
+    result.vertices    = summarizeField(&FrameSample::vertices);
+    result.allocations = summarizeField(&FrameSample::allocations);
+    result.deltaTime   = summarizeField(&FrameSample::deltaTime).mean;
+
+    log("Benchmark %s: %u frames, cpu median %.3f ms, p95 %.3f ms, %.0f draw calls, %.0f vertices, %.1f allocations",
+        result.name.c_str(), result.frames, result.cpuTime.median, result.cpuTime.p95, result.drawCalls.mean,
+        result.vertices.mean, result.allocations.mean);
+    _results.push_back(std::move(result));
+}
+
+void BenchmarkRunner::finish()
+{
+    auto director   = Director::getInstance();
+    auto dispatcher = director->getEventDispatcher();
+    dispatcher->removeEventListener(_beforeUpdateListener);
+    dispatcher->removeEventListener(_afterDrawListener);
+    _beforeUpdateListener = nullptr;
+    _afterDrawListener    = nullptr;
+
+    director->setDisplayStats(_displayStats);
+    director->setFixedTimeStep(_fixedTimeStep);
+    _running = false;
+
+    if (!_options.baselinePath.empty())
+        compareWithBaseline();
+
+    if (!_options.outputPath.empty() && !FileUtils::getInstance()->writeStringToFile(toJson(), _options.outputPath))
+        log("Can't write the benchmark report to %s", _options.outputPath.c_str());
+
+    log("Benchmark finished: %d scenes, %d regressions", static_cast<int>(_results.size()),
+        static_cast<int>(_regressions.size()));
+
+    if (_options.exitWhenDone)
+        director->end();
+    else if (_options.onFinished)
+        _options.onFinished();
+}
+
+void BenchmarkRunner::compareWithBaseline()
+{
+    auto content = FileUtils::getInstance()->getStringFromFile(_options.baselinePath);
+
+    rapidjson::Document baseline;
+    baseline.Parse(content.c_str());
+    if (baseline.HasParseError() || !baseline.IsObject() || !baseline.HasMember("scenes") ||
+        !baseline["scenes"].IsObject())
+    {
+        log("Can't read the benchmark baseline %s", _options.baselinePath.c_str());
+        _passed = false;
+        return;
+    }
+
+    struct Check
+    {
+        const char* metric;
+        const char* statistic;
+        float threshold;
+        // absolute tolerance, keeps the noise of near zero baselines from counting as regressions
+        double slack;
+        BenchmarkMetric BenchmarkSceneResult::*value;
+        double BenchmarkMetric::*field;
+    };
+    const auto& thresholds = _options.thresholds;
+    const Check checks[]   = {
+        {"cpu_ms", "median", thresholds.cpuTime, 0.05, &BenchmarkSceneResult::cpuTime, &BenchmarkMetric::median},
+        {"cpu_ms", "p95", thresholds.cpuTime, 0.05, &BenchmarkSceneResult::cpuTime, &BenchmarkMetric::p95},
+        {"draw_calls", "mean", thresholds.drawCalls, 0.5, &BenchmarkSceneResult::drawCalls, &BenchmarkMetric::mean},
+        {"vertices", "mean", thresholds.vertices, 0.5, &BenchmarkSceneResult::vertices, &BenchmarkMetric::mean},
+        {"allocations", "mean", thresholds.allocations, 0.5, &BenchmarkSceneResult::allocations,
+         &BenchmarkMetric::mean},
+    };
+
+    const auto& scenes = baseline["scenes"];
+    for (const auto& result : _results)
+    {
+        auto sceneIt = scenes.FindMember(result.name.c_str());
+        if (sceneIt == scenes.MemberEnd() || !sceneIt->value.IsObject())
+        {
+            log("Benchmark %s has no baseline", result.name.c_str());
+            continue;
+        }
+
+        for (const auto& check : checks)
+        {
+            auto metricIt = sceneIt->value.FindMember(check.metric);
+            if (metricIt == sceneIt->value.MemberEnd() || !metricIt->value.IsObject())
+                continue;
+            auto statisticIt = metricIt->value.FindMember(check.statistic);
+            if (statisticIt == metricIt->value.MemberEnd() || !statisticIt->value.IsNumber())
+                continue;
+
+            double expected = statisticIt->value.GetDouble();
+            double current  = (result.*check.value).*check.field;
+            if (current > expected * (1 + check.threshold) + check.slack)
+            {
+                auto metric = std::string(check.metric) + "." + check.statistic;
+                log("Benchmark %s regressed on %s: %.3f -> %.3f", result.name.c_str(), metric.c_str(), expected,
+                    current);
+                _regressions.push_back({result.name, metric, expected, current});
+            }
+        }
+    }
+    _passed = _regressions.empty();
+}
+
+using BenchmarkJsonWriter = rapidjson::PrettyWriter<rapidjson::StringBuffer>;
+
+static void writeMetric(BenchmarkJsonWriter& writer, const char* name, const BenchmarkMetric& metric)
+{
+    writer.Key(name);
+    writer.StartObject();
+    writer.Key("mean");
+    writer.Double(metric.mean);
+    writer.Key("median");
+    writer.Double(metric.median);
+    writer.Key("p95");
+    writer.Double(metric.p95);
+    writer.Key("max");
+    writer.Double(metric.max);
+    writer.EndObject();
+}
+
+std::string BenchmarkRunner::toJson() const
+{
+    rapidjson::StringBuffer buffer;
+    BenchmarkJsonWriter writer(buffer);
+
+    writer.StartObject();
+    writer.Key("version");
+    writer.Uint(1);
+    writer.Key("frames");
+    writer.Uint(_options.frames);
+    writer.Key("warmup_frames");
+    writer.Uint(_options.warmupFrames);
+
+    writer.Key("thresholds");
+    writer.StartObject();
+    writer.Key("cpu_ms");
+    writer.Double(_options.thresholds.cpuTime);
+    writer.Key("draw_calls");
+    writer.Double(_options.thresholds.drawCalls);
+    writer.Key("vertices");
+    writer.Double(_options.thresholds.vertices);
+    writer.Key("allocations");
+    writer.Double(_options.thresholds.allocations);
+    writer.EndObject();
+
+    writer.Key("scenes");
+    writer.StartObject();
+    for (const auto& result : _results)
+    {
+        writer.Key(result.name.c_str());
+        writer.StartObject();
+        writer.Key("frames");
+        writer.Uint(result.frames);
+        writer.Key("delta_time");
+        writer.Double(result.deltaTime);
+        writeMetric(writer, "cpu_ms", result.cpuTime);
+        writeMetric(writer, "draw_calls", result.drawCalls);
+        writeMetric(writer, "vertices", result.vertices);
+        writeMetric(writer, "allocations", result.allocations);
+        writer.EndObject();
+    }
+    writer.EndObject();
+
+    if (!_options.baselinePath.empty())
+    {
+        writer.Key("baseline");
+        writer.String(_options.baselinePath.c_str());
+        writer.Key("regressions");
+        writer.StartArray();
+        for (const auto& regression : _regressions)
+        {
+            writer.StartObject();
+            writer.Key("scene");
+            writer.String(regression.scene.c_str());
+            writer.Key("metric");
+            writer.String(regression.metric.c_str());
+            writer.Key("baseline");
+            writer.Double(regression.baseline);
+            writer.Key("current");
+            writer.Double(regression.current);
+            writer.EndObject();
+        }
+        writer.EndArray();
+        writer.Key("passed");
+        writer.Bool(_passed);
+    }
+    writer.EndObject();
+
+    return buffer.GetString();
+}
@@ -0,0 +1,178 @@
+/****************************************************************************
+ Copyright (c) 2021 Bytedance Inc.
+
+ https://adxeproject.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef _BENCHMARK_RUNNER_H_
+#define _BENCHMARK_RUNNER_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cocos2d
+{
+class EventListenerCustom;
+}
+
+/** Relative increases over the baseline tolerated before a metric counts as a regression, 0.1 means 10%. */
+struct BenchmarkThresholds
+{
+    float cpuTime     = 0.15f;
+    float drawCalls   = 0.0f;
+    float vertices    = 0.0f;
+    float allocations = 0.05f;
+
+    /** Sets the threshold of cpu_ms, draw_calls, vertices or allocations, returns false for other names. */
+    bool set(std::string_view metric, float threshold);
+};
+
+struct BenchmarkOptions
+{
+    /** Frames measured per scene, after the warm up. */
+    unsigned int frames = 300;
+    /** Frames run before measuring, they absorb the scene loading and the first texture uploads. */
+    unsigned int warmupFrames = 30;
+    /** The JSON report is written there when it isn't empty. */
+    std::string outputPath;
+    /** A report from an earlier run to compare the results with. */
+    std::string baselinePath;
+    BenchmarkThresholds thresholds;
+    /** Ends the Director once the suite finished, used by the command line runs. */
+    bool exitWhenDone = false;
+    /** Called once the suite finished unless exitWhenDone is set. */
+    std::function<void()> onFinished;
+};
+
+/** Summary of one metric over the measured frames of a scene. */
+struct BenchmarkMetric
+{
+    double mean   = 0;
+    double median = 0;
+    double p95    = 0;
+    double max    = 0;
+};
+
+struct BenchmarkSceneResult
+{
+    std::string name;
+    unsigned int frames = 0;
+    double deltaTime    = 0;
+    /** Update, visit and render time of the frame, in milliseconds. */
+    BenchmarkMetric cpuTime;
+    BenchmarkMetric drawCalls;
+    BenchmarkMetric vertices;
+    /** operator new calls made by the update, visit and render of the frame. */
+    BenchmarkMetric allocations;
+};
+
+struct BenchmarkRegression
+{
+    std::string scene;
+    std::string metric;
+    double baseline = 0;
+    double current  = 0;
+};
+
+/**
+ * Runs the scenes returned by getBenchmarkScenes() one after another for a fixed number of frames each and
+ * reports the frame statistics as JSON, optionally compared with a baseline report.
+ *
+ * The frame time comes from the FramePacer timings, so run it in the headless mode with a fixed delta time to
+ * get results which can be compared between runs.
+ */
+class BenchmarkRunner
+{
+public:
+    static BenchmarkRunner* getInstance();
+    static void destroyInstance();
+
+    /** Options for the next run, set them before applicationDidFinishLaunching to run the suite at launch. */
+    void setOptions(const BenchmarkOptions& options) { _options = options; }
+    const BenchmarkOptions& getOptions() const { return _options; }
+
+    /** Whether the suite should start at launch instead of the test menu. */
+    void setRunAtLaunch(bool runAtLaunch) { _runAtLaunch = runAtLaunch; }
+    bool isRunAtLaunch() const { return _runAtLaunch; }
+
+    /** Replaces the running scene with the first benchmark scene. */
+    void start();
+    bool isRunning() const { return _running; }
+
+    /** Results of the last finished run. */
+    const std::vector<BenchmarkSceneResult>& getResults() const { return _results; }
+    const std::vector<BenchmarkRegression>& getRegressions() const { return _regressions; }
+    /** False when the last run regressed against the baseline or the baseline couldn't be read. */
+    bool hasPassed() const { return _passed; }
+
+    /**
+     * Number of operator new calls since the launch, counted by cpp-tests only. Always 0 unless cpp-tests is built with
+     * the CPP_TESTS_BENCHMARK_ALLOCATIONS cmake option.
+     */
+    static uint64_t getAllocationCount();
+
+private:
+    struct FrameSample
+    {
+        float cpuTime;
+        float drawCalls;
+        float vertices;
+        float allocations;
+        float deltaTime;
+    };
+
+    BenchmarkRunner() = default;
+
+    void loadScene(size_t index);
+    void onBeforeUpdate();
+    void onAfterDraw();
+    void finishScene();
+    void finish();
+
+    void compareWithBaseline();
+    std::string toJson() const;
+
+    BenchmarkOptions _options;
+    bool _runAtLaunch = false;
+    bool _running     = false;
+    bool _passed      = true;
+
+    size_t _sceneIndex       = 0;
+    unsigned int _sceneFrame = 0;
+    std::vector<FrameSample> _samples;
+    FrameSample _pendingSample{};
+    bool _hasPendingSample          = false;
+    uint64_t _frameStartAllocations = 0;
+
+    bool _displayStats   = false;
+    float _fixedTimeStep = 0;
+
+    cocos2d::EventListenerCustom* _beforeUpdateListener = nullptr;
+    cocos2d::EventListenerCustom* _afterDrawListener    = nullptr;
+
+    std::vector<BenchmarkSceneResult> _results;
+    std::vector<BenchmarkRegression> _regressions;
+};
+
+#endif /* _BENCHMARK_RUNNER_H_ */
@@ -0,0 +1,396 @@
+/****************************************************************************
+ Copyright (c) 2021 Bytedance Inc.
+
+ https://adxeproject.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "BenchmarkTest.h"
+#include "BenchmarkRunner.h"
+#include "../controller.h"
+
+USING_NS_CC;
+
+BenchmarkTests::BenchmarkTests()
+{
+    ADD_TEST_CASE(BenchmarkRunSuite);
+    ADD_TEST_CASE(BenchmarkSpriteBatch);
+    ADD_TEST_CASE(BenchmarkParticles);
+    ADD_TEST_CASE(BenchmarkLabels);
+    ADD_TEST_CASE(BenchmarkTileMap);
+#if CC_USE_PHYSICS
+    ADD_TEST_CASE(BenchmarkPhysics);
+#endif
+    ADD_TEST_CASE(BenchmarkSkinning);
+    ADD_TEST_CASE(BenchmarkUIList);
+}
+
+const std::vector<BenchmarkScene>& getBenchmarkScenes()
+{
+    static const std::vector<BenchmarkScene> scenes = {
+        {"SpriteBatch", []() -> Scene* { return BenchmarkSpriteBatch::create(); }},
+        {"Particles", []() -> Scene* { return BenchmarkParticles::create(); }},
+        {"Labels", []() -> Scene* { return BenchmarkLabels::create(); }},
+        {"TileMap", []() -> Scene* { return BenchmarkTileMap::create(); }},
+#if CC_USE_PHYSICS
+        {"Physics", []() -> Scene* { return BenchmarkPhysics::create(); }},
+#endif
+        {"Skinning", []() -> Scene* { return BenchmarkSkinning::create(); }},
+        {"UIList", []() -> Scene* { return BenchmarkUIList::create(); }},
+    };
+    return scenes;
+}
+
+//------------------------------------------------------------------
+//
+// BenchmarkSpriteBatch
+//
+//------------------------------------------------------------------
+static const int kBenchmarkSpriteCount = 1500;
+
+bool BenchmarkSpriteBatch::init()
+{
+    if (!TestCase::init())
+        return false;
+
+    auto size = VisibleRect::getVisibleRect().size;
+    _sprites.reserve(kBenchmarkSpriteCount);
+    _origins.reserve(kBenchmarkSpriteCount);
+    for (int i = 0; i < kBenchmarkSpriteCount; ++i)
+    {
+        // every sprite samples the same atlas, the renderer can draw them in a few batches
+        int idx     = i % 14;
+        auto sprite = Sprite::create("Images/grossini_dance_atlas.png", Rect((idx % 5) * 85, (idx / 5) * 121, 85, 121));
+        sprite->setScale(0.3f);
+        _origins.push_back(Vec2((i * 37) % static_cast<int>(size.width), (i * 61) % static_cast<int>(size.height)));
+        _sprites.push_back(sprite);
+        addChild(sprite);
+    }
+
+    scheduleUpdate();
+    return true;
+}
+
+void BenchmarkSpriteBatch::update(float dt)
+{
+    _time += dt;
+    for (size_t i = 0; i < _sprites.size(); ++i)
+    {
+        float phase = _time * 2 + i * 0.1f;
+        _sprites[i]->setPosition(_origins[i] + Vec2(cosf(phase), sinf(phase)) * 20);
+        _sprites[i]->setRotation(phase * 30);
+    }
+}
+
+std::string BenchmarkSpriteBatch::subtitle() const
+{
+    return StringUtils::format("%d moving sprites sharing one texture", kBenchmarkSpriteCount);
+}
+
+//------------------------------------------------------------------
+//
+// BenchmarkParticles
+//
+//------------------------------------------------------------------
+bool BenchmarkParticles::init()
+{
+    if (!TestCase::init())
+        return false;
+
+    static const char* plists[] = {"Particles/Galaxy.plist", "Particles/SpookyPeas.plist", "Particles/Phoenix.plist",
+                                   "Particles/LavaFlow.plist"};
+    auto size = VisibleRect::getVisibleRect().size;
+    for (int i = 0; i < 4; ++i)
+    {
+        auto emitter = ParticleSystemQuad::create(plists[i]);
+        emitter->setPosition(VisibleRect::leftBottom() + Vec2(size.width * (i % 2 ? 0.75f : 0.25f),
+                                                              size.height * (i / 2 ? 0.7f : 0.3f)));
+        addChild(emitter);
+    }
+    return true;
+}
+
+std::string BenchmarkParticles::subtitle() const
+{
+    return "4 particle systems";
+}
+
+//------------------------------------------------------------------
+//
+// BenchmarkLabels
+//
+//------------------------------------------------------------------
+static const int kBenchmarkLabelCount = 40;
+
+bool BenchmarkLabels::init()
+{
+    if (!TestCase::init())
+        return false;
+
+    auto origin = VisibleRect::leftTop() + Vec2(10.0f, -40.0f);
+    for (int i = 0; i < kBenchmarkLabelCount; ++i)
+    {
+        // half the labels lay out TTF glyphs, the other half bitmap font glyphs
+        auto label = i % 2 ? Label::createWithBMFont("fonts/bitmapFontTest3.fnt", "0")
+                           : Label::createWithTTF("0", "fonts/arial.ttf", 12);
+        label->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+        label->setPosition(origin + Vec2((i % 4) * 115.0f, (i / 4) * -24.0f));
+        label->setScale(i % 2 ? 0.4f : 1.0f);
+        _labels.push_back(label);
+        addChild(label);
+    }
+
+    scheduleUpdate();
+    return true;
+}
+
+void BenchmarkLabels::update(float dt)
+{
+    ++_frame;
+    for (size_t i = 0; i < _labels.size(); ++i)
+        _labels[i]->setString(StringUtils::format("Frame %u", _frame * 7 + static_cast<unsigned int>(i)));
+}
+
+std::string BenchmarkLabels::subtitle() const
+{
+    return StringUtils::format("%d labels changing text every frame", kBenchmarkLabelCount);
+}
+
+//------------------------------------------------------------------
+//
+// BenchmarkTileMap
+//
+//------------------------------------------------------------------
+bool BenchmarkTileMap::init()
+{
+    if (!TestCase::init())
+        return false;
+
+    _map = FastTMXTiledMap::create("TileMaps/orthogonal-test2.tmx");
+    addChild(_map, -1);
+
+    scheduleUpdate();
+    return true;
+}
+
+void BenchmarkTileMap::update(float dt)
+{
+    _time += dt;
+
+    // pan back and forth over the whole map
+    auto range = _map->getContentSize() * _map->getScale() - VisibleRect::getVisibleRect().size;
+    float t    = 0.5f - 0.5f * cosf(_time * 0.5f);
+    _map->setPosition(VisibleRect::leftBottom() -
+                      Vec2(std::max(range.width, 0.0f) * t, std::max(range.height, 0.0f) * t));
+}
+
+std::string BenchmarkTileMap::subtitle() const
+{
+    return "Panning an orthogonal TMX map";
+}
+
+#if CC_USE_PHYSICS
+//------------------------------------------------------------------
+//
+// BenchmarkPhysics
+//
+//------------------------------------------------------------------
+bool BenchmarkPhysics::init()
+{
+    TestCase::init();
+    if (!initWithPhysics())
+        return false;
+
+    auto wall = Node::create();
+    wall->addComponent(PhysicsBody::createEdgeBox(VisibleRect::getVisibleRect().size));
+    wall->setPosition(VisibleRect::center());
+    addChild(wall);
+
+    // a pile of bodies dropped in a fixed pattern, the collisions keep the solver busy
+    auto left = VisibleRect::left().x + 40;
+    auto top  = VisibleRect::top().y - 20;
+    for (int i = 0; i < 200; ++i)
+    {
+        auto position = Vec2(left + (i % 20) * 20.0f + (i / 20 % 2) * 10.0f, top - (i / 20) * 22.0f);
+        if (i % 2)
+        {
+            auto ball = Sprite::create("Images/ball.png");
+            ball->setScale(0.6f);
+            ball->addComponent(PhysicsBody::createCircle(ball->getContentSize().width * 0.3f));
+            ball->setPosition(position);
+            addChild(ball);
+        }
+        else
+        {
+            auto box = Sprite::create("Images/YellowSquare.png");
+            box->setScale(0.25f);
+            box->addComponent(PhysicsBody::createBox(box->getContentSize() * 0.25f));
+            box->setPosition(position);
+            addChild(box);
+        }
+    }
+    return true;
+}
+
+std::string BenchmarkPhysics::subtitle() const
+{
+    return "200 bodies falling in a box";
+}
+#endif
+
+//------------------------------------------------------------------
+//
+// BenchmarkSkinning
+//
+//------------------------------------------------------------------
+bool BenchmarkSkinning::init()
+{
+    if (!TestCase::init())
+        return false;
+
+    auto animation = Animation3D::create("Sprite3DTest/orc.c3b");
+    auto size      = VisibleRect::getVisibleRect().size;
+    for (int i = 0; i < 12; ++i)
+    {
+        auto orc = Sprite3D::create("Sprite3DTest/orc.c3b");
+        orc->setScale(3);
+        orc->setRotation3D(Vec3(0.0f, 180.0f, 0.0f));
+        orc->setPosition(VisibleRect::leftBottom() +
+                         Vec2(size.width * ((i % 4) + 0.5f) / 4, size.height * ((i / 4) + 0.2f) / 3));
+        if (animation)
+            orc->runAction(RepeatForever::create(Animate3D::create(animation)));
+        addChild(orc);
+    }
+    return true;
+}
+
+std::string BenchmarkSkinning::subtitle() const
+{
+    return "12 skinned and animated meshes";
+}
+
+//------------------------------------------------------------------
+//
+// BenchmarkUIList
+//
+//------------------------------------------------------------------
+bool BenchmarkUIList::init()
+{
+    if (!TestCase::init())
+        return false;
+
+    auto size = VisibleRect::getVisibleRect().size;
+    _listView = ui::ListView::create();
+    _listView->setDirection(ui::ScrollView::Direction::VERTICAL);
+    _listView->setBackGroundImage("cocosui/green_edit.png");
+    _listView->setBackGroundImageScale9Enabled(true);
+    _listView->setContentSize(Size(size.width * 0.6f, size.height * 0.7f));
+    _listView->setPosition(VisibleRect::center() - Vec2(_listView->getContentSize() / 2.0f));
+    _listView->setItemsMargin(2.0f);
+    addChild(_listView);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        auto item = ui::Layout::create();
+        item->setContentSize(Size(_listView->getContentSize().width, 30.0f));
+
+        auto icon = ui::ImageView::create("cocosui/backtotoppressed.png");
+        icon->setScale(0.5f);
+        icon->setPosition(Vec2(20.0f, 15.0f));
+        item->addChild(icon);
+
+        auto text = ui::Text::create(StringUtils::format("List item %d", i), "fonts/arial.ttf", 14);
+        text->setAnchorPoint(Vec2::ANCHOR_MIDDLE_LEFT);
+        text->setPosition(Vec2(45.0f, 15.0f));
+        item->addChild(text);
+
+        _listView->pushBackCustomItem(item);
+    }
+
+    scheduleUpdate();
+    return true;
+}
+
+void BenchmarkUIList::update(float dt)
+{
+    _time += dt;
+    _listView->jumpToPercentVertical(50.0f - 50.0f * cosf(_time));
+}
+
+std::string BenchmarkUIList::subtitle() const
+{
+    return "Scrolling a list view of 100 items";
+}
+
+//------------------------------------------------------------------
+//
+// BenchmarkRunSuite
+//
+//------------------------------------------------------------------
+bool BenchmarkRunSuite::init()
+{
+    if (!TestCase::init())
+        return false;
+
+    MenuItemFont::setFontSize(18);
+    auto item = MenuItemFont::create("Run the suite", CC_CALLBACK_1(BenchmarkRunSuite::runSuite, this));
+    auto menu = Menu::create(item, nullptr);
+    menu->setPosition(VisibleRect::center() + Vec2(0.0f, 90.0f));
+    addChild(menu);
+
+    auto runner = BenchmarkRunner::getInstance();
+    std::string report;
+    for (const auto& result : runner->getResults())
+    {
+        report += StringUtils::format("%s: %.2f ms, %.0f draws, %.0f vertices, %.1f allocations\n",
+                                      result.name.c_str(), result.cpuTime.median, result.drawCalls.mean,
+                                      result.vertices.mean, result.allocations.mean);
+    }
+    for (const auto& regression : runner->getRegressions())
+    {
+        report += StringUtils::format("Regressed %s %s: %.2f -> %.2f\n", regression.scene.c_str(),
+                                      regression.metric.c_str(), regression.baseline, regression.current);
+    }
+
+    auto label = Label::createWithTTF(report, "fonts/arial.ttf", 10);
+    label->setPosition(VisibleRect::center() - Vec2(0.0f, 20.0f));
+    addChild(label);
+    return true;
+}
+
+void BenchmarkRunSuite::runSuite(Ref* sender)
+{
+    auto options         = BenchmarkRunner::getInstance()->getOptions();
+    options.exitWhenDone = false;
+    if (options.outputPath.empty())
+        options.outputPath = FileUtils::getInstance()->getWritablePath() + "benchmark.json";
+    options.onFinished = []() {
+        if (auto testSuite = TestController::getInstance()->getCurrTestSuite())
+            testSuite->restartCurrTest();
+    };
+
+    BenchmarkRunner::getInstance()->setOptions(options);
+    BenchmarkRunner::getInstance()->start();
+}
+
+std::string BenchmarkRunSuite::subtitle() const
+{
+    return "Median frame time, mean draw calls, vertices and allocations of the last run";
+}
@@ -0,0 +1,151 @@
+/****************************************************************************
+ Copyright (c) 2021 Bytedance Inc.
+
+ https://adxeproject.github.io/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef _BENCHMARK_TEST_H_
+#define _BENCHMARK_TEST_H_
+
+#include "../BaseTest.h"
+#include "ui/CocosGUI.h"
+
+DEFINE_TEST_SUITE(BenchmarkTests);
+
+struct BenchmarkScene
+{
+    std::string name;
+    std::function<cocos2d::Scene*()> create;
+};
+
+/**
+ * The scenes run by BenchmarkRunner, in order. The names key the results in the reports, changing a scene makes
+ * the stored baselines stale.
+ */
+const std::vector<BenchmarkScene>& getBenchmarkScenes();
+
+/** The benchmark scenes animate from the delta time only, so a fixed delta time replays the same frames. */
+class BenchmarkDemo : public TestCase
+{
+public:
+    virtual std::string title() const override { return "Benchmark"; }
+};
+
+class BenchmarkSpriteBatch : public BenchmarkDemo
+{
+public:
+    CREATE_FUNC(BenchmarkSpriteBatch);
+
+    virtual bool init() override;
+    virtual void update(float dt) override;
+    virtual std::string subtitle() const override;
+
+private:
+    std::vector<cocos2d::Sprite*> _sprites;
+    std::vector<cocos2d::Vec2> _origins;
+    float _time = 0;
+};
+
+class BenchmarkParticles : public BenchmarkDemo
+{
+public:
+    CREATE_FUNC(BenchmarkParticles);
+
+    virtual bool init() override;
+    virtual std::string subtitle() const override;
+};
+
+class BenchmarkLabels : public BenchmarkDemo
+{
+public:
+    CREATE_FUNC(BenchmarkLabels);
+
+    virtual bool init() override;
+    virtual void update(float dt) override;
+    virtual std::string subtitle() const override;
+
+private:
+    std::vector<cocos2d::Label*> _labels;
+    unsigned int _frame = 0;
+};
+
+class BenchmarkTileMap : public BenchmarkDemo
+{
+public:
+    CREATE_FUNC(BenchmarkTileMap);
+
+    virtual bool init() override;
+    virtual void update(float dt) override;
+    virtual std::string subtitle() const override;
+
+private:
+    cocos2d::FastTMXTiledMap* _map = nullptr;
+    float _time                    = 0;
+};
+
+#if CC_USE_PHYSICS
+class BenchmarkPhysics : public BenchmarkDemo
+{
+public:
+    CREATE_FUNC(BenchmarkPhysics);
+
+    virtual bool init() override;
+    virtual std::string subtitle() const override;
+};
+#endif
+
+class BenchmarkSkinning : public BenchmarkDemo
+{
+public:
+    CREATE_FUNC(BenchmarkSkinning);
+
+    virtual bool init() override;
+    virtual std::string subtitle() const override;
+};
+
+class BenchmarkUIList : public BenchmarkDemo
+{
+public:
+    CREATE_FUNC(BenchmarkUIList);
+
+    virtual bool init() override;
+    virtual void update(float dt) override;
+    virtual std::string subtitle() const override;
+
+private:
+    cocos2d::ui::ListView* _listView = nullptr;
+    float _time                      = 0;
+};
+
+/** Runs the whole suite in the window and shows the results of the last run. */
+class BenchmarkRunSuite : public BenchmarkDemo
+{
+public:
+    CREATE_FUNC(BenchmarkRunSuite);
+
+    virtual bool init() override;
+    virtual std::string subtitle() const override;
+
+private:
+    void runSuite(cocos2d::Ref* sender);
+};
+
+#endif /* _BENCHMARK_TEST_H_ */
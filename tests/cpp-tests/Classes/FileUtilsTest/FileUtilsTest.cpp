@@ -37,6 +37,7 @@ FileUtilsTests::FileUtilsTests()
     ADD_TEST_CASE(TestDirectoryFuncs);
     ADD_TEST_CASE(TestWriteString);
     ADD_TEST_CASE(TestGetContents);
+    ADD_TEST_CASE(TestGetMappedData);
     ADD_TEST_CASE(TestWriteData);
     ADD_TEST_CASE(TestWriteValueMap);
     ADD_TEST_CASE(TestWriteValueVector);
@@ -673,6 +674,65 @@ std::string TestGetContents::subtitle() const
     return "";
 }
 
+void TestGetMappedData::onEnter()
+{
+    FileUtilsDemo::onEnter();
+    auto fs = FileUtils::getInstance();
+
+    auto winSize = Director::getInstance()->getWinSize();
+
+    auto readResult = Label::createWithTTF("show readResult", "fonts/Thonburi.ttf", 16);
+    this->addChild(readResult);
+    readResult->setPosition(winSize.width / 2, winSize.height / 2);
+
+    auto runTests = [fs]() {
+        std::string files[] = {"background.wav", "fileLookup.plist"};
+        for (auto& file : files)
+        {
+            Data dbuf;
+            auto derr = fs->getContents(file, &dbuf);
+            if (derr != FileUtils::Status::OK)
+                return std::string("failed: error: " + FileErrors[(int)derr]);
+
+            // map every file, then read every file
+            for (auto threshold : {size_t(0), std::numeric_limits<size_t>::max()})
+            {
+                auto oldThreshold = fs->getMappedFileSizeThreshold();
+                fs->setMappedFileSizeThreshold(threshold);
+                auto mbuf = fs->getMappedDataFromFile(file);
+                fs->setMappedFileSizeThreshold(oldThreshold);
+
+                if (mbuf.getSize() != dbuf.getSize() || memcmp(mbuf.getBytes(), dbuf.getBytes(), dbuf.getSize()) != 0)
+                    return std::string("failed: error: mbuf != dbuf");
+
+                auto copy = mbuf;
+                ssize_t size;
+                auto buffer = mbuf.takeBuffer(&size);
+                bool same   = size == copy.getSize() && memcmp(buffer, copy.getBytes(), size) == 0;
+                free(buffer);
+                if (!same || !mbuf.isNull())
+                    return std::string("failed: error: takeBuffer");
+            }
+        }
+
+        if (!fs->getMappedDataFromFile("not-exists-file").isNull())
+            return std::string("failed: error: not-exists-file");
+
+        return std::string("read success");
+    };
+    readResult->setString("FileUtils::getMappedDataFromFile() " + runTests());
+}
+
+std::string TestGetMappedData::title() const
+{
+    return "FileUtils: TestGetMappedData";
+}
+
+std::string TestGetMappedData::subtitle() const
+{
+    return "";
+}
+
 void TestWriteData::onEnter()
 {
     FileUtilsDemo::onEnter();
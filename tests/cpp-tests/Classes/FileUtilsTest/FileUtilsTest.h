@@ -141,6 +141,16 @@ private:
     std::string _generatedFile;
 };
 
+class TestGetMappedData : public FileUtilsDemo
+{
+public:
+    CREATE_FUNC(TestGetMappedData);
+
+    virtual void onEnter() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
 class TestWriteData : public FileUtilsDemo
 {
 public:
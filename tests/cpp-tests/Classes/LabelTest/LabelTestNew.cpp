@@ -26,6 +26,7 @@
 #include "../testResource.h"
 #include "renderer/CCRenderer.h"
 #include "2d/CCFontAtlasCache.h"
+#include <chrono>
 
 USING_NS_CC;
 using namespace ui;
@@ -146,6 +147,8 @@ NewLabelTests::NewLabelTests()
     ADD_TEST_CASE(LabelIssueLineGap);
     ADD_TEST_CASE(LabelIssue17902);
     ADD_TEST_CASE(LabelLetterColorsTest);
+    ADD_TEST_CASE(LabelAsyncGlyphsTest);
+    ADD_TEST_CASE(LabelIncrementalLayoutTest);
 };
 
 LabelFNTColorAndOpacity::LabelFNTColorAndOpacity()
@@ -3656,3 +3659,218 @@ void LabelLetterColorsTest::setLetterColors(cocos2d::Label* label, const cocos2d
             letter->setColor(color);
     }
 }
+
+//
+// LabelAsyncGlyphsTest
+//
+LabelAsyncGlyphsTest::LabelAsyncGlyphsTest()
+{
+    auto center = VisibleRect::center();
+
+    // a size no other test uses, so the glyphs are new to the atlas
+    auto label = Label::createWithTTF("", "fonts/HKYuanMini.ttf", 27);
+    label->setPosition(center.x, center.y);
+    label->setWidth(VisibleRect::getVisibleRect().size.width * 0.8f);
+    addChild(label);
+
+    this->schedule(
+        [this, label](float) {
+            static const std::u32string text =
+                U"\u5929\u5730\u7384\u9ec4\u5b87\u5b99\u6d2a\u8352\u65e5\u6708\u76c8\u6603\u8fb0\u5bbf"
+                U"\u5217\u5f20\u5bd2\u6765\u6691\u5f80\u79cb\u6536\u51ac\u85cf\u95f0\u4f59\u6210\u5c81"
+                U"\u5f8b\u5415\u8c03\u9633\u4e91\u817e\u81f4\u96e8\u9732\u7ed3\u4e3a\u971c";
+            _length = _length % text.size() + 1;
+            std::string utf8;
+            StringUtils::UTF32ToUTF8(text.substr(0, _length), utf8);
+            label->setString(utf8);
+        },
+        0.1f, CC_REPEAT_FOREVER, 0, "append");
+}
+
+void LabelAsyncGlyphsTest::onEnter()
+{
+    AtlasDemoNew::onEnter();
+    _asyncGlyphRenderingEnabled = FontAtlas::isAsyncGlyphRenderingEnabled();
+    FontAtlas::setAsyncGlyphRenderingEnabled(true);
+}
+
+void LabelAsyncGlyphsTest::onExit()
+{
+    FontAtlas::setAsyncGlyphRenderingEnabled(_asyncGlyphRenderingEnabled);
+    AtlasDemoNew::onExit();
+}
+
+std::string LabelAsyncGlyphsTest::title() const
+{
+    return "Async glyph rendering";
+}
+
+std::string LabelAsyncGlyphsTest::subtitle() const
+{
+    return "New characters show up a frame later, without hitches";
+}
+
+//
+// LabelIncrementalLayoutTest
+//
+namespace
+{
+// exposes the result of a layout, to compare the incremental layout with a full one
+class LayoutProbeLabel : public Label
+{
+public:
+    static LayoutProbeLabel* create(std::string_view text, std::string_view fontFilePath, float fontSize)
+    {
+        auto ret = new LayoutProbeLabel();
+        if (ret->initWithTTF(text, fontFilePath, fontSize))
+        {
+            ret->autorelease();
+            return ret;
+        }
+        delete ret;
+        return nullptr;
+    }
+
+    struct Layout
+    {
+        Vec2 contentSize;
+        std::vector<Vec2> letterPositions;
+        std::vector<V3F_C4B_T2F_Quad> quads;
+    };
+
+    Layout getLayout()
+    {
+        updateContent();
+
+        Layout layout;
+        layout.contentSize = getContentSize();
+        // the letter infos past the string are left over from longer strings
+        auto letterCount = std::min(_lettersInfo.size(), static_cast<size_t>(_lengthOfString));
+        for (size_t i = 0; i < letterCount; ++i)
+        {
+            if (_lettersInfo[i].valid)
+                layout.letterPositions.emplace_back(_lettersInfo[i].positionX, _lettersInfo[i].positionY);
+        }
+        for (auto batchNode : _batchNodes)
+        {
+            auto textureAtlas = batchNode->getTextureAtlas();
+            layout.quads.insert(layout.quads.end(), textureAtlas->getQuads(),
+                                textureAtlas->getQuads() + textureAtlas->getTotalQuads());
+        }
+        return layout;
+    }
+
+    // the quads kept by the incremental layout are translated, allow for rounding
+    static bool isSameLayout(const Layout& a, const Layout& b)
+    {
+        const float epsilon = 0.01f;
+        if (!a.contentSize.fuzzyEquals(b.contentSize, epsilon) || a.letterPositions.size() != b.letterPositions.size() ||
+            a.quads.size() != b.quads.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < a.letterPositions.size(); ++i)
+        {
+            if (!a.letterPositions[i].fuzzyEquals(b.letterPositions[i], epsilon))
+                return false;
+        }
+        auto isSameVertex = [epsilon](const V3F_C4B_T2F& va, const V3F_C4B_T2F& vb) {
+            return std::abs(va.vertices.x - vb.vertices.x) < epsilon &&
+                   std::abs(va.vertices.y - vb.vertices.y) < epsilon && va.colors == vb.colors &&
+                   va.texCoords.u == vb.texCoords.u && va.texCoords.v == vb.texCoords.v;
+        };
+        for (size_t i = 0; i < a.quads.size(); ++i)
+        {
+            const auto& qa = a.quads[i];
+            const auto& qb = b.quads[i];
+            if (!isSameVertex(qa.bl, qb.bl) || !isSameVertex(qa.br, qb.br) || !isSameVertex(qa.tl, qb.tl) ||
+                !isSameVertex(qa.tr, qb.tr))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+}  // namespace
+
+LabelIncrementalLayoutTest::LabelIncrementalLayoutTest()
+{
+    auto visibleRect = VisibleRect::getVisibleRect();
+
+    std::string text;
+    while (text.size() < 10000)
+    {
+        text += StringUtils::format("%sLine %04d: the quick brown fox jumps over the lazy dog", text.empty() ? "" : "\n",
+                                    ++_lineCount);
+    }
+
+    // the label grows upwards, the newest lines stay at the bottom of the screen
+    _label = LayoutProbeLabel::create(text, "fonts/arial.ttf", 12);
+    _label->setAnchorPoint(Vec2::ANCHOR_BOTTOM_LEFT);
+    _label->setPosition(visibleRect.origin.x + 10, visibleRect.origin.y + 40);
+    _label->setWidth(visibleRect.size.width - 20);
+    _label->updateContent();
+    addChild(_label);
+
+    _timings = Label::createWithTTF("", "fonts/arial.ttf", 14);
+    _timings->setAnchorPoint(Vec2::ANCHOR_BOTTOM_LEFT);
+    _timings->setPosition(visibleRect.origin.x + 10, visibleRect.origin.y + 10);
+    _timings->setTextColor(Color4B::YELLOW);
+    addChild(_timings, 1);
+
+    schedule(CC_SCHEDULE_SELECTOR(LabelIncrementalLayoutTest::appendLine), 0.1f);
+}
+
+void LabelIncrementalLayoutTest::appendLine(float /*dt*/)
+{
+    using clock = std::chrono::steady_clock;
+
+    auto label = static_cast<LayoutProbeLabel*>(_label);
+    auto line  = StringUtils::format("\nLine %04d: the quick brown fox jumps over the lazy dog", ++_lineCount);
+    auto start = clock::now();
+    label->appendString(line);
+    label->updateContent();
+    auto appended = clock::now();
+
+    // more edits taking the incremental path: a word of an older line changes length, and setString extends the text
+    std::string text{label->getString()};
+    auto wordIndex = text.find("quick", static_cast<size_t>(text.size() * CCRANDOM_0_1()));
+    if (wordIndex != std::string::npos)
+        label->replaceString(static_cast<int>(wordIndex), 5, _lineCount % 2 ? "QUICK" : "quick and");
+    text = label->getString();
+    label->setString(text + ".");
+    auto incremental = label->getLayout();
+
+    // the same text laid out from scratch
+    text         = label->getString();
+    auto rebuild = clock::now();
+    label->setString("");
+    label->setString(text);
+    label->updateContent();
+    auto rebuilt = clock::now();
+
+    if (!LayoutProbeLabel::isSameLayout(incremental, label->getLayout()))
+    {
+        ++_mismatches;
+        log("LabelIncrementalLayoutTest: the incremental layout of line %d differs from the full layout", _lineCount);
+    }
+
+    _incrementalTime += std::chrono::duration<double, std::milli>(appended - start).count();
+    _fullTime += std::chrono::duration<double, std::milli>(rebuilt - rebuild).count();
+    ++_samples;
+
+    _timings->setString(StringUtils::format("%d letters, append: %.3f ms, full layout: %.3f ms, %d mismatches",
+                                            _label->getStringLength(), _incrementalTime / _samples,
+                                            _fullTime / _samples, _mismatches));
+}
+
+std::string LabelIncrementalLayoutTest::title() const
+{
+    return "Incremental layout";
+}
+
+std::string LabelIncrementalLayoutTest::subtitle() const
+{
+    return "Appending a line to a 10k letter label, checked against a full layout";
+}
@@ -1030,4 +1030,44 @@ private:
     static void setLetterColors(cocos2d::Label* label, const cocos2d::Color3B& color);
 };
 
+class LabelAsyncGlyphsTest : public AtlasDemoNew
+{
+public:
+    CREATE_FUNC(LabelAsyncGlyphsTest);
+
+    LabelAsyncGlyphsTest();
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+protected:
+    bool _asyncGlyphRenderingEnabled = false;
+    size_t _length                   = 0;
+};
+
+class LabelIncrementalLayoutTest : public AtlasDemoNew
+{
+public:
+    CREATE_FUNC(LabelIncrementalLayoutTest);
+
+    LabelIncrementalLayoutTest();
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+protected:
+    void appendLine(float dt);
+
+    cocos2d::Label* _label   = nullptr;
+    cocos2d::Label* _timings = nullptr;
+    int _lineCount           = 0;
+    int _samples             = 0;
+    int _mismatches          = 0;
+    double _incrementalTime  = 0.0;
+    double _fullTime         = 0.0;
+};
+
 #endif
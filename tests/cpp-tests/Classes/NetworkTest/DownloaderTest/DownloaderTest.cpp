@@ -342,8 +342,72 @@ struct DownloaderMultiTask : public TestCase
     }
 };
 
+struct DownloaderChunkedTask : public TestCase
+{
+    CREATE_FUNC(DownloaderChunkedTask);
+
+    virtual std::string title() const override { return "Downloader Chunked Task"; }
+    virtual std::string subtitle() const override
+    {
+        return "big file in parallel range chunks, cancel and start again to resume";
+    }
+
+    std::unique_ptr<network::Downloader> downloader;
+    std::shared_ptr<network::DownloadTask> task;
+    Label* status = nullptr;
+
+    DownloaderChunkedTask()
+    {
+        // 512KB chunks, 8 range requests at the same time
+        network::DownloaderHints hints = {6, 45, ".tmp", 1024 * 1024, 512 * 1024, 8};
+        downloader.reset(new network::Downloader(hints));
+    }
+
+    virtual void onEnter() override
+    {
+        TestCase::onEnter();
+
+        status = Label::createWithTTF("", "fonts/arial.ttf", 16);
+        status->setPosition(VisibleRect::center());
+        this->addChild(status);
+
+        auto start = MenuItemFont::create("Start", [this](Ref*) {
+            if (task)
+                return;
+            auto path = FileUtils::getInstance()->getWritablePath() + "CppTests/DownloaderTest/chunked.bin";
+            task      = downloader->createDownloadFileTask(sURLList[3], path, sNameList[3]);
+        });
+        auto cancel = MenuItemFont::create("Cancel", [this](Ref*) {
+            if (task)
+                task->cancel();
+        });
+        auto menu = Menu::create(start, cancel, nullptr);
+        menu->alignItemsHorizontallyWithPadding(40);
+        menu->setPosition(VisibleRect::bottom() + Vec2(0, 60));
+        this->addChild(menu);
+
+        downloader->onTaskProgress = [this](const network::DownloadTask& task) {
+            float percent = float(task.progressInfo.totalBytesReceived * 100) / task.progressInfo.totalBytesExpected;
+            status->setString(StringUtils::format("%.1f%% of %d KB, %d KB/s", percent,
+                                                  int(task.progressInfo.totalBytesExpected / 1024),
+                                                  int(task.progressInfo.speedInBytes / 1024)));
+        };
+        downloader->onFileTaskSuccess = [this](const network::DownloadTask& task) {
+            status->setString(StringUtils::format("Download [%s] success.", task.identifier.c_str()));
+            this->task.reset();
+        };
+        downloader->onTaskError = [this](const network::DownloadTask& task, int errorCode, int errorCodeInternal,
+                                         std::string_view errorStr) {
+            status->setString(StringUtils::format("Stopped (%d, %d), start again to resume.", errorCode,
+                                                  errorCodeInternal));
+            this->task.reset();
+        };
+    }
+};
+
 DownloaderTests::DownloaderTests()
 {
     ADD_TEST_CASE(DownloaderTest);
     ADD_TEST_CASE(DownloaderMultiTask);
+    ADD_TEST_CASE(DownloaderChunkedTask);
 };
@@ -25,6 +25,9 @@
 
 #include "HttpClientTest.h"
 #include <string>
+#include <unordered_map>
+#include "yasio/yasio.hpp"
+#include "llhttp.h"
 
 USING_NS_CC;
 using namespace cocos2d::network;
@@ -37,6 +40,7 @@ HttpClientTests::HttpClientTests()
 {
     ADD_TEST_CASE(HttpClientTest);
     ADD_TEST_CASE(HttpClientClearRequestsTest);
+    ADD_TEST_CASE(HttpClientKeepAliveTest);
 }
 
 HttpClientTest::HttpClientTest() : _labelStatusCode(nullptr)
@@ -477,3 +481,122 @@ void HttpClientClearRequestsTest::onHttpRequestCompleted(HttpClient* sender, Htt
         // log("error buffer: %s", response->getErrorBuffer());
     }
 }
+
+namespace
+{
+const u_short KEEP_ALIVE_TEST_PORT = 28080;
+const int KEEP_ALIVE_TEST_REQUESTS = 20;
+
+// parses the requests of one connection to the stub server
+struct StubConnection
+{
+    llhttp_t parser;
+    llhttp_settings_t settings;
+    int completedRequests = 0;
+
+    StubConnection()
+    {
+        llhttp_settings_init(&settings);
+        settings.on_message_complete = [](llhttp_t* context) {
+            ++static_cast<StubConnection*>(context->data)->completedRequests;
+            return 0;
+        };
+        llhttp_init(&parser, HTTP_REQUEST, &settings);
+        parser.data = this;
+    }
+};
+}  // namespace
+
+HttpClientKeepAliveTest::HttpClientKeepAliveTest()
+    : _server(nullptr), _acceptedConnections(0), _responseCount(0), _streamedBytes(0), _labelResult(nullptr)
+{
+    auto winSize = Director::getInstance()->getWinSize();
+
+    _labelResult = Label::createWithTTF("waiting...", "fonts/arial.ttf", 18);
+    _labelResult->setPosition(winSize.width / 2, winSize.height / 2);
+    addChild(_labelResult);
+
+    auto connections = std::make_shared<std::unordered_map<yasio::transport_handle_t, StubConnection>>();
+    _server          = new yasio::io_service(yasio::io_hostent{"127.0.0.1", KEEP_ALIVE_TEST_PORT});
+    _server->set_option(yasio::YOPT_S_DEFERRED_EVENT, 0);
+    _server->start([this, connections](yasio::event_ptr&& event) {
+        auto transport = event->transport();
+        switch (event->kind())
+        {
+        case yasio::YEK_ON_OPEN:
+            if (event->status() == 0)
+            {
+                ++_acceptedConnections;
+                (*connections)[transport];
+            }
+            break;
+        case yasio::YEK_ON_PACKET:
+        {
+            auto& connection = (*connections)[transport];
+            auto& packet     = event->packet();
+            int before       = connection.completedRequests;
+            llhttp_execute(&connection.parser, packet.data(), packet.size());
+            for (int i = before; i < connection.completedRequests; ++i)
+            {
+                std::string body = "response " + std::to_string(i);
+                std::string reply =
+                    "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: " + std::to_string(body.size()) +
+                    "\r\n\r\n" + body;
+                _server->write(transport, yasio::sbyte_buffer{reply.begin(), reply.end()});
+            }
+            break;
+        }
+        case yasio::YEK_ON_CLOSE:
+            connections->erase(transport);
+            break;
+        }
+    });
+    _server->open(0, yasio::YCK_TCP_SERVER);
+
+    sendNextRequest();
+}
+
+HttpClientKeepAliveTest::~HttpClientKeepAliveTest()
+{
+    HttpClient::destroyInstance();
+    delete _server;
+}
+
+void HttpClientKeepAliveTest::onExit()
+{
+    HttpClient::getInstance()->clearResponseQueue();
+    TestCase::onExit();
+}
+
+void HttpClientKeepAliveTest::sendNextRequest()
+{
+    HttpRequest* request = new HttpRequest();
+    request->setUrl(StringUtils::format("http://127.0.0.1:%u/config?id=%d", KEEP_ALIVE_TEST_PORT, _responseCount));
+    request->setRequestType(HttpRequest::Type::GET);
+    // half of the responses are streamed to a callback instead of being accumulated
+    if (_responseCount % 2)
+    {
+        request->setResponseDataCallback(
+            [this](HttpResponse* response, const char* data, size_t len) { _streamedBytes += len; });
+    }
+    request->setResponseCallback([this](HttpClient* client, HttpResponse* response) {
+        if (!response->isSucceed())
+        {
+            _labelResult->setString(
+                StringUtils::format("request %d failed, internal code: %d", _responseCount, response->getInternalCode()));
+            return;
+        }
+
+        ++_responseCount;
+        _labelResult->setString(StringUtils::format(
+            "responses: %d, streamed bytes: %u\nconnections accepted by the server: %d\nconnections opened: %u, "
+            "reused: %u",
+            _responseCount, (unsigned int)_streamedBytes, _acceptedConnections.load(),
+            client->getOpenedConnectionCount(), client->getReusedConnectionCount()));
+
+        if (_responseCount < KEEP_ALIVE_TEST_REQUESTS)
+            sendNextRequest();
+    });
+    HttpClient::getInstance()->send(request);
+    request->release();
+}
@@ -29,6 +29,7 @@
 #include "extensions/cocos-ext.h"
 #include "network/HttpClient.h"
 #include "BaseTest.h"
+#include <atomic>
 
 DEFINE_TEST_SUITE(HttpClientTests);
 
@@ -80,4 +81,28 @@ private:
     cocos2d::Label* _labelStatusCode;
 };
 
+// Sends requests to a local llhttp based server which keeps the connections alive
+class HttpClientKeepAliveTest : public TestCase
+{
+public:
+    CREATE_FUNC(HttpClientKeepAliveTest);
+
+    HttpClientKeepAliveTest();
+    virtual ~HttpClientKeepAliveTest();
+
+    virtual void onExit() override;
+
+    void sendNextRequest();
+
+    virtual std::string title() const override { return "Http Keep-Alive Test"; }
+    virtual std::string subtitle() const override { return "Requests to the same host share one connection"; }
+
+private:
+    yasio::io_service* _server;
+    std::atomic<int> _acceptedConnections;
+    int _responseCount;
+    size_t _streamedBytes;
+    cocos2d::Label* _labelResult;
+};
+
 #endif  //__HTTPREQUESTHTTP_H
@@ -27,6 +27,7 @@
 #include "platform/CCPlatformConfig.h"
 #include "NewAudioEngineTest.h"
 #include "ui/CocosGUI.h"
+#include "audio/AudioStreamService.h"
 
 using namespace cocos2d;
 using namespace cocos2d::ui;
@@ -41,6 +42,8 @@ AudioEngineTests::AudioEngineTests()
     ADD_TEST_CASE(InvalidAudioFileTest);
     ADD_TEST_CASE(LargeAudioFileTest);
     ADD_TEST_CASE(AudioPerformanceTest);
+    ADD_TEST_CASE(AudioStreamingStatsTest);
+    ADD_TEST_CASE(AudioCacheBudgetTest);
     ADD_TEST_CASE(AudioSmallFileTest);
     ADD_TEST_CASE(AudioSmallFile2Test);
     ADD_TEST_CASE(AudioSmallFile3Test);
@@ -936,6 +939,156 @@ std::string AudioPerformanceTest::subtitle() const
     return "Please see console for the result";
 }
 
+/////////////////////////////////////////////////////////////////////////
+bool AudioStreamingStatsTest::init()
+{
+    if (AudioEngineTestDemo::init())
+    {
+        auto& layerSize = this->getContentSize();
+
+        auto playItem = TextButton::create("play 4 streams", [this](TextButton* button) {
+            AudioStreamService::getInstance()->resetStats();
+            for (int i = 0; i < 4; ++i)
+            {
+                _audioIDs.push_back(AudioEngine::play2d("audio/LuckyDay.mp3", true, 0.25f));
+            }
+        });
+        playItem->setPosition(layerSize.width * 0.3f, layerSize.height * 0.7f);
+        addChild(playItem);
+
+        auto stopItem = TextButton::create("stop all", [this](TextButton* button) {
+            for (auto id : _audioIDs)
+            {
+                AudioEngine::stop(id);
+            }
+            _audioIDs.clear();
+        });
+        stopItem->setPosition(layerSize.width * 0.7f, layerSize.height * 0.7f);
+        addChild(stopItem);
+
+        auto statsLabel = Label::createWithTTF("", "fonts/arial.ttf", 18);
+        statsLabel->setPosition(layerSize.width * 0.5f, layerSize.height * 0.4f);
+        addChild(statsLabel);
+
+        schedule(
+            [statsLabel](float dt) {
+                auto stats = AudioStreamService::getInstance()->getStats();
+                char text[256];
+                snprintf(text, sizeof(text),
+                         "streams: %u  wakeups: %llu\nbuffers: %llu  underruns: %llu\ndecode avg: %lluus  max: %lluus",
+                         stats.streams, (unsigned long long)stats.wakeups, (unsigned long long)stats.buffersQueued,
+                         (unsigned long long)stats.underruns,
+                         (unsigned long long)(stats.buffersQueued ? stats.decodeTimeTotal / stats.buffersQueued : 0),
+                         (unsigned long long)stats.decodeTimeMax);
+                statsLabel->setString(text);
+            },
+            0.5f, "stats");
+
+        return true;
+    }
+
+    return false;
+}
+
+void AudioStreamingStatsTest::onExit()
+{
+    for (auto id : _audioIDs)
+    {
+        AudioEngine::stop(id);
+    }
+    _audioIDs.clear();
+
+    AudioEngineTestDemo::onExit();
+}
+
+std::string AudioStreamingStatsTest::title() const
+{
+    return "Streaming service stats";
+}
+
+std::string AudioStreamingStatsTest::subtitle() const
+{
+    return "All the streams are refilled by one thread";
+}
+
+/////////////////////////////////////////////////////////////////////////
+bool AudioCacheBudgetTest::init()
+{
+    if (AudioEngineTestDemo::init())
+    {
+        AudioEngine::uncacheAll();
+        AudioEngine::resetCacheStats();
+        // effects decoding to more than 64KB are kept compressed, all the caches stay under 256KB
+        AudioEngine::setPcmCacheMaxSize(64 * 1024);
+        AudioEngine::setCompressedCacheMaxSize(1024 * 1024);
+        AudioEngine::setCacheBudget(256 * 1024);
+
+        std::vector<std::string> audioFiles = {
+            "audio/SoundEffectsFX009/FX081.mp3", "audio/SoundEffectsFX009/FX082.mp3",
+            "audio/SoundEffectsFX009/FX083.mp3", "audio/SoundEffectsFX009/FX084.mp3",
+            "audio/SoundEffectsFX009/FX085.mp3", "audio/SoundEffectsFX009/FX086.mp3",
+            "audio/SoundEffectsFX009/FX087.mp3", "audio/SoundEffectsFX009/FX088.mp3",
+            "audio/SoundEffectsFX009/FX089.mp3", "audio/SoundEffectsFX009/FX090.mp3"};
+
+        auto& layerSize = this->getContentSize();
+
+        auto playItem = TextButton::create("play random effects", [this, audioFiles](TextButton* button) {
+            unschedule("play");
+            schedule(
+                [audioFiles](float dt) {
+                    int index = cocos2d::random(0, (int)(audioFiles.size() - 1));
+                    AudioEngine::play2d(audioFiles[index]);
+                },
+                0.25f, "play");
+        });
+        playItem->setPosition(layerSize.width * 0.5f, layerSize.height * 0.7f);
+        addChild(playItem);
+
+        auto statsLabel = Label::createWithTTF("", "fonts/arial.ttf", 18);
+        statsLabel->setPosition(layerSize.width * 0.5f, layerSize.height * 0.4f);
+        addChild(statsLabel);
+
+        schedule(
+            [statsLabel](float dt) {
+                auto stats = AudioEngine::getCacheStats();
+                char text[256];
+                snprintf(text, sizeof(text),
+                         "caches: %u (%u compressed)  memory: %uKB / %uKB\nhits: %llu  misses: %llu  evictions: %llu",
+                         stats.cacheCount, stats.compressedCount, (unsigned int)(stats.memoryUsed / 1024),
+                         (unsigned int)(AudioEngine::getCacheBudget() / 1024), (unsigned long long)stats.hits,
+                         (unsigned long long)stats.misses, (unsigned long long)stats.evictions);
+                statsLabel->setString(text);
+            },
+            0.5f, "stats");
+
+        return true;
+    }
+
+    return false;
+}
+
+void AudioCacheBudgetTest::onExit()
+{
+    unschedule("play");
+    AudioEngine::stopAll();
+    AudioEngine::setCacheBudget(0);
+    AudioEngine::setPcmCacheMaxSize(PCMDATA_CACHEMAXSIZE);
+    AudioEngine::setCompressedCacheMaxSize(0);
+    AudioEngine::uncacheAll();
+
+    AudioEngineTestDemo::onExit();
+}
+
+std::string AudioCacheBudgetTest::title() const
+{
+    return "Audio cache budget";
+}
+
+std::string AudioCacheBudgetTest::subtitle() const
+{
+    return "Least recently used effects are uncached above 256KB";
+}
+
 /////////////////////////////////////////////////////////////////////////
 
 void AudioSwitchStateTest::onEnter()
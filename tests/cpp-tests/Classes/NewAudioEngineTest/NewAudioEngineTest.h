@@ -218,6 +218,33 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class AudioStreamingStatsTest : public AudioEngineTestDemo
+{
+public:
+    CREATE_FUNC(AudioStreamingStatsTest);
+
+    virtual bool init() override;
+    virtual void onExit() override;
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    std::vector<int> _audioIDs;
+};
+
+class AudioCacheBudgetTest : public AudioEngineTestDemo
+{
+public:
+    CREATE_FUNC(AudioCacheBudgetTest);
+
+    virtual bool init() override;
+    virtual void onExit() override;
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
 class AudioSwitchStateTest : public AudioEngineTestDemo
 {
 public:
@@ -28,13 +28,17 @@
 #include <chrono>
 #include <sstream>
 #include "renderer/backend/Device.h"
+#ifndef CC_USE_METAL
+#    include "renderer/backend/opengl/StateCacheGL.h"
+#endif
 
 namespace
 {
 enum CustomProgramType : uint32_t
 {
-    BLUR  = 1,
-    SEPIA = 2,
+    BLUR          = 1,
+    SEPIA         = 2,
+    UNIFORM_BLOCK = 3,
 };
 }
 
@@ -80,6 +84,10 @@ NewRendererTests::NewRendererTests()
     programCache->registerCustomProgramFactory(
         CustomProgramType::SEPIA, positionTextureColor_vert,
         FileUtils::getInstance()->getStringFromFile("Shaders/example_Sepia.fsh"));
+    programCache->registerCustomProgramFactory(
+        CustomProgramType::UNIFORM_BLOCK,
+        FileUtils::getInstance()->getStringFromFile("Shaders/example_UniformBlock.vsh"),
+        FileUtils::getInstance()->getStringFromFile("Shaders/example_UniformBlock.fsh"));
 
     ADD_TEST_CASE(NewSpriteTest);
     ADD_TEST_CASE(GroupCommandTest);
@@ -95,6 +103,10 @@ NewRendererTests::NewRendererTests()
     ADD_TEST_CASE(RendererUniformBatch2);
     ADD_TEST_CASE(SpriteCreation);
     ADD_TEST_CASE(NonBatchSprites);
+    ADD_TEST_CASE(ParallelRecordingTest);
+    ADD_TEST_CASE(GLStateCacheTest);
+    ADD_TEST_CASE(UniformBlockTest);
+    ADD_TEST_CASE(VertexStreamingTest);
 };
 
 std::string MultiSceneTest::title() const
@@ -1074,3 +1086,309 @@ std::string NonBatchSprites::subtitle() const
     return "RELEASE: simulate lots of sprites, drop to 30 fps";
 #endif
 }
+
+//
+// ParallelRecordingTest
+//
+
+ParallelRecordingTest::ParallelRecordingTest()
+{
+    Size s = Director::getInstance()->getWinSize();
+
+    // 20000 rotating sprites split into 64 independent subtrees
+    auto root = Node::create();
+    root->setParallelRoot(true);
+    addChild(root);
+
+    const int groupCount      = 64;
+    const int spritesPerGroup = 20000 / groupCount;
+    for (int g = 0; g < groupCount; ++g)
+    {
+        auto group = Node::create();
+        group->setPosition(Vec2(CCRANDOM_0_1() * s.width, CCRANDOM_0_1() * s.height));
+        group->runAction(RepeatForever::create(RotateBy::create(4, 360)));
+        root->addChild(group);
+
+        for (int i = 0; i < spritesPerGroup; ++i)
+        {
+            auto sprite = Sprite::create("Images/grossini_dance_01.png");
+            sprite->setScale(0.1f);
+            sprite->setPosition(Vec2(CCRANDOM_MINUS1_1() * 100, CCRANDOM_MINUS1_1() * 100));
+            group->addChild(sprite);
+        }
+    }
+
+    MenuItemFont::setFontName("fonts/arial.ttf");
+    MenuItemFont::setFontSize(24);
+    Vector<MenuItem*> items;
+    for (int threadCount : {-1, 1, 2, 4, 0})
+    {
+        std::string text = StringUtils::format("%d threads", threadCount);
+        if (threadCount < 0)
+            text = "Serial";
+        else if (threadCount == 0)
+            text = "All cores";
+        items.pushBack(MenuItemFont::create(text, [this, threadCount](Ref*) { setRecordingThreads(threadCount); }));
+    }
+    auto menu = Menu::createWithArray(items);
+    menu->alignItemsHorizontallyWithPadding(20);
+    menu->setPosition(Vec2(s.width / 2, s.height - 90));
+    addChild(menu, 1);
+
+    _timeLabel = Label::createWithTTF(TTFConfig("fonts/arial.ttf", 20), "visit: -");
+    _timeLabel->setPosition(Vec2(s.width / 2, s.height - 120));
+    addChild(_timeLabel, 1);
+
+    setRecordingThreads(-1);
+}
+
+void ParallelRecordingTest::setRecordingThreads(int threadCount)
+{
+    auto renderer = Director::getInstance()->getRenderer();
+    renderer->setParallelRecordingEnabled(threadCount >= 0);
+    if (threadCount >= 0)
+        renderer->setRecordingThreadCount(threadCount);
+
+    _threadCount   = threadCount;
+    _frames        = 0;
+    _visitDuration = 0;
+}
+
+void ParallelRecordingTest::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags)
+{
+    auto start = std::chrono::steady_clock::now();
+    MultiSceneTest::visit(renderer, parentTransform, parentFlags);
+    _visitDuration +=
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    if (++_frames == 60)
+    {
+        auto threads = _threadCount < 0 ? 0 : renderer->getRecordingThreadCount();
+        _timeLabel->setString(StringUtils::format("%s: visit %.2f ms/frame, %u worker threads",
+                                                  _threadCount < 0 ? "Serial" : "Parallel", _visitDuration / 60000.0,
+                                                  threads));
+        _frames        = 0;
+        _visitDuration = 0;
+    }
+}
+
+void ParallelRecordingTest::onExit()
+{
+    auto renderer = Director::getInstance()->getRenderer();
+    renderer->setParallelRecordingEnabled(false);
+    renderer->setRecordingThreadCount(0);
+
+    MultiSceneTest::onExit();
+}
+
+std::string ParallelRecordingTest::title() const
+{
+    return "Parallel Recording";
+}
+
+std::string ParallelRecordingTest::subtitle() const
+{
+    return "20000 sprites in 64 subtrees, compare visit time with thread count";
+}
+
+//
+// GLStateCacheTest
+//
+
+GLStateCacheTest::GLStateCacheTest()
+{
+    Size s = Director::getInstance()->getWinSize();
+
+    // alternate textures and blend modes so that every sprite breaks the batch and issues its own draw
+    const char* images[] = {"Images/grossini_dance_01.png", "Images/grossini_dance_02.png"};
+    for (int i = 0; i < 200; ++i)
+    {
+        auto sprite = Sprite::create(images[i % 2]);
+        sprite->setScale(0.5f);
+        sprite->setPosition(Vec2(CCRANDOM_0_1() * s.width, CCRANDOM_0_1() * s.height));
+        if (i % 3 == 0)
+            sprite->setBlendFunc(BlendFunc::ADDITIVE);
+        sprite->runAction(RepeatForever::create(RotateBy::create(2, 360)));
+        addChild(sprite);
+    }
+
+    _statsLabel = Label::createWithTTF(TTFConfig("fonts/arial.ttf", 16), "");
+    _statsLabel->setPosition(Vec2(s.width / 2, s.height - 90));
+    addChild(_statsLabel, 1);
+
+    scheduleUpdate();
+}
+
+void GLStateCacheTest::update(float dt)
+{
+#ifndef CC_USE_METAL
+    // the counters hold the previous frame, the scene hasn't been drawn yet in this one
+    const auto& stats = backend::StateCacheGL::getStats();
+    _statsLabel->setString(StringUtils::format("state calls: %u issued, %u skipped\nuniforms: %u issued, %u skipped",
+                                               stats.issuedCalls, stats.skippedCalls, stats.issuedUniforms,
+                                               stats.skippedUniforms));
+    backend::StateCacheGL::resetStats();
+#else
+    _statsLabel->setString("The state cache is only used by the OpenGL backend");
+#endif
+}
+
+std::string GLStateCacheTest::title() const
+{
+    return "GL State Cache";
+}
+
+std::string GLStateCacheTest::subtitle() const
+{
+    return "200 unbatched sprites, redundant GL calls dropped per frame";
+}
+
+//
+// UniformBlockTest
+//
+
+UniformBlockTest::UniformBlockTest()
+{
+    Size s = Director::getInstance()->getWinSize();
+
+    auto deviceInfo = backend::Device::getInstance()->getDeviceInfo();
+    if (!deviceInfo->checkForFeatureSupported(backend::FeatureType::UNIFORM_BUFFER))
+    {
+        auto label = Label::createWithTTF(TTFConfig("fonts/arial.ttf", 20), "Uniform buffers aren't supported");
+        label->setPosition(Vec2(s.width / 2, s.height / 2));
+        addChild(label);
+        return;
+    }
+
+    // one ProgramState per row, each one uploads its MaterialBlock once
+    auto program = backend::ProgramCache::getInstance()->getCustomProgram(CustomProgramType::UNIFORM_BLOCK);
+
+    const Vec4 tints[]    = {Vec4(1, 0.5f, 0.5f, 1), Vec4(0.5f, 1, 0.5f, 1), Vec4(0.5f, 0.5f, 1, 1), Vec4(1, 1, 1, 1)};
+    const int rowCount    = 4;
+    const int spriteCount = 10;
+    for (int y = 0; y < rowCount; ++y)
+    {
+        auto programState = new backend::ProgramState(program);
+        programState->setUniform(programState->getUniformLocation("u_tint"), &tints[y], sizeof(tints[y]));
+        for (int x = 0; x < spriteCount; ++x)
+        {
+            auto sprite = Sprite::create("Images/grossini.png");
+            sprite->setScale(0.4f);
+            sprite->setPosition(Vec2((x + 0.5f) * s.width / spriteCount, (y + 1) * s.height / (rowCount + 2)));
+            sprite->setProgramState(programState);
+            addChild(sprite);
+        }
+        programState->release();
+    }
+
+    scheduleUpdate();
+}
+
+void UniformBlockTest::update(float dt)
+{
+    _time += dt;
+    Vec4 time(_time, 0, 0, 0);
+    backend::ProgramState::setSharedUniformBlock("FrameBlock", &time, sizeof(time));
+}
+
+std::string UniformBlockTest::title() const
+{
+    return "Uniform Blocks";
+}
+
+std::string UniformBlockTest::subtitle() const
+{
+    return "FrameBlock shared by all the sprites, MaterialBlock per row";
+}
+
+//
+// VertexStreamingTest
+//
+
+VertexStreamingTest::VertexStreamingTest()
+{
+    Size s = Director::getInstance()->getWinSize();
+
+    // 20000 sprites sharing a texture, the batches only break when a buffer fills up
+    auto root = Node::create();
+    root->setPosition(Vec2(s.width / 2, s.height / 2));
+    root->runAction(RepeatForever::create(RotateBy::create(8, 360)));
+    addChild(root);
+    for (int i = 0; i < 20000; ++i)
+    {
+        auto sprite = Sprite::create("Images/grossini_dance_01.png");
+        sprite->setScale(0.1f);
+        sprite->setPosition(Vec2(CCRANDOM_MINUS1_1() * s.width / 2, CCRANDOM_MINUS1_1() * s.height / 2));
+        root->addChild(sprite);
+    }
+
+    MenuItemFont::setFontName("fonts/arial.ttf");
+    MenuItemFont::setFontSize(24);
+    auto copyItem   = MenuItemFont::create("Copy", [this](Ref*) { setStreamingEnabled(false); });
+    auto streamItem = MenuItemFont::create("Streaming", [this](Ref*) { setStreamingEnabled(true); });
+    auto menu       = Menu::create(copyItem, streamItem, nullptr);
+    menu->alignItemsHorizontallyWithPadding(20);
+    menu->setPosition(Vec2(s.width / 2, s.height - 90));
+    addChild(menu, 1);
+
+    _timeLabel = Label::createWithTTF(TTFConfig("fonts/arial.ttf", 20), "draw: -");
+    _timeLabel->setPosition(Vec2(s.width / 2, s.height - 120));
+    addChild(_timeLabel, 1);
+}
+
+void VertexStreamingTest::onEnter()
+{
+    MultiSceneTest::onEnter();
+
+    // visit and render are both timed, streaming moves the vertex transform from render into visit
+    auto dispatcher     = Director::getInstance()->getEventDispatcher();
+    _beforeDrawListener = dispatcher->addCustomEventListener(
+        Director::EVENT_BEFORE_DRAW, [this](EventCustom*) { _drawStart = std::chrono::steady_clock::now(); });
+    _afterDrawListener = dispatcher->addCustomEventListener(Director::EVENT_AFTER_DRAW, [this](EventCustom*) {
+        _drawDuration +=
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _drawStart)
+                .count();
+        if (++_frames == 60)
+        {
+            auto renderer = Director::getInstance()->getRenderer();
+            _timeLabel->setString(StringUtils::format("%s: visit + render %.2f ms/frame, %d batches",
+                                                      renderer->isVertexStreamingEnabled() ? "Streaming" : "Copy",
+                                                      _drawDuration / 60000.0, (int)renderer->getDrawnBatches()));
+            _frames       = 0;
+            _drawDuration = 0;
+        }
+    });
+
+    setStreamingEnabled(false);
+}
+
+void VertexStreamingTest::setStreamingEnabled(bool enabled)
+{
+    auto renderer = Director::getInstance()->getRenderer();
+    renderer->setVertexStreamingEnabled(enabled);
+    if (enabled && !renderer->isVertexStreamingEnabled())
+        _timeLabel->setString("Vertex streaming isn't supported by this device");
+
+    _frames       = 0;
+    _drawDuration = 0;
+}
+
+void VertexStreamingTest::onExit()
+{
+    auto dispatcher = Director::getInstance()->getEventDispatcher();
+    dispatcher->removeEventListener(_beforeDrawListener);
+    dispatcher->removeEventListener(_afterDrawListener);
+    Director::getInstance()->getRenderer()->setVertexStreamingEnabled(false);
+
+    MultiSceneTest::onExit();
+}
+
+std::string VertexStreamingTest::title() const
+{
+    return "Vertex Streaming";
+}
+
+std::string VertexStreamingTest::subtitle() const
+{
+    return "20000 sprites, compare copying the vertices with streaming them into mapped buffers";
+}
@@ -28,6 +28,8 @@
 #include "cocos2d.h"
 #include "../BaseTest.h"
 
+#include <chrono>
+
 #define kTagSpriteBatchNode 100
 #define kTagClipperNode 101
 #define kTagContentNode 102
@@ -279,4 +281,78 @@ protected:
     Ticker _contFast              = Ticker(2);
     Ticker _around30fps           = Ticker(60 * 3);
 };
+class ParallelRecordingTest : public MultiSceneTest
+{
+public:
+    CREATE_FUNC(ParallelRecordingTest);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void onExit() override;
+    virtual void visit(cocos2d::Renderer* renderer, const cocos2d::Mat4& parentTransform, uint32_t parentFlags) override;
+
+protected:
+    ParallelRecordingTest();
+
+    void setRecordingThreads(int threadCount);
+
+    cocos2d::Label* _timeLabel = nullptr;
+    int _threadCount           = -1;
+    int _frames                = 0;
+    int64_t _visitDuration     = 0;
+};
+
+class GLStateCacheTest : public MultiSceneTest
+{
+public:
+    CREATE_FUNC(GLStateCacheTest);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void update(float dt) override;
+
+protected:
+    GLStateCacheTest();
+
+    cocos2d::Label* _statsLabel = nullptr;
+};
+
+class UniformBlockTest : public MultiSceneTest
+{
+public:
+    CREATE_FUNC(UniformBlockTest);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void update(float dt) override;
+
+protected:
+    UniformBlockTest();
+
+    float _time = 0.0f;
+};
+
+class VertexStreamingTest : public MultiSceneTest
+{
+public:
+    CREATE_FUNC(VertexStreamingTest);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+
+protected:
+    VertexStreamingTest();
+
+    void setStreamingEnabled(bool enabled);
+
+    cocos2d::Label* _timeLabel                        = nullptr;
+    cocos2d::EventListenerCustom* _beforeDrawListener = nullptr;
+    cocos2d::EventListenerCustom* _afterDrawListener  = nullptr;
+    std::chrono::steady_clock::time_point _drawStart;
+    int _frames           = 0;
+    int64_t _drawDuration = 0;
+};
+
 #endif  //__NewRendererTest_H_
@@ -49,6 +49,8 @@ Particle3DTests::Particle3DTests()
     ADD_TEST_CASE(Particle3DRibbonTrailDemo);
     ADD_TEST_CASE(Particle3DWeaponTrailDemo);
     ADD_TEST_CASE(Particle3DWithSprite3DDemo);
+    ADD_TEST_CASE(Particle3DPoolBenchmarkDemo);
+    ADD_TEST_CASE(Particle3DParallelAffectorDemo);
 }
 
 std::string Particle3DTestDemo::title() const
@@ -464,3 +466,96 @@ bool Particle3DWithSprite3DDemo::init()
 
     return true;
 }
+
+std::string Particle3DPoolBenchmarkDemo::subtitle() const
+{
+    return "Pool Benchmark: 20 torches, particle update time";
+}
+
+bool Particle3DPoolBenchmarkDemo::init()
+{
+    if (!Particle3DTestDemo::init())
+        return false;
+
+    const int columns = 5;
+    const int rows    = 4;
+    for (int y = 0; y < rows; ++y)
+    {
+        for (int x = 0; x < columns; ++x)
+        {
+            auto ps = PUParticleSystem3D::create("mp_torch.pu", "pu_mediapack_01.material");
+            ps->setCameraMask((unsigned short)CameraFlag::USER1);
+            ps->setPosition3D(Vec3((x - (columns - 1) * 0.5f) * 16.0f, (y - (rows - 1) * 0.5f) * 12.0f - 6.0f, 0.0f));
+            ps->setScale(1.5f);
+            ps->startParticleSystem();
+            this->addChild(ps);
+            _systems.pushBack(ps);
+        }
+    }
+
+    // the particle systems update with priority 0, between the two measure points
+    scheduleUpdateWithPriority(-1);
+    schedule(CC_SCHEDULE_SELECTOR(Particle3DPoolBenchmarkDemo::measure));
+
+    return true;
+}
+
+void Particle3DPoolBenchmarkDemo::update(float delta)
+{
+    _updateStart = std::chrono::steady_clock::now();
+}
+
+void Particle3DPoolBenchmarkDemo::measure(float delta)
+{
+    _updateDuration +=
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _updateStart).count();
+    if (++_frames < 60)
+        return;
+
+    int count = 0;
+    for (auto ps : _systems)
+        count += ps->getAliveParticleCount();
+
+    char str[128];
+    sprintf(str, "Particle Count: %d, update: %.3f ms/frame", count, _updateDuration / 60000.0);
+    _particleLab->setString(str);
+    _frames         = 0;
+    _updateDuration = 0;
+}
+
+std::string Particle3DParallelAffectorDemo::subtitle() const
+{
+    return "Parallel Affectors: 20 torches, particle update time";
+}
+
+bool Particle3DParallelAffectorDemo::init()
+{
+    if (!Particle3DPoolBenchmarkDemo::init())
+        return false;
+
+    auto s = Director::getInstance()->getWinSize();
+
+    MenuItemFont::setFontName("fonts/arial.ttf");
+    MenuItemFont::setFontSize(20);
+    auto serial   = MenuItemFont::create("Serial", [this](Ref*) { setParallelAffectorsEnabled(false); });
+    auto parallel = MenuItemFont::create("Parallel", [this](Ref*) { setParallelAffectorsEnabled(true); });
+    auto menu     = Menu::create(serial, parallel, nullptr);
+    menu->alignItemsHorizontallyWithPadding(20);
+    menu->setPosition(Vec2(s.width / 2, s.height - 90));
+    addChild(menu, 1);
+
+    // the torches only hold a few hundred particles each
+    for (auto ps : _systems)
+        static_cast<PUParticleSystem3D*>(ps)->setParallelAffectorThreshold(64);
+    setParallelAffectorsEnabled(true);
+
+    return true;
+}
+
+void Particle3DParallelAffectorDemo::setParallelAffectorsEnabled(bool enabled)
+{
+    for (auto ps : _systems)
+        static_cast<PUParticleSystem3D*>(ps)->setParallelAffectorsEnabled(enabled);
+    _frames         = 0;
+    _updateDuration = 0;
+}
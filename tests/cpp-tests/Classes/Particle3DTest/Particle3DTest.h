@@ -28,6 +28,7 @@
 
 #include "../BaseTest.h"
 #include "Particle3D/CCParticleSystem3D.h"
+#include <chrono>
 #include <string>
 
 DEFINE_TEST_SUITE(Particle3DTests);
@@ -235,4 +236,40 @@ public:
     virtual bool init() override;
 };
 
+class Particle3DPoolBenchmarkDemo : public Particle3DTestDemo
+{
+public:
+    CREATE_FUNC(Particle3DPoolBenchmarkDemo);
+    Particle3DPoolBenchmarkDemo(){};
+    virtual ~Particle3DPoolBenchmarkDemo(){};
+
+    virtual std::string subtitle() const override;
+
+    virtual bool init() override;
+    virtual void update(float delta) override;
+
+protected:
+    void measure(float delta);
+
+    cocos2d::Vector<cocos2d::ParticleSystem3D*> _systems;
+    std::chrono::steady_clock::time_point _updateStart;
+    int64_t _updateDuration = 0;
+    int _frames             = 0;
+};
+
+class Particle3DParallelAffectorDemo : public Particle3DPoolBenchmarkDemo
+{
+public:
+    CREATE_FUNC(Particle3DParallelAffectorDemo);
+    Particle3DParallelAffectorDemo(){};
+    virtual ~Particle3DParallelAffectorDemo(){};
+
+    virtual std::string subtitle() const override;
+
+    virtual bool init() override;
+
+protected:
+    void setParallelAffectorsEnabled(bool enabled);
+};
+
 #endif
\ No newline at end of file
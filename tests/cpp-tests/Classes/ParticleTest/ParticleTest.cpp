@@ -26,6 +26,8 @@
 #include "../testResource.h"
 #include "cocostudio/CocosStudioExtension.h"
 
+#include <chrono>
+
 USING_NS_CC;
 
 enum
@@ -1068,6 +1070,7 @@ ParticleTests::ParticleTests()
 
     ADD_TEST_CASE(ParticleIssue12310);
     ADD_TEST_CASE(ParticleSpriteFrame);
+    ADD_TEST_CASE(ParticleSIMDBenchmark);
 }
 
 ParticleDemo::~ParticleDemo()
@@ -2098,3 +2101,107 @@ std::string ParticleSpriteFrame::subtitle() const
 {
     return "Should not use entire texture atlas";
 }
+
+//------------------------------------------------------------------
+//
+// ParticleSIMDBenchmark
+//
+//------------------------------------------------------------------
+void ParticleSIMDBenchmark::onEnter()
+{
+    ParticleDemo::onEnter();
+
+    _color->setColor(Color3B::BLACK);
+    removeChild(_background, true);
+    _background = nullptr;
+
+    _wasSIMDEnabled = ParticleSystem::isSIMDEnabled();
+
+    _resultLabel = Label::createWithTTF("", "fonts/arial.ttf", 16);
+    _resultLabel->setPosition(VisibleRect::center() + Vec2(0, 20));
+    addChild(_resultLabel);
+
+    auto run = MenuItemFont::create("Run benchmark", [this](Ref*) { runBenchmark(); });
+    run->setFontSizeObj(24);
+    auto menu = Menu::create(run, nullptr);
+    menu->setPosition(VisibleRect::center() - Vec2(0, 80));
+    addChild(menu);
+}
+
+void ParticleSIMDBenchmark::onExit()
+{
+    ParticleSystem::setSIMDEnabled(_wasSIMDEnabled);
+    ParticleDemo::onExit();
+}
+
+void ParticleSIMDBenchmark::runBenchmark()
+{
+    static const int PARTICLE_COUNT = 50000;
+    static const int UPDATE_COUNT   = 60;
+
+    // ms per update of a full system, the same particles are simulated by the scalar and the SIMD path
+    auto measure = [](ParticleSystem::Mode mode, bool simd) -> double {
+        auto system = ParticleSystemQuad::createWithTotalParticles(PARTICLE_COUNT);
+        system->setEmitterMode(mode);
+        if (mode == ParticleSystem::Mode::GRAVITY)
+        {
+            system->setGravity(Vec2(0, -90));
+            system->setSpeed(60);
+            system->setSpeedVar(20);
+            system->setRadialAccel(-10);
+            system->setTangentialAccel(10);
+            system->setTangentialAccelVar(5);
+        }
+        else
+        {
+            system->setStartRadius(100);
+            system->setStartRadiusVar(20);
+            system->setEndRadius(0);
+            system->setRotatePerSecond(90);
+            system->setRotatePerSecondVar(30);
+        }
+        system->setAngleVar(360);
+        system->setStartSize(16);
+        system->setEndSize(4);
+        system->setStartSpin(0);
+        system->setEndSpin(360);
+        system->setStartColor(Color4F(1.0f, 0.5f, 0.25f, 1.0f));
+        system->setEndColor(Color4F(0.0f, 0.0f, 0.0f, 0.0f));
+        system->setLife(60);
+        system->setEmissionRate(0);
+
+        srand(0);
+        system->addParticles(PARTICLE_COUNT);
+
+        ParticleSystem::setSIMDEnabled(simd);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < UPDATE_COUNT; ++i)
+            system->update(1.0f / 60);
+        auto elapsed =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        return elapsed / 1000.0 / UPDATE_COUNT;
+    };
+
+    double gravityScalar = measure(ParticleSystem::Mode::GRAVITY, false);
+    double gravitySIMD   = measure(ParticleSystem::Mode::GRAVITY, true);
+    double radiusScalar  = measure(ParticleSystem::Mode::RADIUS, false);
+    double radiusSIMD    = measure(ParticleSystem::Mode::RADIUS, true);
+    ParticleSystem::setSIMDEnabled(_wasSIMDEnabled);
+
+    auto result = StringUtils::format(
+        "%d particles, ms per update\ngravity: scalar %.3f, SIMD %.3f (x%.2f)\nradius: scalar %.3f, SIMD %.3f (x%.2f)",
+        PARTICLE_COUNT, gravityScalar, gravitySIMD, gravityScalar / gravitySIMD, radiusScalar, radiusSIMD,
+        radiusScalar / radiusSIMD);
+    _resultLabel->setString(result);
+    log("%s", result.c_str());
+}
+
+std::string ParticleSIMDBenchmark::title() const
+{
+    return "SIMD update benchmark";
+}
+
+std::string ParticleSIMDBenchmark::subtitle() const
+{
+    return "Compares the scalar and SIMD update of 50000 particles";
+}
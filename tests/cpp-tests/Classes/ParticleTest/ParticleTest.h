@@ -424,4 +424,20 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class ParticleSIMDBenchmark : public ParticleDemo
+{
+public:
+    CREATE_FUNC(ParticleSIMDBenchmark);
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    void runBenchmark();
+
+private:
+    cocos2d::Label* _resultLabel;
+    bool _wasSIMDEnabled;
+};
+
 #endif
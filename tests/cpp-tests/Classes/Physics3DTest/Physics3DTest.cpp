@@ -61,6 +61,7 @@ Physics3DTests::Physics3DTests()
     ADD_TEST_CASE(Physics3DCollisionCallbackDemo);
     ADD_TEST_CASE(Physics3DColliderDemo);
     ADD_TEST_CASE(Physics3DTerrainDemo);
+    ADD_TEST_CASE(Physics3DBatchQueryDemo);
 #endif
 };
 
@@ -841,4 +842,157 @@ bool Physics3DColliderDemo::init()
     return true;
 }
 
+std::string Physics3DBatchQueryDemo::subtitle() const
+{
+    return "Batched ray casts and box queries";
+}
+
+bool Physics3DBatchQueryDemo::init()
+{
+    if (!Physics3DTestDemo::init())
+        return false;
+
+    // create floor
+    Physics3DRigidBodyDes rbDes;
+    rbDes.mass  = 0.0f;
+    rbDes.shape = Physics3DShape::createBox(Vec3(60.0f, 1.0f, 60.0f));
+
+    auto floor = PhysicsSprite3D::create("Sprite3DTest/box.c3t", &rbDes);
+    floor->setTexture("Sprite3DTest/plane.png");
+    floor->setScaleX(60);
+    floor->setScaleZ(60);
+    this->addChild(floor);
+    floor->setCameraMask((unsigned short)CameraFlag::USER1);
+    floor->syncNodeToPhysics();
+    floor->setSyncFlag(Physics3DComponent::PhysicsSyncFlag::NONE);
+
+    // scatter falling boxes, so the queries run against moving objects too
+    rbDes.mass  = 1.f;
+    rbDes.shape = Physics3DShape::createBox(Vec3(0.8f, 0.8f, 0.8f));
+    for (int i = 0; i < 100; ++i)
+    {
+        auto sprite = PhysicsSprite3D::create("Sprite3DTest/box.c3t", &rbDes);
+        sprite->setTexture("Images/CyanSquare.png");
+        sprite->setPosition3D(
+            Vec3(CCRANDOM_MINUS1_1() * 20.0f, 2.0f + CCRANDOM_0_1() * 20.0f, CCRANDOM_MINUS1_1() * 20.0f));
+        sprite->syncNodeToPhysics();
+        sprite->setSyncFlag(Physics3DComponent::PhysicsSyncFlag::PHYSICS_TO_NODE);
+        sprite->setCameraMask((unsigned short)CameraFlag::USER1);
+        sprite->setScale(0.8f);
+        this->addChild(sprite);
+    }
+
+    const int rayCount = 1000;
+    _starts.assign(rayCount, Vec3(0.0f, 30.0f, 0.0f));
+    _ends.resize(rayCount);
+    _hits.resize(rayCount);
+
+    const int cells      = 8;
+    const float cellSize = 50.0f / cells;
+    for (int i = 0; i < cells; ++i)
+    {
+        for (int j = 0; j < cells; ++j)
+        {
+            Vec3 min(-25.0f + i * cellSize, -1.0f, -25.0f + j * cellSize);
+            _boxes.push_back(AABB(min, min + Vec3(cellSize, 5.0f, cellSize)));
+        }
+    }
+
+    _label = Label::createWithTTF("", "fonts/arial.ttf", 14);
+    _label->setPosition(VisibleRect::top() + Vec2(0.0f, -60.0f));
+    addChild(_label);
+
+    physicsScene->setPhysics3DDebugCamera(_camera);
+    scheduleUpdate();
+
+    return true;
+}
+
+void Physics3DBatchQueryDemo::update(float /*delta*/)
+{
+    // a cone of rays from above the scene, turning a little every frame
+    const size_t count = _starts.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        float angle = _rayAngle + 2.0f * (float)M_PI * i / count;
+        float dist  = 25.0f * (i % 10 + 1) / 10.0f;
+        _ends[i]    = Vec3(cosf(angle) * dist, -5.0f, sinf(angle) * dist);
+    }
+
+    auto world  = getPhysics3DWorld();
+    size_t hits = world->rayCastBatch(_starts.data(), _ends.data(), count, _hits.data());
+    world->queryAABBBatch(_boxes.data(), _boxes.size(), _boxObjects, _boxOffsets);
+
+    _mismatches += compareWithSingleQueries();
+    CCASSERT(_mismatches == 0, "batched queries should match rayCast and the objects' bounding boxes");
+
+    _label->setString(StringUtils::format("%zu rays, %zu hits, %zu objects in %zu boxes\nmismatches: %zu", count,
+                                          hits, _boxObjects.size(), _boxes.size(), _mismatches));
+
+    _rayAngle += 0.25f * (float)M_PI / 180.0f;
+}
+
+size_t Physics3DBatchQueryDemo::compareWithSingleQueries()
+{
+    auto world        = getPhysics3DWorld();
+    size_t mismatches = 0;
+
+    for (size_t i = 0; i < _starts.size(); ++i)
+    {
+        Physics3DWorld::HitResult single;
+        world->rayCast(_starts[i], _ends[i], &single);
+
+        const auto& hit = _hits[i];
+        bool same       = hit.hitObj == single.hitObj;
+        if (same && hit.hitObj)
+        {
+            same = hit.hitPosition.distanceSquared(single.hitPosition) < 1e-6f;
+        }
+        if (!same)
+        {
+            log("Physics3DBatchQueryDemo: ray %zu differs from rayCast", i);
+            ++mismatches;
+        }
+    }
+
+    // test every object's broadphase bounding box against every query box
+    std::vector<Physics3DObject*> found;
+    for (size_t i = 0; i < _boxes.size(); ++i)
+    {
+        found.clear();
+        auto min = convertVec3TobtVector3(_boxes[i]._min);
+        auto max = convertVec3TobtVector3(_boxes[i]._max);
+        for (auto object : world->getPhysicsObjects())
+        {
+            btCollisionObject* btObject = nullptr;
+            if (object->getObjType() == Physics3DObject::PhysicsObjType::RIGID_BODY)
+            {
+                btObject = static_cast<Physics3DRigidBody*>(object)->getRigidBody();
+            }
+            else if (object->getObjType() == Physics3DObject::PhysicsObjType::COLLIDER)
+            {
+                btObject = static_cast<Physics3DCollider*>(object)->getGhostObject();
+            }
+
+            auto proxy = btObject ? btObject->getBroadphaseHandle() : nullptr;
+            if (proxy && TestAabbAgainstAabb2(min, max, proxy->m_aabbMin, proxy->m_aabbMax))
+            {
+                found.push_back(object);
+            }
+        }
+
+        std::vector<Physics3DObject*> batched(_boxObjects.begin() + _boxOffsets[i],
+                                              _boxObjects.begin() + _boxOffsets[i + 1]);
+        std::sort(found.begin(), found.end());
+        std::sort(batched.begin(), batched.end());
+        if (found != batched)
+        {
+            log("Physics3DBatchQueryDemo: box %zu differs from the bounding box test", i);
+            ++mismatches;
+        }
+    }
+
+    return mismatches;
+}
+
 #endif
@@ -27,6 +27,7 @@
 #define _PHYSICS3D_TEST_H_
 
 #include "../BaseTest.h"
+#include "physics3d/CCPhysics3D.h"
 #include <string>
 
 namespace cocos2d
@@ -157,6 +158,32 @@ public:
 private:
 };
 
+class Physics3DBatchQueryDemo : public Physics3DTestDemo
+{
+public:
+    CREATE_FUNC(Physics3DBatchQueryDemo);
+    Physics3DBatchQueryDemo(){};
+    virtual ~Physics3DBatchQueryDemo(){};
+
+    virtual std::string subtitle() const override;
+
+    virtual bool init() override;
+    virtual void update(float delta) override;
+
+private:
+    size_t compareWithSingleQueries();
+
+    cocos2d::Label* _label = nullptr;
+    float _rayAngle        = 0.0f;
+    size_t _mismatches     = 0;
+    std::vector<cocos2d::Vec3> _starts;
+    std::vector<cocos2d::Vec3> _ends;
+    std::vector<cocos2d::Physics3DWorld::HitResult> _hits;
+    std::vector<cocos2d::AABB> _boxes;
+    std::vector<cocos2d::Physics3DObject*> _boxObjects;
+    std::vector<size_t> _boxOffsets;
+};
+
 #endif
 
 #endif
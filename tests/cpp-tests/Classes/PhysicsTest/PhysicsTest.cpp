@@ -26,6 +26,7 @@
 
 #if CC_USE_PHYSICS
 
+#    include <chrono>
 #    include <cmath>
 #    include "ui/CocosGUI.h"
 #    include "../testResource.h"
@@ -52,6 +53,9 @@ PhysicsTests::PhysicsTests()
     ADD_TEST_CASE(PhysicsTransformTest);
     ADD_TEST_CASE(PhysicsIssue9959);
     ADD_TEST_CASE(PhysicsIssue15932);
+    ADD_TEST_CASE(PhysicsThreadedStepTest);
+    ADD_TEST_CASE(PhysicsAsyncStepTest);
+    ADD_TEST_CASE(PhysicsBatchQueryTest);
 }
 
 namespace
@@ -1954,4 +1958,322 @@ std::string PhysicsIssue15932::subtitle() const
     return "addComponent()/removeComponent() should not crash";
 }
 
+void PhysicsThreadedStepTest::onEnter()
+{
+    PhysicsDemo::onEnter();
+
+    auto wall = Node::create();
+    wall->addComponent(
+        PhysicsBody::createEdgeBox(VisibleRect::getVisibleRect().size, PhysicsMaterial(0.1f, 0.5f, 0.5f)));
+    wall->setPosition(VisibleRect::center());
+    addChild(wall);
+
+    // enough touching bodies for the solver to be split across threads
+    const int columns = 30;
+    const int rows    = 15;
+    const float step  = (VisibleRect::getVisibleRect().size.width - 40.0f) / columns;
+    for (int i = 0; i < rows; ++i)
+    {
+        for (int j = 0; j < columns; ++j)
+        {
+            auto offset = Vec2(20.0f + (j + 0.5f * (i % 2)) * step, 40.0f + i * step);
+            auto ball   = makeBall(VisibleRect::leftBottom() + offset, step * 0.4f);
+            ball->getPhysicsBody()->setTag(DRAG_BODYS_TAG);
+            addChild(ball);
+        }
+    }
+
+    MenuItemFont::setFontSize(18);
+    _threadsButton = MenuItemFont::create("", CC_CALLBACK_1(PhysicsThreadedStepTest::toggleThreadsCallback, this));
+    _asyncButton   = MenuItemFont::create("", CC_CALLBACK_1(PhysicsThreadedStepTest::toggleAsyncCallback, this));
+
+    auto menu = Menu::create(_threadsButton, _asyncButton, nullptr);
+    menu->alignItemsVertically();
+    menu->setPosition(VisibleRect::right() + Vec2(-80.0f, 60.0f));
+    addChild(menu);
+
+    updateButtons();
+}
+
+void PhysicsThreadedStepTest::onExit()
+{
+    _physicsWorld->setAsyncStepping(false);
+    _physicsWorld->setThreadCount(1);
+
+    PhysicsDemo::onExit();
+}
+
+void PhysicsThreadedStepTest::toggleThreadsCallback(Ref* /*sender*/)
+{
+    _physicsWorld->setThreadCount(_physicsWorld->getThreadCount() == 1 ? 0 : 1);
+    updateButtons();
+}
+
+void PhysicsThreadedStepTest::toggleAsyncCallback(Ref* /*sender*/)
+{
+    _physicsWorld->setAsyncStepping(!_physicsWorld->isAsyncStepping());
+    updateButtons();
+}
+
+void PhysicsThreadedStepTest::updateButtons()
+{
+    _threadsButton->setString(StringUtils::format("Solver threads: %d", _physicsWorld->getThreadCount()));
+    _asyncButton->setString(_physicsWorld->isAsyncStepping() ? "Async stepping: On" : "Async stepping: Off");
+}
+
+std::string PhysicsThreadedStepTest::title() const
+{
+    return "Threaded Step";
+}
+
+std::string PhysicsThreadedStepTest::subtitle() const
+{
+    return "450 balls, toggle the solver threads and the background step";
+}
+
+namespace
+{
+// an off-screen scene with a stack of boxes falling on the ground, bodies are added in the same order every time
+Scene* createBoxStackScene(bool asyncStepping)
+{
+    auto scene = Scene::createWithPhysics();
+    auto world = scene->getPhysicsWorld();
+    world->setThreadCount(1);
+    world->setAsyncStepping(asyncStepping);
+
+    auto ground = Node::create();
+    scene->addChild(ground);
+    ground->addComponent(PhysicsBody::createEdgeSegment(Vec2(-400.0f, 0.0f), Vec2(400.0f, 0.0f)));
+
+    for (int i = 0; i < 100; ++i)
+    {
+        auto box = Node::create();
+        box->setPosition(Vec2((i % 10) * 22.0f - 100.0f, 20.0f + (i / 10) * 22.0f));
+        box->setRotation(i * 7.0f);
+        scene->addChild(box);
+        box->addComponent(PhysicsBody::createBox(Size(20.0f, 20.0f)));
+    }
+    return scene;
+}
+}  // namespace
+
+void PhysicsAsyncStepTest::onEnter()
+{
+    PhysicsDemo::onEnter();
+
+    auto asyncScene  = createBoxStackScene(true);
+    auto serialScene = createBoxStackScene(false);
+
+    // the async world starts every step on a JobSystem worker and applies it at the start of the next update
+    const int steps = 300;
+    for (int i = 0; i < steps; ++i)
+    {
+        asyncScene->stepPhysicsAndNavigation(1.0f / 60.0f);
+        serialScene->stepPhysicsAndNavigation(1.0f / 60.0f);
+    }
+    asyncScene->getPhysicsWorld()->setAsyncStepping(false);
+
+    const auto& asyncBodies  = asyncScene->getPhysicsWorld()->getAllBodies();
+    const auto& serialBodies = serialScene->getPhysicsWorld()->getAllBodies();
+    int mismatches           = 0;
+    for (ssize_t i = 0; i < asyncBodies.size() && i < serialBodies.size(); ++i)
+    {
+        auto asyncBody  = asyncBodies.at(i);
+        auto serialBody = serialBodies.at(i);
+        if (asyncBody->getPosition() != serialBody->getPosition() ||
+            asyncBody->getRotation() != serialBody->getRotation() ||
+            asyncBody->getOwner()->getPosition() != serialBody->getOwner()->getPosition())
+        {
+            ++mismatches;
+        }
+    }
+    CCASSERT(asyncBodies.size() == serialBodies.size(), "the worlds should have the same bodies");
+
+    std::string result = StringUtils::format("%d bodies after %d steps: ", (int)asyncBodies.size(), steps);
+    result += mismatches ? StringUtils::format("%d positions differ", mismatches) : "same positions";
+    if (mismatches)
+    {
+        log("PhysicsAsyncStepTest: %s", result.c_str());
+    }
+
+    auto label = Label::createWithTTF(result, "fonts/arial.ttf", 24);
+    label->setPosition(VisibleRect::center());
+    label->setTextColor(mismatches ? Color4B::RED : Color4B::GREEN);
+    addChild(label);
+}
+
+std::string PhysicsAsyncStepTest::title() const
+{
+    return "Async Step";
+}
+
+std::string PhysicsAsyncStepTest::subtitle() const
+{
+    return "Background and synchronous steps should move the bodies the same way";
+}
+
+PhysicsBatchQueryTest::PhysicsBatchQueryTest() : _angle(0.0f), _node(nullptr), _label(nullptr), _mismatches(0) {}
+
+void PhysicsBatchQueryTest::onEnter()
+{
+    PhysicsDemo::onEnter();
+
+    _physicsWorld->setGravity(Vec2::ZERO);
+
+    auto size = VisibleRect::getVisibleRect().size;
+    for (int i = 0; i < 30; ++i)
+    {
+        auto position = VisibleRect::leftBottom() + Vec2(CCRANDOM_0_1() * size.width, CCRANDOM_0_1() * size.height);
+        if (position.distance(VisibleRect::center()) < 40.0f)
+        {
+            continue;
+        }
+
+        if (i % 2)
+        {
+            addChild(makeBall(position, 5 + CCRANDOM_0_1() * 10));
+        }
+        else
+        {
+            addChild(makeBox(position, Size(10 + CCRANDOM_0_1() * 15, 10 + CCRANDOM_0_1() * 15)));
+        }
+    }
+
+    const int rayCount = 2000;
+    _starts.assign(rayCount, VisibleRect::center());
+    _ends.resize(rayCount);
+    _hits.resize(rayCount);
+
+    const int columns = 12;
+    const int rows    = 8;
+    for (int i = 0; i < rows; ++i)
+    {
+        for (int j = 0; j < columns; ++j)
+        {
+            _cells.push_back(Rect(VisibleRect::left().x + j * size.width / columns,
+                                  VisibleRect::bottom().y + i * size.height / rows, size.width / columns,
+                                  size.height / rows));
+        }
+    }
+
+    _node = DrawNode::create();
+    addChild(_node);
+
+    _label = Label::createWithTTF("", "fonts/arial.ttf", 14);
+    _label->setPosition(VisibleRect::top() + Vec2(0.0f, -60.0f));
+    addChild(_label);
+
+    scheduleUpdate();
+}
+
+void PhysicsBatchQueryTest::update(float /*delta*/)
+{
+    const size_t count = _starts.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        float angle = _angle + 2.0f * (float)M_PI * i / count;
+        _ends[i]    = _starts[i] + Vec2(cosf(angle), sinf(angle)) * 300.0f;
+    }
+
+    auto start  = std::chrono::steady_clock::now();
+    size_t hits = _physicsWorld->rayCastBatch(_starts.data(), _ends.data(), count, _hits.data());
+    _physicsWorld->queryRectBatch(_cells.data(), _cells.size(), _cellShapes, _cellOffsets);
+    auto elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    _mismatches += compareWithSingleQueries();
+    CCASSERT(_mismatches == 0, "batched queries should match rayCast and queryRect");
+
+    _node->clear();
+    for (size_t i = 0; i < _cells.size(); ++i)
+    {
+        if (_cellOffsets[i + 1] > _cellOffsets[i])
+        {
+            _node->drawRect(_cells[i].origin, _cells[i].origin + _cells[i].size, Color4F(0.0f, 1.0f, 0.0f, 0.5f));
+        }
+    }
+
+    for (auto& hit : _hits)
+    {
+        if (hit.shape)
+        {
+            _node->drawDot(hit.contact, 1, Color4F(1.0f, 1.0f, 1.0f, 1.0f));
+        }
+    }
+
+    _label->setString(StringUtils::format("%zu rays, %zu hits, %zu cells: %.2f ms\nmismatches: %zu", count, hits,
+                                          _cells.size(), elapsed, _mismatches));
+
+    _angle += 0.25f * (float)M_PI / 180.0f;
+}
+
+size_t PhysicsBatchQueryTest::compareWithSingleQueries()
+{
+    size_t mismatches = 0;
+
+    // rayCast reports every shape along the segment, the batch only keeps the closest one
+    for (size_t i = 0; i < _starts.size(); ++i)
+    {
+        PhysicsRayCastInfo closest = {};
+        _physicsWorld->rayCast(
+            [&closest](PhysicsWorld& /*world*/, const PhysicsRayCastInfo& info, void* /*data*/) -> bool {
+                if (closest.shape == nullptr || info.fraction < closest.fraction)
+                {
+                    closest = info;
+                }
+                return true;
+            },
+            _starts[i], _ends[i], nullptr);
+
+        const auto& hit = _hits[i];
+        bool same       = hit.shape == closest.shape;
+        if (same && hit.shape)
+        {
+            same = fabsf(hit.fraction - closest.fraction) < 1e-4f && hit.contact.fuzzyEquals(closest.contact, 0.01f);
+        }
+        if (!same)
+        {
+            log("PhysicsBatchQueryTest: ray %zu differs from rayCast", i);
+            ++mismatches;
+        }
+    }
+
+    std::vector<PhysicsShape*> found;
+    for (size_t i = 0; i < _cells.size(); ++i)
+    {
+        found.clear();
+        _physicsWorld->queryRect(
+            [&found](PhysicsWorld& /*world*/, PhysicsShape& shape, void* /*data*/) -> bool {
+                // a PhysicsShape may own several chipmunk shapes
+                if (std::find(found.begin(), found.end(), &shape) == found.end())
+                {
+                    found.push_back(&shape);
+                }
+                return true;
+            },
+            _cells[i], nullptr);
+
+        std::vector<PhysicsShape*> batched(_cellShapes.begin() + _cellOffsets[i],
+                                           _cellShapes.begin() + _cellOffsets[i + 1]);
+        std::sort(found.begin(), found.end());
+        std::sort(batched.begin(), batched.end());
+        if (found != batched)
+        {
+            log("PhysicsBatchQueryTest: cell %zu differs from queryRect", i);
+            ++mismatches;
+        }
+    }
+
+    return mismatches;
+}
+
+std::string PhysicsBatchQueryTest::title() const
+{
+    return "Batched Queries";
+}
+
+std::string PhysicsBatchQueryTest::subtitle() const
+{
+    return "Hits of 2000 rays and the grid cells overlapping a shape";
+}
+
 #endif
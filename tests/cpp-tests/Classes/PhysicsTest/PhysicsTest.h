@@ -308,4 +308,61 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class PhysicsThreadedStepTest : public PhysicsDemo
+{
+public:
+    CREATE_FUNC(PhysicsThreadedStepTest);
+
+    void onEnter() override;
+    void onExit() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    void toggleThreadsCallback(cocos2d::Ref* sender);
+    void toggleAsyncCallback(cocos2d::Ref* sender);
+
+private:
+    void updateButtons();
+
+    cocos2d::MenuItemFont* _threadsButton;
+    cocos2d::MenuItemFont* _asyncButton;
+};
+
+class PhysicsAsyncStepTest : public PhysicsDemo
+{
+public:
+    CREATE_FUNC(PhysicsAsyncStepTest);
+
+    void onEnter() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
+class PhysicsBatchQueryTest : public PhysicsDemo
+{
+public:
+    CREATE_FUNC(PhysicsBatchQueryTest);
+
+    PhysicsBatchQueryTest();
+
+    void onEnter() override;
+    void update(float delta) override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    float _angle;
+    cocos2d::DrawNode* _node;
+    cocos2d::Label* _label;
+    std::vector<cocos2d::Vec2> _starts;
+    std::vector<cocos2d::Vec2> _ends;
+    std::vector<cocos2d::PhysicsRayCastInfo> _hits;
+    std::vector<cocos2d::Rect> _cells;
+    std::vector<cocos2d::PhysicsShape*> _cellShapes;
+    std::vector<size_t> _cellOffsets;
+    size_t _mismatches;
+
+    size_t compareWithSingleQueries();
+};
+
 #endif  // #if CC_USE_PHYSICS
\ No newline at end of file
@@ -62,6 +62,7 @@ SchedulerTests::SchedulerTests()
     ADD_TEST_CASE(SchedulerIssue17149);
     ADD_TEST_CASE(SchedulerRemoveEntryWhileUpdate);
     ADD_TEST_CASE(SchedulerRemoveSelectorDuringCall);
+    ADD_TEST_CASE(SchedulerFixedTimeStep);
 };
 
 //------------------------------------------------------------------
@@ -1455,3 +1456,86 @@ void SchedulerRemoveSelectorDuringCall::callback(float)
     Scheduler* const scheduler(Director::getInstance()->getScheduler());
     scheduler->unschedule(SEL_SCHEDULE(&SchedulerRemoveSelectorDuringCall::callback), this);
 }
+
+//------------------------------------------------------------------
+//
+// SchedulerFixedTimeStep
+//
+//------------------------------------------------------------------
+
+std::string SchedulerFixedTimeStep::title() const
+{
+    return "Fixed time step";
+}
+
+std::string SchedulerFixedTimeStep::subtitle() const
+{
+    return "Updates at 20 Hz. Top: drawn at the last step, bottom: interpolated";
+}
+
+void SchedulerFixedTimeStep::onEnter()
+{
+    SchedulerTestLayer::onEnter();
+
+    auto director = Director::getInstance();
+    director->setFixedTimeStep(1.0f / 20.0f);
+    FramePacer::getInstance()->clearHistory();
+
+    auto center = VisibleRect::center();
+    _currentX   = center.x;
+    _previousX  = center.x;
+
+    _stepped = Sprite::create("Images/grossinis_sister1.png");
+    _stepped->setPosition(center + Vec2(0.0f, 60.0f));
+    addChild(_stepped);
+
+    _interpolated = Sprite::create("Images/grossinis_sister2.png");
+    _interpolated->setPosition(center - Vec2(0.0f, 60.0f));
+    addChild(_interpolated);
+
+    _timingsLabel = Label::createWithTTF("", "fonts/arial.ttf", 14);
+    _timingsLabel->setPosition(VisibleRect::bottom() + Vec2(0.0f, 50.0f));
+    addChild(_timingsLabel);
+
+    scheduleUpdate();
+
+    // all the fixed steps of the frame have run by then
+    _beforeDrawListener = director->getEventDispatcher()->addCustomEventListener(
+        Director::EVENT_BEFORE_DRAW, [this](EventCustom*) { beforeDraw(); });
+}
+
+void SchedulerFixedTimeStep::onExit()
+{
+    auto director = Director::getInstance();
+    director->getEventDispatcher()->removeEventListener(_beforeDrawListener);
+    director->setFixedTimeStep(0.0f);
+
+    SchedulerTestLayer::onExit();
+}
+
+void SchedulerFixedTimeStep::update(float dt)
+{
+    _time += dt;
+    _previousX = _currentX;
+    _currentX  = VisibleRect::center().x + 150.0f * std::sin(_time * 2.0f);
+}
+
+void SchedulerFixedTimeStep::beforeDraw()
+{
+    float alpha = Director::getInstance()->getFrameInterpolation();
+    _stepped->setPositionX(_currentX);
+    _interpolated->setPositionX(_previousX + (_currentX - _previousX) * alpha);
+
+    if (++_frames % 30 != 0)
+        return;
+
+    auto framePacer = FramePacer::getInstance();
+    auto stats      = framePacer->getFrameTimeStats();
+    auto& last      = framePacer->getLastFrameTimings();
+    char text[256];
+    sprintf(text,
+            "frame %.2f ms, deviation %.2f ms, max %.2f ms\n"
+            "update %.2f, visit %.2f, render %.2f, swap %.2f, idle %.2f ms",
+            stats.mean, stats.deviation, stats.max, last.update, last.visit, last.render, last.swap, last.idle);
+    _timingsLabel->setString(text);
+}
@@ -461,4 +461,28 @@ private:
     bool _scheduled;
 };
 
+class SchedulerFixedTimeStep : public SchedulerTestLayer
+{
+public:
+    CREATE_FUNC(SchedulerFixedTimeStep);
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual void update(float dt) override;
+
+private:
+    void beforeDraw();
+
+    cocos2d::Sprite* _stepped                         = nullptr;
+    cocos2d::Sprite* _interpolated                    = nullptr;
+    cocos2d::Label* _timingsLabel                     = nullptr;
+    cocos2d::EventListenerCustom* _beforeDrawListener = nullptr;
+    float _time                                       = 0.0f;
+    float _previousX                                  = 0.0f;
+    float _currentX                                   = 0.0f;
+    unsigned int _frames                              = 0;
+};
+
 #endif
@@ -28,6 +28,7 @@
 #include "DrawNode3D.h"
 #include "2d/CCCameraBackgroundBrush.h"
 #include "3d/CCSprite3DMaterial.h"
+#include "3d/CCMeshSkin.h"
 #include "3d/CCMotionStreak3D.h"
 
 #include "extensions/Particle3D/PU/CCPUParticleSystem3D.h"
@@ -70,6 +71,8 @@ Sprite3DTests::Sprite3DTests()
     ADD_TEST_CASE(Sprite3DPropertyTest);
     ADD_TEST_CASE(Sprite3DNormalMappingTest);
     ADD_TEST_CASE(Issue16155Test);
+    ADD_TEST_CASE(Sprite3DSkinPaletteBenchmark);
+    ADD_TEST_CASE(Sprite3DInstancingTest);
 };
 
 //------------------------------------------------------------------
@@ -2656,3 +2659,177 @@ std::string Issue16155Test::subtitle() const
 {
     return "Should not leak texture. See console";
 }
+
+//
+// Sprite3DSkinPaletteBenchmark
+//
+static const int SKIN_BENCHMARK_ROWS            = 20;
+static const int SKIN_BENCHMARK_COLUMNS         = 25;
+static const float SKIN_BENCHMARK_CACHE_QUANTUM = 1.0f / 30.0f;
+
+Sprite3DSkinPaletteBenchmark::Sprite3DSkinPaletteBenchmark()
+{
+    MenuItemFont::setFontName("fonts/arial.ttf");
+    MenuItemFont::setFontSize(15);
+    _cacheItem    = MenuItemFont::create("", CC_CALLBACK_1(Sprite3DSkinPaletteBenchmark::switchCacheCallback, this));
+    _parallelItem = MenuItemFont::create("", CC_CALLBACK_1(Sprite3DSkinPaletteBenchmark::switchParallelCallback, this));
+    _dualQuaternionItem =
+        MenuItemFont::create("", CC_CALLBACK_1(Sprite3DSkinPaletteBenchmark::switchDualQuaternionCallback, this));
+    _cacheItem->setPosition(VisibleRect::left().x + 80, VisibleRect::top().y - 70);
+    _parallelItem->setPosition(VisibleRect::left().x + 80, VisibleRect::top().y - 90);
+    _dualQuaternionItem->setPosition(VisibleRect::left().x + 80, VisibleRect::top().y - 110);
+    auto menu = Menu::create(_cacheItem, _parallelItem, _dualQuaternionItem, nullptr);
+    menu->setPosition(Vec2::ZERO);
+    addChild(menu, 1);
+
+    _statsLabel = Label::createWithTTF("", "fonts/arial.ttf", 12);
+    _statsLabel->setAnchorPoint(Vec2::ANCHOR_BOTTOM_LEFT);
+    _statsLabel->setPosition(VisibleRect::left().x + 10, VisibleRect::bottom().y + 10);
+    addChild(_statsLabel, 1);
+
+    // every instance plays the same clip at the same speed, so that the palette cache can share their samples
+    std::string fileName = "Sprite3DTest/orc.c3b";
+    auto animation       = Animation3D::create(fileName);
+    auto s               = Director::getInstance()->getWinSize();
+    for (int row = 0; row < SKIN_BENCHMARK_ROWS; ++row)
+    {
+        for (int column = 0; column < SKIN_BENCHMARK_COLUMNS; ++column)
+        {
+            auto sprite = Sprite3D::create(fileName);
+            sprite->setScale(0.8f);
+            sprite->setRotation3D(Vec3(0.0f, 180.0f, 0.0f));
+            sprite->setPosition(Vec2(s.width * (column + 0.5f) / SKIN_BENCHMARK_COLUMNS,
+                                     s.height * 0.8f * (row + 0.5f) / SKIN_BENCHMARK_ROWS));
+            addChild(sprite);
+            _sprites.push_back(sprite);
+
+            if (animation)
+                sprite->runAction(RepeatForever::create(Animate3D::create(animation)));
+        }
+    }
+
+    refreshMenuLabels();
+    scheduleUpdate();
+}
+
+std::string Sprite3DSkinPaletteBenchmark::title() const
+{
+    return "Skin Palette Benchmark";
+}
+
+std::string Sprite3DSkinPaletteBenchmark::subtitle() const
+{
+    return StringUtils::format("%d animated orcs", SKIN_BENCHMARK_ROWS * SKIN_BENCHMARK_COLUMNS);
+}
+
+void Sprite3DSkinPaletteBenchmark::onExit()
+{
+    Sprite3DTestDemo::onExit();
+
+    MeshSkin::setPaletteCacheQuantum(0.0f);
+    MeshSkin::setParallelPaletteUpdate(false);
+}
+
+void Sprite3DSkinPaletteBenchmark::update(float dt)
+{
+    _elapsed += dt;
+    ++_frames;
+    if (_elapsed < 1.0f)
+        return;
+
+    auto stats = MeshSkin::getPaletteCacheStats();
+    auto text  = StringUtils::format("%.2f ms/frame, palettes per frame: %.1f cached, %.1f computed, %d entries",
+                                     _elapsed * 1000.0f / _frames, (float)stats.hits / _frames,
+                                     (float)stats.misses / _frames, (int)stats.entries);
+    _statsLabel->setString(text);
+    MeshSkin::resetPaletteCacheStats();
+    _elapsed = 0.0f;
+    _frames  = 0;
+}
+
+void Sprite3DSkinPaletteBenchmark::switchCacheCallback(Ref* sender)
+{
+    bool enabled = MeshSkin::getPaletteCacheQuantum() > 0.0f;
+    MeshSkin::setPaletteCacheQuantum(enabled ? 0.0f : SKIN_BENCHMARK_CACHE_QUANTUM);
+    refreshMenuLabels();
+}
+
+void Sprite3DSkinPaletteBenchmark::switchParallelCallback(Ref* sender)
+{
+    MeshSkin::setParallelPaletteUpdate(!MeshSkin::isParallelPaletteUpdate());
+    refreshMenuLabels();
+}
+
+void Sprite3DSkinPaletteBenchmark::switchDualQuaternionCallback(Ref* sender)
+{
+    _dualQuaternion = !_dualQuaternion;
+    for (auto sprite : _sprites)
+        sprite->setDualQuaternionSkinning(_dualQuaternion);
+    refreshMenuLabels();
+}
+
+void Sprite3DSkinPaletteBenchmark::refreshMenuLabels()
+{
+    _cacheItem->setString(MeshSkin::getPaletteCacheQuantum() > 0.0f ? "Palette Cache: On" : "Palette Cache: Off");
+    _parallelItem->setString(MeshSkin::isParallelPaletteUpdate() ? "Parallel Update: On" : "Parallel Update: Off");
+    _dualQuaternionItem->setString(_dualQuaternion ? "Dual Quaternion: On" : "Dual Quaternion: Off");
+}
+
+//
+// Sprite3DInstancingTest
+//
+static const int INSTANCING_TEST_ROWS    = 20;
+static const int INSTANCING_TEST_COLUMNS = 40;
+
+Sprite3DInstancingTest::Sprite3DInstancingTest()
+{
+    MenuItemFont::setFontName("fonts/arial.ttf");
+    MenuItemFont::setFontSize(15);
+    _instancingItem = MenuItemFont::create("Instancing: Off",
+                                           CC_CALLBACK_1(Sprite3DInstancingTest::switchInstancingCallback, this));
+    _instancingItem->setPosition(VisibleRect::left().x + 80, VisibleRect::top().y - 70);
+    auto menu = Menu::create(_instancingItem, nullptr);
+    menu->setPosition(Vec2::ZERO);
+    addChild(menu, 1);
+
+    // the ships share their buffers and texture, and only differ by their transform and color
+    auto s = Director::getInstance()->getWinSize();
+    for (int row = 0; row < INSTANCING_TEST_ROWS; ++row)
+    {
+        for (int column = 0; column < INSTANCING_TEST_COLUMNS; ++column)
+        {
+            auto sprite = Sprite3D::create("Sprite3DTest/boss1.obj");
+            sprite->setTexture("Sprite3DTest/boss.png");
+            sprite->setScale(0.8f);
+            sprite->setPosition(Vec2(s.width * (column + 0.5f) / INSTANCING_TEST_COLUMNS,
+                                     s.height * 0.8f * (row + 0.5f) / INSTANCING_TEST_ROWS));
+            int red   = 127 + 128 * column / INSTANCING_TEST_COLUMNS;
+            int green = 127 + 128 * row / INSTANCING_TEST_ROWS;
+            sprite->setColor(Color3B(red, green, 255));
+            sprite->runAction(RepeatForever::create(RotateBy::create(2.0f + (row + column) % 3, Vec3(0, 360, 0))));
+            addChild(sprite);
+            _sprites.push_back(sprite);
+        }
+    }
+}
+
+std::string Sprite3DInstancingTest::title() const
+{
+    return "Instanced Sprite3D";
+}
+
+std::string Sprite3DInstancingTest::subtitle() const
+{
+    if (!Director::getInstance()->getRenderer()->isInstancingSupported())
+        return "Instancing is not supported by the renderer";
+    return StringUtils::format("%d ships, compare the draw calls", INSTANCING_TEST_ROWS * INSTANCING_TEST_COLUMNS);
+}
+
+void Sprite3DInstancingTest::switchInstancingCallback(Ref* sender)
+{
+    _instancing = !_instancing;
+    for (auto sprite : _sprites)
+        sprite->setInstancing(_instancing);
+    _instancingItem->setString(_sprites.empty() || !_sprites.front()->isInstancing() ? "Instancing: Off"
+                                                                                      : "Instancing: On");
+}
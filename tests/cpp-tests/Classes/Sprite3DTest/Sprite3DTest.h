@@ -627,3 +627,46 @@ public:
     virtual std::string title() const override;
     virtual std::string subtitle() const override;
 };
+
+class Sprite3DInstancingTest : public Sprite3DTestDemo
+{
+public:
+    CREATE_FUNC(Sprite3DInstancingTest);
+    Sprite3DInstancingTest();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    void switchInstancingCallback(cocos2d::Ref* sender);
+
+protected:
+    std::vector<cocos2d::Sprite3D*> _sprites;
+    cocos2d::MenuItemFont* _instancingItem = nullptr;
+    bool _instancing                       = false;
+};
+
+class Sprite3DSkinPaletteBenchmark : public Sprite3DTestDemo
+{
+public:
+    CREATE_FUNC(Sprite3DSkinPaletteBenchmark);
+    Sprite3DSkinPaletteBenchmark();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    virtual void onExit() override;
+    virtual void update(float dt) override;
+
+    void switchCacheCallback(cocos2d::Ref* sender);
+    void switchParallelCallback(cocos2d::Ref* sender);
+    void switchDualQuaternionCallback(cocos2d::Ref* sender);
+
+protected:
+    void refreshMenuLabels();
+
+    std::vector<cocos2d::Sprite3D*> _sprites;
+    cocos2d::MenuItemFont* _cacheItem          = nullptr;
+    cocos2d::MenuItemFont* _parallelItem       = nullptr;
+    cocos2d::MenuItemFont* _dualQuaternionItem = nullptr;
+    cocos2d::Label* _statsLabel                = nullptr;
+    bool _dualQuaternion                       = false;
+    float _elapsed                             = 0.0f;
+    unsigned int _frames                       = 0;
+};
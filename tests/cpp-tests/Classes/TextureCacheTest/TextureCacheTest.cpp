@@ -30,6 +30,7 @@ TextureCacheTests::TextureCacheTests()
 {
     ADD_TEST_CASE(TextureCacheTest);
     ADD_TEST_CASE(TextureCacheUnbindTest);
+    ADD_TEST_CASE(TextureCacheBatchPreloadTest);
 }
 
 TextureCacheTest::TextureCacheTest() : _numberOfSprites(20), _numberOfLoadedSprites(0)
@@ -211,3 +212,73 @@ void TextureCacheUnbindTest::textureLoadedB(Texture2D* texture)
     s->setPosition(3 * size.width / 4, size.height / 2);
     this->addChild(s);
 }
+
+TextureCacheBatchPreloadTest::TextureCacheBatchPreloadTest() : _batchId(0)
+{
+    auto size = Director::getInstance()->getWinSize();
+
+    _labelPercent = Label::createWithTTF("%0", "fonts/arial.ttf", 15);
+    _labelPercent->setPosition(Vec2(size.width / 2, size.height / 2));
+    this->addChild(_labelPercent);
+
+    _paths = {"Images/HelloWorld.png", "Images/grossini.png", "Images/background1.png", "Images/background2.png",
+              "Images/background3.png", "Images/blocks.png"};
+    char path[64];
+    for (int i = 1; i <= 14; ++i)
+    {
+        sprintf(path, "Images/grossini_dance_%02d.png", i);
+        _paths.push_back(path);
+    }
+
+    auto cache = Director::getInstance()->getTextureCache();
+    for (auto& path : _paths)
+        cache->removeTextureForKey(path);
+    cache->removeTextureForKey("Images/texture2048x2048.png");
+
+    _batchId = cache->preloadTexturesAsync(_paths, CC_CALLBACK_2(TextureCacheBatchPreloadTest::onProgress, this));
+
+    // shares the entries in flight with the first batch, then gets cancelled before its big texture is decoded
+    std::vector<std::string> cancelled(_paths.begin(), _paths.begin() + 4);
+    cancelled.push_back("Images/texture2048x2048.png");
+    auto cancelledId = cache->preloadTexturesAsync(cancelled, [](size_t, size_t) {
+        CCASSERT(false, "the progress of a cancelled batch must not be reported");
+    });
+    cache->cancelPreload(cancelledId);
+}
+
+void TextureCacheBatchPreloadTest::onExit()
+{
+    Director::getInstance()->getTextureCache()->cancelPreload(_batchId);
+    TestCase::onExit();
+}
+
+void TextureCacheBatchPreloadTest::onProgress(size_t loaded, size_t total)
+{
+    char tmp[10];
+    sprintf(tmp, "%%%d", (int)(loaded * 100 / total));
+    _labelPercent->setString(tmp);
+
+    if (loaded != total)
+        return;
+
+    _batchId   = 0;
+    auto size  = Director::getInstance()->getWinSize();
+    auto cache = Director::getInstance()->getTextureCache();
+    for (size_t i = 0; i < _paths.size(); ++i)
+    {
+        auto sprite = Sprite::createWithTexture(cache->getTextureForKey(_paths[i]));
+        sprite->setScale(0.25f);
+        sprite->setPosition(Vec2(size.width * ((i % 5) + 0.5f) / 5, size.height * ((i / 5) + 0.5f) / 5));
+        this->addChild(sprite);
+    }
+}
+
+std::string TextureCacheBatchPreloadTest::title() const
+{
+    return "TextureCache batch preload";
+}
+
+std::string TextureCacheBatchPreloadTest::subtitle() const
+{
+    return "20 textures decoded in parallel, a second batch is cancelled";
+}
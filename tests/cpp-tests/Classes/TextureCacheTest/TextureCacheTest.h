@@ -61,4 +61,23 @@ private:
     void textureLoadedB(cocos2d::Texture2D* texture);
 };
 
+class TextureCacheBatchPreloadTest : public TestCase
+{
+public:
+    CREATE_FUNC(TextureCacheBatchPreloadTest);
+
+    TextureCacheBatchPreloadTest();
+
+    virtual void onExit() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    void onProgress(size_t loaded, size_t total);
+
+    cocos2d::Label* _labelPercent;
+    std::vector<std::string> _paths;
+    unsigned int _batchId;
+};
+
 #endif  // _TEXTURECACHE_TEST_H_
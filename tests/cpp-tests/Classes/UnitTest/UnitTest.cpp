@@ -27,6 +27,9 @@
 #include "ui/UIHelper.h"
 #include "network/Uri.h"
 #include "base/ccUtils.h"
+#include "base/CCFrameProfiler.h"
+#include "base/CCJobSystem.h"
+#include "base/CCAsyncTaskPool.h"
 
 USING_NS_CC;
 using namespace cocos2d::network;
@@ -78,6 +81,9 @@ UnitTests::UnitTests()
     ADD_TEST_CASE(ParseIntegerListTest);
     ADD_TEST_CASE(ParseUriTest);
     ADD_TEST_CASE(ResizableBufferAdapterTest);
+    ADD_TEST_CASE(FrameProfilerTest);
+    ADD_TEST_CASE(JobSystemTest);
+    ADD_TEST_CASE(AsyncTaskPoolTest);
 #ifdef UNIT_TEST_FOR_OPTIMIZED_MATH_UTIL
     ADD_TEST_CASE(MathUtilTest);
 #endif
@@ -1723,3 +1729,229 @@ std::string ResizableBufferAdapterTest::subtitle() const
 {
     return "ResiziableBufferAdapter<Data> Test";
 }
+
+// FrameProfilerTest
+
+void FrameProfilerTest::onEnter()
+{
+    UnitTestDemo::onEnter();
+
+    auto profiler = FrameProfiler::getInstance();
+
+    {
+        ProfileZone zone("FrameProfilerTest::ignored");
+    }
+
+    profiler->startCapture();
+    {
+        ProfileZone outer("FrameProfilerTest::outer");
+        ProfileZone inner("FrameProfilerTest::inner");
+        JobSystem::getInstance()->parallelFor(4, [](size_t) { ProfileZone job("FrameProfilerTest::job"); });
+    }
+    profiler->stopCapture();
+
+    {
+        ProfileZone zone("FrameProfilerTest::late");
+    }
+
+    auto trace = profiler->toChromeTrace();
+    EXPECT_EQ(trace.compare(0, 15, "{\"traceEvents\":"), 0);
+    EXPECT_NE(trace.find("\"name\":\"FrameProfilerTest::outer\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(trace.find("FrameProfilerTest::inner"), std::string::npos);
+    EXPECT_NE(trace.find("FrameProfilerTest::job"), std::string::npos);
+    EXPECT_EQ(trace.find("FrameProfilerTest::ignored"), std::string::npos);
+    EXPECT_EQ(trace.find("FrameProfilerTest::late"), std::string::npos);
+
+    // a capture limited to two frames stops on its own
+    profiler->startCapture(2);
+    profiler->markFrame();
+    EXPECT_TRUE(FrameProfiler::isCapturing());
+    profiler->markFrame();
+    EXPECT_FALSE(FrameProfiler::isCapturing());
+    EXPECT_EQ(profiler->getCapturedFrames(), 2);
+}
+
+std::string FrameProfilerTest::subtitle() const
+{
+    return "FrameProfiler Test";
+}
+
+// waits up to a few seconds for a condition set by worker threads
+static bool waitUntil(const std::function<bool()>& condition)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!condition())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+// JobSystemTest
+
+void JobSystemTest::onEnter()
+{
+    UnitTestDemo::onEnter();
+
+    // submit runs every job once
+    {
+        JobSystem jobSystem(2);
+        std::atomic<int> counter{0};
+        for (int i = 0; i < 100; ++i)
+            jobSystem.submit([&counter] { ++counter; });
+        EXPECT_TRUE(waitUntil([&counter] { return counter.load() == 100; }));
+    }
+
+    // parallelFor visits every index exactly once and returns after the last one
+    {
+        JobSystem jobSystem(3);
+        std::vector<std::atomic<int>> hits(1000);
+        jobSystem.parallelFor(hits.size(), [&hits](size_t i) { ++hits[i]; });
+        for (auto& hit : hits)
+            EXPECT_EQ(hit.load(), 1);
+
+        int calls = 0;
+        jobSystem.parallelFor(0, [&calls](size_t) { ++calls; });
+        EXPECT_EQ(calls, 0);
+        jobSystem.parallelFor(1, [&calls](size_t) { ++calls; });
+        EXPECT_EQ(calls, 1);
+    }
+
+    // parallelForRange covers [begin, end) with chunks no larger than the grain size
+    {
+        JobSystem jobSystem(3);
+        std::vector<std::atomic<int>> hits(1003);
+        std::atomic<bool> chunkTooLarge{false};
+        jobSystem.parallelForRange(3, hits.size(), 64, [&](size_t begin, size_t end) {
+            if (end - begin > 64)
+                chunkTooLarge = true;
+            for (size_t i = begin; i < end; ++i)
+                ++hits[i];
+        });
+        EXPECT_FALSE(chunkTooLarge.load());
+        for (size_t i = 0; i < hits.size(); ++i)
+            EXPECT_EQ(hits[i].load(), i < 3 ? 0 : 1);
+    }
+
+    // a worker picks the higher priority job first
+    {
+        JobSystem jobSystem(1);
+        std::atomic<bool> started{false};
+        std::atomic<bool> release{false};
+        jobSystem.submit([&] {
+            started = true;
+            while (!release)
+                std::this_thread::yield();
+        });
+        EXPECT_TRUE(waitUntil([&started] { return started.load(); }));
+
+        std::mutex mutex;
+        std::vector<JobSystem::Priority> order;
+        auto record = [&](JobSystem::Priority priority) {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(priority);
+        };
+        jobSystem.submit([&] { record(JobSystem::Priority::LOW); }, JobSystem::Priority::LOW);
+        jobSystem.submit([&] { record(JobSystem::Priority::NORMAL); }, JobSystem::Priority::NORMAL);
+        jobSystem.submit([&] { record(JobSystem::Priority::HIGH); }, JobSystem::Priority::HIGH);
+        release = true;
+
+        EXPECT_TRUE(waitUntil([&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            return order.size() == 3;
+        }));
+        EXPECT_TRUE(order[0] == JobSystem::Priority::HIGH);
+        EXPECT_TRUE(order[1] == JobSystem::Priority::NORMAL);
+        EXPECT_TRUE(order[2] == JobSystem::Priority::LOW);
+    }
+
+    // shutting down drops the jobs not started yet with their continuations and waits for the running ones
+    {
+        auto jobSystem     = new JobSystem(1);
+        auto started       = std::make_shared<std::atomic<bool>>(false);
+        auto release       = std::make_shared<std::atomic<bool>>(false);
+        auto pendingRan    = std::make_shared<std::atomic<bool>>(false);
+        auto continuations = std::make_shared<std::atomic<int>>(0);
+        jobSystem->submit([started, release] {
+            *started = true;
+            while (!*release)
+                std::this_thread::yield();
+        });
+        EXPECT_TRUE(waitUntil([started] { return started->load(); }));
+        jobSystem->submit([pendingRan] { *pendingRan = true; }, [continuations] { ++*continuations; });
+
+        // release the running job once the destructor asked the worker to stop
+        std::thread releaser([release] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            *release = true;
+        });
+        delete jobSystem;
+        releaser.join();
+        EXPECT_FALSE(pendingRan->load());
+
+        // a finished job's continuation runs on the cocos thread
+        auto mainThread = std::this_thread::get_id();
+        auto ranOnMain  = std::make_shared<std::atomic<bool>>(false);
+        JobSystem::getInstance()->submit([] {},
+                                         [continuations, ranOnMain, mainThread] {
+                                             ++*continuations;
+                                             *ranOnMain = std::this_thread::get_id() == mainThread;
+                                         });
+        scheduleOnce(
+            [continuations, ranOnMain](float) {
+                EXPECT_EQ(continuations->load(), 1);
+                EXPECT_TRUE(ranOnMain->load());
+            },
+            0.5f, "JobSystemTest::continuation");
+    }
+}
+
+std::string JobSystemTest::subtitle() const
+{
+    return "JobSystem Test";
+}
+
+// AsyncTaskPoolTest
+
+void AsyncTaskPoolTest::onEnter()
+{
+    UnitTestDemo::onEnter();
+
+    // io tasks run one at a time in the order they were enqueued
+    struct State
+    {
+        std::mutex mutex;
+        std::vector<int> order;
+        std::atomic<int> running{0};
+        std::atomic<bool> overlapped{false};
+    };
+    auto state = std::make_shared<State>();
+    for (int i = 0; i < 50; ++i)
+    {
+        AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_IO, [state, i] {
+            if (++state->running > 1)
+                state->overlapped = true;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->order.push_back(i);
+            }
+            --state->running;
+        });
+    }
+
+    EXPECT_TRUE(waitUntil([state] {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        return state->order.size() == 50;
+    }));
+    EXPECT_FALSE(state->overlapped.load());
+    for (int i = 0; i < 50; ++i)
+        EXPECT_EQ(state->order[i], i);
+}
+
+std::string AsyncTaskPoolTest::subtitle() const
+{
+    return "AsyncTaskPool TASK_IO order Test";
+}
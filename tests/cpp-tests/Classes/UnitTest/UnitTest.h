@@ -112,4 +112,28 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class FrameProfilerTest : public UnitTestDemo
+{
+public:
+    CREATE_FUNC(FrameProfilerTest);
+    virtual void onEnter() override;
+    virtual std::string subtitle() const override;
+};
+
+class JobSystemTest : public UnitTestDemo
+{
+public:
+    CREATE_FUNC(JobSystemTest);
+    virtual void onEnter() override;
+    virtual std::string subtitle() const override;
+};
+
+class AsyncTaskPoolTest : public UnitTestDemo
+{
+public:
+    CREATE_FUNC(AsyncTaskPoolTest);
+    virtual void onEnter() override;
+    virtual std::string subtitle() const override;
+};
+
 #endif /* __UNIT_TEST__ */
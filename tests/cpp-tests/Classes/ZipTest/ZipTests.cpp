@@ -35,6 +35,7 @@ ZipTests::ZipTests()
 {
     ADD_TEST_CASE(UnZipNormalFile);
     ADD_TEST_CASE(UnZipWithPassword);
+    ADD_TEST_CASE(MountArchive);
 }
 
 std::string ZipTest::title() const
@@ -186,3 +187,72 @@ std::string UnZipWithPassword::subtitle() const
 {
     return "unzip with password";
 }
+
+void MountArchive::onEnter()
+{
+    TestCase::onEnter();
+
+    const auto winSize = Director::getInstance()->getWinSize();
+
+    Label* label = Label::createWithTTF("mounting archive", "fonts/Marker Felt.ttf", 23);
+    label->setPosition(winSize.width / 2, winSize.height / 2);
+    addChild(label);
+
+    auto fu = FileUtils::getInstance();
+
+    // copy file to support android
+    std::string zipPath{fu->getWritablePath()};
+    zipPath += "mount-test.zip";
+    if (!fu->writeDataToFile(fu->getDataFromFile("zip/10k-nopass.zip"), zipPath))
+    {
+        label->setString("Failed to copy zip file to writable path");
+        return;
+    }
+
+    std::string mountPoint{fu->getWritablePath()};
+    mountPoint += "mount-test/";
+    if (!fu->mountArchive(zipPath, mountPoint))
+    {
+        label->setString("Failed to mount zip file");
+        return;
+    }
+
+    auto origContent = fu->getDataFromFile("zip/10k.txt");
+
+    // the entry is stored, so it's viewed in the archive mapping instead of being copied
+    auto mapped = fu->getMappedDataFromFile(mountPoint + "10k.txt");
+
+    // each reader gets its own copy concurrently
+    const size_t readerCount = 8;
+    std::atomic<size_t> matches{0};
+    JobSystem::getInstance()->parallelFor(readerCount, [&](size_t) {
+        auto content = FileUtils::getInstance()->getDataFromFile(mountPoint + "10k.txt");
+        if (content.getSize() == origContent.getSize() &&
+            memcmp(content.getBytes(), origContent.getBytes(), content.getSize()) == 0)
+            ++matches;
+    });
+
+    if (!fu->isFileExist(mountPoint + "10k.txt"))
+        label->setString("mounted file not found!");
+    else if (matches != readerCount)
+        label->setString("mounted file data mismatch!");
+    else if (!mapped.isMapped() || mapped.getSize() != origContent.getSize() ||
+             memcmp(mapped.getBytes(), origContent.getBytes(), mapped.getSize()) != 0)
+        label->setString("mounted file isn't viewed in the mapping!");
+    else
+        label->setString("mount ok!");
+
+    fu->unmountArchive(mountPoint);
+
+    // the view keeps the archive mapped after unmounting, it must be released before the file can be removed
+    if (mapped.getSize() != origContent.getSize() ||
+        memcmp(mapped.getBytes(), origContent.getBytes(), mapped.getSize()) != 0)
+        label->setString("mapped view lost after unmount!");
+    mapped.clear();
+    fu->removeFile(zipPath);
+}
+
+std::string MountArchive::subtitle() const
+{
+    return "mount a zip file and read it from several threads";
+}
@@ -49,3 +49,11 @@ public:
     virtual void onEnter() override;
     virtual std::string subtitle() const override;
 };
+
+class MountArchive : public ZipTest
+{
+public:
+    CREATE_FUNC(MountArchive);
+    virtual void onEnter() override;
+    virtual std::string subtitle() const override;
+};
@@ -53,6 +53,7 @@ public:
         addTest("Actions - Ease", []() { return new ActionsEaseTests(); });
         addTest("Actions - Progress", []() { return new ActionsProgressTests(); });
         addTest("Audio - NewAudioEngine", []() { return new AudioEngineTests(); });
+        addTest("Benchmark", []() { return new BenchmarkTests(); });
 
         addTest("Box2D - Basic", []() { return new Box2DTests(); });
 #if defined(CC_PLATFORM_PC)
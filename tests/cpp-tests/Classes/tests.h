@@ -58,6 +58,7 @@
 #include "ActionsEaseTest/ActionsEaseTest.h"
 #include "ActionsProgressTest/ActionsProgressTest.h"
 #include "ActionsTest/ActionsTest.h"
+#include "BenchmarkTest/BenchmarkTest.h"
 #include "BillBoardTest/BillBoardTest.h"
 #include "BugsTest/BugsTest.h"
 #include "Camera3DTest/Camera3DTest.h"
@@ -23,6 +23,7 @@
  ****************************************************************************/
 
 #include "../Classes/AppDelegate.h"
+#include "../Classes/BenchmarkTest/BenchmarkRunner.h"
 #include "cocos2d.h"
 
 #include <stdlib.h>
@@ -32,9 +33,94 @@
 
 USING_NS_CC;
 
+static void printUsage(const char* program)
+{
+    printf("usage: %s [--headless [--frames N] [--dt SECONDS] [--size WIDTHxHEIGHT]\n"
+           "          [--capture-interval N --capture-dir DIR] [--stats FILE]]\n"
+           "       %s --benchmark [--benchmark-frames N] [--benchmark-warmup N] [--benchmark-out FILE]\n"
+           "          [--benchmark-baseline FILE] [--benchmark-threshold METRIC=PERCENT] [--dt SECONDS]\n",
+           program, program);
+}
+
 int main(int argc, char** argv)
 {
     // create the application instance
     AppDelegate app;
-    return Application::getInstance()->run();
+
+    bool headless  = false;
+    bool benchmark = false;
+    Application::HeadlessOptions options;
+    BenchmarkOptions benchmarkOptions;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool hasValue   = i + 1 < argc;
+        if (arg == "--headless")
+            headless = true;
+        else if (arg == "--frames" && hasValue)
+            options.frameCount = static_cast<unsigned int>(atoi(argv[++i]));
+        else if (arg == "--dt" && hasValue)
+            options.deltaTime = static_cast<float>(atof(argv[++i]));
+        else if (arg == "--size" && hasValue)
+            sscanf(argv[++i], "%fx%f", &options.width, &options.height);
+        else if (arg == "--capture-interval" && hasValue)
+            options.captureInterval = static_cast<unsigned int>(atoi(argv[++i]));
+        else if (arg == "--capture-dir" && hasValue)
+            options.captureDirectory = argv[++i];
+        else if (arg == "--stats" && hasValue)
+            options.statsPath = argv[++i];
+        else if (arg == "--benchmark")
+            benchmark = true;
+        else if (arg == "--benchmark-frames" && hasValue)
+            benchmarkOptions.frames = static_cast<unsigned int>(atoi(argv[++i]));
+        else if (arg == "--benchmark-warmup" && hasValue)
+            benchmarkOptions.warmupFrames = static_cast<unsigned int>(atoi(argv[++i]));
+        else if (arg == "--benchmark-out" && hasValue)
+            benchmarkOptions.outputPath = argv[++i];
+        else if (arg == "--benchmark-baseline" && hasValue)
+            benchmarkOptions.baselinePath = argv[++i];
+        else if (arg == "--benchmark-threshold" && hasValue)
+        {
+            // e.g. cpu_ms=15 tolerates a frame time 15% above the baseline
+            std::string threshold = argv[++i];
+            auto separator        = threshold.find('=');
+            if (separator == std::string::npos ||
+                !benchmarkOptions.thresholds.set(threshold.substr(0, separator),
+                                                 static_cast<float>(atof(threshold.c_str() + separator + 1)) / 100))
+            {
+                printUsage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    auto benchmarkRunner = BenchmarkRunner::getInstance();
+    if (benchmark)
+    {
+        // the benchmark needs the fixed delta time of the headless mode to be comparable between runs
+        headless                      = true;
+        benchmarkOptions.exitWhenDone = true;
+        if (benchmarkOptions.outputPath.empty())
+            benchmarkOptions.outputPath = "benchmark.json";
+        benchmarkRunner->setOptions(benchmarkOptions);
+        benchmarkRunner->setRunAtLaunch(true);
+    }
+
+    if (headless)
+    {
+        if (options.captureInterval > 0 && options.captureDirectory.empty())
+            options.captureDirectory = ".";
+        Application::getInstance()->setHeadlessOptions(options);
+    }
+    int result = Application::getInstance()->run();
+
+    // a suite cut short by --frames or a closed window fails as well
+    if (benchmark && (benchmarkRunner->isRunning() || !benchmarkRunner->hasPassed()))
+        return EXIT_FAILURE;
+    return result;
 }